@@ -154,6 +154,54 @@ if(BUILD_NVCOMP)
 endif()
 
 
+##################################################################
+# lz4
+##################################################################
+if(BUILD_LZ4)
+  find_optional_library(LZ4_LIB_FOUND lz4_LIBS lz4_INCLUDE_DIR "${LZ4_ROOT_DIR}" lz4.h lz4 liblz4)
+  if(${lz4_LIBS} STREQUAL lz4_LIBS-NOTFOUND)
+    message(FATAL_ERROR "lz4 could not be found. Try to specify it's location with `-DLZ4_ROOT_DIR`.")
+  endif()
+  if(${lz4_INCLUDE_DIR} STREQUAL lz4_INCLUDE_DIR-NOTFOUND)
+    message(FATAL_ERROR "lz4 headers could not be found. Try to specify it's location with `-DLZ4_ROOT_DIR`.")
+  endif()
+  message(STATUS "Found lz4: ${lz4_LIBS} ${lz4_INCLUDE_DIR}")
+  include_directories(SYSTEM ${lz4_INCLUDE_DIR})
+  list(APPEND DALI_LIBS ${lz4_LIBS})
+endif()
+
+##################################################################
+# zstd
+##################################################################
+if(BUILD_ZSTD)
+  find_optional_library(ZSTD_LIB_FOUND zstd_LIBS zstd_INCLUDE_DIR "${ZSTD_ROOT_DIR}" zstd.h zstd libzstd)
+  if(${zstd_LIBS} STREQUAL zstd_LIBS-NOTFOUND)
+    message(FATAL_ERROR "zstd could not be found. Try to specify it's location with `-DZSTD_ROOT_DIR`.")
+  endif()
+  if(${zstd_INCLUDE_DIR} STREQUAL zstd_INCLUDE_DIR-NOTFOUND)
+    message(FATAL_ERROR "zstd headers could not be found. Try to specify it's location with `-DZSTD_ROOT_DIR`.")
+  endif()
+  message(STATUS "Found zstd: ${zstd_LIBS} ${zstd_INCLUDE_DIR}")
+  include_directories(SYSTEM ${zstd_INCLUDE_DIR})
+  list(APPEND DALI_LIBS ${zstd_LIBS})
+endif()
+
+##################################################################
+# zlib
+##################################################################
+if(BUILD_ZLIB)
+  find_optional_library(ZLIB_LIB_FOUND zlib_LIBS zlib_INCLUDE_DIR "${ZLIB_ROOT_DIR}" zlib.h z zlib libz)
+  if(${zlib_LIBS} STREQUAL zlib_LIBS-NOTFOUND)
+    message(FATAL_ERROR "zlib could not be found. Try to specify it's location with `-DZLIB_ROOT_DIR`.")
+  endif()
+  if(${zlib_INCLUDE_DIR} STREQUAL zlib_INCLUDE_DIR-NOTFOUND)
+    message(FATAL_ERROR "zlib headers could not be found. Try to specify it's location with `-DZLIB_ROOT_DIR`.")
+  endif()
+  message(STATUS "Found zlib: ${zlib_LIBS} ${zlib_INCLUDE_DIR}")
+  include_directories(SYSTEM ${zlib_INCLUDE_DIR})
+  list(APPEND DALI_LIBS ${zlib_LIBS})
+endif()
+
 ##################################################################
 # FFmpeg
 ##################################################################
@@ -234,6 +234,26 @@ function(propagate_option BUILD_OPTION_NAME)
   endif()
 endfunction(propagate_option)
 
+# Looks for an optional library and its header in <ROOT_DIR> and the default locations.
+# Sets <LIB_VAR> and <INCLUDE_VAR> (cached, so the later lookups reuse them) and sets
+# <FOUND_VAR> to ON if both were found, OFF otherwise.
+#
+macro(find_optional_library FOUND_VAR LIB_VAR INCLUDE_VAR ROOT_DIR HEADER)
+  find_library(${LIB_VAR}
+          NAMES ${ARGN}
+          PATHS ${ROOT_DIR} "/usr/local" ${CMAKE_SYSTEM_PREFIX_PATH}
+          PATH_SUFFIXES lib lib64)
+  find_path(${INCLUDE_VAR}
+          NAMES ${HEADER}
+          PATHS ${ROOT_DIR} "/usr/local" ${CMAKE_SYSTEM_PREFIX_PATH}
+          PATH_SUFFIXES include)
+  if (${LIB_VAR} AND ${INCLUDE_VAR})
+    set(${FOUND_VAR} ON)
+  else()
+    set(${FOUND_VAR} OFF)
+  endif()
+endmacro(find_optional_library)
+
 function(add_sources_to_lint LINT_TARGET LINT_EXTRA LIST_SRC)
   add_custom_command(
     TARGET ${LINT_TARGET}
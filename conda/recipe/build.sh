@@ -87,6 +87,9 @@ cmake -DCUDA_TOOLKIT_ROOT_DIR=/usr/local/cuda \
       -DBUILD_NVML=${BUILD_NVML:-ON}                      \
       -DBUILD_CUFILE=${BUILD_CUFILE:-ON}                  \
       -DBUILD_NVCOMP=${BUILD_NVCOMP}                      \
+      -DBUILD_LZ4=${BUILD_LZ4:-ON}                        \
+      -DBUILD_ZSTD=${BUILD_ZSTD:-ON}                      \
+      -DBUILD_ZLIB=${BUILD_ZLIB:-ON}                      \
       -DBUILD_CVCUDA=${BUILD_CVCUDA:-ON}                  \
       -DLINK_LIBCUDA=${LINK_LIBCUDA:-OFF}                 \
       -DWITH_DYNAMIC_CUDA_TOOLKIT=${WITH_DYNAMIC_CUDA_TOOLKIT:-${WITH_DYNAMIC_CUDA_TOOLKIT_DEFAULT}}\
@@ -0,0 +1,123 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "dali/kernels/imgproc/filter/median_blur_cpu.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief The straightforward implementation, with std::nth_element for every pixel -
+ *        the reference for the timings
+ */
+template <typename T>
+void MedianBlurNthElement(const kernels::OutTensorCPU<T, 3> &out,
+                          const kernels::InTensorCPU<T, 3> &in, ivec2 window) {
+  int H = in.shape[0], W = in.shape[1], C = in.shape[2];
+  kernels::median_blur::PaddedRows<T> rows(in.data, H, W, C, window);
+  std::vector<T> buf(window.x * window.y);
+  for (int y = 0; y < H; y++)
+    kernels::median_blur::MedianRowGeneric(out.data + static_cast<int64_t>(y) * W * C,
+                                           rows.Get(y), W, C, window, buf.data());
+}
+
+static void MedianBlurArgs(benchmark::internal::Benchmark *b) {
+  for (int channels : {1, 3}) {
+    for (int window : {3, 5, 7, 9, 15}) {
+      b->Args({channels, window});
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+class MedianBlurFixture : public benchmark::Fixture {
+ public:
+  void SetUp(benchmark::State &st) override {
+    channels_ = st.range(0);
+    window_ = ivec2(st.range(1), st.range(1));
+    TensorShape<3> shape{kHeight, kWidth, channels_};
+    in_mem_.resize(volume(shape));
+    out_mem_.resize(volume(shape));
+    std::mt19937 rng(123);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (auto &v : in_mem_)
+      v = dist(rng);
+    in_ = kernels::InTensorCPU<T, 3>(in_mem_.data(), shape);
+    out_ = kernels::OutTensorCPU<T, 3>(out_mem_.data(), shape);
+  }
+
+  void TearDown(benchmark::State &st) override {
+    st.SetItemsProcessed(st.iterations() * volume(in_.shape));
+  }
+
+  void RunKernel() {
+    kernels::MedianBlurCpu<T> kernel;
+    kernels::KernelContext ctx;
+    kernel.Setup(ctx, in_, window_);
+    kernel.Run(ctx, out_, in_, window_);
+    benchmark::DoNotOptimize(out_mem_.data());
+  }
+
+  void RunReference() {
+    MedianBlurNthElement(out_, in_, window_);
+    benchmark::DoNotOptimize(out_mem_.data());
+  }
+
+  static constexpr int kHeight = 480, kWidth = 640;
+  int channels_ = 1;
+  ivec2 window_;
+  std::vector<T> in_mem_, out_mem_;
+  kernels::InTensorCPU<T, 3> in_;
+  kernels::OutTensorCPU<T, 3> out_;
+};
+
+BENCHMARK_TEMPLATE_DEFINE_F(MedianBlurFixture, Uint8, uint8_t)(benchmark::State &st) {
+  for (auto _ : st)
+    RunKernel();
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(MedianBlurFixture, Uint16, uint16_t)(benchmark::State &st) {
+  for (auto _ : st)
+    RunKernel();
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(MedianBlurFixture, Float, float)(benchmark::State &st) {
+  for (auto _ : st)
+    RunKernel();
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(MedianBlurFixture, NthElementUint8, uint8_t)
+    (benchmark::State &st) {
+  for (auto _ : st)
+    RunReference();
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(MedianBlurFixture, NthElementFloat, float)(benchmark::State &st) {
+  for (auto _ : st)
+    RunReference();
+}
+
+BENCHMARK_REGISTER_F(MedianBlurFixture, Uint8)->Apply(MedianBlurArgs);
+BENCHMARK_REGISTER_F(MedianBlurFixture, Uint16)->Apply(MedianBlurArgs);
+BENCHMARK_REGISTER_F(MedianBlurFixture, Float)->Apply(MedianBlurArgs);
+BENCHMARK_REGISTER_F(MedianBlurFixture, NthElementUint8)->Apply(MedianBlurArgs);
+BENCHMARK_REGISTER_F(MedianBlurFixture, NthElementFloat)->Apply(MedianBlurArgs);
+
+}  // namespace dali
@@ -0,0 +1,110 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef DALI_BUILD_PROTO3
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "dali/operators/reader/parser/example.pb.h"
+#include "dali/operators/reader/parser/tfrecord_scanner.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Builds a record resembling the ImageNet TFRecords - an encoded image, a few scalars and
+ *        bounding boxes, along with some metadata that is not requested
+ */
+std::string MakeRecord(int64_t image_size) {
+  tensorflow::Example example;
+  auto &map = *example.mutable_features()->mutable_feature();
+  map["image/encoded"].mutable_bytes_list()->add_value(std::string(image_size, '\xab'));
+  map["image/class/label"].mutable_int64_list()->add_value(42);
+  for (auto *name : {"image/object/bbox/xmin", "image/object/bbox/ymin",
+                     "image/object/bbox/xmax", "image/object/bbox/ymax"}) {
+    auto &list = *map[name].mutable_float_list();
+    for (int i = 0; i < 4; i++)
+      list.add_value(0.1f * i);
+  }
+  map["image/height"].mutable_int64_list()->add_value(480);
+  map["image/width"].mutable_int64_list()->add_value(640);
+  map["image/format"].mutable_bytes_list()->add_value("JPEG");
+  map["image/filename"].mutable_bytes_list()->add_value("n01440764_10026.JPEG");
+  map["image/class/synset"].mutable_bytes_list()->add_value("n01440764");
+  map["image/class/text"].mutable_bytes_list()->add_value("tench, Tinca tinca");
+  std::string record;
+  example.SerializeToString(&record);
+  return record;
+}
+
+const std::vector<std::string> kFeatureNames = {
+  "image/encoded", "image/class/label", "image/object/bbox/xmin", "image/object/bbox/ymin",
+  "image/object/bbox/xmax", "image/object/bbox/ymax"
+};
+
+struct Outputs {
+  explicit Outputs(int64_t image_size) : image(image_size), bbox(4, std::vector<float>(4)) {}
+  std::vector<uint8_t> image;
+  int64_t label = 0;
+  std::vector<std::vector<float>> bbox;
+};
+
+}  // namespace
+
+static void TFRecordParseProtobuf(benchmark::State& st) {
+  auto record = MakeRecord(st.range(0));
+  Outputs out(st.range(0));
+  for (auto _ : st) {
+    tensorflow::Example example;
+    example.ParseFromArray(record.data(), record.size());
+    auto &map = example.features().feature();
+    auto &image = map.find(kFeatureNames[0])->second.bytes_list().value(0);
+    std::memcpy(out.image.data(), image.data(), image.size());
+    out.label = map.find(kFeatureNames[1])->second.int64_list().value(0);
+    for (int i = 0; i < 4; i++) {
+      auto &bbox = map.find(kFeatureNames[2 + i])->second.float_list().value();
+      std::memcpy(out.bbox[i].data(), bbox.data(), bbox.size() * sizeof(float));
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  st.SetBytesProcessed(st.iterations() * record.size());
+}
+
+static void TFRecordParseScanner(benchmark::State& st) {
+  auto record = MakeRecord(st.range(0));
+  Outputs out(st.range(0));
+  auto data = make_cspan(reinterpret_cast<const uint8_t *>(record.data()), record.size());
+  for (auto _ : st) {
+    tfrecord::FeatureView views[6];
+    tfrecord::ScanExample(data, make_cspan(kFeatureNames), make_span(views));
+    auto image = views[0].BytesValue(0);
+    std::memcpy(out.image.data(), image.data(), image.size());
+    views[1].CopyValues(&out.label);
+    for (int i = 0; i < 4; i++)
+      views[2 + i].CopyValues(out.bbox[i].data());
+    benchmark::DoNotOptimize(out);
+  }
+  st.SetBytesProcessed(st.iterations() * record.size());
+}
+
+BENCHMARK(TFRecordParseProtobuf)->Arg(1 << 10)->Arg(100 << 10)->Arg(1 << 20);
+BENCHMARK(TFRecordParseScanner)->Arg(1 << 10)->Arg(100 << 10)->Arg(1 << 20);
+
+}  // namespace dali
+
+#endif  // DALI_BUILD_PROTO3
@@ -103,4 +103,49 @@ BENCHMARK_REGISTER_F(ThreadPoolBench, AddWorkDeferred)->Iterations(1000)
 ->UseRealTime()
 ->Apply(ThreadPoolArgs);
 
+
+static void ThreadPoolScalingArgs(benchmark::internal::Benchmark *b) {
+  int batch_size = 256;
+  int work_size = 64;
+  for (int work_stealing = 0; work_stealing < 2; work_stealing++) {
+    for (int nthreads = 1; nthreads <= 64; nthreads *= 2) {
+      b->Args({batch_size, work_size, nthreads, work_stealing});
+    }
+  }
+}
+
+// Many cheap tasks, as scheduled by per-sample operators (e.g. Cast or Flip) - the time is
+// dominated by the scheduling overhead
+BENCHMARK_DEFINE_F(ThreadPoolBench, CheapWorkScaling)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int work_size = st.range(1);
+  int nthreads = st.range(2);
+  bool work_stealing = st.range(3);
+
+  ThreadPool thread_pool(nthreads, 0, false, "ThreadPoolBench");
+  thread_pool.SetWorkStealing(work_stealing);
+  std::vector<float> data(batch_size * work_size, 1.0f);
+
+  while (st.KeepRunning()) {
+    for (int i = 0; i < batch_size; i++) {
+      thread_pool.AddWork(
+        [&data, i, work_size](int thread_id) {
+          float *sample = &data[i * work_size];
+          for (int j = 0; j < work_size; j++)
+            sample[j] = sample[j] * 0.5f + 0.5f;
+        }, work_size);
+    }
+    thread_pool.RunAll();
+
+    int num_batches = st.iterations() + 1;
+    st.counters["FPS"] = benchmark::Counter(batch_size*num_batches,
+        benchmark::Counter::kIsRate);
+  }
+}
+
+BENCHMARK_REGISTER_F(ThreadPoolBench, CheapWorkScaling)->Iterations(1000)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ThreadPoolScalingArgs);
+
 }  // namespace dali
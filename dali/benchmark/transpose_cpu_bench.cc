@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -36,6 +36,10 @@ static CaseData cases[] = {
     CaseData{{100, 60, 3}, {0, 1, 2}},        // HWC
     CaseData{{100, 60, 3}, {2, 0, 1}},        // CHW
     CaseData{{100, 60, 3}, {2, 1, 0}},        // CWH
+                                              // tiled cases
+    CaseData{{60, 80, 3}, {2, 0, 1}},         // CHW
+    CaseData{{60, 80, 16}, {2, 0, 1}},        // CHW
+    CaseData{{128, 128}, {1, 0}},
                                               // 4D
     CaseData{{20, 20, 20, 4}, {0, 1, 2, 3}},  // id
     CaseData{{20, 20, 20, 4}, {3, 2, 1, 0}},
@@ -60,6 +64,19 @@ static void CustomArguments(benchmark::internal::Benchmark* b) {
   }
 }
 
+/**
+ * @brief The element-wise recursion, without the tiled path - the reference for the timings
+ */
+template <typename T>
+void TransposeRecursive(const TensorView<StorageCPU, T> &dst,
+                        const TensorView<StorageCPU, const T> &src, span<const int> perm) {
+  auto dst_strides = kernels::GetStrides(dst.shape);
+  auto src_strides = kernels::GetStrides(src.shape);
+  kernels::transpose_impl::TransposeRecursive(dst.data, src.data, dst.shape.sample_dim(),
+                                              make_span(dst_strides), make_span(src_strides),
+                                              dst.shape, perm);
+}
+
 }  // namespace
 
 template <typename T>
@@ -168,4 +185,29 @@ BENCHMARK_REGISTER_F(TransposeFixture, CompactUint16Test)->Apply(CustomArguments
 BENCHMARK_REGISTER_F(TransposeFixture, CompactIntTest)->Apply(CustomArguments);
 BENCHMARK_REGISTER_F(TransposeFixture, CompactDoubleTest)->Apply(CustomArguments);
 
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeFixture, RecursiveUint8Test,
+                            uint8_t)(benchmark::State& st) {
+  for (auto _ : st) {
+    benchmark<&TransposeRecursive<uint8_t>>();
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeFixture, RecursiveUint16Test,
+                            uint16_t)(benchmark::State& st) {
+  for (auto _ : st) {
+    benchmark<&TransposeRecursive<uint16_t>>();
+  }
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(TransposeFixture, RecursiveIntTest,
+                            int)(benchmark::State& st) {
+  for (auto _ : st) {
+    benchmark<&TransposeRecursive<int>>();
+  }
+}
+
+BENCHMARK_REGISTER_F(TransposeFixture, RecursiveUint8Test)->Apply(CustomArguments);
+BENCHMARK_REGISTER_F(TransposeFixture, RecursiveUint16Test)->Apply(CustomArguments);
+BENCHMARK_REGISTER_F(TransposeFixture, RecursiveIntTest)->Apply(CustomArguments);
+
 }  // namespace dali
@@ -0,0 +1,95 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "dali/benchmark/dali_bench.h"
+#include "dali/pipeline/pipeline.h"
+#include "dali/test/dali_test_config.h"
+
+namespace dali {
+
+class VideoReaderCpuBench : public DALIBenchmark {
+ public:
+  void VideoReaderTest(benchmark::State& st, const std::vector<std::string> &filenames) {
+    const int batch_size = 8;
+    const int sequence_length = 16;
+    int num_thread = st.range(0);
+    int codec_threads = st.range(1);
+
+    Pipeline pipe(batch_size, num_thread, 0);
+    pipe.AddOperator(OpSpec("experimental__readers__Video")
+      .AddArg("device", "cpu")
+      .AddArg("sequence_length", sequence_length)
+      .AddArg("random_shuffle", true)
+      .AddArg("codec_threads", codec_threads)
+      .AddArg("filenames", filenames)
+      .AddOutput("frames", "cpu"));
+    pipe.Build({{"frames", "cpu"}});
+
+    // Run once to open the decoders
+    Workspace ws;
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+
+    for (auto _ : st) {
+      pipe.RunCPU();
+      pipe.RunGPU();
+      pipe.Outputs(&ws);
+    }
+
+    st.counters["FPS"] = benchmark::Counter(batch_size * sequence_length * st.iterations(),
+                                            benchmark::Counter::kIsRate);
+  }
+};
+
+static void VideoReaderArgs(benchmark::internal::Benchmark *b) {
+  // codec_threads == 0 means the automatic split between the sequences and the codec threads
+  for (int num_thread : {1, 4, 8}) {
+    for (int codec_threads : {0, 1, 4}) {
+      b->Args({num_thread, codec_threads});
+    }
+  }
+}
+
+BENCHMARK_DEFINE_F(VideoReaderCpuBench, H264)(benchmark::State& st) {
+  this->VideoReaderTest(st, {
+    testing::dali_extra_path() + "/db/video/cfr/test_1.mp4",
+    testing::dali_extra_path() + "/db/video/cfr/test_2.mp4",
+    testing::dali_extra_path() + "/db/video/vfr/test_1.mp4",
+    testing::dali_extra_path() + "/db/video/vfr/test_2.mp4"});
+}
+
+BENCHMARK_REGISTER_F(VideoReaderCpuBench, H264)->Iterations(20)
+->Unit(benchmark::kMillisecond)
+->UseRealTime()
+->Apply(VideoReaderArgs);
+
+BENCHMARK_DEFINE_F(VideoReaderCpuBench, Hevc)(benchmark::State& st) {
+  this->VideoReaderTest(st, {
+    testing::dali_extra_path() + "/db/video/cfr/test_1_hevc.mp4",
+    testing::dali_extra_path() + "/db/video/cfr/test_2_hevc.mp4",
+    testing::dali_extra_path() + "/db/video/vfr/test_1_hevc.mp4",
+    testing::dali_extra_path() + "/db/video/vfr/test_2_hevc.mp4"});
+}
+
+BENCHMARK_REGISTER_F(VideoReaderCpuBench, Hevc)->Iterations(20)
+->Unit(benchmark::kMillisecond)
+->UseRealTime()
+->Apply(VideoReaderArgs);
+
+}  // namespace dali
@@ -782,6 +782,48 @@ void daliFreeExecutorMetadata(daliExecutorMetadata *operator_meta, size_t operat
   free(operator_meta);
 }
 
+void daliEnableOperatorProfiling(daliPipelineHandle_t pipe_handle, int enable) {
+  dali::Pipeline* pipeline = (*pipe_handle)->pipeline.get();
+  pipeline->EnableOperatorProfiling(enable);
+}
+
+void daliGetOperatorProfile(daliPipelineHandle_t pipe_handle,
+                            daliOperatorProfile **operator_profile,
+                            size_t *operator_profile_num) {
+  dali::Pipeline* pipeline = (*pipe_handle)->pipeline.get();
+  auto profile = pipeline->GetOperatorProfile();
+  *operator_profile_num = profile.size();
+  *operator_profile = static_cast<daliOperatorProfile*>(malloc(sizeof(daliOperatorProfile) *
+                                                        profile.size()));
+
+  int i = 0;
+  for (const auto &entry : profile) {
+    auto op_name_size = entry.first.size();
+    auto &op_profile = (*operator_profile)[i];
+    op_profile.operator_name = static_cast<char*>(malloc(sizeof(char) * (op_name_size + 1)));
+    entry.first.copy(op_profile.operator_name, op_name_size);
+    op_profile.operator_name[op_name_size] = '\0';
+
+    const auto &stats = entry.second;
+    op_profile.iterations = stats.iterations;
+    op_profile.setup_time_ns = stats.setup_time;
+    op_profile.run_time_ns = stats.run_time;
+    op_profile.thread_pool_busy_ns = stats.thread_pool_busy_time;
+    op_profile.queue_wait_ns = stats.queue_wait_time;
+    op_profile.streamed_iterations = stats.streamed_iterations;
+    op_profile.samples = stats.samples;
+    op_profile.bytes = stats.bytes;
+    ++i;
+  }
+}
+
+void daliFreeOperatorProfile(daliOperatorProfile *operator_profile,
+                             size_t operator_profile_num) {
+  for (size_t i = 0; i < operator_profile_num; ++i)
+    free(operator_profile[i].operator_name);
+  free(operator_profile);
+}
+
 void daliReleaseUnusedMemory() {
   dali::mm::ReleaseUnusedMemory();
 }
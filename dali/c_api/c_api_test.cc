@@ -669,6 +669,63 @@ TYPED_TEST(CApiTest, TestExecutorMeta) {
   daliDeletePipeline(&handle);
 }
 
+TYPED_TEST(CApiTest, TestOperatorProfile) {
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  pipe_ptr.reset();
+  daliPipelineHandle handle;
+  daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
+                     this->device_id_, false, prefetch_queue_depth, prefetch_queue_depth,
+                     prefetch_queue_depth, false);
+
+  size_t N;
+  daliOperatorProfile *profile;
+  daliGetOperatorProfile(&handle, &profile, &N);
+  EXPECT_EQ(N, 0) << "The profiling is disabled by default";
+  daliFreeOperatorProfile(profile, N);
+
+  daliEnableOperatorProfiling(&handle, 1);
+  const int iterations = 3;
+  for (int i = 0; i < iterations; i++) {
+    daliRun(&handle);
+    daliOutput(&handle);
+  }
+  if (std::is_same_v<TypeParam, GPUBackend>)
+    CUDA_CALL(cudaDeviceSynchronize());
+
+  daliGetOperatorProfile(&handle, &profile, &N);
+  size_t num_ops = 0;
+  for (size_t i = 0; i < N; ++i) {
+    auto &entry = profile[i];
+    std::string name = entry.operator_name;
+    if (name == "CPU" || name == "MIXED" || name == "GPU") {
+      // the entries of the stages hold only the wait for the queues
+      EXPECT_GE(entry.iterations, static_cast<size_t>(iterations)) << name;
+      EXPECT_GE(entry.queue_wait_ns, 0) << name;
+      continue;
+    }
+    num_ops++;
+    EXPECT_EQ(entry.queue_wait_ns, 0) << name;
+    // the sample streaming is disabled by default
+    EXPECT_EQ(entry.streamed_iterations, 0u) << name;
+    // the pipeline may have run ahead, filling the prefetch queue
+    EXPECT_GE(entry.iterations, static_cast<size_t>(iterations)) << entry.operator_name;
+    EXPECT_GT(entry.run_time_ns, 0) << entry.operator_name;
+    EXPECT_GE(entry.setup_time_ns, 0) << entry.operator_name;
+    EXPECT_EQ(entry.samples, entry.iterations * batch_size) << entry.operator_name;
+    EXPECT_GT(entry.bytes, 0) << entry.operator_name;
+  }
+  // File Reader -> Image Decoder -> [Copy to Gpu] -> Resize -> Make Contiguous (always for outputs)
+  if (std::is_same_v<TypeParam, CPUBackend>) {
+    EXPECT_EQ(num_ops, 4);
+  } else {
+    EXPECT_EQ(num_ops, 5);
+  }
+  daliFreeOperatorProfile(profile, N);
+  daliDeletePipeline(&handle);
+}
+
 TYPED_TEST(CApiTest, UseCopyKernel) {
   TensorListShape<> input_shape = {{37, 23, 3}, {12, 22, 3}, {42, 42, 3}, {8, 8, 3},
                                    {64, 32, 3}, {32, 64, 3}, {20, 20, 3}, {64, 64, 3},
@@ -23,6 +23,7 @@
 #include "dali/core/mm/async_pool.h"
 #include "dali/core/mm/composite_resource.h"
 #include "dali/core/mm/cuda_vm_resource.h"
+#include "dali/core/mm/numa_cached_resource.h"
 #include "dali/core/call_at_exit.h"
 
 namespace dali {
@@ -140,6 +141,7 @@ struct MMEnv {
   bool use_pinned_mem_pool = true;
   bool use_vmm = true;
   bool use_cuda_malloc_async = false;
+  bool use_host_mem_cache = false;
 
   size_t host_malloc_threshold;
 
@@ -180,6 +182,9 @@ struct MMEnv {
       }
     }
 
+    const char *use_host_mem_cache_env = std::getenv("DALI_USE_HOST_MEM_CACHE");
+    use_host_mem_cache = use_host_mem_cache_env && atoi(use_host_mem_cache_env);
+
     host_malloc_threshold = ParseMallocThresholdEnv();
   }
 
@@ -216,6 +221,16 @@ struct MMEnv {
 inline std::shared_ptr<host_memory_resource> CreateDefaultHostResource() {
   static auto rsrc = std::make_shared<malloc_memory_resource>();
   size_t threshold = MMEnv::get().host_malloc_threshold;
+  if (MMEnv::get().use_host_mem_cache) {
+    auto cached = std::make_shared<numa_cached_resource>(rsrc.get());
+    if (threshold == 0)
+      return cached;
+    // The allocations above the threshold go directly to malloc, without growing the node pools
+    size_t thresholds[] = { threshold };
+    std::shared_ptr<host_memory_resource> resources[2] = { cached, rsrc };
+    using binning_t = decltype(binning_resource(thresholds, resources));
+    return std::make_shared<binning_t>(thresholds, resources);
+  }
   if (threshold > 0) {
     using pool_t = pool_resource<mm::memory_kind::host, mm::coalescing_free_tree, spinlock>;
     static auto pool = std::make_shared<pool_t>(rsrc.get());
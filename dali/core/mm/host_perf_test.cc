@@ -0,0 +1,170 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "dali/core/format.h"
+#include "dali/core/mm/malloc_resource.h"
+#include "dali/core/mm/numa_cached_resource.h"
+#include "dali/core/mm/pool_resource.h"
+#include "dali/core/spinlock.h"
+#include "dali/test/timing.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+using dali::test::format_time;
+using dali::test::perf_timer;
+using dali::test::seconds;
+
+/**
+ * @brief Measures the time of host allocations and deallocations done concurrently
+ *        by `num_threads` threads.
+ *
+ * Most of the allocations are freed by the thread which allocated them, but some are passed
+ * to other threads, as it happens with the buffers produced and consumed by different operators.
+ */
+void RunHostBenchmark(host_memory_resource *res, int num_threads, int num_iter = 100000) {
+  struct Alloc {
+    void *ptr;
+    size_t size, alignment;
+  };
+  std::vector<Alloc> shared;
+  spinlock lock;
+
+  perf_timer::duration total_alloc_time = {};
+  perf_timer::duration total_dealloc_time = {};
+  int64_t total_num_allocs = 0, total_num_deallocs = 0;
+
+  std::vector<std::thread> threads;
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&, tid]() {
+      std::mt19937_64 rng(tid);
+      std::uniform_real_distribution<float> size_log_dist(4, 20);
+      std::bernoulli_distribution action_dist(0.5);
+      std::bernoulli_distribution share_dist(0.05);
+      std::vector<Alloc> allocs;
+
+      perf_timer::duration alloc_time = {};
+      perf_timer::duration dealloc_time = {};
+      int64_t num_allocs = 0, num_deallocs = 0;
+
+      auto dealloc = [&](const Alloc &alloc) {
+        auto start = perf_timer::now();
+        res->deallocate(alloc.ptr, alloc.size, alloc.alignment);
+        auto end = perf_timer::now();
+        dealloc_time += (end-start);
+        num_deallocs++;
+      };
+
+      for (int iter = 0; iter < num_iter; iter++) {
+        if (action_dist(rng)) {
+          if (share_dist(rng)) {
+            Alloc alloc;
+            {
+              std::lock_guard g(lock);
+              if (shared.empty())
+                continue;
+              alloc = shared.back();
+              shared.pop_back();
+            }
+            dealloc(alloc);
+          } else {
+            if (allocs.empty())
+              continue;
+            int idx = std::uniform_int_distribution<int>(0, allocs.size() - 1)(rng);
+            Alloc alloc = allocs[idx];
+            std::swap(allocs[idx], allocs.back());
+            allocs.pop_back();
+            dealloc(alloc);
+          }
+        } else {
+          Alloc alloc = {};
+          alloc.size = static_cast<int>(powf(2, size_log_dist(rng)));
+          alloc.alignment = 64;
+          auto start = perf_timer::now();
+          alloc.ptr = res->allocate(alloc.size, alloc.alignment);
+          auto end = perf_timer::now();
+          alloc_time += (end-start);
+          num_allocs++;
+          if (share_dist(rng)) {
+            std::lock_guard g(lock);
+            shared.push_back(alloc);
+          } else {
+            allocs.push_back(alloc);
+          }
+        }
+      }
+
+      for (auto &alloc : allocs)
+        dealloc(alloc);
+
+      std::lock_guard g(lock);
+      total_alloc_time += alloc_time;
+      total_dealloc_time += dealloc_time;
+      total_num_allocs += num_allocs;
+      total_num_deallocs += num_deallocs;
+    });
+  }
+
+  for (auto &t : threads)
+    t.join();
+
+  for (auto &alloc : shared) {
+    res->deallocate(alloc.ptr, alloc.size, alloc.alignment);
+  }
+
+  print(std::cout,
+    "# threads:               ", num_threads, "\n"
+    "# allocations:           ", total_num_allocs, "\n"
+    "# deallocations:         ", total_num_deallocs, "\n"
+    "Allocation time:         ", format_time(seconds(total_alloc_time) / total_num_allocs), "\n"
+    "Dellocation time:        ", format_time(seconds(total_dealloc_time) / total_num_deallocs),
+    "\n");
+}
+
+inline int MaxBenchmarkThreads() {
+  return std::max<int>(std::thread::hardware_concurrency(), 1);
+}
+
+TEST(MMPerfTest, HostMalloc) {
+  auto &res = malloc_memory_resource::instance();
+  RunHostBenchmark(&res, 1);
+  RunHostBenchmark(&res, MaxBenchmarkThreads());
+}
+
+TEST(MMPerfTest, HostPool) {
+  pool_resource<memory_kind::host, coalescing_free_tree, spinlock> res(
+      &malloc_memory_resource::instance());
+  RunHostBenchmark(&res, 1);
+  RunHostBenchmark(&res, MaxBenchmarkThreads());
+}
+
+TEST(MMPerfTest, HostNumaCached) {
+  numa_cached_resource res;
+  print(std::cout, "# NUMA nodes:            ", res.num_nodes(), "\n");
+  RunHostBenchmark(&res, 1);
+  RunHostBenchmark(&res, MaxBenchmarkThreads());
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
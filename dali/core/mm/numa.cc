@@ -0,0 +1,126 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include "dali/core/mm/detail/numa.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace mm {
+namespace detail {
+
+namespace {
+
+std::string read_sysfs_line(const std::string &path) {
+  std::ifstream f(path);
+  std::string line;
+  if (f)
+    std::getline(f, line);
+  return line;
+}
+
+cpu_topology read_topology() {
+  cpu_topology topo;
+  topo.num_cpus = std::max<int>(1, sysconf(_SC_NPROCESSORS_CONF));
+  std::vector<int> cpu_node;
+  int num_nodes = 0;
+  auto nodes = parse_cpu_list(read_sysfs_line("/sys/devices/system/node/online").c_str());
+  for (int node : nodes) {
+    auto cpus = parse_cpu_list(
+        read_sysfs_line(make_string("/sys/devices/system/node/node", node, "/cpulist")).c_str());
+    for (int cpu : cpus) {
+      if (cpu >= static_cast<int>(cpu_node.size()))
+        cpu_node.resize(cpu + 1, 0);
+      cpu_node[cpu] = node;
+    }
+    num_nodes = std::max(num_nodes, node + 1);
+  }
+  if (num_nodes <= 1)
+    return topo;  // not a NUMA system or no information - use the default (single node)
+  topo.num_nodes = num_nodes;
+  topo.num_cpus = std::max<int>(topo.num_cpus, cpu_node.size());
+  cpu_node.resize(topo.num_cpus, 0);
+  topo.cpu_node = std::move(cpu_node);
+  return topo;
+}
+
+}  // namespace
+
+std::vector<int> parse_cpu_list(const char *text) {
+  std::vector<int> ret;
+  const char *p = text;
+  auto parse_int = [&](int &value) {
+    char *end;
+    int64_t v = std::strtoll(p, &end, 10);
+    if (end == p || v < 0 || v > (1 << 20))
+      return false;
+    value = v;
+    p = end;
+    return true;
+  };
+  while (*p && *p != '\n') {
+    int lo, hi;
+    if (!parse_int(lo))
+      return {};
+    hi = lo;
+    if (*p == '-') {
+      p++;
+      if (!parse_int(hi) || hi < lo)
+        return {};
+    }
+    for (int i = lo; i <= hi; i++)
+      ret.push_back(i);
+    if (*p == ',')
+      p++;
+    else if (*p && *p != '\n')
+      return {};
+  }
+  return ret;
+}
+
+const cpu_topology &cpu_topology::get() {
+  static const cpu_topology topo = read_topology();
+  return topo;
+}
+
+int current_cpu() noexcept {
+  int cpu = sched_getcpu();
+  return cpu < 0 ? 0 : cpu;
+}
+
+void prefer_numa_node(void *ptr, size_t bytes, int node) noexcept {
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t start = align_up(reinterpret_cast<uintptr_t>(ptr), page_size);
+  uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + bytes) & ~(page_size - 1);
+  if (node < 0 || end <= start)
+    return;
+  constexpr int kBitsPerWord = sizeof(unsigned long) * 8;  // NOLINT
+  std::vector<unsigned long> mask(node / kBitsPerWord + 1);  // NOLINT
+  mask[node / kBitsPerWord] = 1ul << (node % kBitsPerWord);
+  (void)syscall(SYS_mbind, start, end - start, MPOL_PREFERRED, mask.data(),
+                mask.size() * kBitsPerWord + 1, 0);
+}
+
+}  // namespace detail
+}  // namespace mm
+}  // namespace dali
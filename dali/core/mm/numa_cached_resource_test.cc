@@ -0,0 +1,196 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "dali/core/mm/mm_test_utils.h"
+#include "dali/core/mm/numa_cached_resource.h"
+#include "dali/core/mm/detail/numa.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMNumaCachedResource, ParseCpuList) {
+  EXPECT_EQ(detail::parse_cpu_list("0-3,8,10-11\n"), (std::vector<int>{ 0, 1, 2, 3, 8, 10, 11 }));
+  EXPECT_EQ(detail::parse_cpu_list("5"), (std::vector<int>{ 5 }));
+  EXPECT_TRUE(detail::parse_cpu_list("").empty());
+  EXPECT_TRUE(detail::parse_cpu_list("3-1").empty());
+  EXPECT_TRUE(detail::parse_cpu_list("1,x").empty());
+}
+
+TEST(MMNumaCachedResource, Topology) {
+  auto &topo = detail::cpu_topology::get();
+  ASSERT_GE(topo.num_nodes, 1);
+  ASSERT_GE(topo.num_cpus, 1);
+  for (int cpu = 0; cpu < topo.num_cpus; cpu++) {
+    EXPECT_GE(topo.node_of(cpu), 0);
+    EXPECT_LT(topo.node_of(cpu), topo.num_nodes);
+  }
+}
+
+TEST(MMNumaCachedResource, SizeClasses) {
+  using res_t = numa_cached_resource;
+  for (size_t size = 1; size <= (1 << 21); size += 1 + size / 64) {
+    int cls = res_t::size_class(size);
+    size_t cls_size = res_t::class_size(cls);
+    ASSERT_GE(cls_size, size);
+    if (cls > 0) {
+      ASSERT_LT(res_t::class_size(cls - 1), size);
+      ASSERT_LE(cls_size, size + size / 4);
+    }
+    for (size_t alignment = 1; alignment <= res_t::kMaxClassAlignment; alignment *= 2) {
+      int aligned_cls = res_t::size_class(align_up(size, alignment));
+      ASSERT_EQ(res_t::class_alignment(aligned_cls) % alignment, 0u)
+        << "size " << size << " alignment " << alignment;
+    }
+  }
+}
+
+/**
+ * @brief A fake topology, with the CPUs assigned alternately to one of two nodes, which makes
+ *        the threads allocate from and free to different node pools.
+ */
+detail::cpu_topology TwoNodeTopology() {
+  detail::cpu_topology topo = detail::cpu_topology::get();
+  topo.num_nodes = 2;
+  topo.cpu_node.resize(topo.num_cpus);
+  for (int cpu = 0; cpu < topo.num_cpus; cpu++)
+    topo.cpu_node[cpu] = cpu & 1;
+  return topo;
+}
+
+void TestRandomAllocations(const detail::cpu_topology &topology) {
+  test_host_resource upstream;
+  {
+    numa_cache_options opt;
+    opt.max_bin_count = 8;  // force frequent flushes
+    numa_cached_resource res(&upstream, opt, topology);
+    std::mt19937_64 rng(12345);
+    std::bernoulli_distribution is_free(0.4);
+    std::uniform_int_distribution<int> align_dist(0, 10);  // alignment from 1B to 1kB
+    std::uniform_real_distribution<float> size_log_dist(0, 21);
+    struct allocation {
+      void *ptr;
+      size_t size, alignment;
+      size_t fill;
+    };
+    std::vector<allocation> allocs;
+
+    const int num_iter = 5000;
+    for (int i = 0; i < num_iter; i++) {
+      if (i == num_iter / 2)
+        res.release_unused();
+      if (is_free(rng) && !allocs.empty()) {
+        auto idx = rng() % allocs.size();
+        allocation a = allocs[idx];
+        CheckFill(a.ptr, a.size, a.fill);
+        res.deallocate(a.ptr, a.size, a.alignment);
+        std::swap(allocs[idx], allocs.back());
+        allocs.pop_back();
+      } else {
+        allocation a;
+        a.size = std::max<size_t>(1, exp2f(size_log_dist(rng)));
+        a.alignment = 1 << align_dist(rng);
+        a.fill = rng();
+        a.ptr = res.allocate(a.size, a.alignment);
+        ASSERT_TRUE(detail::is_aligned(a.ptr, a.alignment));
+        Fill(a.ptr, a.size, a.fill);
+        allocs.push_back(a);
+      }
+    }
+
+    for (auto &a : allocs) {
+      CheckFill(a.ptr, a.size, a.fill);
+      res.deallocate(a.ptr, a.size, a.alignment);
+    }
+    allocs.clear();
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMNumaCachedResource, RandomAllocations) {
+  TestRandomAllocations(detail::cpu_topology::get());
+}
+
+TEST(MMNumaCachedResource, RandomAllocationsTwoNodes) {
+  TestRandomAllocations(TwoNodeTopology());
+}
+
+void TestCrossThreadDeallocation(const detail::cpu_topology &topology) {
+  numa_cached_resource res(&malloc_memory_resource::instance(), {}, topology);
+  const int num_threads = 4;
+  const int num_iter = 5000;
+  struct allocation {
+    void *ptr;
+    size_t size;
+    size_t fill;
+  };
+  // the allocations are freed by a different thread than the one which allocated them
+  std::vector<allocation> shared;
+  std::mutex mtx;
+  std::vector<std::thread> threads;
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&, tid]() {
+      std::mt19937_64 rng(tid);
+      std::uniform_int_distribution<size_t> size_dist(1, 20000);
+      std::vector<allocation> own;
+      for (int i = 0; i < num_iter; i++) {
+        allocation a;
+        a.size = size_dist(rng);
+        a.fill = rng();
+        a.ptr = res.allocate(a.size);
+        Fill(a.ptr, a.size, a.fill);
+        own.push_back(a);
+        if (own.size() < 16)
+          continue;
+        std::vector<allocation> to_free;
+        {
+          std::lock_guard<std::mutex> guard(mtx);
+          std::swap(to_free, shared);
+          std::swap(shared, own);
+        }
+        for (auto &f : to_free) {
+          CheckFill(f.ptr, f.size, f.fill);
+          res.deallocate(f.ptr, f.size);
+        }
+      }
+      std::lock_guard<std::mutex> guard(mtx);
+      for (auto &a : own)
+        shared.push_back(a);
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  for (auto &a : shared) {
+    CheckFill(a.ptr, a.size, a.fill);
+    res.deallocate(a.ptr, a.size);
+  }
+}
+
+TEST(MMNumaCachedResource, CrossThreadDeallocation) {
+  TestCrossThreadDeallocation(detail::cpu_topology::get());
+}
+
+TEST(MMNumaCachedResource, CrossThreadDeallocationTwoNodes) {
+  TestCrossThreadDeallocation(TwoNodeTopology());
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
@@ -269,6 +269,7 @@ class DecoderTestBase : public ::testing::Test {
     EXPECT_TRUE(Decoder()->CanDecode(ctx, src, opts));
 
     ImageInfo info = Parser()->GetInfo(src);
+    info = ScaledImageInfo(info, DecodeScale(src, info, opts));
     TensorShape<> shape;
     OutputShape(shape, info, opts, roi);
 
@@ -309,6 +310,7 @@ class DecoderTestBase : public ::testing::Test {
       EXPECT_TRUE(Parser()->CanParse(in[i]));
       EXPECT_TRUE(Decoder()->CanDecode(ctx, in[i], opts));
       ImageInfo info = Parser()->GetInfo(in[i]);
+      info = ScaledImageInfo(info, DecodeScale(in[i], info, opts));
       OutputShape(shape[i], info, opts, rois.empty() ? ROI{} : rois[i]);
     }
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 #include "dali/imgcodec/decoders/jpeg/jpeg_mem.h"
 #include "dali/imgcodec/parsers/jpeg.h"
 #include "dali/imgcodec/util/convert.h"
+#include "dali/imgcodec/util/output_shape.h"
 #include "dali/imgcodec/registry.h"
 #include "dali/core/common.h"
 
@@ -31,7 +32,9 @@ DecodeResult LibJpegTurboDecoderInstance::DecodeImplTask(int thread_idx,
 
   auto &out_type = opts.format;
   auto info = JpegParser{}.GetInfo(in);
-  auto target_shape = info.shape;
+  // DCT scaling - the image is decoded directly at a reduced resolution
+  flags.ratio = DecodeScale(in, info, opts);
+  auto target_shape = ScaledImageInfo(info, flags.ratio).shape;
 
   if (out_type == DALI_ANY_DATA) {
     flags.color_space = out_type = info.shape[2] == 3 ? DALI_RGB : DALI_GRAY;
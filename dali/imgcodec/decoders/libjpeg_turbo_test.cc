@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "dali/imgcodec/decoders/libjpeg_turbo.h"
@@ -46,6 +47,33 @@ const auto ref_prefix1 = join(ref_dir, "snail-4291306_1280");
 const auto jpeg_image2 = join(img_dir, "100/swan-3584559_640.jpg");
 const auto ref_prefix2 = join(ref_dir, "swan-3584559_640");
 
+/**
+ * @brief Downscales an HWC image by averaging 2x2 blocks, rounding the size up
+ *
+ * The result is a float image in the [0, 1] range.
+ */
+template <typename T>
+Tensor<CPUBackend> Downscale2x(const TensorView<StorageCPU, const T, 3> &in) {
+  int64_t h = in.shape[0], w = in.shape[1], c = in.shape[2];
+  int64_t out_h = div_ceil(h, 2), out_w = div_ceil(w, 2);
+  Tensor<CPUBackend> out;
+  out.Resize({out_h, out_w, c}, DALI_FLOAT);
+  float *out_data = out.mutable_data<float>();
+  for (int64_t y = 0; y < out_h; y++) {
+    for (int64_t x = 0; x < out_w; x++) {
+      for (int64_t ch = 0; ch < c; ch++) {
+        float sum = 0;
+        int n = 0;
+        for (int64_t sy = 2 * y; sy < std::min(2 * y + 2, h); sy++)
+          for (int64_t sx = 2 * x; sx < std::min(2 * x + 2, w); sx++, n++)
+            sum += ConvertSatNorm<float>(*in(sy, sx, ch));
+        *out_data++ = sum / n;
+      }
+    }
+  }
+  return out;
+}
+
 }  // namespace
 
 TEST(LibJpegTurboDecoderTest, Factory) {
@@ -162,6 +190,29 @@ TYPED_TEST(LibJpegTurboDecoderTest, DecodeRoi) {
   AssertEqualSatNorm(decoded, ref);
 }
 
+TYPED_TEST(LibJpegTurboDecoderTest, DecodeHintSize) {
+  ImageBuffer image(jpeg_image);
+  auto info = JpegParser().GetInfo(&image.src);
+  auto opts = this->GetParams(DALI_RGB);
+  // just enough to allow decoding at half the resolution
+  int64_t min_size = std::min(div_ceil(info.shape[0], 2), div_ceil(info.shape[1], 2));
+  opts.hint_size = {min_size, min_size};
+  ASSERT_EQ(DecodeScale(&image.src, info, opts), 2);
+
+  auto decoded = this->Decode(&image.src, opts);
+  ASSERT_EQ(decoded.shape, TensorShape<>(div_ceil(info.shape[0], 2), div_ceil(info.shape[1], 2),
+                                         info.shape[2]));
+  auto ref = this->ReadReferenceFrom(make_string(ref_prefix, ".npy"));
+  TYPE_SWITCH(ref.type(), type2id, RefType, NUMPY_ALLOWED_TYPES, (
+    AssertSimilar(decoded, Downscale2x(view<const RefType, 3>(ref)));
+  ), DALI_FAIL(make_string("Unsupported reference type: ", ref.type())));  // NOLINT
+
+  opts.hint_size = {min_size + 1, min_size + 1};
+  EXPECT_EQ(DecodeScale(&image.src, info, opts), 1);
+  opts.hint_size = {1, 1};
+  EXPECT_EQ(DecodeScale(&image.src, info, opts), 8);
+}
+
 TYPED_TEST(LibJpegTurboDecoderTest, DecodeYCbCr) {
   this->TestDecodeSingleAPI(DALI_YCbCr);
 }
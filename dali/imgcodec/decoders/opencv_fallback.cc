@@ -16,6 +16,7 @@
 #include <opencv2/imgproc.hpp>
 #include "dali/imgcodec/decoders/opencv_fallback.h"
 #include "dali/imgcodec/util/convert.h"
+#include "dali/imgcodec/util/output_shape.h"
 #include "dali/imgcodec/registry.h"
 #include "dali/imgcodec/parsers/jpeg.h"
 
@@ -97,6 +98,16 @@ DecodeResult OpenCVDecoderInstance::DecodeImplTask(int thread_idx,
     }
 
     res.success = cvimg.ptr(0) != nullptr;
+    if (res.success && !opts.hint_size.empty() && cvimg.dims == 2) {
+      // Other decoders would reduce the resolution of a JPEG while decoding - here we have to
+      // resize the decoded image to match their output.
+      auto info = ImageFormatRegistry::instance().GetImageFormat(in)->Parser()->GetInfo(in);
+      int scale = DecodeScale(in, info, opts);
+      if (scale > 1) {
+        cv::Size size(div_ceil(cvimg.cols, scale), div_ceil(cvimg.rows, scale));
+        cv::resize(cvimg, cvimg, size, 0, 0, cv::INTER_AREA);
+      }
+    }
     if (res.success) {
       DALI_ENFORCE(cvimg.dims + 1 == out.shape().sample_dim(), make_string(
         "The decoded image has an unexpected number of spatial dimensions: ", cvimg.dims,
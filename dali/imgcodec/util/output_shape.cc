@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,10 +13,30 @@
 // limitations under the License.
 
 #include "dali/imgcodec/util/output_shape.h"
+#include "dali/core/tensor_shape_print.h"
+#include "dali/imgcodec/parsers/jpeg.h"
 
 namespace dali {
 namespace imgcodec {
 
+int DecodeScale(ImageSource *src, const ImageInfo &info, const DecodeParams &params) {
+  const auto &hint = params.hint_size;
+  if (hint.empty() || info.shape.sample_dim() != 3 || !JpegParser{}.CanParse(src))
+    return 1;
+  DALI_ENFORCE(hint.sample_dim() == 2, make_string(
+    "The hint size must have 2 elements (height and width), got: ", hint));
+  // the hint is given after the orientation is applied
+  bool swap_xy = params.use_orientation && info.orientation.rotate % 180 == 90;
+  int64_t min_h = swap_xy ? hint[1] : hint[0];
+  int64_t min_w = swap_xy ? hint[0] : hint[1];
+  int scale = 1;
+  while (scale < 8 &&
+         div_ceil(info.shape[0], 2 * scale) >= min_h &&
+         div_ceil(info.shape[1], 2 * scale) >= min_w)
+    scale *= 2;
+  return scale;
+}
+
 ROI PreOrientationRoi(const ImageInfo &info, ROI roi) {
   bool swap_xy = info.orientation.rotate % 180 == 90;
   bool flip_x = info.orientation.rotate == 180 || info.orientation.rotate == 270;
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 #ifndef DALI_IMGCODEC_UTIL_OUTPUT_SHAPE_H_
 #define DALI_IMGCODEC_UTIL_OUTPUT_SHAPE_H_
 
+#include "dali/core/util.h"
 #include "dali/imgcodec/image_decoder_interfaces.h"
 
 namespace dali {
@@ -61,6 +62,28 @@ void OutputShape(OutShape &&out_shape,
   }
 }
 
+/**
+ * @brief Calculates the factor by which the image is downscaled while decoding
+ *
+ * Only JPEG images, which can be decoded with DCT scaling, are downscaled. The result is
+ * the largest of 1, 2, 4 and 8, for which the image (with the dimensions rounded up) is not
+ * smaller than `params.hint_size`.
+ */
+int DLL_PUBLIC DecodeScale(ImageSource *src, const ImageInfo &info, const DecodeParams &params);
+
+/**
+ * @brief Returns the image info describing the image downscaled by `scale`
+ *
+ * The spatial extents are rounded up, the same way libjpeg-turbo does it.
+ */
+inline ImageInfo ScaledImageInfo(ImageInfo info, int scale) {
+  if (scale != 1) {
+    for (int d = 0; d < info.shape.sample_dim() - 1; d++)
+      info.shape[d] = div_ceil(info.shape[d], scale);
+  }
+  return info;
+}
+
 /**
  * @brief Calculates the ROI in the pre-orientation coordinates
  */
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -26,6 +26,18 @@ TEST(OutputShapeTest, Trivial) {
   EXPECT_EQ(ii.shape, out);
 }
 
+TEST(OutputShapeTest, Scaled) {
+  ImageInfo ii;
+  ii.shape = { 481, 640, 3 };
+  TensorShape<> out;
+  OutputShape(out, ScaledImageInfo(ii, 1), {}, {});
+  EXPECT_EQ(out, ii.shape);
+  OutputShape(out, ScaledImageInfo(ii, 2), {}, {});
+  EXPECT_EQ(out, TensorShape<>(241, 320, 3));
+  OutputShape(out, ScaledImageInfo(ii, 8), {}, {});
+  EXPECT_EQ(out, TensorShape<>(61, 80, 3));
+}
+
 TEST(OutputShapeTest, Grayscale) {
   ImageInfo ii;
   ii.shape = { 480, 640, 3 };
@@ -20,6 +20,7 @@
 #endif
 
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 #include "dali/core/force_inline.h"
@@ -298,7 +299,7 @@ struct multivec : float4x<num_vecs> {
       "Total number of lanes is not a multiple of storage lanes.");
     multivec m;
     for (int i = 0; i < num_vecs; i += load_vecs) {
-      auto tmp = simd::load_f(in + i * load_lanes);
+      auto tmp = simd::load_f(in + i * 4);  // each vector holds 4 lanes
       for (int j = 0; j < load_vecs; j++)
         m.v[i + j] = tmp.v[j];
     }
@@ -326,6 +327,55 @@ DALI_FORCEINLINE static void store(Out *out, multivec<num_vecs> m) noexcept {
   }
 }
 
+/**
+ * @brief Interleaves the lower halves of two vectors with given lane size
+ */
+template <int lane_bytes>
+__m128i unpacklo(__m128i a, __m128i b);
+
+/**
+ * @brief Interleaves the upper halves of two vectors with given lane size
+ */
+template <int lane_bytes>
+__m128i unpackhi(__m128i a, __m128i b);
+
+template <>
+inline __m128i unpacklo<1>(__m128i a, __m128i b) { return _mm_unpacklo_epi8(a, b); }
+template <>
+inline __m128i unpackhi<1>(__m128i a, __m128i b) { return _mm_unpackhi_epi8(a, b); }
+template <>
+inline __m128i unpacklo<2>(__m128i a, __m128i b) { return _mm_unpacklo_epi16(a, b); }
+template <>
+inline __m128i unpackhi<2>(__m128i a, __m128i b) { return _mm_unpackhi_epi16(a, b); }
+template <>
+inline __m128i unpacklo<4>(__m128i a, __m128i b) { return _mm_unpacklo_epi32(a, b); }
+template <>
+inline __m128i unpackhi<4>(__m128i a, __m128i b) { return _mm_unpackhi_epi32(a, b); }
+template <>
+inline __m128i unpacklo<8>(__m128i a, __m128i b) { return _mm_unpacklo_epi64(a, b); }
+template <>
+inline __m128i unpackhi<8>(__m128i a, __m128i b) { return _mm_unpackhi_epi64(a, b); }
+
+/**
+ * @brief Transposes, in registers, a square matrix of N = 16 / lane_bytes rows
+ *        with N lanes each.
+ *
+ * Each stage interleaves the row `i` with the row `i + N/2` - after log2(N) such perfect
+ * shuffles, the lane `j` of the row `i` ends up in the lane `i` of the row `j`.
+ */
+template <int lane_bytes>
+DALI_FORCEINLINE void transpose(i128x<16 / lane_bytes> &m) {
+  constexpr int N = 16 / lane_bytes;
+  for (int stage = 1; stage < N; stage *= 2) {
+    i128x<N> tmp;
+    for (int i = 0; i < N / 2; i++) {
+      tmp.v[2 * i]     = unpacklo<lane_bytes>(m.v[i], m.v[i + N / 2]);
+      tmp.v[2 * i + 1] = unpackhi<lane_bytes>(m.v[i], m.v[i + N / 2]);
+    }
+    m = tmp;
+  }
+}
+
 #endif  // __SSE2__
 
 }  // namespace simd
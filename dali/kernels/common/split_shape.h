@@ -15,7 +15,9 @@
 #ifndef DALI_KERNELS_COMMON_SPLIT_SHAPE_H_
 #define DALI_KERNELS_COMMON_SPLIT_SHAPE_H_
 
+#include <algorithm>
 #include <utility>
+#include "dali/core/small_vector.h"
 #include "dali/core/util.h"
 #include "dali/core/tensor_shape.h"
 
@@ -117,6 +119,67 @@ void ForEachBlock(TensorShape<ndim> start, TensorShape<ndim> end, const SplitFac
   }
 }
 
+/**
+ * @brief Calculates the desired number of blocks for a sample, so that the work for the whole
+ *        batch is spread evenly across the threads.
+ *
+ * The blocks are distributed proportionally to the volume of the sample, so that a batch of
+ * `num_threads * blocks_per_thread` similarly sized blocks is produced. Small batches of
+ * big samples are thus split into many blocks, while big batches are not split at all.
+ *
+ * @param sample_volume volume of the sample to be split
+ * @param total_volume total volume of all the samples in the batch
+ * @param num_threads number of threads processing the batch
+ * @param blocks_per_thread desired number of blocks processed by a thread; values greater
+ *                          than one allow to balance the load when the cost of a block is
+ *                          not exactly proportional to its volume.
+ */
+inline int NumBlocksForSample(int64_t sample_volume, int64_t total_volume, int num_threads,
+                              int blocks_per_thread = 4) {
+  if (sample_volume <= 0 || total_volume <= 0)
+    return 1;
+  int64_t total_blocks = static_cast<int64_t>(num_threads) * blocks_per_thread;
+  int64_t nblocks = div_ceil(total_blocks * sample_volume, total_volume);
+  return std::max<int64_t>(1, std::min<int64_t>(nblocks, total_blocks));
+}
+
+/**
+ * @brief Splits the shape into blocks, as described in `split_shape`, and schedules
+ *        `func(thread_idx, block_start, block_end)` for each block in the execution engine.
+ *
+ * The priority of each block is its volume, multiplied by `cost_per_element`.
+ * The work is not started - it's up to the caller to run the engine.
+ *
+ * @param exec_engine execution engine, e.g. a ThreadPool
+ * @param shape shape to be split
+ * @param min_nblocks desired minimum number of blocks
+ * @param min_sz minimum practical block volume
+ * @param skip_dim_mask bitmask representing which dimensions should not be split
+ * @param func function to run for each block
+ * @return number of blocks scheduled
+ */
+template <int ndim, typename ExecutionEngine, typename BlockFunc>
+int ScheduleBlocks(ExecutionEngine &exec_engine, const TensorShape<ndim> &shape,
+                   int min_nblocks, int min_sz, uint64_t skip_dim_mask, BlockFunc &&func,
+                   int64_t cost_per_element = 1) {
+  SmallVector<int, 6> split_factor;
+  split_factor.resize(shape.size());
+  int nblocks = split_shape(split_factor, shape, min_nblocks, min_sz, skip_dim_mask);
+  TensorShape<ndim> start = shape;
+  for (int d = 0; d < start.size(); d++)
+    start[d] = 0;
+  ForEachBlock(start, shape, split_factor, 0, LastSplitDim(split_factor),
+    [&](const TensorShape<ndim> &blk_start, const TensorShape<ndim> &blk_end) {
+      int64_t blk_volume = 1;
+      for (int d = 0; d < blk_start.size(); d++)
+        blk_volume *= blk_end[d] - blk_start[d];
+      exec_engine.AddWork([=](int thread_idx) {
+        func(thread_idx, blk_start, blk_end);
+      }, blk_volume * cost_per_element, false);  // do not start work immediately
+    });
+  return nblocks;
+}
+
 }  // namespace kernels
 }  // namespace dali
 
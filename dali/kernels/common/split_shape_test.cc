@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 #include <vector>
+#include "dali/core/exec/engine.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/kernels/common/split_shape.h"
 
@@ -75,5 +76,36 @@ TEST(split_shape, basic_test) {
   ASSERT_EQ(split_factor[2], 1);
 }
 
+TEST(split_shape, num_blocks_for_sample) {
+  // a single sample takes all the blocks
+  EXPECT_EQ(NumBlocksForSample(1000, 1000, 8, 4), 32);
+  // the blocks are distributed proportionally to the volume
+  EXPECT_EQ(NumBlocksForSample(750, 1000, 8, 4), 24);
+  EXPECT_EQ(NumBlocksForSample(250, 1000, 8, 4), 8);
+  // big batch - no splitting
+  EXPECT_EQ(NumBlocksForSample(1, 1000, 8, 4), 1);
+  // degenerate cases
+  EXPECT_EQ(NumBlocksForSample(0, 1000, 8, 4), 1);
+  EXPECT_EQ(NumBlocksForSample(0, 0, 8, 4), 1);
+}
+
+TEST(split_shape, schedule_blocks) {
+  TensorShape<> sh(10, 20, 30);
+  std::vector<int> hits(volume(sh), 0);
+  SequentialExecutionEngine engine;
+  int nblocks = ScheduleBlocks(engine, sh, 16, 10, 1_u64 << 2,
+    [&](int thread_idx, const TensorShape<> &start, const TensorShape<> &end) {
+      ASSERT_EQ(start[2], 0);
+      ASSERT_EQ(end[2], 30);
+      for (int64_t i = start[0]; i < end[0]; i++)
+        for (int64_t j = start[1]; j < end[1]; j++)
+          for (int64_t k = start[2]; k < end[2]; k++)
+            hits[(i * 20 + j) * 30 + k]++;
+    });
+  EXPECT_GE(nblocks, 16);
+  for (auto h : hits)
+    ASSERT_EQ(h, 1);
+}
+
 }  // namespace kernels
 }  // namespace dali
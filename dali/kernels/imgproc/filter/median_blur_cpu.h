@@ -0,0 +1,356 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_FILTER_MEDIAN_BLUR_CPU_H_
+#define DALI_KERNELS_IMGPROC_FILTER_MEDIAN_BLUR_CPU_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/span.h"
+#include "dali/core/tensor_view.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+
+namespace median_blur {
+
+/**
+ * @brief The largest window (number of elements) for which the median is found with
+ *        a sorting network.
+ */
+constexpr int kMaxNetworkWindow = 121;
+
+/**
+ * @brief A comparator network which moves the median of `n` values, i.e. the element that
+ *        would be at the position `n / 2` after sorting, to the wire `median`.
+ *
+ * The network is derived from Batcher's odd-even merge sort, padded to a power of 2:
+ * - the comparators with a padding (+infinity) wire are either no-ops or just swap the wires,
+ * - the comparators that don't affect the median are removed.
+ * Each comparator (a, b) stores the minimum at the wire `a` and the maximum at the wire `b`.
+ */
+struct MedianNetwork {
+  std::vector<std::pair<int, int>> comparators;
+  int median = 0;
+
+  MedianNetwork() = default;
+
+  explicit MedianNetwork(int n) {
+    int N = 1;
+    while (N < n)
+      N *= 2;
+    // logical position -> physical wire; the wires >= n are the padding
+    std::vector<int> wire(N);
+    for (int i = 0; i < N; i++)
+      wire[i] = i;
+    auto is_padding = [&](int pos) { return wire[pos] >= n; };
+
+    std::vector<std::pair<int, int>> network;
+    for (int p = 1; p < N; p *= 2) {
+      for (int k = p; k >= 1; k /= 2) {
+        for (int j = k % p; j + k < N; j += 2 * k) {
+          for (int i = 0; i < k && i + j + k < N; i++) {
+            int a = i + j, b = i + j + k;
+            if ((a / (2 * p)) != (b / (2 * p)))
+              continue;
+            if (is_padding(b))
+              continue;  // min(x, inf) = x
+            if (is_padding(a))
+              std::swap(wire[a], wire[b]);  // the padding goes up, the value goes down
+            else
+              network.emplace_back(wire[a], wire[b]);
+          }
+        }
+      }
+    }
+    median = wire[n / 2];
+
+    // remove the comparators that don't affect the median
+    std::vector<bool> needed(n);
+    needed[median] = true;
+    for (auto it = network.rbegin(); it != network.rend(); ++it) {
+      if (needed[it->first] || needed[it->second]) {
+        needed[it->first] = needed[it->second] = true;
+        comparators.push_back(*it);
+      }
+    }
+    std::reverse(comparators.begin(), comparators.end());
+  }
+};
+
+inline const MedianNetwork &GetMedianNetwork(int n) {
+  assert(n >= 1 && n <= kMaxNetworkWindow);
+  static const auto networks = []() {
+    std::array<MedianNetwork, kMaxNetworkWindow + 1> networks;
+    for (int i = 1; i <= kMaxNetworkWindow; i++)
+      networks[i] = MedianNetwork(i);
+    return networks;
+  }();
+  return networks[n];
+}
+
+/**
+ * @brief Horizontally padded (with replicated border pixels) copies of the input rows
+ *        needed to calculate consecutive rows of the output.
+ */
+template <typename T>
+class PaddedRows {
+ public:
+  PaddedRows(const T *in, int height, int width, int channels, ivec2 window)
+  : in_(in), height_(height), width_(width), channels_(channels), window_(window) {
+    row_size_ = static_cast<int64_t>(width + window.x - 1) * channels;
+    buffer_.resize(row_size_ * window.y);
+    virtual_row_.resize(window.y, std::numeric_limits<int>::min());
+    row_ptrs_.resize(window.y);
+  }
+
+  /**
+   * @brief Returns the pointers to the padded input rows covered by the window
+   *        for the output row `y`
+   */
+  const T *const *Get(int y) {
+    int anchor = window_.y / 2;
+    for (int dy = 0; dy < window_.y; dy++) {
+      int r = y - anchor + dy;
+      int slot = (r % window_.y + window_.y) % window_.y;
+      T *row = buffer_.data() + slot * row_size_;
+      if (virtual_row_[slot] != r) {
+        Fill(row, std::clamp(r, 0, height_ - 1));
+        virtual_row_[slot] = r;
+      }
+      row_ptrs_[dy] = row;
+    }
+    return row_ptrs_.data();
+  }
+
+ private:
+  void Fill(T *row, int src_y) {
+    const T *src = in_ + static_cast<int64_t>(src_y) * width_ * channels_;
+    int left = window_.x / 2, right = window_.x - 1 - left;
+    for (int x = 0; x < left; x++, row += channels_)
+      std::memcpy(row, src, channels_ * sizeof(T));
+    std::memcpy(row, src, static_cast<int64_t>(width_) * channels_ * sizeof(T));
+    row += static_cast<int64_t>(width_) * channels_;
+    const T *last = src + static_cast<int64_t>(width_ - 1) * channels_;
+    for (int x = 0; x < right; x++, row += channels_)
+      std::memcpy(row, last, channels_ * sizeof(T));
+  }
+
+  const T *in_;
+  int height_, width_, channels_;
+  ivec2 window_;
+  int64_t row_size_;
+  std::vector<T> buffer_;
+  std::vector<int> virtual_row_;
+  std::vector<const T *> row_ptrs_;
+};
+
+/**
+ * @brief Finds the medians for a row of output with std::nth_element - works for any window.
+ */
+template <typename T>
+void MedianRowGeneric(T *out, const T *const *rows, int width, int channels, ivec2 window,
+                      T *buf) {
+  int n = window.x * window.y;
+  for (int x = 0; x < width; x++) {
+    for (int c = 0; c < channels; c++) {
+      int k = 0;
+      for (int dy = 0; dy < window.y; dy++) {
+        const T *src = rows[dy] + x * channels + c;
+        for (int dx = 0; dx < window.x; dx++)
+          buf[k++] = src[dx * channels];
+      }
+      std::nth_element(buf, buf + n / 2, buf + n);
+      out[x * channels + c] = buf[n / 2];
+    }
+  }
+}
+
+/**
+ * @brief The number of consecutive output values calculated at once by the sorting network
+ */
+constexpr int kNetworkLanes = 64;
+
+template <typename T>
+inline void CompareSwapLanes(T *__restrict__ a, T *__restrict__ b) {
+  for (int l = 0; l < kNetworkLanes; l++) {
+    T lo = std::min(a[l], b[l]);
+    T hi = std::max(a[l], b[l]);
+    a[l] = lo;
+    b[l] = hi;
+  }
+}
+
+/**
+ * @brief Finds the medians for a row of output with a sorting network.
+ *
+ * The network is applied to `kNetworkLanes` consecutive output values at once, which
+ * allows the compiler to vectorize the min/max operations. The row must be at least
+ * `kNetworkLanes` values long.
+ */
+template <typename T>
+void MedianRowNetwork(T *out, const T *const *rows, int width, int channels, ivec2 window,
+                      const MedianNetwork &network) {
+  int64_t row_len = static_cast<int64_t>(width) * channels;
+  assert(row_len >= kNetworkLanes);
+  T values[kMaxNetworkWindow][kNetworkLanes];
+  for (int64_t x0 = 0; x0 < row_len; x0 += kNetworkLanes) {
+    // the last block overlaps with the previous one, if needed
+    int64_t start = std::min<int64_t>(x0, row_len - kNetworkLanes);
+    for (int dy = 0, k = 0; dy < window.y; dy++) {
+      for (int dx = 0; dx < window.x; dx++, k++)
+        std::memcpy(values[k], rows[dy] + start + dx * channels, sizeof(values[k]));
+    }
+    for (auto &cmp : network.comparators)
+      CompareSwapLanes(values[cmp.first], values[cmp.second]);
+    std::memcpy(out + start, values[network.median], sizeof(values[network.median]));
+  }
+}
+
+/**
+ * @brief Finds the medians for a row of 8-bit output with Huang's algorithm.
+ *
+ * A histogram of the window is updated as the window slides along the row - only
+ * the columns leaving and entering the window are processed. The median is tracked along
+ * with the number of values below it, so it's usually found in a few steps.
+ */
+inline void MedianRowHuang(uint8_t *out, const uint8_t *const *rows, int width, int channels,
+                           ivec2 window) {
+  int m = window.x * window.y / 2;
+  for (int c = 0; c < channels; c++) {
+    int hist[256] = {};
+    for (int dy = 0; dy < window.y; dy++)
+      for (int dx = 0; dx < window.x; dx++)
+        hist[rows[dy][dx * channels + c]]++;
+    int median = 0, below = 0;  // `below` is the number of values less than `median`
+    for (int x = 0; x < width; x++) {
+      if (x > 0) {
+        int64_t out_ofs = static_cast<int64_t>(x - 1) * channels + c;
+        int64_t in_ofs = out_ofs + static_cast<int64_t>(window.x) * channels;
+        for (int dy = 0; dy < window.y; dy++) {
+          int v_out = rows[dy][out_ofs], v_in = rows[dy][in_ofs];
+          hist[v_out]--;
+          hist[v_in]++;
+          below += (v_in < median) - (v_out < median);
+        }
+      }
+      if (below > m) {
+        do {
+          median--;
+          below -= hist[median];
+        } while (below > m);
+      } else {
+        while (below + hist[median] <= m) {
+          below += hist[median];
+          median++;
+        }
+      }
+      out[static_cast<int64_t>(x) * channels + c] = median;
+    }
+  }
+}
+
+}  // namespace median_blur
+
+/**
+ * @brief Median filter for 2D images with interleaved channels (HWC)
+ *
+ * Each channel is filtered separately. The window of size `window` (width, height) is anchored
+ * at (window.x / 2, window.y / 2) and the image borders are replicated. For windows with
+ * an even number of elements, the upper median is used.
+ *
+ * Depending on the type and the window size, the median is found with:
+ * - a sorting network, for small windows,
+ * - Huang's sliding histogram algorithm, for larger windows and 8-bit images,
+ * - std::nth_element, otherwise.
+ */
+template <typename T>
+class MedianBlurCpu {
+ public:
+  static_assert(std::is_arithmetic<T>::value, "MedianBlurCpu requires an arithmetic type");
+
+  /**
+   * @brief The largest window for which the sorting network is used for 8-bit images -
+   *        beyond that, Huang's algorithm is faster.
+   */
+  static constexpr int kMaxNetworkWindowU8 = 25;
+
+  KernelRequirements Setup(KernelContext &ctx, const InTensorCPU<T, 3> &in, ivec2 window) {
+    DALI_ENFORCE(window.x >= 1 && window.y >= 1, make_string(
+      "The window size must be positive, got: ", window.x, "x", window.y, "."));
+    KernelRequirements req;
+    req.output_shapes = {TensorListShape<3>({in.shape})};
+    return req;
+  }
+
+  /**
+   * @brief Calculates the rows [row_begin, row_end) of the output
+   *
+   * Distinct ranges of rows can be calculated concurrently.
+   */
+  void Run(KernelContext &ctx, const OutTensorCPU<T, 3> &out, const InTensorCPU<T, 3> &in,
+           ivec2 window, int row_begin = 0, int row_end = -1) {
+    int height = in.shape[0], width = in.shape[1], channels = in.shape[2];
+    assert(out.shape == in.shape);
+    if (row_end < 0)
+      row_end = height;
+    if (row_begin >= row_end || width == 0 || channels == 0)
+      return;
+
+    int n = window.x * window.y;
+    int64_t row_len = static_cast<int64_t>(width) * channels;
+    median_blur::PaddedRows<T> rows(in.data, height, width, channels, window);
+    std::vector<T> buf;
+
+    bool use_huang = std::is_same<T, uint8_t>::value && n > kMaxNetworkWindowU8;
+    bool use_network = !use_huang && n <= median_blur::kMaxNetworkWindow &&
+                       row_len >= median_blur::kNetworkLanes;
+    if (!use_huang && !use_network)
+      buf.resize(n);
+
+    for (int y = row_begin; y < row_end; y++) {
+      T *out_row = out.data + y * row_len;
+      const T *const *in_rows = rows.Get(y);
+      if (use_network) {
+        median_blur::MedianRowNetwork(out_row, in_rows, width, channels, window,
+                                      median_blur::GetMedianNetwork(n));
+      } else if (use_huang) {
+        RunHuang(out_row, in_rows, width, channels, window);
+      } else {
+        median_blur::MedianRowGeneric(out_row, in_rows, width, channels, window, buf.data());
+      }
+    }
+  }
+
+ private:
+  void RunHuang(T *out, const T *const *rows, int width, int channels, ivec2 window) {
+    if constexpr (std::is_same<T, uint8_t>::value)
+      median_blur::MedianRowHuang(out, rows, width, channels, window);
+  }
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_FILTER_MEDIAN_BLUR_CPU_H_
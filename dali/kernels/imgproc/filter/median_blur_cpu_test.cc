@@ -0,0 +1,134 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "dali/kernels/imgproc/filter/median_blur_cpu.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+template <typename T>
+void MedianBlurRef(const OutTensorCPU<T, 3> &out, const InTensorCPU<T, 3> &in, ivec2 window) {
+  int H = in.shape[0], W = in.shape[1], C = in.shape[2];
+  std::vector<T> values;
+  for (int y = 0; y < H; y++) {
+    for (int x = 0; x < W; x++) {
+      for (int c = 0; c < C; c++) {
+        values.clear();
+        for (int dy = 0; dy < window.y; dy++) {
+          for (int dx = 0; dx < window.x; dx++) {
+            int sy = std::clamp(y + dy - window.y / 2, 0, H - 1);
+            int sx = std::clamp(x + dx - window.x / 2, 0, W - 1);
+            values.push_back(*in(sy, sx, c));
+          }
+        }
+        std::sort(values.begin(), values.end());
+        *out(y, x, c) = values[values.size() / 2];
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(MedianBlurCpuTest, MedianNetwork) {
+  std::mt19937 rng(1234);
+  for (int n = 1; n <= median_blur::kMaxNetworkWindow; n++) {
+    auto &network = median_blur::GetMedianNetwork(n);
+    ASSERT_GE(network.median, 0);
+    ASSERT_LT(network.median, n);
+    std::vector<int> values(n);
+    for (int iter = 0; iter < 100; iter++) {
+      for (auto &v : values)
+        v = rng() % 16;  // many duplicates
+      auto sorted = values;
+      std::sort(sorted.begin(), sorted.end());
+      for (auto &cmp : network.comparators) {
+        ASSERT_LT(cmp.first, n);
+        ASSERT_LT(cmp.second, n);
+        if (values[cmp.first] > values[cmp.second])
+          std::swap(values[cmp.first], values[cmp.second]);
+      }
+      ASSERT_EQ(values[network.median], sorted[n / 2]) << "n = " << n;
+    }
+  }
+}
+
+template <typename T>
+class MedianBlurCpuTypedTest : public ::testing::Test {
+ protected:
+  void RunTest(TensorShape<3> shape, ivec2 window) {
+    TestTensorList<T, 3> in, out, ref;
+    in.reshape(uniform_list_shape(1, shape));
+    out.reshape(uniform_list_shape(1, shape));
+    ref.reshape(uniform_list_shape(1, shape));
+    std::mt19937_64 rng(shape.num_elements() + window.x * 100 + window.y);
+    UniformRandomFill(in.cpu(), rng, 0, 255);
+    InTensorCPU<T, 3> in_view = in.cpu()[0];
+    OutTensorCPU<T, 3> out_view = out.cpu()[0];
+    OutTensorCPU<T, 3> ref_view = ref.cpu()[0];
+
+    MedianBlurCpu<T> kernel;
+    KernelContext ctx;
+    auto req = kernel.Setup(ctx, in_view, window);
+    ASSERT_EQ(req.output_shapes[0][0], shape);
+    // calculate the output in a few row ranges, as the operator does
+    int H = shape[0];
+    int split = H / 3;
+    kernel.Run(ctx, out_view, in_view, window, 0, split);
+    kernel.Run(ctx, out_view, in_view, window, split, H);
+
+    MedianBlurRef<T>(ref_view, in_view, window);
+    Check(out_view, ref_view);
+  }
+};
+
+using MedianBlurTypes = ::testing::Types<uint8_t, uint16_t, float>;
+TYPED_TEST_SUITE(MedianBlurCpuTypedTest, MedianBlurTypes);
+
+TYPED_TEST(MedianBlurCpuTypedTest, SmallWindows) {
+  for (int channels : {1, 3, 4}) {
+    for (ivec2 window : {ivec2(1, 1), ivec2(3, 3), ivec2(5, 5), ivec2(7, 7), ivec2(3, 5),
+                         ivec2(4, 2), ivec2(1, 7)}) {
+      this->RunTest({37, 53, channels}, window);
+    }
+  }
+}
+
+TYPED_TEST(MedianBlurCpuTypedTest, LargeWindows) {
+  for (int channels : {1, 3}) {
+    for (ivec2 window : {ivec2(9, 9), ivec2(11, 5), ivec2(15, 15)}) {
+      this->RunTest({29, 71, channels}, window);
+    }
+  }
+}
+
+TYPED_TEST(MedianBlurCpuTypedTest, NarrowImages) {
+  for (ivec2 window : {ivec2(3, 3), ivec2(7, 7), ivec2(9, 9)}) {
+    this->RunTest({1, 1, 1}, window);
+    this->RunTest({5, 2, 3}, window);
+    this->RunTest({40, 3, 1}, window);
+    this->RunTest({2, 30, 1}, window);
+  }
+}
+
+}  // namespace kernels
+}  // namespace dali
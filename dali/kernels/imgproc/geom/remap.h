@@ -15,6 +15,7 @@
 #ifndef DALI_KERNELS_IMGPROC_GEOM_REMAP_H_
 #define DALI_KERNELS_IMGPROC_GEOM_REMAP_H_
 
+#include <cassert>
 #include <vector>
 #include <optional>
 #include "dali/core/common.h"
@@ -27,6 +28,20 @@ namespace dali {
 namespace kernels {
 namespace remap {
 
+namespace detail {
+
+/**
+ * Return a default ROI. Default ROI is a whole image.
+ */
+template<int ndims>
+Roi<2> default_roi(const TensorShape<ndims> &ts) {
+  assert(ts.sample_dim() >= 2);
+  return {{0,     0},
+          {ts[1], ts[0]}};
+}
+
+}  // namespace detail
+
 /**
  * API for Remap operation. Remap applies a generic geometrical transformation to an image.
  * @tparam Backend Storage backend for data.
@@ -0,0 +1,375 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_GEOM_REMAP_CPU_H_
+#define DALI_KERNELS_IMGPROC_GEOM_REMAP_CPU_H_
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include "dali/core/convert.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/imgproc/geom/remap.h"
+#include "dali/kernels/imgproc/sampler.h"
+#include "dali/kernels/imgproc/surface.h"
+#include "include/dali/core/boundary.h"
+#include "include/dali/core/tensor_shape_print.h"
+#include "include/dali/core/tensor_view.h"
+
+namespace dali {
+namespace kernels {
+namespace remap {
+
+namespace detail {
+
+/// The number of output pixels for which the source coordinates are calculated at once
+constexpr int kRemapChunk = 64;
+
+/// Map values beyond this magnitude are out of range for any image - clamping them
+/// keeps the float to int conversion well-defined
+constexpr float kMaxMapCoord = 1 << 30;
+
+/**
+ * @brief Converts a chunk of map values to integer source coordinates and the fractional parts
+ *
+ * For linear interpolation, `coord` is the first of the two source pixels and `frac` is
+ * the weight of the second one. For nearest neighbor, `coord` is the nearest pixel.
+ * The loop is free of calls and branches, so that the compiler can vectorize it.
+ * NaNs end up at `-kMaxMapCoord`, i.e. out of range.
+ */
+template <DALIInterpType interp>
+inline void MapToCoords(int *__restrict__ coord, float *__restrict__ frac,
+                        const float *__restrict__ map, int n, float offset) {
+  if (interp == DALI_INTERP_NN)
+    offset += 0.5f;  // round to nearest
+  for (int i = 0; i < n; i++) {
+    float x = std::min(kMaxMapCoord, std::max(-kMaxMapCoord, map[i] + offset));
+    int xi = static_cast<int>(x);
+    xi -= x < xi;  // floor
+    coord[i] = xi;
+    frac[i] = x - xi;
+  }
+}
+
+/**
+ * @brief Converts the result of linear interpolation to the output type
+ *
+ * The result is a weighted average of input values, so it never needs saturation - and
+ * rounding by hand is much faster than the call to std::round in ConvertSat.
+ */
+template <typename T>
+inline T ConvertInterpolated(float value) {
+  if constexpr (std::is_integral_v<T>)
+    return static_cast<T>(static_cast<int>(value + (value >= 0 ? 0.5f : -0.5f)));
+  else
+    return ConvertSat<T>(value);
+}
+
+/**
+ * @brief Maps an out-of-range coordinate back to the image, following the border type
+ *
+ * Only for the border types which always produce a valid coordinate.
+ */
+inline int BorderCoord(int idx, int size, boundary::BoundaryType type) {
+  using boundary::BoundaryType;
+  switch (type) {
+    case BoundaryType::REFLECT_101:
+      return boundary::idx_reflect_101(idx, size);
+    case BoundaryType::REFLECT_1001:
+      return boundary::idx_reflect_1001(idx, size);
+    case BoundaryType::WRAP:
+      return boundary::idx_wrap(idx, size);
+    default:
+      return boundary::idx_clamp(idx, size);
+  }
+}
+
+/**
+ * @brief Calculates an output pixel whose source (or its neighborhood) is not entirely
+ *        within the input.
+ *
+ * @param x, y  source coordinates, as produced by `MapToCoords`
+ * @param qx, qy fractional parts of the source coordinates
+ * @param same_pos the input pixel at the position of the output pixel, or nullptr if there's
+ *                 no such pixel - used by BoundaryType::TRANSPARENT
+ */
+template <DALIInterpType interp, typename T>
+void RemapBorderPixel(T *pixel, int x, int y, float qx, float qy,
+                      const Surface2D<const T> &in, const boundary::Boundary<T> &border,
+                      const T *same_pos) {
+  using boundary::BoundaryType;
+  Sampler2D<interp, T> sampler(in);
+  // the samplers place the pixel corners (not the centers) at integer coordinates
+  vec2 pos(x + qx + 0.5f, y + qy + 0.5f);
+  switch (border.type) {
+    case BoundaryType::CONSTANT:
+      if (interp == DALI_INTERP_NN)
+        sampler(pixel, ivec2(x, y), border.value);
+      else
+        sampler(pixel, pos, border.value);
+      return;
+    case BoundaryType::CLAMP:
+    case BoundaryType::ISOLATED:  // the surface covers just the ROI
+      if (interp == DALI_INTERP_NN)
+        sampler(pixel, ivec2(x, y), BorderClamp());
+      else
+        sampler(pixel, pos, BorderClamp());
+      return;
+    case BoundaryType::TRANSPARENT:
+      if (same_pos) {
+        for (int c = 0; c < in.channels; c++)
+          pixel[c] = same_pos[c];
+      }
+      return;
+    default:
+      break;
+  }
+  int x0 = BorderCoord(x, in.size.x, border.type);
+  int y0 = BorderCoord(y, in.size.y, border.type);
+  if (interp == DALI_INTERP_NN) {
+    for (int c = 0; c < in.channels; c++)
+      pixel[c] = in(x0, y0, c);
+    return;
+  }
+  int x1 = BorderCoord(x + 1, in.size.x, border.type);
+  int y1 = BorderCoord(y + 1, in.size.y, border.type);
+  float px = 1 - qx;
+  for (int c = 0; c < in.channels; c++) {
+    float s0 = in(x0, y0, c) * px + in(x1, y0, c) * qx;
+    float s1 = in(x0, y1, c) * px + in(x1, y1, c) * qx;
+    pixel[c] = ConvertInterpolated<T>(s0 + (s1 - s0) * qy);
+  }
+}
+
+/**
+ * @brief Remaps a row of the output
+ *
+ * The source coordinates are calculated in chunks, with vectorized code. The pixels whose
+ * source neighborhood is entirely within the input are interpolated directly, the rest
+ * goes through the samplers, which handle the borders.
+ *
+ * @param out_row      output pixels
+ * @param same_pos_row input pixels at the positions of the output pixels (used for
+ *                     BoundaryType::TRANSPARENT); nullptr if the row is outside the input
+ * @param same_pos_width the number of valid pixels in `same_pos_row`
+ * @param offset       the offset added to the map values to get the coordinates in `in`
+ */
+template <DALIInterpType interp, int static_channels, typename T>
+void RemapRow(T *out_row, const T *same_pos_row, int same_pos_width, int width,
+              const float *mapx_row, const float *mapy_row, vec2 offset,
+              const Surface2D<const T> &in, const boundary::Boundary<T> &border) {
+  const int C = static_channels > 0 ? static_channels : in.channels;
+  assert(in.channel_stride == 1 && in.strides.x == C);
+  const int64_t row_stride = in.strides.y;
+  // for linear interpolation, the neighbor to the right and below must be in range, too
+  const int lin = interp == DALI_INTERP_NN ? 0 : 1;
+  const unsigned xlimit = std::max(in.size.x - lin, 0);
+  const unsigned ylimit = std::max(in.size.y - lin, 0);
+  int ix[kRemapChunk], iy[kRemapChunk];
+  float qx[kRemapChunk], qy[kRemapChunk];
+  for (int x0 = 0; x0 < width; x0 += kRemapChunk) {
+    int n = std::min(kRemapChunk, width - x0);
+    MapToCoords<interp>(ix, qx, mapx_row + x0, n, offset.x);
+    MapToCoords<interp>(iy, qy, mapy_row + x0, n, offset.y);
+    for (int i = 0; i < n; i++) {
+      T *pixel = out_row + static_cast<int64_t>(x0 + i) * C;
+      if (static_cast<unsigned>(ix[i]) < xlimit && static_cast<unsigned>(iy[i]) < ylimit) {
+        const T *src = in.data + iy[i] * row_stride + static_cast<int64_t>(ix[i]) * C;
+        if (interp == DALI_INTERP_NN) {
+          for (int c = 0; c < C; c++)
+            pixel[c] = src[c];
+        } else {
+          float q = qx[i], p = 1 - q;
+          for (int c = 0; c < C; c++) {
+            float s0 = src[c] * p + src[c + C] * q;
+            float s1 = src[c + row_stride] * p + src[c + row_stride + C] * q;
+            pixel[c] = ConvertInterpolated<T>(s0 + (s1 - s0) * qy[i]);
+          }
+        }
+      } else {
+        int x = x0 + i;
+        const T *same_pos = same_pos_row && x < same_pos_width
+                          ? same_pos_row + static_cast<int64_t>(x) * C
+                          : nullptr;
+        RemapBorderPixel<interp>(pixel, ix[i], iy[i], qx[i], qy[i], in, border, same_pos);
+      }
+    }
+  }
+}
+
+template <DALIInterpType interp, int static_channels, typename T>
+void RemapRows(const TensorView<StorageCPU, T, 3> &output,
+               const TensorView<StorageCPU, const T, 3> &input,
+               const TensorView<StorageCPU, const float, 2> &mapx,
+               const TensorView<StorageCPU, const float, 2> &mapy,
+               Roi<2> output_roi, Roi<2> input_roi, const boundary::Boundary<T> &border,
+               int row_begin, int row_end, float map_offset) {
+  auto in = crop(as_surface_HWC(input), input_roi);
+  auto out = as_surface_HWC(output);
+  // the maps refer to the whole input image, while the surface starts at the ROI
+  vec2 offset(map_offset - input_roi.lo.x, map_offset - input_roi.lo.y);
+  int width = output_roi.extent().x;
+  for (int y = row_begin; y < row_end; y++) {
+    int out_x = output_roi.lo.x, out_y = output_roi.lo.y + y;
+    const T *same_pos_row = nullptr;
+    int same_pos_width = 0;
+    if (out_y < input.shape[0] && out_x < input.shape[1]) {
+      same_pos_row = input.data + (static_cast<int64_t>(out_y) * input.shape[1] + out_x) *
+                                  input.shape[2];
+      same_pos_width = input.shape[1] - out_x;
+    }
+    RemapRow<interp, static_channels>(&out(out_x, out_y), same_pos_row, same_pos_width, width,
+                                      mapx.data + static_cast<int64_t>(y) * mapx.shape[1],
+                                      mapy.data + static_cast<int64_t>(y) * mapy.shape[1],
+                                      offset, in, border);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * RemapKernel implementation for the CPU.
+ *
+ * Supports nearest neighbor and linear interpolation and all the border types.
+ * BoundaryType::ISOLATED is handled like BoundaryType::CLAMP applied to the input ROI.
+ *
+ * @see RemapKernel.
+ *
+ * @tparam T Type of the input and output data.
+ */
+template <typename T>
+struct CpuRemapKernel : public RemapKernel<StorageCPU, T> {
+  using Border = typename RemapKernel<StorageCPU, T>::Border;
+  using MapType = typename RemapKernel<StorageCPU, T>::MapType;
+
+  void Run(KernelContext &context,
+           TensorListView<StorageCPU, T> output,
+           TensorListView<StorageCPU, const T> input,
+           TensorListView<StorageCPU, const MapType, 2> mapsx,
+           TensorListView<StorageCPU, const MapType, 2> mapsy,
+           span<const Roi<2>> output_rois = {},
+           span<const Roi<2>> input_rois = {},
+           span<DALIInterpType> interpolations = {},
+           span<Border> borders = {}) override {
+    DALI_ENFORCE(output.num_samples() == input.num_samples(),
+                 make_string("Incorrect number of output samples passed. Got ",
+                             output.num_samples(), " output samples, but ", input.num_samples(),
+                             " input samples."));
+    DALI_ENFORCE(mapsx.shape == mapsy.shape,
+                 make_string("Maps shapes do not match. mapsx: ", mapsx.shape, " ; mapsy: ",
+                             mapsy.shape, "."));
+    DALI_ENFORCE(output_rois.empty() || output_rois.size() == input.num_samples(),
+                 make_string("Incorrect number of output_rois passed. Got ", output_rois.size(),
+                             " output_rois, but ", input.num_samples(), " input samples."));
+    DALI_ENFORCE(input_rois.empty() || input_rois.size() == input.num_samples(),
+                 make_string("Incorrect number of input_rois passed. Got ", input_rois.size(),
+                             " input_rois, but ", input.num_samples(), " input samples."));
+    DALI_ENFORCE(interpolations.empty() || interpolations.size() == input.num_samples(),
+                 make_string("Incorrect number of interpolations passed. Got ",
+                             interpolations.size(), " interpolations, but ", input.num_samples(),
+                             " input samples."));
+    DALI_ENFORCE(borders.empty() || borders.size() == input.num_samples(),
+                 make_string("Incorrect number of borders passed. Got ", borders.size(),
+                             " borders, but ", input.num_samples(), " input samples."));
+    for (int i = 0; i < input.num_samples(); i++) {
+      auto out_shape = output.tensor_shape(i);
+      RunSample(output[i].template to_static<3>(), input[i].template to_static<3>(),
+                mapsx[i], mapsy[i],
+                output_rois.empty() ? detail::default_roi(out_shape) : output_rois[i],
+                input_rois.empty() ? Roi<2>{} : input_rois[i],
+                interpolations.empty() ? DALI_INTERP_LINEAR : interpolations[i],
+                borders.empty() ? Border{} : borders[i]);
+    }
+  }
+
+  void Run(KernelContext &context,
+           TensorListView<StorageCPU, T> output,
+           TensorListView<StorageCPU, const T> input,
+           TensorView<StorageCPU, const MapType, 2> mapx,
+           TensorView<StorageCPU, const MapType, 2> mapy,
+           Roi<2> output_roi = {},
+           Roi<2> input_roi = {},
+           DALIInterpType interpolation = DALI_INTERP_LINEAR,
+           Border border = {}) override {
+    DALI_ENFORCE(output.num_samples() == input.num_samples(),
+                 make_string("Incorrect number of output samples passed. Got ",
+                             output.num_samples(), " output samples, but ", input.num_samples(),
+                             " input samples."));
+    DALI_ENFORCE(mapx.shape == mapy.shape,
+                 make_string("Maps shapes do not match. mapx: ", mapx.shape, " ; mapy: ",
+                             mapy.shape, "."));
+    for (int i = 0; i < input.num_samples(); i++) {
+      auto out_shape = output.tensor_shape(i);
+      RunSample(output[i].template to_static<3>(), input[i].template to_static<3>(), mapx, mapy,
+                output_roi.empty() ? detail::default_roi(out_shape) : output_roi,
+                input_roi, interpolation, border);
+    }
+  }
+
+  /**
+   * @brief Remaps a single sample
+   *
+   * Unlike the batch variants, allows to remap just the rows [row_begin, row_end)
+   * of the output ROI - distinct ranges of rows can be processed concurrently.
+   *
+   * @param map_offset The value added to the maps. The maps follow the OpenCV convention,
+   *                   with the pixel centers at integer coordinates - an offset of -0.5
+   *                   places the pixel corners there, instead.
+   */
+  static void RunSample(TensorView<StorageCPU, T, 3> output,
+                        TensorView<StorageCPU, const T, 3> input,
+                        TensorView<StorageCPU, const MapType, 2> mapx,
+                        TensorView<StorageCPU, const MapType, 2> mapy,
+                        Roi<2> output_roi, Roi<2> input_roi,
+                        DALIInterpType interpolation, Border border,
+                        int row_begin = 0, int row_end = -1, float map_offset = 0) {
+    DALI_ENFORCE(mapx.shape == mapy.shape,
+                 make_string("Maps shapes do not match. mapx: ", mapx.shape, " ; mapy: ",
+                             mapy.shape, "."));
+    if (output_roi.empty())
+      output_roi = detail::default_roi(output.shape);
+    if (input_roi.empty())
+      input_roi = detail::default_roi(input.shape);
+    DALI_ENFORCE(mapx.shape == ShapeFromRoi(output_roi),
+                 make_string("Shapes of maps and ROI don't match. ROI: ",
+                             ShapeFromRoi(output_roi), " ; mapx: ", mapx.shape, "."));
+    DALI_ENFORCE(output.shape[2] == input.shape[2],
+                 make_string("The number of channels in the output (", output.shape[2],
+                             ") and the input (", input.shape[2], ") do not match."));
+    if (row_end < 0)
+      row_end = output_roi.extent().y;
+    if (input_roi.extent().x <= 0 || input_roi.extent().y <= 0) {
+      // there's nothing to sample from - everything is a border
+      border.type = boundary::BoundaryType::CONSTANT;
+    }
+
+    int channels = input.shape[2];
+    VALUE_SWITCH(interpolation, interp, (DALI_INTERP_NN, DALI_INTERP_LINEAR), (
+      VALUE_SWITCH(channels, static_channels, (1, 3, 4), (
+        detail::RemapRows<interp, static_channels>(output, input, mapx, mapy, output_roi,
+            input_roi, border, row_begin, row_end, map_offset);
+      ), (  // NOLINT
+        detail::RemapRows<interp, -1>(output, input, mapx, mapy, output_roi,
+            input_roi, border, row_begin, row_end, map_offset);
+      ));  // NOLINT
+    ), DALI_FAIL(make_string("Unsupported interpolation type: ", interpolation,  // NOLINT
+                             ". Only INTERP_NN and INTERP_LINEAR are supported on the CPU.")));
+  }
+};
+
+}  // namespace remap
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_GEOM_REMAP_CPU_H_
@@ -0,0 +1,212 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/kernels/imgproc/geom/remap_cpu.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali::kernels::remap::test {
+
+namespace {
+
+using boundary::BoundaryType;
+
+/**
+ * @brief A straightforward, per-pixel implementation of remap with OpenCV-like semantics
+ */
+template <typename T>
+void RemapRef(const TensorView<StorageCPU, T, 3> &out, const TensorView<StorageCPU, const T, 3> &in,
+              const TensorView<StorageCPU, const float, 2> &mapx,
+              const TensorView<StorageCPU, const float, 2> &mapy,
+              DALIInterpType interp, boundary::Boundary<T> border, float map_offset) {
+  int H = in.shape[0], W = in.shape[1], C = in.shape[2];
+  auto fetch = [&](int x, int y, int c, bool &outside) -> float {
+    bool in_range = x >= 0 && x < W && y >= 0 && y < H;
+    if (!in_range) {
+      outside = true;
+      switch (border.type) {
+        case BoundaryType::CONSTANT:
+        case BoundaryType::TRANSPARENT:
+          return border.value;
+        case BoundaryType::CLAMP:
+          x = std::clamp(x, 0, W - 1);
+          y = std::clamp(y, 0, H - 1);
+          break;
+        case BoundaryType::REFLECT_101:
+          x = boundary::idx_reflect_101(x, W);
+          y = boundary::idx_reflect_101(y, H);
+          break;
+        case BoundaryType::REFLECT_1001:
+          x = boundary::idx_reflect_1001(x, W);
+          y = boundary::idx_reflect_1001(y, H);
+          break;
+        case BoundaryType::WRAP:
+          x = boundary::idx_wrap(x, W);
+          y = boundary::idx_wrap(y, H);
+          break;
+        default:
+          assert(false);
+      }
+    }
+    return *in(y, x, c);
+  };
+
+  for (int y = 0; y < out.shape[0]; y++) {
+    for (int x = 0; x < out.shape[1]; x++) {
+      float sx = *mapx(y, x) + map_offset, sy = *mapy(y, x) + map_offset;
+      for (int c = 0; c < C; c++) {
+        bool outside = false;
+        float value;
+        if (interp == DALI_INTERP_NN) {
+          value = fetch(std::floor(sx + 0.5f), std::floor(sy + 0.5f), c, outside);
+        } else {
+          int x0 = std::floor(sx), y0 = std::floor(sy);
+          float qx = sx - x0, qy = sy - y0;
+          float s00 = fetch(x0, y0, c, outside), s01 = fetch(x0 + 1, y0, c, outside);
+          float s10 = fetch(x0, y0 + 1, c, outside), s11 = fetch(x0 + 1, y0 + 1, c, outside);
+          float s0 = s00 * (1 - qx) + s01 * qx;
+          float s1 = s10 * (1 - qx) + s11 * qx;
+          value = s0 + (s1 - s0) * qy;
+        }
+        if (outside && border.type == BoundaryType::TRANSPARENT)
+          *out(y, x, c) = *in(y, x, c);
+        else
+          *out(y, x, c) = ConvertSat<T>(value);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+class CpuRemapTest : public ::testing::Test {
+ protected:
+  /**
+   * @param map_range the map values are drawn from [-map_range, 1 + map_range] times
+   *                  the image size
+   */
+  void RunTest(TensorShape<3> shape, DALIInterpType interp, boundary::Boundary<T> border,
+               float map_range, float map_offset = 0) {
+    TestTensorList<T, 3> in, out, ref;
+    TestTensorList<float, 2> mapx, mapy;
+    auto list_shape = uniform_list_shape(1, shape);
+    in.reshape(list_shape);
+    out.reshape(list_shape);
+    ref.reshape(list_shape);
+    TensorShape<2> map_shape{shape[0], shape[1]};
+    mapx.reshape(uniform_list_shape(1, map_shape));
+    mapy.reshape(uniform_list_shape(1, map_shape));
+    std::mt19937_64 rng(1234);
+    UniformRandomFill(in.cpu(), rng, 0, 100);
+    UniformRandomFill(mapx.cpu(), rng, -map_range * shape[1], (1 + map_range) * shape[1]);
+    UniformRandomFill(mapy.cpu(), rng, -map_range * shape[0], (1 + map_range) * shape[0]);
+
+    TensorView<StorageCPU, const T, 3> in_view = in.cpu()[0];
+    auto out_view = out.cpu()[0];
+    auto ref_view = ref.cpu()[0];
+    TensorView<StorageCPU, const float, 2> mapx_view = mapx.cpu()[0];
+    TensorView<StorageCPU, const float, 2> mapy_view = mapy.cpu()[0];
+    int H = shape[0];
+    int split = H / 2;
+    // the sample is calculated in two ranges of rows, as the operator does
+    CpuRemapKernel<T>::RunSample(out_view, in_view, mapx_view, mapy_view, {}, {}, interp, border,
+                                 0, split, map_offset);
+    CpuRemapKernel<T>::RunSample(out_view, in_view, mapx_view, mapy_view, {}, {}, interp, border,
+                                 split, H, map_offset);
+    RemapRef(ref_view, in_view, mapx_view, mapy_view, interp, border, map_offset);
+    Check(out_view, ref_view, EqualEpsRel(1e-5, 1e-5));
+  }
+};
+
+using CpuRemapTypes = ::testing::Types<uint8_t, int16_t, uint16_t, float>;
+TYPED_TEST_SUITE(CpuRemapTest, CpuRemapTypes);
+
+TYPED_TEST(CpuRemapTest, InRange) {
+  for (auto interp : {DALI_INTERP_NN, DALI_INTERP_LINEAR}) {
+    for (int channels : {1, 2, 3, 4}) {
+      this->RunTest({37, 150, channels}, interp, {BoundaryType::CONSTANT, 0}, -0.05f);
+    }
+  }
+}
+
+TYPED_TEST(CpuRemapTest, Borders) {
+  for (auto interp : {DALI_INTERP_NN, DALI_INTERP_LINEAR}) {
+    for (auto type : {BoundaryType::CONSTANT, BoundaryType::CLAMP, BoundaryType::REFLECT_101,
+                      BoundaryType::REFLECT_1001, BoundaryType::WRAP,
+                      BoundaryType::TRANSPARENT}) {
+      for (int channels : {1, 3}) {
+        this->RunTest({29, 70, channels}, interp, {type, 42}, 0.3f);
+      }
+    }
+  }
+}
+
+TYPED_TEST(CpuRemapTest, PixelCornerOrigin) {
+  this->RunTest({16, 80, 3}, DALI_INTERP_LINEAR, {BoundaryType::CONSTANT, 0}, 0.1f, -0.5f);
+  this->RunTest({16, 80, 3}, DALI_INTERP_NN, {BoundaryType::CONSTANT, 0}, 0.1f, -0.5f);
+}
+
+TEST(CpuRemapTest, BatchAndRoi) {
+  using T = uint8_t;
+  TestTensorList<T, 3> in, out;
+  TestTensorList<float, 2> mapx, mapy;
+  TensorListShape<3> shape = {{{8, 10, 1}, {6, 12, 1}}};
+  in.reshape(shape);
+  out.reshape(shape);
+  auto in_view = in.cpu();
+  for (int i = 0; i < 2; i++) {
+    for (int64_t j = 0; j < in_view[i].num_elements(); j++)
+      in_view[i].data[j] = j;
+  }
+  // the output ROI is 3x4 pixels at (2, 1), the maps sample the input at (x + 1, y)
+  std::vector<Roi<2>> out_rois = {{{2, 1}, {5, 5}}, {{2, 1}, {5, 5}}};
+  mapx.reshape(uniform_list_shape<2>(2, {4, 3}));
+  mapy.reshape(uniform_list_shape<2>(2, {4, 3}));
+  for (int i = 0; i < 2; i++) {
+    for (int y = 0; y < 4; y++) {
+      for (int x = 0; x < 3; x++) {
+        *mapx.cpu()[i](y, x) = x + 1;
+        *mapy.cpu()[i](y, x) = y;
+      }
+    }
+  }
+  std::vector<DALIInterpType> interps = {DALI_INTERP_NN, DALI_INTERP_LINEAR};
+  std::vector<boundary::Boundary<T>> borders(2, {BoundaryType::CONSTANT, 0});
+  auto out_view = out.cpu();
+  for (int i = 0; i < 2; i++)
+    std::fill(out_view[i].data, out_view[i].data + out_view[i].num_elements(), 255);
+
+  CpuRemapKernel<T> kernel;
+  KernelContext ctx;
+  kernel.Run(ctx, out_view, in.cpu(), mapx.cpu(), mapy.cpu(), make_cspan(out_rois), {},
+             make_span(interps), make_span(borders));
+  for (int i = 0; i < 2; i++) {
+    auto o = out_view[i];
+    auto s = in_view[i];
+    for (int y = 0; y < o.shape[0]; y++) {
+      for (int x = 0; x < o.shape[1]; x++) {
+        bool in_roi = x >= 2 && x < 5 && y >= 1 && y < 5;
+        int expected = in_roi ? *s(y - 1, x - 2 + 1, 0) : 255;
+        EXPECT_EQ(*o(y, x, 0), expected) << "sample " << i << " at " << x << ", " << y;
+      }
+    }
+  }
+}
+
+}  // namespace dali::kernels::remap::test
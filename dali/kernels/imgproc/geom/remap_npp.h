@@ -28,20 +28,6 @@ namespace dali {
 namespace kernels {
 namespace remap {
 
-namespace detail {
-
-/**
- * Return a default ROI. Default ROI is a whole image.
- */
-template<int ndims>
-Roi<2> default_roi(const TensorShape<ndims> &ts) {
-  assert(ts.sample_dim() >= 2);
-  return {{0,     0},
-          {ts[1], ts[0]}};
-}
-
-}  // namespace detail
-
 /**
  * RemapKernel implementation using NPP.
  *
@@ -127,6 +127,28 @@ TEST(SSE2Test, ConvertLoad) {
   TestConvertLoad<int32_t>(-1000000000, 1000000000);
 }
 
+template <typename In>
+void TestMultivecLoad() {
+  In in[16];  // NOLINT
+  for (int i = 0; i < 16; i++)
+    in[i] = i + 1;
+  auto m = multivec<4>::load(in);
+  float flt[16];  // NOLINT
+  for (int i = 0; i < 4; i++)
+    _mm_storeu_ps(flt + i * 4, m.v[i]);
+  for (int i = 0; i < 16; i++)
+    EXPECT_EQ(flt[i], in[i]) << "at lane " << i;
+}
+
+TEST(SSE2Test, MultivecLoad) {
+  TestMultivecLoad<uint8_t>();
+  TestMultivecLoad<int8_t>();
+  TestMultivecLoad<uint16_t>();
+  TestMultivecLoad<int16_t>();
+  TestMultivecLoad<int32_t>();
+  TestMultivecLoad<float>();
+}
+
 #endif  // __SSE2__
 
 }  // namespace test
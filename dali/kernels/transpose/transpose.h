@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,12 +15,16 @@
 #ifndef DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 #define DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "dali/core/force_inline.h"
+#include "dali/core/small_vector.h"
 #include "dali/core/static_switch.h"
 #include "dali/core/tensor_view.h"
+#include "dali/kernels/common/simd.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/kernels/transpose/transpose_util.h"
 
@@ -111,6 +115,164 @@ void TransposeImpl(T *dst, const T *src, int level, int max_levels, span<const i
   }
 }
 
+/**
+ * @brief Size of the square tile transposed in registers; 0 if the type is not supported.
+ */
+template <typename T>
+constexpr int TileSize() {
+  return std::is_trivially_copyable<T>::value &&
+         (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+         ? 16 / sizeof(T) : 0;
+}
+
+/**
+ * @brief Transposes a tile of TileSize<T>() x TileSize<T>() elements,
+ *        storing the first `nrows` rows of the result.
+ *
+ * `dst[i * dst_stride + j] = src[j * src_stride + i]`
+ *
+ * The source rows are always read in full, even if only some of the output rows are stored.
+ */
+template <typename T>
+DALI_FORCEINLINE void TransposeTile(T *dst, int64_t dst_stride,
+                                    const T *src, int64_t src_stride, int nrows) {
+  constexpr int N = TileSize<T>();
+#ifdef __SSE2__
+  simd::i128x<N> m;
+  for (int i = 0; i < N; i++)
+    m.v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * src_stride));
+  simd::transpose<sizeof(T)>(m);
+  for (int i = 0; i < nrows; i++)
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * dst_stride), m.v[i]);
+#else
+  for (int i = 0; i < nrows; i++)
+    for (int j = 0; j < N; j++)
+      dst[i * dst_stride + j] = src[j * src_stride + i];
+#endif
+}
+
+/**
+ * @brief Cache-blocked transposition of a 2D slab: `dst[r * dst_stride + c]` is
+ *        set to `src[c * src_stride + r]`, for `r < rows` and `c < cols`.
+ *
+ * The slab is processed in register tiles (see TransposeTile). The last tile in each
+ * direction overlaps the previous one instead of going out of bounds; when there are fewer
+ * rows than the tile size, the tiles that would read past the slab are copied element-wise.
+ * Requires `cols >= TileSize<T>()`.
+ */
+template <typename T>
+void TransposeTiled2D(T *dst, const T *src, int64_t rows, int64_t cols,
+                      int64_t dst_stride, int64_t src_stride) {
+  constexpr int N = TileSize<T>();
+  // keeps the source cache lines touched by a strip of tiles in L1
+  constexpr int64_t kColBlock = 256;
+  assert(cols >= N);
+  bool full_rows = rows >= N;
+  int nrows = full_rows ? N : rows;
+  // the offset one past the last element of the slab
+  int64_t src_end = (cols - 1) * src_stride + rows;
+  for (int64_t cb = 0; cb < cols; cb += kColBlock) {
+    int64_t cend = std::min(cb + kColBlock, cols);
+    for (int64_t r_start = 0; r_start < rows; r_start += N) {
+      int64_t r = full_rows ? std::min(r_start, rows - N) : 0;
+      for (int64_t c_start = cb; c_start < cend; c_start += N) {
+        int64_t c = std::min(c_start, cend - N);
+        if (!full_rows && (c + N - 1) * src_stride + r + N > src_end) {
+          for (int64_t i = r; i < r + nrows; i++)
+            for (int64_t j = c_start; j < cend; j++)
+              dst[i * dst_stride + j] = src[j * src_stride + i];
+          break;
+        }
+        TransposeTile(dst + r * dst_stride + c, dst_stride, src + c * src_stride + r, src_stride,
+                      nrows);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Transposes `size` elements (in dst-order) of strided tensors using register tiles.
+ *
+ * The tiles span the innermost destination dimension and the destination dimension that
+ * is innermost in the source, so that both the loads and the stores are contiguous.
+ * All other dimensions are iterated over in the destination order.
+ *
+ * @return false if the tiled path is not applicable, i.e. the type is not supported,
+ *         the innermost dimension is not permuted or the dimensions are too small.
+ */
+template <typename T>
+bool TransposeTiled(T *dst, const T *src, int ndim, span<const int64_t> dst_stride,
+                    span<const int64_t> src_stride, const TensorShape<> &size,
+                    span<const int> perm) {
+  constexpr int N = TileSize<T>();
+  if (N == 0 || ndim < 2)
+    return false;
+  int inner = ndim - 1;
+  int src_inner = -1;  // destination dimension which is the innermost one in the source
+  for (int d = 0; d < ndim; d++)
+    if (perm[d] == inner)
+      src_inner = d;
+  if (src_inner == inner || dst_stride[inner] != 1 || src_stride[inner] != 1)
+    return false;
+  int64_t rows = size[src_inner], cols = size[inner];
+  if (rows < 2 || cols < N)
+    return false;
+
+  SmallVector<int, 6> outer;
+  for (int d = 0; d < inner; d++)
+    if (d != src_inner && size[d] > 1)
+      outer.push_back(d);
+  SmallVector<int64_t, 6> idx;
+  idx.resize(outer.size(), 0);
+  int64_t dst_row_stride = dst_stride[src_inner];
+  int64_t src_col_stride = src_stride[perm[inner]];
+  for (;;) {
+    TransposeTiled2D(dst, src, rows, cols, dst_row_stride, src_col_stride);
+    int k = static_cast<int>(outer.size()) - 1;
+    for (; k >= 0; k--) {
+      int d = outer[k];
+      dst += dst_stride[d];
+      src += src_stride[perm[d]];
+      if (++idx[k] < size[d])
+        break;
+      idx[k] = 0;
+      dst -= size[d] * dst_stride[d];
+      src -= size[d] * src_stride[perm[d]];
+    }
+    if (k < 0)
+      return true;
+  }
+}
+
+/**
+ * @brief Transposes `size` elements (in dst-order) of strided tensors element by element,
+ *        selecting the statically unrolled recursion for low dimensionalities.
+ */
+template <typename T>
+void TransposeRecursive(T *dst, const T *src, int ndim, span<const int64_t> dst_stride,
+                        span<const int64_t> src_stride, const TensorShape<> &size,
+                        span<const int> perm) {
+  VALUE_SWITCH(ndim, static_dims, (1, 2, 3), (
+    TransposeImplStatic<static_dims, static_dims>(
+        dst, src, static_dims, dst_stride, src_stride, size, perm);),
+  (
+    TransposeImpl(dst, src, 0, ndim, dst_stride, src_stride, size, perm);));
+}
+
+/**
+ * @brief Transposes `size` elements (in dst-order) of strided tensors.
+ *
+ * Uses the tiled implementation when the innermost dimension is permuted and falls back
+ * to the recursion otherwise.
+ */
+template <typename T>
+void TransposeStrided(T *dst, const T *src, int ndim, span<const int64_t> dst_stride,
+                      span<const int64_t> src_stride, const TensorShape<> &size,
+                      span<const int> perm) {
+  if (!TransposeTiled(dst, src, ndim, dst_stride, src_stride, size, perm))
+    TransposeRecursive(dst, src, ndim, dst_stride, src_stride, size, perm);
+}
+
 }  // namespace transpose_impl
 
 /**
@@ -130,13 +292,45 @@ void Transpose(const TensorView<StorageCPU, T> &dst, const TensorView<StorageCPU
   assert(volume(src.shape) == volume(dst.shape));
   auto dst_strides = GetStrides(dst.shape);
   auto src_strides = GetStrides(src.shape);
-  VALUE_SWITCH(N, static_dims, (1, 2, 3), (
-    transpose_impl::TransposeImplStatic<static_dims, static_dims>(
-        dst.data, src.data,
-        static_dims, make_span(dst_strides), make_span(src_strides), dst.shape, perm);),
-  (
-    transpose_impl::TransposeImpl(dst.data, src.data, 0, N,
-        make_span(dst_strides), make_span(src_strides), dst.shape, perm);));
+  transpose_impl::TransposeStrided(dst.data, src.data, N, make_span(dst_strides),
+                                   make_span(src_strides), dst.shape, perm);
+}
+
+/**
+ * @brief Transpose a block of `dst` Tensor, spanning from `start` to `end` (exclusive),
+ *        from the corresponding part of `src` wrt to permutation `perm`
+ *
+ * The coordinates are given in the destination order. Transposing disjoint blocks
+ * can be used to split the transposition of a big tensor into independent tasks.
+ *
+ * Source dimension `perm[i]` goes to destination dimension `i`.
+ */
+template <typename T>
+void TransposeBlock(const TensorView<StorageCPU, T> &dst,
+                    const TensorView<StorageCPU, const T> &src, span<const int> perm,
+                    const TensorShape<> &start, const TensorShape<> &end) {
+  int N = src.shape.sample_dim();
+  if (N == 0) {  // it's a scalar - just copy it
+    *dst.data = *src.data;
+    return;
+  }
+  assert(dst.shape.sample_dim() == N);
+  assert(start.sample_dim() == N && end.sample_dim() == N);
+  auto dst_strides = GetStrides(dst.shape);
+  auto src_strides = GetStrides(src.shape);
+  T *dst_ptr = dst.data;
+  const T *src_ptr = src.data;
+  TensorShape<> size = end;
+  for (int d = 0; d < N; d++) {
+    assert(0 <= start[d] && start[d] <= end[d] && end[d] <= dst.shape[d]);
+    dst_ptr += start[d] * dst_strides[d];
+    src_ptr += start[d] * src_strides[perm[d]];
+    size[d] = end[d] - start[d];
+  }
+  if (volume(size) == 0)
+    return;
+  transpose_impl::TransposeStrided(dst_ptr, src_ptr, N, make_span(dst_strides),
+                                   make_span(src_strides), size, perm);
 }
 
 /**
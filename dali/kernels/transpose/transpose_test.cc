@@ -0,0 +1,102 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+#include "dali/core/exec/engine.h"
+#include "dali/kernels/common/split_shape.h"
+#include "dali/kernels/transpose/transpose.h"
+#include "dali/kernels/transpose/transpose_test.h"
+
+namespace dali {
+namespace kernels {
+
+template <typename T>
+void TestTransposeCPU(const TensorShape<> &src_shape, span<const int> perm, int nblocks) {
+  int ndim = src_shape.sample_dim();
+  auto dst_shape = permute(src_shape, perm);
+  int64_t vol = volume(src_shape);
+  std::vector<T> in(vol), out(vol, 0), ref(vol);
+  std::iota(in.begin(), in.end(), 0);
+  testing::RefTranspose(ref.data(), in.data(), src_shape.data(), perm.data(), ndim);
+
+  TensorView<StorageCPU, T> out_view{out.data(), dst_shape};
+  TensorView<StorageCPU, const T> in_view{in.data(), src_shape};
+  if (nblocks == 1) {
+    Transpose(out_view, in_view, perm);
+  } else {
+    SequentialExecutionEngine engine;
+    ScheduleBlocks(engine, dst_shape, nblocks, 1, 0,
+      [&](int, const TensorShape<> &start, const TensorShape<> &end) {
+        TransposeBlock(out_view, in_view, perm, start, end);
+      });
+  }
+  for (int64_t i = 0; i < vol; i++)
+    ASSERT_EQ(out[i], ref[i]) << " at offset " << i;
+}
+
+TEST(TransposeCPUTest, AllPermutations4D) {
+  TensorShape<> shape{5, 7, 3, 11};
+  for (auto &perm : testing::Permutations4) {
+    for (int nblocks : {1, 2, 7, 64}) {
+      TestTransposeCPU<int>(shape, make_cspan(perm), nblocks);
+    }
+  }
+}
+
+TEST(TransposeCPUTest, Blocks2D) {
+  int perm[] = {1, 0};
+  for (int nblocks : {1, 3, 16}) {
+    TestTransposeCPU<uint8_t>({37, 53}, make_cspan(perm), nblocks);
+    TestTransposeCPU<float>({1, 53}, make_cspan(perm), nblocks);
+  }
+}
+
+TEST(TransposeCPUTest, TiledAllTypes) {
+  // the innermost dimension is permuted, so the register tiles are used
+  int perm2[] = {1, 0};
+  int perm3[] = {2, 0, 1};
+  int perm4[] = {0, 3, 1, 2};
+  for (auto shape : {TensorShape<>{16, 16}, TensorShape<>{37, 53}, TensorShape<>{300, 19}}) {
+    TestTransposeCPU<uint8_t>(shape, make_cspan(perm2), 1);
+    TestTransposeCPU<int16_t>(shape, make_cspan(perm2), 1);
+    TestTransposeCPU<float>(shape, make_cspan(perm2), 1);
+    TestTransposeCPU<double>(shape, make_cspan(perm2), 1);
+  }
+  for (auto shape : {TensorShape<>{20, 33, 3}, TensorShape<>{7, 9, 18}, TensorShape<>{5, 40, 4}}) {
+    TestTransposeCPU<uint8_t>(shape, make_cspan(perm3), 1);
+    TestTransposeCPU<uint16_t>(shape, make_cspan(perm3), 1);
+    TestTransposeCPU<int>(shape, make_cspan(perm3), 1);
+    TestTransposeCPU<uint8_t>(shape, make_cspan(perm3), 5);
+  }
+  TensorShape<> shape4{3, 19, 21, 6};
+  TestTransposeCPU<uint8_t>(shape4, make_cspan(perm4), 1);
+  TestTransposeCPU<uint16_t>(shape4, make_cspan(perm4), 1);
+  TestTransposeCPU<float>(shape4, make_cspan(perm4), 1);
+  TestTransposeCPU<uint8_t>(shape4, make_cspan(perm4), 7);
+}
+
+TEST(TransposeCPUTest, TiledPartialRows) {
+  // fewer rows than the tile size - the last tiles are copied element-wise
+  int perm[] = {1, 0};
+  for (int rows = 2; rows < 16; rows++) {
+    TestTransposeCPU<uint8_t>({61, rows}, make_cspan(perm), 1);
+    TestTransposeCPU<uint16_t>({61, rows}, make_cspan(perm), 1);
+    TestTransposeCPU<uint8_t>({1000, rows}, make_cspan(perm), 3);
+  }
+}
+
+}  // namespace kernels
+}  // namespace dali
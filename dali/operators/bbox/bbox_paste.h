@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_BBOX_BBOX_PASTE_H_
 #define DALI_OPERATORS_BBOX_BBOX_PASTE_H_
 
+#include <type_traits>
 #include <vector>
 
 #include "dali/core/common.h"
@@ -39,6 +40,10 @@ class BBoxPaste : public Operator<Backend> {
     return false;
   }
 
+  bool SupportsSampleStreaming() const override {
+    return std::is_same<Backend, CPUBackend>::value;
+  }
+
   void RunImpl(legacy_workspace_t<Backend> &ws) override;
 
   USE_OPERATOR_MEMBERS();
@@ -23,7 +23,7 @@ namespace dali {
 // NOTE: has to be in .cc so we can forward-declare ScatterGatherGPU
 CachedDecoderImpl::~CachedDecoderImpl() = default;
 
-CachedDecoderImpl::CachedDecoderImpl(const OpSpec& spec)
+CachedDecoderImpl::CachedDecoderImpl(const OpSpec& spec, bool host_cache)
     : device_id_(spec.GetArgument<int>("device_id")) {
   // Fused operators don't have cache options
   if (spec.HasArgument("cache_size")) {
@@ -36,12 +36,15 @@ CachedDecoderImpl::CachedDecoderImpl(const OpSpec& spec)
       const std::string cache_type = spec.GetArgument<std::string>("cache_type");
       const bool cache_debug = spec.GetArgument<bool>("cache_debug");
       cache_ = ImageCacheFactory::Instance().Get(
-        device_id_, cache_type, cache_size, cache_debug, cache_threshold);
-
-      use_batch_copy_kernel_ = spec.GetArgument<bool>("cache_batch_copy");
-      auto batch_size = spec.GetArgument<int>("max_batch_size");
-      const size_t kMaxSizePerBlock = 1<<18;  // 256 kB per block
-      scatter_gather_.reset(new kernels::ScatterGatherGPU(kMaxSizePerBlock));
+        device_id_, cache_type, cache_size, cache_debug, cache_threshold, host_cache);
+
+      // the host cache is read with plain copies
+      if (!host_cache) {
+        use_batch_copy_kernel_ = spec.GetArgument<bool>("cache_batch_copy");
+        auto batch_size = spec.GetArgument<int>("max_batch_size");
+        const size_t kMaxSizePerBlock = 1<<18;  // 256 kB per block
+        scatter_gather_.reset(new kernels::ScatterGatherGPU(kMaxSizePerBlock));
+      }
     }
   }
 }
@@ -92,21 +95,22 @@ void CachedDecoderImpl::CacheStore(const std::string& file_name, const uint8_t *
 DALI_SCHEMA(CachedDecoderAttr)
   .DocStr(R"code(Attributes for cached decoder.)code")
   .AddOptionalArg("cache_size",
-      R"code(Applies **only** to the ``mixed`` backend type.
+      R"code(Applies **only** to the ``mixed`` and ``cpu`` backend types.
 
 Total size of the decoder cache in megabytes. When provided, the decoded images
-that are larger than ``cache_threshold`` will be cached in GPU memory.
+that are larger than ``cache_threshold`` will be cached in GPU memory (``mixed`` backend)
+or in host memory (``cpu`` backend).
 )code",
       0)
   .AddOptionalArg("cache_threshold",
-      R"code(Applies **only** to the ``mixed`` backend type.
+      R"code(Applies **only** to the ``mixed`` and ``cpu`` backend types.
 
 The size threshold, in bytes, for decoded images to be cached. When an image is cached, it no
 longer needs to be decoded when it is encountered at the operator input saving processing time.
 )code",
       0)
   .AddOptionalArg("cache_debug",
-      R"code(Applies **only** to the ``mixed`` backend type.
+      R"code(Applies **only** to the ``mixed`` and ``cpu`` backend types.
 
 Prints the debug information about the decoder cache.)code",
       false)
@@ -118,7 +122,7 @@ Otherwise, unless the order in the batch is the same as in the cache, each image
 copied with ``cudaMemcpy``.)code",
       true)
   .AddOptionalArg("cache_type",
-      R"code(Applies **only** to the ``mixed`` backend type.
+      R"code(Applies **only** to the ``mixed`` and ``cpu`` backend types.
 
 Here is a list of the available cache types:
 
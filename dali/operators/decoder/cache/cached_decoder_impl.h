@@ -30,8 +30,9 @@ class CachedDecoderImpl {
  public:
   /**
    * @params spec: to determine all the cache parameters
+   * @params host_cache: if true, the images are cached in host memory (for the CPU decoders)
    */
-  explicit CachedDecoderImpl(const OpSpec& spec);
+  explicit CachedDecoderImpl(const OpSpec& spec, bool host_cache = false);
 
   bool CacheLoad(
     const std::string& file_name,
@@ -15,6 +15,7 @@
 #include "dali/operators/decoder/cache/image_cache_factory.h"
 #include <memory>
 #include "dali/operators/decoder/cache/image_cache_blob.h"
+#include "dali/operators/decoder/cache/image_cache_host.h"
 #include "dali/operators/decoder/cache/image_cache_largest.h"
 
 namespace dali {
@@ -23,16 +24,23 @@ std::shared_ptr<ImageCache> ImageCacheFactory::Get(int device_id,
                                                    const std::string& cache_policy,
                                                    std::size_t cache_size,
                                                    bool cache_debug,
-                                                   std::size_t cache_threshold) {
+                                                   std::size_t cache_threshold,
+                                                   bool host_memory) {
   std::lock_guard<std::mutex> lock(mutex_);
-  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold};
+  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold, host_memory};
   auto &instance = caches_[device_id];
   auto cache = instance.cache.lock();
   if (!cache) {
     if (cache_policy == "threshold") {
-      cache.reset(new ImageCacheBlob(cache_size, cache_threshold, cache_debug));
+      if (host_memory)
+        cache.reset(new ImageCacheHost(cache_size, cache_threshold, cache_debug));
+      else
+        cache.reset(new ImageCacheBlob(cache_size, cache_threshold, cache_debug));
     } else if (cache_policy == "largest") {
-      cache.reset(new ImageCacheLargest(cache_size, cache_debug));
+      if (host_memory)
+        cache.reset(new ImageCacheHostLargest(cache_size, cache_debug));
+      else
+        cache.reset(new ImageCacheLargest(cache_size, cache_debug));
     } else {
       DALI_FAIL("unexpected cache policy `" + cache_policy + "`");
     }
@@ -36,13 +36,15 @@ class DLL_PUBLIC ImageCacheFactory {
    * are the same.
    * Will fail if the cache was already allocated but with different
    * parameters
+   * @param host_memory if true, the images are cached in host memory, for the CPU decoders
    */
   DLL_PUBLIC std::shared_ptr<ImageCache> Get(
     int device_id,
     const std::string& cache_policy,
     std::size_t cache_size,
     bool cache_debug = false,
-    std::size_t cache_threshold = 0);
+    std::size_t cache_threshold = 0,
+    bool host_memory = false);
 
   /**
    * @brief Get the already allocated cache
@@ -65,12 +67,14 @@ class DLL_PUBLIC ImageCacheFactory {
     std::size_t cache_size;
     bool cache_debug;
     std::size_t cache_threshold;
+    bool host_memory;
 
     inline bool operator==(const CacheParams& oth) const {
       return cache_policy == oth.cache_policy
           && cache_size == oth.cache_size
           && cache_debug == oth.cache_debug
-          && cache_threshold == oth.cache_threshold;
+          && cache_threshold == oth.cache_threshold
+          && host_memory == oth.host_memory;
     }
   };
 
@@ -15,6 +15,7 @@
 #include "dali/operators/decoder/cache/image_cache_factory.h"
 #include <gtest/gtest.h>
 #include <memory>
+#include "dali/operators/decoder/cache/image_cache_host.h"
 
 namespace dali {
 namespace testing {
@@ -112,5 +113,23 @@ TEST_F(ImageCacheFactoryTest, GetAndRefCount) {
   auto cache03 = factory.Get(0, "threshold", 2*1024*1024, true, 1024);
 }
 
+TEST_F(ImageCacheFactoryTest, HostMemory) {
+  auto &factory = ImageCacheFactory::Instance();
+  ASSERT_FALSE(factory.IsInitialized(0));
+
+  auto cache0 = factory.Get(0, "threshold", 1*1024*1024, false, 1024, true);
+  ASSERT_NE(nullptr, cache0);
+  EXPECT_NE(nullptr, dynamic_cast<ImageCacheHost*>(cache0.get()));
+  // device memory cache is a different configuration
+  EXPECT_THROW(
+    factory.Get(0, "threshold", 1*1024*1024, false, 1024, false),
+    std::runtime_error);
+  cache0.reset();
+  EXPECT_FALSE(factory.IsInitialized(0));
+
+  cache0 = factory.Get(0, "largest", 1*1024*1024, false, 0, true);
+  EXPECT_NE(nullptr, dynamic_cast<ImageCacheHost*>(cache0.get()));
+}
+
 }  // namespace testing
 }  // namespace dali
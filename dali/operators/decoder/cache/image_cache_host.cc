@@ -0,0 +1,163 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_host.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include "dali/core/error_handling.h"
+
+namespace dali {
+
+ImageCacheHost::ImageCacheHost(std::size_t cache_size,
+                               std::size_t image_size_threshold,
+                               bool stats_enabled)
+    : cache_size_(cache_size)
+    , image_size_threshold_(image_size_threshold)
+    , stats_enabled_(stats_enabled)
+    , shards_(new Shard[kNumShards]) {
+  DALI_ENFORCE(image_size_threshold <= cache_size_, "Cache size should fit at least one image");
+
+  buffer_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::host>(cache_size_);
+  DALI_ENFORCE(buffer_ != nullptr);
+  LOG_LINE << "cache size is " << cache_size_ / (1024 * 1024) << " MB" << std::endl;
+}
+
+ImageCacheHost::~ImageCacheHost() {
+  if (stats_enabled_ && images_seen() > 0) print_stats();
+}
+
+bool ImageCacheHost::IsCached(const ImageKey& image_key) const {
+  auto &shard = GetShard(image_key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.entries.find(image_key) != shard.entries.end();
+}
+
+const ImageCache::ImageShape& ImageCacheHost::GetShape(const ImageKey& image_key) const {
+  auto &shard = GetShard(image_key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  const auto it = shard.entries.find(image_key);
+  DALI_ENFORCE(it != shard.entries.end(), "cache entry [" + image_key + "] not found");
+  // the entries are never removed, so the reference remains valid
+  return it->second.shape;
+}
+
+bool ImageCacheHost::Read(const ImageKey& image_key,
+                          void* destination_buffer,
+                          cudaStream_t) const {
+  DALI_ENFORCE(!image_key.empty());
+  DALI_ENFORCE(destination_buffer != nullptr);
+  LOG_LINE << "Read: image_key[" << image_key << "]" << std::endl;
+  Entry entry;
+  {
+    auto &shard = GetShard(image_key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const auto it = shard.entries.find(image_key);
+    if (it == shard.entries.end())
+      return false;
+    entry = it->second;
+  }
+  // the cached data is immutable - no need to hold the lock while copying
+  std::memcpy(destination_buffer, entry.data, volume(entry.shape));
+
+  if (stats_enabled_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_[image_key].reads++;
+  }
+  return true;
+}
+
+ImageCache::DecodedImage ImageCacheHost::Get(const ImageKey&) const {
+  DALI_FAIL("The images are cached in host memory and cannot be accessed as GPU tensors.");
+}
+
+uint8_t *ImageCacheHost::Reserve(std::size_t size) {
+  std::size_t offset = used_.load();
+  do {
+    if (cache_size_ - offset < size)
+      return nullptr;
+  } while (!used_.compare_exchange_weak(offset, offset + size));
+  return buffer_.get() + offset;
+}
+
+void ImageCacheHost::Add(const ImageKey& image_key, const uint8_t* data,
+                         const ImageShape& data_shape, cudaStream_t) {
+  const std::size_t data_size = volume(data_shape);
+  if (stats_enabled_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_[image_key].decodes++;
+  }
+  if (data_size < image_size_threshold_) return;
+  DALI_ENFORCE(!image_key.empty());
+
+  auto &shard = GetShard(image_key);
+  {
+    std::lock_guard<std::shared_mutex> lock(shard.mutex);
+    if (shard.entries.find(image_key) != shard.entries.end())
+      return;
+
+    uint8_t *dst = Reserve(data_size);
+    if (!dst) {
+      LOG_LINE << "WARNING: not enough space in cache. Ignore" << std::endl;
+      if (stats_enabled_) {
+        std::lock_guard<std::mutex> stats_lock(mutex_);
+        is_full = true;
+      }
+      return;
+    }
+
+    std::memcpy(dst, data, data_size);
+    shard.entries.emplace(image_key, Entry{dst, data_shape});
+  }
+
+  if (stats_enabled_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_[image_key].is_cached = true;
+  }
+}
+
+void ImageCacheHost::print_stats() const {
+  static std::mutex stats_mutex;
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  std::size_t images_cached = 0;
+  for (auto& elem : stats_)
+    if (elem.second.is_cached) images_cached++;
+  DALI_ENFORCE(images_cached <= images_seen());
+  const char* log_filename = std::getenv("DALI_LOG_FILE");
+  std::ofstream log_file;
+  if (log_filename) log_file.open(log_filename);
+  std::ostream& out = log_filename ? log_file : std::cout;
+  out << "#################### CACHE STATS ####################" << std::endl;
+  out << "cache_type: host" << std::endl;
+  out << "cache_size: " << cache_size_ << std::endl;
+  out << "cache_threshold: " << image_size_threshold_ << std::endl;
+  out << "is_cache_full: " << static_cast<int>(is_full) << std::endl;
+  out << "images_seen: " << images_seen() << std::endl;
+  out << "images_cached: " << images_cached << std::endl;
+  out << "images_not_cached: " << images_seen() - images_cached << std::endl;
+  for (auto& elem : stats_) {
+    out << "image[" << elem.first << "] : is_cached[" << static_cast<int>(elem.second.is_cached)
+        << "] decodes[" << elem.second.decodes << "] reads[" << elem.second.reads << "]";
+    if (elem.second.is_cached) {
+      auto shape = GetShape(elem.first);
+      out << " shape[" << shape[0] << ", " << shape[1] << ", " << shape[2] << "]";
+    }
+    out << std::endl;
+  }
+  out << "#################### END   STATS ####################" << std::endl;
+}
+
+}  // namespace dali
@@ -0,0 +1,122 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_HOST_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_HOST_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include "dali/core/error_handling.h"
+#include "dali/core/mm/memory.h"
+#include "dali/operators/decoder/cache/image_cache.h"
+
+namespace dali {
+
+/**
+ * @brief Image cache which keeps the decoded images in host memory
+ *
+ * Caches every image larger than the threshold until the cache is full. The images are never
+ * evicted, so the lookups don't need a global lock - the index is split into shards, each with
+ * its own reader-writer lock, and the data is copied without any lock held.
+ *
+ * The CUDA streams passed to the functions are ignored - the copies are synchronous.
+ */
+class DLL_PUBLIC ImageCacheHost : public ImageCache {
+ public:
+  DLL_PUBLIC ImageCacheHost(std::size_t cache_size,
+                            std::size_t image_size_threshold,
+                            bool stats_enabled = false);
+
+  ~ImageCacheHost() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCacheHost);
+
+  bool IsCached(const ImageKey& image_key) const override;
+
+  bool Read(const ImageKey& image_key,
+            void* destination_data,
+            cudaStream_t stream) const override;
+
+  const ImageShape& GetShape(const ImageKey& image_key) const override;
+
+  void Add(const ImageKey& image_key,
+           const uint8_t *data,
+           const ImageShape& data_shape,
+           cudaStream_t stream) override;
+
+  /**
+   * @brief Not supported - the cached images are not in device memory; use Read instead
+   */
+  DecodedImage Get(const ImageKey &image_key) const override;
+
+  void SyncToRead(cudaStream_t stream) const override {}
+
+ protected:
+  struct Entry {
+    const uint8_t *data;
+    ImageShape shape;
+  };
+
+  static constexpr int kNumShards = 64;
+
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<ImageKey, Entry> entries;
+  };
+
+  Shard &GetShard(const ImageKey &image_key) const {
+    return shards_[std::hash<ImageKey>()(image_key) % kNumShards];
+  }
+
+  /**
+   * @brief Reserves space for an image in the buffer
+   * @return The pointer to the reserved space or nullptr, if the cache is full
+   */
+  uint8_t *Reserve(std::size_t size);
+
+  void print_stats() const;
+
+  inline std::size_t images_seen() const {
+    return (total_seen_images_ == 0) ?
+        stats_.size() : total_seen_images_;
+  }
+
+  std::size_t cache_size_ = 0;
+  std::size_t image_size_threshold_ = 0;
+  bool stats_enabled_ = false;
+  mm::uptr<uint8_t> buffer_;
+  std::atomic<std::size_t> used_{0};
+
+  std::unique_ptr<Shard[]> shards_;
+
+  // Guards the state of the policy (in derived classes) and the statistics
+  mutable std::mutex mutex_;
+
+  struct Stats {
+    std::size_t decodes = 0;
+    std::size_t reads = 0;
+    bool is_cached = false;
+  };
+  mutable std::unordered_map<ImageKey, Stats> stats_;
+  bool is_full = false;
+  std::size_t total_seen_images_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_HOST_H_
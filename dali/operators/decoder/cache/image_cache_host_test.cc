@@ -0,0 +1,131 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_host.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dali/operators/decoder/cache/image_cache_largest.h"
+
+namespace dali {
+namespace testing {
+
+namespace {
+
+const char kKey1[] = "file1.jpg";
+const std::vector<uint8_t> kValue1(300, 0xAA);
+const ImageCache::ImageShape kShape1{100, 1, 3};
+
+}  // namespace
+
+struct ImageCacheHostTest : public ::testing::Test {
+  void SetUp() override { SetUpImpl((1 << 9)); }
+
+  void SetUpImpl(std::size_t cache_size, std::size_t image_size_threshold = 0) {
+    cache_.reset(new ImageCacheHost(cache_size, image_size_threshold, false));
+  }
+
+  std::unique_ptr<ImageCacheHost> cache_;
+};
+
+TEST_F(ImageCacheHostTest, Add) {
+  EXPECT_FALSE(cache_->IsCached(kKey1));
+  cache_->Add(kKey1, &kValue1[0], kShape1, 0);
+  EXPECT_TRUE(cache_->IsCached(kKey1));
+  EXPECT_EQ(cache_->GetShape(kKey1), kShape1);
+  std::vector<uint8_t> cachedData(kValue1.size());
+  EXPECT_TRUE(cache_->Read(kKey1, &cachedData[0], 0));
+  EXPECT_EQ(kValue1, cachedData);
+}
+
+TEST_F(ImageCacheHostTest, ReadNonExistent) {
+  std::vector<uint8_t> cachedData(kValue1.size());
+  EXPECT_FALSE(cache_->Read(kKey1, &cachedData[0], 0));
+}
+
+TEST_F(ImageCacheHostTest, AddExistingIgnored) {
+  cache_->Add(kKey1, &kValue1[0], kShape1, 0);
+  std::vector<uint8_t> other(kValue1.size(), 0x55);
+  cache_->Add(kKey1, &other[0], kShape1, 0);
+  std::vector<uint8_t> cachedData(kValue1.size());
+  EXPECT_TRUE(cache_->Read(kKey1, &cachedData[0], 0));
+  EXPECT_EQ(kValue1, cachedData);
+}
+
+TEST_F(ImageCacheHostTest, TooSmallCacheSize) {
+  SetUpImpl(kValue1.size() - 1);
+  cache_->Add(kKey1, &kValue1[0], kShape1, 0);
+  EXPECT_FALSE(cache_->IsCached(kKey1));
+}
+
+TEST_F(ImageCacheHostTest, BelowThresholdNotCached) {
+  SetUpImpl(1 << 12, kValue1.size() + 1);
+  cache_->Add(kKey1, &kValue1[0], kShape1, 0);
+  EXPECT_FALSE(cache_->IsCached(kKey1));
+}
+
+TEST_F(ImageCacheHostTest, ConcurrentAccess) {
+  const int kNumThreads = 8;
+  const int kImagesPerThread = 100;
+  const std::size_t kImageSize = 64;
+  // room for 3/4 of the images
+  SetUpImpl(kNumThreads * kImagesPerThread * kImageSize * 3 / 4);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&, t]() {
+      std::vector<uint8_t> data(kImageSize), read(kImageSize);
+      for (int i = 0; i < kImagesPerThread; i++) {
+        // the threads add overlapping sets of images
+        int img = (t * kImagesPerThread / 2 + i) % (kNumThreads * kImagesPerThread);
+        std::fill(data.begin(), data.end(), img % 256);
+        std::string key = std::to_string(img);
+        cache_->Add(key, data.data(), {static_cast<int64_t>(kImageSize), 1, 1}, 0);
+        if (cache_->Read(key, read.data(), 0))
+          EXPECT_EQ(read, data);
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+}
+
+TEST(ImageCacheHostLargestTest, SecondRoundCache) {
+  ImageCacheHostLargest cache(310);
+  std::vector<std::vector<uint8_t>> data;
+  for (int i = 0; i < 4; i++)
+    data.emplace_back(100 + i, i);
+  auto add = [&](int i) {
+    cache.Add(std::to_string(i), data[i].data(),
+              {static_cast<int64_t>(data[i].size()), 1, 1}, 0);
+  };
+  for (int i = 0; i < 4; i++)
+    add(i);
+  for (int i = 0; i < 4; i++)
+    EXPECT_FALSE(cache.IsCached(std::to_string(i)));
+  for (int i = 0; i < 4; i++)
+    add(i);
+  // only the 3 largest images fit
+  EXPECT_FALSE(cache.IsCached("0"));
+  for (int i = 1; i < 4; i++) {
+    ASSERT_TRUE(cache.IsCached(std::to_string(i)));
+    std::vector<uint8_t> read(data[i].size());
+    EXPECT_TRUE(cache.Read(std::to_string(i), read.data(), 0));
+    EXPECT_EQ(read, data[i]);
+  }
+}
+
+}  // namespace testing
+}  // namespace dali
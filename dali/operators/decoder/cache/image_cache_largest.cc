@@ -19,15 +19,18 @@
 
 namespace dali {
 
-ImageCacheLargest::ImageCacheLargest(std::size_t cache_size, bool stats_enabled)
-    : ImageCacheBlob(cache_size, 0, stats_enabled) {}
+template <typename BlobCache>
+ImageCacheLargestImpl<BlobCache>::ImageCacheLargestImpl(std::size_t cache_size,
+                                                        bool stats_enabled)
+    : BlobCache(cache_size, 0, stats_enabled) {}
 
-void ImageCacheLargest::Add(const ImageKey& image_key,
-                                  const uint8_t *data,
-                                  const ImageShape& data_shape,
-                                  cudaStream_t stream) {
+template <typename BlobCache>
+void ImageCacheLargestImpl<BlobCache>::Add(const ImageKey& image_key,
+                                           const uint8_t *data,
+                                           const ImageShape& data_shape,
+                                           cudaStream_t stream) {
   const std::size_t data_size = volume(data_shape);
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::unique_lock<std::mutex> lock(this->mutex_);
   // If we haven't started caching
   if (!start_caching_) {
     // if we've already seen this image, start caching
@@ -36,7 +39,7 @@ void ImageCacheLargest::Add(const ImageKey& image_key,
     if (start_caching_) {
       // replace images_ with the biggest_images
       // and clean unnecessary data structures
-      total_seen_images_ = images_.size();
+      this->total_seen_images_ = images_.size();
       images_.clear();
       while (!biggest_images_.empty()) {
         images_.insert(biggest_images_.top().second);
@@ -46,17 +49,17 @@ void ImageCacheLargest::Add(const ImageKey& image_key,
       // mark the image as seen
       images_.insert(image_key);
 
-      const bool data_fits = (biggest_images_total_ + data_size <= cache_size_);
-      is_full = is_full || !data_fits;
+      const bool data_fits = (biggest_images_total_ + data_size <= this->cache_size_);
+      this->is_full = this->is_full || !data_fits;
       // if there is enough space, store the image as one of biggest
       if (data_fits) {
         biggest_images_.push({data_size, image_key});
         biggest_images_total_ += data_size;
-      } else if (data_size <= cache_size_) {
+      } else if (data_size <= this->cache_size_) {
         // If full, check whether the current image has higher priority
         std::stack<QueueElement> to_be_discarded;
         while (!biggest_images_.empty()
-            && biggest_images_total_ + data_size > cache_size_
+            && biggest_images_total_ + data_size > this->cache_size_
             && biggest_images_.top().first < data_size) {
           biggest_images_total_ -= biggest_images_.top().first;
           to_be_discarded.push(biggest_images_.top());
@@ -64,14 +67,14 @@ void ImageCacheLargest::Add(const ImageKey& image_key,
         }
 
         // If we have enough space now, push the new image
-        if (biggest_images_total_ + data_size <= cache_size_) {
+        if (biggest_images_total_ + data_size <= this->cache_size_) {
           biggest_images_.push({data_size, image_key});
           biggest_images_total_ += data_size;
         }
 
         // If there is extra space, push back the images we took out
         while (!to_be_discarded.empty()) {
-          if (biggest_images_total_ + to_be_discarded.top().first <= cache_size_) {
+          if (biggest_images_total_ + to_be_discarded.top().first <= this->cache_size_) {
             biggest_images_total_ += to_be_discarded.top().first;
             biggest_images_.push(std::move(to_be_discarded.top()));
           }
@@ -83,8 +86,11 @@ void ImageCacheLargest::Add(const ImageKey& image_key,
   lock.unlock();
 
   if (start_caching_ && images_.find(image_key) != images_.end()) {
-    ImageCacheBlob::Add(image_key, data, data_shape, stream);
+    BlobCache::Add(image_key, data, data_shape, stream);
   }
 }
 
+template class ImageCacheLargestImpl<ImageCacheBlob>;
+template class ImageCacheLargestImpl<ImageCacheHost>;
+
 }  // namespace dali
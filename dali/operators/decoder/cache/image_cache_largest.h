@@ -21,15 +21,29 @@
 #include <utility>
 #include <vector>
 #include "dali/operators/decoder/cache/image_cache_blob.h"
+#include "dali/operators/decoder/cache/image_cache_host.h"
 #include "dali/core/common.h"
 
 namespace dali {
 
-class DLL_PUBLIC ImageCacheLargest : public ImageCacheBlob {
+/**
+ * @brief Caches the largest images which fit in the cache
+ *
+ * During the first epoch, the cache only selects the images to keep - the caching starts
+ * when an image is seen for the second time.
+ *
+ * @tparam BlobCache  the cache which stores the selected images; it provides the storage
+ *                    (device or host memory)
+ */
+template <typename BlobCache>
+class DLL_PUBLIC ImageCacheLargestImpl : public BlobCache {
  public:
-  DLL_PUBLIC ImageCacheLargest(std::size_t cache_size, bool stats_enabled = false);
+  using ImageKey = typename BlobCache::ImageKey;
+  using ImageShape = typename BlobCache::ImageShape;
 
-  DISABLE_COPY_MOVE_ASSIGN(ImageCacheLargest);
+  DLL_PUBLIC ImageCacheLargestImpl(std::size_t cache_size, bool stats_enabled = false);
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCacheLargestImpl);
 
   void Add(const ImageKey& image_key, const uint8_t* data, const ImageShape& data_shape,
            cudaStream_t stream) override;
@@ -44,6 +58,9 @@ class DLL_PUBLIC ImageCacheLargest : public ImageCacheBlob {
   std::size_t biggest_images_total_ = 0;
 };
 
+using ImageCacheLargest = ImageCacheLargestImpl<ImageCacheBlob>;
+using ImageCacheHostLargest = ImageCacheLargestImpl<ImageCacheHost>;
+
 }  // namespace dali
 
 #endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_LARGEST_H_
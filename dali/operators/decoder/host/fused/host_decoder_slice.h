@@ -30,9 +30,8 @@ class HostDecoderSlice : public HostDecoder {
   DISABLE_COPY_MOVE_ASSIGN(HostDecoderSlice);
 
  protected:
-  inline void RunImpl(Workspace &ws) override {
+  inline void SetupSharedSampleParams(Workspace &ws) override {
     slice_attr_.ProcessArguments<CPUBackend>(spec_, ws);
-    Operator<CPUBackend>::RunImpl(ws);
   }
 
   inline void RunImpl(SampleWorkspace &ws) override {
@@ -25,6 +25,18 @@ void HostDecoder::RunImpl(SampleWorkspace &ws) {
   auto &output = ws.Output<CPUBackend>(0);
   auto file_name = input.GetSourceInfo();
 
+  // The cached samples are not decoded at all - with `skip_cached_images`, the reader
+  // doesn't even provide the encoded data for them
+  if (IsCacheEnabled()) {
+    auto cached_shape = CacheImageShape(file_name);
+    if (volume(cached_shape) > 0) {
+      output.Resize(cached_shape, DALI_UINT8);
+      output.SetLayout("HWC");
+      if (CacheLoad(file_name, output.mutable_data<uint8_t>(), 0))
+        return;
+    }
+  }
+
   // Verify input
   DALI_ENFORCE(input.ndim() == 1,
                 "Input must be 1D encoded jpeg string.");
@@ -46,6 +58,7 @@ void HostDecoder::RunImpl(SampleWorkspace &ws) {
   output.SetLayout("HWC");
   auto *out_data = output.mutable_data<uint8_t>();
   std::memcpy(out_data, decoded.get(), volume(shape));
+  CacheStore(file_name, out_data, shape, 0);
 }
 
 DALI_REGISTER_OPERATOR(decoders__Image, HostDecoder, CPU);
@@ -19,15 +19,17 @@
 
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/operators/decoder/cache/cached_decoder_impl.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/util/crop_window.h"
 
 namespace dali {
 
-class HostDecoder : public Operator<CPUBackend> {
+class HostDecoder : public Operator<CPUBackend>, protected CachedDecoderImpl {
  public:
   explicit inline HostDecoder(const OpSpec &spec) :
       Operator<CPUBackend>(spec),
+      CachedDecoderImpl(spec, true),
       output_type_(spec.GetArgument<DALIImageType>("output_type")),
       use_fast_idct_(spec.GetArgument<bool>("use_fast_idct"))
   {}
@@ -40,6 +42,10 @@ class HostDecoder : public Operator<CPUBackend> {
     return false;
   }
 
+  bool SupportsSampleStreaming() const override {
+    return true;
+  }
+
   void RunImpl(SampleWorkspace &ws) override;
 
   virtual CropWindowGenerator GetCropWindowGenerator(int data_idx) const {
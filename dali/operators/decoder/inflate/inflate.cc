@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -34,6 +34,8 @@ must be specified. In that case, the ``shape`` must describe the shape of a sing
 (output) chunk. The number of the chunks will automatically be added as the outermost extent
 to the output tensors.
 
+The CPU operator decompresses the chunks in parallel, using the pipeline's thread pool.
+
 For example, the following snippet presents decompression of a video-like sequences.
 Each video sequence was deflated by, first, compressing each frame separately and then
 concatenating compressed frames from the corresponding sequences.::
@@ -69,7 +71,14 @@ in the input tensor and the first chunk starts at the beginning of the sample.)c
                                       nullptr, true)
     .AddOptionalArg(inflate::algArgName, R"code(Algorithm to be used to decode the data.
 
-Currently only ``LZ4`` is supported.)code",
+The supported values are:
+
+* ``LZ4`` - LZ4 block format (without the frame header),
+* ``zstd`` - Zstandard frames,
+* ``deflate`` - raw DEFLATE streams (RFC 1951), without zlib or gzip headers.
+
+The GPU operator supports only ``LZ4``. The algorithms available in the CPU operator depend
+on the build options of DALI.)code",
                     "LZ4")
     .AddOptionalArg(inflate::layoutArgName,
                     R"code(Layout of the output (inflated) chunk.
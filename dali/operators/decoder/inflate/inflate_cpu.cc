@@ -0,0 +1,253 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if LZ4_ENABLED
+#include <lz4.h>
+#endif
+#if ZSTD_ENABLED
+#include <zstd.h>
+#endif
+#if ZLIB_ENABLED
+#include <zlib.h>
+#endif
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/backend_tags.h"
+#include "dali/core/common.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/operators/decoder/inflate/inflate.h"
+#include "dali/operators/decoder/inflate/inflate_params.h"
+#include "dali/pipeline/data/types.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+namespace inflate {
+
+namespace {
+
+/*
+ * The functions below decompress a single chunk of `in_size` bytes into at most `out_size`
+ * bytes and return the number of bytes actually written.
+ * Just like in the GPU operator, if the chunk inflates to more than `out_size` bytes,
+ * the excess is discarded.
+ */
+
+#if LZ4_ENABLED
+size_t InflateLZ4(uint8_t *out, size_t out_size, const uint8_t *in, size_t in_size,
+                  int sample_idx) {
+  DALI_ENFORCE(in_size <= static_cast<size_t>(std::numeric_limits<int>::max()) &&
+               out_size <= static_cast<size_t>(std::numeric_limits<int>::max()),
+               make_string("The LZ4 chunks cannot exceed 2GB. Got a chunk of ", in_size,
+                           " bytes that inflates to ", out_size, " bytes for sample of idx ",
+                           sample_idx, "."));
+  int ret = LZ4_decompress_safe_partial(reinterpret_cast<const char *>(in),
+                                        reinterpret_cast<char *>(out), in_size, out_size,
+                                        out_size);
+  DALI_ENFORCE(ret >= 0, make_string("Failed to inflate LZ4 chunk of sample of idx ", sample_idx,
+                                     ". The data is malformed."));
+  return ret;
+}
+#endif
+
+#if ZSTD_ENABLED
+ZSTD_DCtx *ThreadZstdContext() {
+  // the contexts are reused across the chunks processed by a thread
+  static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx{
+      ZSTD_createDCtx(), ZSTD_freeDCtx};
+  DALI_ENFORCE(ctx != nullptr, "Failed to create zstd decompression context.");
+  return ctx.get();
+}
+
+size_t InflateZstd(uint8_t *out, size_t out_size, const uint8_t *in, size_t in_size,
+                   int sample_idx) {
+  ZSTD_DCtx *ctx = ThreadZstdContext();
+  ZSTD_DCtx_reset(ctx, ZSTD_reset_session_only);
+  ZSTD_inBuffer in_buf{in, in_size, 0};
+  ZSTD_outBuffer out_buf{out, out_size, 0};
+  for (;;) {
+    size_t in_pos = in_buf.pos, out_pos = out_buf.pos;
+    size_t ret = ZSTD_decompressStream(ctx, &out_buf, &in_buf);
+    DALI_ENFORCE(!ZSTD_isError(ret),
+                 make_string("Failed to inflate zstd chunk of sample of idx ", sample_idx, ": ",
+                             ZSTD_getErrorName(ret)));
+    if (out_buf.pos == out_buf.size)
+      break;
+    if (ret == 0 && in_buf.pos == in_buf.size)  // all the frames were decoded
+      break;
+    DALI_ENFORCE(in_buf.pos != in_pos || out_buf.pos != out_pos,
+                 make_string("Failed to inflate zstd chunk of sample of idx ", sample_idx,
+                             ". The data is truncated."));
+  }
+  return out_buf.pos;
+}
+#endif
+
+#if ZLIB_ENABLED
+class ZlibInflateStream {
+ public:
+  ZlibInflateStream() {
+    // negative window bits - raw deflate stream, without zlib/gzip headers
+    DALI_ENFORCE(inflateInit2(&stream_, -MAX_WBITS) == Z_OK,
+                 "Failed to initialize zlib inflate stream.");
+  }
+
+  ~ZlibInflateStream() {
+    inflateEnd(&stream_);
+  }
+
+  z_stream &get() {
+    inflateReset(&stream_);
+    return stream_;
+  }
+
+ private:
+  z_stream stream_{};
+};
+
+size_t InflateDeflate(uint8_t *out, size_t out_size, const uint8_t *in, size_t in_size,
+                      int sample_idx) {
+  DALI_ENFORCE(in_size <= std::numeric_limits<uInt>::max() &&
+               out_size <= std::numeric_limits<uInt>::max(),
+               make_string("The deflate chunks cannot exceed 4GB. Got a chunk of ", in_size,
+                           " bytes that inflates to ", out_size, " bytes for sample of idx ",
+                           sample_idx, "."));
+  static thread_local ZlibInflateStream thread_stream;
+  z_stream &stream = thread_stream.get();
+  stream.next_in = const_cast<Bytef *>(in);
+  stream.avail_in = in_size;
+  stream.next_out = out;
+  stream.avail_out = out_size;
+  int ret;
+  do {
+    ret = ::inflate(&stream, Z_NO_FLUSH);
+  } while (ret == Z_OK && stream.avail_out > 0 && stream.avail_in > 0);
+  DALI_ENFORCE(ret == Z_STREAM_END || stream.avail_out == 0,
+               make_string("Failed to inflate deflate chunk of sample of idx ", sample_idx, ": ",
+                           stream.msg ? stream.msg : "the data is truncated or malformed."));
+  return out_size - stream.avail_out;
+}
+#endif
+
+bool IsSupportedOnCpu(InflateAlg alg) {
+  switch (alg) {
+    case InflateAlg::LZ4:
+      return LZ4_ENABLED;
+    case InflateAlg::Zstd:
+      return ZSTD_ENABLED;
+    case InflateAlg::Deflate:
+      return ZLIB_ENABLED;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+class InflateOpCpuImpl : public InflateOpImplBase<CPUBackend> {
+ public:
+  InflateOpCpuImpl(const OpSpec &spec, InflateAlg alg)
+      : InflateOpImplBase<CPUBackend>{spec}, alg_{alg} {}
+
+  void RunImpl(Workspace &ws) override {
+    const auto &input = ws.template Input<CPUBackend>(0);
+    auto &output = ws.template Output<CPUBackend>(0);
+    output.SetLayout(params_.GetOutputLayout());
+    auto &tp = ws.GetThreadPool();
+    const auto &out_shape = output.shape();
+    const auto &num_chunks_per_sample = params_.GetChunksNumPerSample();
+    const auto &offsets = params_.GetInChunkOffsets();
+    const auto &sizes = params_.GetInChunkSizes();
+    size_t type_size = output.type_info().size();
+    int batch_size = out_shape.num_samples();
+    // Each chunk is decompressed as a separate task, so that the chunks of a single long
+    // sequence are not processed serially by a single thread
+    for (int64_t sample_idx = 0, chunk_flat_idx = 0; sample_idx < batch_size; sample_idx++) {
+      auto num_chunks = num_chunks_per_sample[sample_idx].num_elements();
+      if (num_chunks == 0) {
+        continue;
+      }
+      const uint8_t *sample_in = static_cast<const uint8_t *>(input.raw_tensor(sample_idx));
+      uint8_t *sample_out = static_cast<uint8_t *>(output.raw_mutable_tensor(sample_idx));
+      size_t out_chunk_size = volume(out_shape[sample_idx]) / num_chunks * type_size;
+      for (int chunk_idx = 0; chunk_idx < num_chunks; chunk_idx++, chunk_flat_idx++) {
+        if (out_chunk_size == 0) {
+          continue;
+        }
+        const uint8_t *in = sample_in + offsets[chunk_flat_idx];
+        size_t in_size = sizes[chunk_flat_idx];
+        uint8_t *out = sample_out + chunk_idx * out_chunk_size;
+        tp.AddWork([this, out, out_chunk_size, in, in_size, sample_idx](int) {
+          InflateChunk(out, out_chunk_size, in, in_size, sample_idx);
+        }, out_chunk_size);
+      }
+    }
+    tp.RunAll();
+  }
+
+ private:
+  void InflateChunk(uint8_t *out, size_t out_size, const uint8_t *in, size_t in_size,
+                    int sample_idx) {
+    size_t inflated_size = 0;
+    switch (alg_) {
+#if LZ4_ENABLED
+      case InflateAlg::LZ4:
+        inflated_size = InflateLZ4(out, out_size, in, in_size, sample_idx);
+        break;
+#endif
+#if ZSTD_ENABLED
+      case InflateAlg::Zstd:
+        inflated_size = InflateZstd(out, out_size, in, in_size, sample_idx);
+        break;
+#endif
+#if ZLIB_ENABLED
+      case InflateAlg::Deflate:
+        inflated_size = InflateDeflate(out, out_size, in, in_size, sample_idx);
+        break;
+#endif
+      default:
+        DALI_FAIL(make_string("Algorithm `", to_string(alg_),
+                              "` is not supported by the CPU inflate operator."));
+    }
+    // If the chunk inflates to less than reported by the user, fill the rest
+    // of the output with 0s rather than leave it uninitialized
+    if (inflated_size < out_size) {
+      std::memset(out + inflated_size, 0, out_size - inflated_size);
+    }
+  }
+
+  InflateAlg alg_;
+};
+
+}  // namespace inflate
+
+template <>
+void Inflate<CPUBackend>::SetupOpImpl() {
+  if (!impl_) {
+    DALI_ENFORCE(inflate::IsSupportedOnCpu(alg_),
+                 make_string("Algorithm `", to_string(alg_),
+                             "` is not supported by the CPU inflate operator in this build "
+                             "of DALI."));
+    impl_ = std::make_unique<inflate::InflateOpCpuImpl>(spec_, alg_);
+  }
+}
+
+DALI_REGISTER_OPERATOR(experimental__Inflate, Inflate<CPUBackend>, CPU);
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -38,13 +38,19 @@ constexpr static const char *layoutArgName = "layout";
 constexpr static const char *sequenceLayoutArgName = "sequence_axis_name";
 
 enum class InflateAlg {
-  LZ4
+  LZ4,
+  Zstd,
+  Deflate
 };
 
 inline std::string to_string(InflateAlg alg) {
   switch (alg) {
     case InflateAlg::LZ4:
       return "LZ4";
+    case InflateAlg::Zstd:
+      return "zstd";
+    case InflateAlg::Deflate:
+      return "deflate";
     default:
       return "<unknown>";
   }
@@ -55,6 +61,12 @@ inline InflateAlg parse_inflate_alg(std::string str) {
   if (str == "lz4") {
     return InflateAlg::LZ4;
   }
+  if (str == "zstd") {
+    return InflateAlg::Zstd;
+  }
+  if (str == "deflate") {
+    return InflateAlg::Deflate;
+  }
   DALI_FAIL(make_string("Unknown inflate algorithm \"", str, "\"."));
 }
 
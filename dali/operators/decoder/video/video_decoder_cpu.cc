@@ -23,12 +23,18 @@ bool VideoDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc,
   int batch_size = input.num_samples();
   frames_decoders_.resize(batch_size);
   auto &thread_pool = ws.GetThreadPool();
+  // Each video is decoded by one task, so the codec threads are only useful when there are
+  // fewer videos than the threads in the pool
+  int codec_threads = codec_threads_ > 0
+      ? codec_threads_
+      : CodecThreadsPerDecoder(thread_pool.NumThreads(), batch_size, batch_size);
   for (int i = 0; i < batch_size; ++i) {
     auto sample = input[i];
     auto data = reinterpret_cast<const char *>(sample.data<uint8_t>());
     size_t size = sample.shape().num_elements();
-    thread_pool.AddWork([this, i, data, size](int tid) {
-      frames_decoders_[i] = std::make_unique<FramesDecoder>(data, size, false);
+    thread_pool.AddWork([this, i, data, size, codec_threads](int tid) {
+      frames_decoders_[i] = std::make_unique<FramesDecoder>(data, size, false, true, -1,
+                                                            codec_threads);
     });
   }
   thread_pool.RunAll();
@@ -65,7 +71,15 @@ The video streams can be in most of the container file formats. FFmpeg is used t
     R"code(Applies only to the mixed backend type.
 
 If set to True, each thread in the internal thread pool will be tied to a specific CPU core.
- Otherwise, the threads can be reassigned to any CPU core by the operating system.)code", true);
+ Otherwise, the threads can be reassigned to any CPU core by the operating system.)code", true)
+    .AddOptionalArg("codec_threads",
+    R"code(Applies only to the CPU backend type.
+
+Number of threads used by each FFmpeg decoder, in addition to decoding different samples
+ concurrently on the pipeline's thread pool.
+
+If set to 0, the pipeline's threads are split between the two levels automatically: the decoders
+ get more threads when there are fewer samples than the pipeline's threads.)code", 0);
 
 DALI_REGISTER_OPERATOR(experimental__decoders__Video, VideoDecoderCpu, CPU);
 
@@ -28,7 +28,11 @@ class VideoDecoderCpu
   using VideoDecoderBase::DecodeSample;
 
  public:
-  explicit VideoDecoderCpu(const OpSpec &spec) : Operator<CPUBackend>(spec) {}
+  explicit VideoDecoderCpu(const OpSpec &spec)
+      : Operator<CPUBackend>(spec), codec_threads_(spec.GetArgument<int>("codec_threads")) {
+    DALI_ENFORCE(codec_threads_ >= 0,
+                 make_string("``codec_threads`` must not be negative, got ", codec_threads_, "."));
+  }
 
 
   bool CanInferOutputs() const override {
@@ -39,6 +43,10 @@ class VideoDecoderCpu
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override;
 
   void RunImpl(Workspace &ws) override;
+
+ private:
+  // 0 means that the number of codec threads is chosen automatically
+  int codec_threads_;
 };
 
 }   // namespace dali
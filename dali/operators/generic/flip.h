@@ -17,6 +17,7 @@
 
 #include <vector>
 #include <string>
+#include <type_traits>
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
@@ -44,6 +45,10 @@ class Flip: public StatelessOperator<Backend> {
     return true;
   }
 
+  bool SupportsSampleStreaming() const override {
+    return std::is_same<Backend, CPUBackend>::value;
+  }
+
   void RunImpl(legacy_workspace_t<Backend> &ws) override;
 
   int GetHorizontal(const ArgumentWorkspace &ws, int idx) {
@@ -18,6 +18,7 @@
 #include <vector>
 #include <algorithm>
 
+#include "dali/kernels/common/split_shape.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/reduce/reduce_cpu.h"
 #include "dali/kernels/reduce/reduce_gpu.h"
@@ -92,19 +93,51 @@ class Reduce : public StatelessOperator<Backend>, AxesHelper {
     using Kernel = ReductionType<OutputType, InputType>;
     kmgr_.template Resize<Kernel>(num_threads);
 
+    // If the outermost dimension is not reduced, big samples can be split along it
+    // into independent reductions, so that small batches can use all the threads.
+    bool outer_dim_reduced = std::find(axes_.begin(), axes_.end(), 0) != axes_.end();
+    int64_t total_volume = in_view.num_elements();
+
     for (int sample = 0; sample < in_view.num_samples(); sample++) {
-      int64_t priority = volume(in_view.shape.tensor_shape_span(sample));
-      thread_pool.AddWork(
-        [&, sample](int thread_id) {
-          auto in_sample_view = in_view[sample];
-          auto out_sample_view = out_view[sample];
-          kernels::KernelContext ctx;
-
-          kmgr_.Setup<Kernel>(
-            thread_id, ctx, out_sample_view, in_sample_view, make_cspan(axes_));
-          kmgr_.Run<Kernel>(thread_id, ctx);
-        },
-        priority);
+      int64_t sample_volume = volume(in_view.shape.tensor_shape_span(sample));
+      int nblocks = 1;
+      if (!outer_dim_reduced && in_view.shape.sample_dim() > 0 &&
+          sample_volume > kMinBlockVolume) {
+        int64_t outer_extent = in_view.shape.tensor_shape_span(sample)[0];
+        nblocks = kernels::NumBlocksForSample(sample_volume, total_volume, num_threads);
+        nblocks = std::min<int64_t>(nblocks, outer_extent);
+      }
+      if (nblocks == 1) {
+        thread_pool.AddWork(
+          [&, sample](int thread_id) {
+            auto in_sample_view = in_view[sample];
+            auto out_sample_view = out_view[sample];
+            kernels::KernelContext ctx;
+
+            kmgr_.Setup<Kernel>(
+              thread_id, ctx, out_sample_view, in_sample_view, make_cspan(axes_));
+            kmgr_.Run<Kernel>(thread_id, ctx);
+          },
+          sample_volume);
+        continue;
+      }
+
+      int64_t outer_extent = in_view.shape.tensor_shape_span(sample)[0];
+      for (int b = 0; b < nblocks; b++) {
+        int64_t start = outer_extent * b / nblocks;
+        int64_t end = outer_extent * (b + 1) / nblocks;
+        thread_pool.AddWork(
+          [&, sample, start, end](int thread_id) {
+            auto in_block_view = SliceOuterDim(in_view[sample], start, end);
+            auto out_block_view = SliceOuterDim(out_view[sample], start, end);
+            kernels::KernelContext ctx;
+
+            kmgr_.Setup<Kernel>(
+              thread_id, ctx, out_block_view, in_block_view, make_cspan(axes_));
+            kmgr_.Run<Kernel>(thread_id, ctx);
+          },
+          sample_volume / outer_extent * (end - start));
+      }
     }
     thread_pool.RunAll();
   }
@@ -148,6 +181,20 @@ class Reduce : public StatelessOperator<Backend>, AxesHelper {
   DALIDataType output_type_ = DALI_NO_TYPE;
 
  private:
+  /**
+   * @brief Returns a view of the range [start, end) of the outermost dimension of the tensor
+   */
+  template <typename T, int ndim>
+  static TensorView<StorageCPU, T, ndim> SliceOuterDim(const TensorView<StorageCPU, T, ndim> &tv,
+                                                       int64_t start, int64_t end) {
+    auto shape = tv.shape;
+    int64_t outer_stride = shape[0] > 0 ? volume(shape) / shape[0] : 0;
+    shape[0] = end - start;
+    return { tv.data + start * outer_stride, shape };
+  }
+
+  static constexpr int64_t kMinBlockVolume = 16 << 10;
+
   USE_OPERATOR_MEMBERS();
   bool keep_dims_;
   kernels::KernelManager kmgr_;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include "dali/kernels/common/split_shape.h"
 #include "dali/kernels/transpose/transpose.h"
 #include "dali/core/static_switch.h"
 #include "dali/core/tensor_layout.h"
@@ -39,9 +40,17 @@ class TransposeCPU : public Transpose<CPUBackend> {
 
     auto out_shape = output.shape();
     int nsamples = out_shape.num_samples();
+    int num_threads = thread_pool.NumThreads();
+    int64_t total_volume = out_shape.num_elements();
 
     TYPE_SWITCH(input_type, type2id, T, TRANSPOSE_ALLOWED_TYPES, (
       for (int i = 0; i < nsamples; i++) {
+        int64_t sample_volume = out_shape.tensor_size(i);
+        int nblocks = kernels::NumBlocksForSample(sample_volume, total_volume, num_threads);
+        if (nblocks > 1 && sample_volume > kMinBlockVolume) {
+          ScheduleSampleBlocks<T>(thread_pool, output, input, i, nblocks);
+          continue;
+        }
         thread_pool.AddWork(
           [this, &input, &output, i](int thread_id) {
             TensorShape<> src_ts = input.shape()[i];
@@ -50,11 +59,41 @@ class TransposeCPU : public Transpose<CPUBackend> {
             kernels::TransposeGrouped(
                 TensorView<StorageCPU, T>{output.mutable_tensor<T>(i), dst_ts},
                 TensorView<StorageCPU, const T>{input.tensor<T>(i), src_ts}, make_cspan(perm_));
-          }, out_shape.tensor_size(i));
+          }, sample_volume);
       }
     ), DALI_FAIL(make_string("Unsupported input type: ", input_type)));  // NOLINT
     thread_pool.RunAll();
   }
+
+ private:
+  /**
+   * @brief Splits the transposition of a big sample into blocks of the output, so that
+   *        small batches of big samples can use all the threads.
+   */
+  template <typename T>
+  void ScheduleSampleBlocks(ThreadPool &thread_pool, TensorList<CPUBackend> &output,
+                            const TensorList<CPUBackend> &input, int sample_idx, int nblocks) {
+    TensorShape<> src_ts = input.shape()[sample_idx];
+    TensorShape<> collapsed_src_ts;
+    SmallVector<int, 6> collapsed_perm;
+    kernels::transpose_impl::SimplifyPermute(collapsed_src_ts, collapsed_perm, src_ts,
+                                             make_cspan(perm_));
+    auto collapsed_dst_ts = permute(collapsed_src_ts, collapsed_perm);
+    TensorView<StorageCPU, T> out_view{output.mutable_tensor<T>(sample_idx), collapsed_dst_ts};
+    TensorView<StorageCPU, const T> in_view{input.tensor<T>(sample_idx), collapsed_src_ts};
+
+    // keep the innermost dimension whole, so that the writes stay contiguous
+    int ndim = collapsed_dst_ts.sample_dim();
+    uint64_t skip_dim_mask = ndim > 1 ? (1_u64 << (ndim - 1)) : 0;
+    kernels::ScheduleBlocks(thread_pool, collapsed_dst_ts, nblocks, kMinBlockVolume,
+                            skip_dim_mask,
+      [out_view, in_view, collapsed_perm](int, const TensorShape<> &start,
+                                          const TensorShape<> &end) {
+        kernels::TransposeBlock(out_view, in_view, make_cspan(collapsed_perm), start, end);
+      });
+  }
+
+  static constexpr int kMinBlockVolume = 16 << 10;
 };
 
 DALI_REGISTER_OPERATOR(Transpose, TransposeCPU, CPU);
@@ -27,7 +27,8 @@ the output image. The transformation is described by ``mapx`` and ``mapy`` param
 
 The type of the output tensor will match the type of the input tensor.
 
-Handles only HWC layout.
+Handles only HWC layout. The CPU backend supports only ``INTERP_NN`` and ``INTERP_LINEAR``
+interpolation.
 
 Currently picking border policy is not supported.
 The ``DALIBorderType`` will always be ``CONSTANT`` with the value ``0``.
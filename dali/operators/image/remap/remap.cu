@@ -14,6 +14,7 @@
 
 #include "dali/operators/image/remap/remap.h"
 #include "dali/operators/image/remap/remap.cuh"
+#include "dali/kernels/imgproc/geom/remap_npp.h"
 #include "dali/kernels/kernel_manager.h"
 
 namespace dali {
@@ -19,7 +19,6 @@
 #include <string>
 #include "dali/core/cuda_stream_pool.h"
 #include "dali/kernels/imgproc/geom/remap.h"
-#include "dali/kernels/imgproc/geom/remap_npp.h"
 #include "dali/pipeline/data/views.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
@@ -0,0 +1,107 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include "dali/kernels/common/split_shape.h"
+#include "dali/kernels/imgproc/geom/remap_cpu.h"
+#include "dali/operators/image/remap/remap.h"
+
+namespace dali {
+namespace remap {
+
+class RemapCpu : public Remap<CPUBackend> {
+  using B = CPUBackend;
+
+ public:
+  explicit RemapCpu(const OpSpec &spec) : Remap<B>(spec) {}
+
+
+  void RunImpl(Workspace &ws) override {
+    const auto &input = ws.template Input<B>(0);
+    TYPE_SWITCH(input.type(), type2id, InputType, REMAP_SUPPORTED_TYPES, (
+    {
+      RunImplTyped<InputType>(ws);
+    }
+    ), DALI_FAIL(make_string("Unsupported input type: ", input.type())))  // NOLINT
+  }
+
+
+ private:
+  /**
+   * @brief Remaps the samples in ranges of rows, so that a few big images can still use
+   *        all the threads.
+   *
+   * Instead of shifting the maps, the pixel origin is passed to the kernel as an offset.
+   */
+  template<typename InputType>
+  void RunImplTyped(Workspace &ws) {
+    using Kernel = kernels::remap::CpuRemapKernel<InputType>;
+    const auto &input = ws.template Input<B>(0);
+    const auto &mapx = ws.template Input<B>(1);
+    const auto &mapy = ws.template Input<B>(2);
+    auto &output = ws.template Output<B>(0);
+    output.SetLayout(input.GetLayout());
+    auto in_view = view<const InputType, 3>(input);
+    auto out_view = view<InputType, 3>(output);
+    auto &thread_pool = ws.GetThreadPool();
+    int num_threads = thread_pool.NumThreads();
+    int64_t total_volume = in_view.num_elements();
+
+    for (int s = 0; s < in_view.num_samples(); s++) {
+      auto in_sample = in_view[s];
+      auto out_sample = out_view[s];
+      auto map_shape = mapx.tensor_shape(s);
+      DALI_ENFORCE(map_shape == mapy.tensor_shape(s),
+                   make_string("The shapes of mapx and mapy do not match. mapx: ", map_shape,
+                               " ; mapy: ", mapy.tensor_shape(s), "."));
+      DALI_ENFORCE(map_shape.sample_dim() >= 2 && map_shape[0] == in_sample.shape[0] &&
+                   map_shape[1] == in_sample.shape[1] && volume(map_shape) ==
+                   map_shape[0] * map_shape[1],
+                   make_string("The maps must have the same height and width as the input and "
+                               "a single channel. Got input of shape ", in_sample.shape,
+                               " and maps of shape ", map_shape, "."));
+      TensorShape<2> map_shape_2d{map_shape[0], map_shape[1]};
+      kernels::InTensorCPU<float, 2> mapx_sample(mapx.template tensor<float>(s), map_shape_2d);
+      kernels::InTensorCPU<float, 2> mapy_sample(mapy.template tensor<float>(s), map_shape_2d);
+
+      int height = in_sample.shape[0];
+      int64_t sample_volume = in_sample.num_elements();
+      if (sample_volume == 0)
+        continue;
+      int nblocks = kernels::NumBlocksForSample(sample_volume, total_volume, num_threads);
+      nblocks = std::max(1, std::min(nblocks, height / kMinRowsPerBlock));
+      int64_t cost_per_row = sample_volume / height;
+      auto interp = interps_[s];
+      float map_offset = shift_value_;
+      for (int b = 0; b < nblocks; b++) {
+        int row_begin = static_cast<int64_t>(height) * b / nblocks;
+        int row_end = static_cast<int64_t>(height) * (b + 1) / nblocks;
+        thread_pool.AddWork([=](int) {
+          Kernel::RunSample(out_sample, in_sample, mapx_sample, mapy_sample, {}, {}, interp,
+                            {boundary::BoundaryType::CONSTANT, 0}, row_begin, row_end,
+                            map_offset);
+        }, (row_end - row_begin) * cost_per_row);
+      }
+    }
+    thread_pool.RunAll();
+  }
+
+  /// Below that, the tasks are too short to be worth scheduling separately
+  static constexpr int kMinRowsPerBlock = 16;
+};
+
+DALI_REGISTER_OPERATOR(experimental__Remap, RemapCpu, CPU);
+
+}  // namespace remap
+}  // namespace dali
@@ -221,6 +221,10 @@ class ResizeCropMirror : public Operator<CPUBackend>, protected ResizeCropMirror
     return false;
   }
 
+  bool SupportsSampleStreaming() const override {
+    return true;
+  }
+
   inline void SetupSharedSampleParams(SampleWorkspace &ws) override {
     per_thread_meta_[ws.thread_idx()] = GetTransfomMeta(&ws, spec_);
   }
@@ -163,7 +163,25 @@ Values will be converted to the dynamic range of the requested type.)code",
       DALI_UINT8)
   .AddOptionalArg("adjust_orientation",
       R"code(Use EXIF orientation metadata to rectify the images)code",
-      true);
+      true)
+  .AddOptionalArg<std::vector<int>>("hint_size",
+      R"code(Applies **only** to the ``cpu`` backend type.
+
+The minimum size of the decoded images, as (height, width) or a single value for both.
+
+If set, JPEG images are decoded at a reduced resolution (1/2, 1/4 or 1/8 of the original
+size, using the DCT scaling of *libjpeg-turbo*), as long as they remain at least this large.
+This saves decoding time and memory when the images are resized to a much smaller size
+afterwards - for example, when followed by ``resize(resize_shorter=224)``, ``hint_size`` can
+be set to 224.
+
+The regions of interest of the cropping decoders are calculated in the coordinates of the
+downscaled image.
+
+.. note::
+  The output shape depends on the hint, so the decoded images can be smaller than the original
+  ones. Other image formats are decoded at the full resolution.)code",
+      nullptr);
 
 DALI_SCHEMA(experimental__decoders__Image)
   .DocStr(R"code(Decodes images.
@@ -42,9 +42,22 @@ class DecoderBase : public Operator<Backend> {
     opts_.format = spec.GetArgument<DALIImageType>("output_type");
     opts_.dtype = spec.GetArgument<DALIDataType>("dtype");
     opts_.use_orientation = spec.GetArgument<bool>("adjust_orientation");
+    GetHintSize(spec);
     GetDecoderSpecificArguments(spec);
   }
 
+  void GetHintSize(const OpSpec &spec) {
+    std::vector<int> hint_size;
+    if (!spec.TryGetRepeatedArgument(hint_size, "hint_size"))
+      return;
+    DALI_ENFORCE(hint_size.size() == 1 || hint_size.size() == 2, make_string(
+      "``hint_size`` must have 1 or 2 elements, got ", hint_size.size(), "."));
+    DALI_ENFORCE(hint_size[0] > 0 && hint_size.back() > 0, "``hint_size`` must be positive.");
+    // only the host decoders can reduce the resolution while decoding
+    if (std::is_same<Backend, CPUBackend>::value)
+      opts_.hint_size = {hint_size[0], hint_size.back()};
+  }
+
   virtual void SetupRoiGenerator(const OpSpec &spec, const Workspace &ws) {}
 
   virtual ROI GetRoi(const OpSpec &spec, const Workspace &ws, std::size_t data_idx,
@@ -105,6 +118,7 @@ class DecoderBase : public Operator<Backend> {
         srcs_[i] = SampleAsImageSource(input[i], input.GetMeta(i).GetSourceInfo());
         src_ptrs_[i] = &srcs_[i];
         auto info = decoder->GetInfo(src_ptrs_[i]);
+        info = ScaledImageInfo(info, DecodeScale(src_ptrs_[i], info, this->opts_));
         ROI roi = GetRoi(spec, ws, i, info.shape);
         rois_[i] = roi;
         OutputShape(shapes.tensor_shape_span(i), info, this->opts_, roi);
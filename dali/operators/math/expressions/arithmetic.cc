@@ -22,10 +22,29 @@ namespace expr {
 
 template <>
 void ArithmeticGenericOp<CPUBackend>::RunImpl(Workspace &ws) {
-  PrepareSamplesPerTask<CPUBackend>(samples_per_task_, exec_order_, ws, constant_storage_, spec_);
   auto &pool = ws.GetThreadPool();
   ws.Output<CPUBackend>(0).SetLayout(result_layout_);
 
+  if (fused_) {
+    fused_expr_.PrepareSamples(ws, constant_storage_, pool.NumThreads());
+    // The broadcasting is handled per element, so the samples can always be split into tiles
+    std::tie(tile_cover_, tile_range_) = GetTiledCover(result_shape_, kTileSize, kTaskSize);
+    for (size_t task_idx = 0; task_idx < tile_range_.size(); task_idx++) {
+      pool.AddWork(
+          [=](int thread_idx) {
+            auto range = tile_range_[task_idx];
+            for (int extent_idx = range.begin; extent_idx < range.end; extent_idx++) {
+              fused_expr_.Execute(tile_cover_[extent_idx], thread_idx);
+            }
+          },
+          -task_idx);
+    }
+    pool.RunAll();
+    return;
+  }
+
+  PrepareSamplesPerTask<CPUBackend>(samples_per_task_, exec_order_, ws, constant_storage_, spec_);
+
   int ndim = 1;
   for (const auto &samples : samples_per_task_) {
     for (const auto &sample : samples) {
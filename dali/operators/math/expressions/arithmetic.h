@@ -31,6 +31,7 @@
 #include "dali/operators/math/expressions/broadcasting.h"
 #include "dali/operators/math/expressions/arithmetic_meta.h"
 #include "dali/operators/math/expressions/expression_impl_factory.h"
+#include "dali/operators/math/expressions/fused_expression_cpu.h"
 #include "dali/pipeline/operator/checkpointing/stateless_operator.h"
 
 namespace dali {
@@ -295,6 +296,23 @@ inline void CheckArithmeticOnBooleans(ExprFunc &func) {
   }
 }
 
+/**
+ * @brief Checks if the expression consists of one function node with tensor or constant inputs
+ */
+inline bool IsSimpleExpression(const ExprNode &expr) {
+  if (expr.GetNodeType() != NodeType::Function || expr.GetSubexpressionCount() == 0 ||
+      expr.GetSubexpressionCount() > kMaxArity) {
+    return false;
+  }
+  auto &func = dynamic_cast<const ExprFunc &>(expr);
+  for (int i = 0; i < func.GetSubexpressionCount(); i++) {
+    if (func[i].GetNodeType() == NodeType::Function) {
+      return false;
+    }
+  }
+  return true;
+}
+
 inline void CheckAllowedOperations(ExprNode &expr) {
   if (expr.GetNodeType() == NodeType::Constant) {
     return;
@@ -314,7 +332,9 @@ inline void CheckAllowedOperations(ExprNode &expr) {
  * @brief Arithmetic operator capable of executing expression tree of element-wise
  *        arithmetic operations.
  *
- * Only expressions consisting of one function node with tensor inputs are now supported.
+ * On the GPU, only expressions consisting of one function node with tensor inputs are now
+ * supported. On the CPU, the whole expression tree is evaluated in a single pass over the output
+ * (see FusedExpressionCpu), without materializing the intermediate results.
  *
  * There are 3 levels for unit of work.
  * - Thread (CPUBackend) or CUDA kernel invokation (GPUBackend)
@@ -370,8 +390,16 @@ class ArithmeticGenericOp : public StatelessOperator<Backend> {
       types_layout_inferred_ = true;
     }
 
-    AllocateIntermediateNodes();
-    exec_order_ = CreateExecutionTasks<Backend>(*expr_, cache_, ws.has_stream() ? ws.stream() : 0);
+    fused_ = !IsSimpleExpression(*expr_);
+    if (fused_) {
+      DALI_ENFORCE((std::is_same<Backend, CPUBackend>::value),
+                   "Complex expression trees are not yet supported on the GPU. Only expressions "
+                   "containing one function node with tensor or constant inputs are supported.");
+      fused_expr_.Compile(*expr_, cache_);
+    } else {
+      exec_order_ =
+          CreateExecutionTasks<Backend>(*expr_, cache_, ws.has_stream() ? ws.stream() : 0);
+    }
 
     output_desc[0] = {result_shape_, result_type_id_};
     return true;
@@ -381,22 +409,6 @@ class ArithmeticGenericOp : public StatelessOperator<Backend> {
   void RunImpl(Workspace &ws) override;
 
  private:
-  void AllocateIntermediateNodes() {
-    auto &expr = *expr_;
-    bool is_simple_expression = expr.GetNodeType() == NodeType::Function &&
-                                expr.GetSubexpressionCount() > 0 &&
-                                expr.GetSubexpressionCount() <= kMaxArity;
-    auto &func = dynamic_cast<ExprFunc &>(expr);
-    for (int i = 0; i < func.GetSubexpressionCount(); i++) {
-      is_simple_expression = is_simple_expression && func[i].GetNodeType() != NodeType::Function;
-    }
-
-    DALI_ENFORCE(is_simple_expression,
-                 "Complex expression trees are not yet supported. Only expressions containing one "
-                 "function node with one or two inputs are supported.");
-    // TODO(klecki): allocate memory for intermediate results and point the threads to them
-  }
-
   std::unique_ptr<ExprNode> expr_;
   TensorListShape<> result_shape_;
   bool types_layout_inferred_ = false;
@@ -408,6 +420,9 @@ class ArithmeticGenericOp : public StatelessOperator<Backend> {
   std::vector<std::vector<SampleDesc>> samples_per_task_;
   ConstantStorage<Backend> constant_storage_;
   ExprImplCache cache_;
+  // Used (only on the CPU) for expressions with more than one function node
+  bool fused_ = false;
+  FusedExpressionCpu fused_expr_;
   // For CPU we limit the tile size to limit the sizes of intermediate buffers
   // For GPU it's better to execute more at one time.
   static constexpr int kTileSize =
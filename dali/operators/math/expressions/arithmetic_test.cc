@@ -798,5 +798,83 @@ TEST(ArithmeticOpsTest, UnaryPipeline) {
   }
 }
 
+TEST(ArithmeticOpsTest, FusedPipeline) {
+  constexpr int batch_size = 6;
+  constexpr int num_threads = 3;
+  constexpr int width = 33;
+  constexpr int channels = 3;
+  constexpr float scale = 255.0f;
+  constexpr int multiplier = 2;
+  Pipeline pipe(batch_size, num_threads, 0);
+
+  pipe.AddExternalInput("image");
+  pipe.AddExternalInput("mean");
+  pipe.AddExternalInput("stddev");
+  pipe.AddExternalInput("offset");
+
+  // (image - mean) / stddev * scale + offset * multiplier, with a scalar-like subexpression
+  pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                       .AddArg("device", "cpu")
+                       .AddArg("expression_desc",
+                               "add(mul(div(sub(&0 &1) &2) $0:float32) mul(&3 $0:int32))")
+                       .AddArg("real_constants", std::vector<float>{scale})
+                       .AddArg("integer_constants", std::vector<int>{multiplier})
+                       .AddInput("image", "cpu")
+                       .AddInput("mean", "cpu")
+                       .AddInput("stddev", "cpu")
+                       .AddInput("offset", "cpu")
+                       .AddOutput("result", "cpu"),
+                   "arithm_cpu_fused");
+
+  vector<std::pair<string, string>> outputs = {{"result", "cpu"}};
+  pipe.Build(outputs);
+
+  // The samples span multiple tiles and their sizes are not multiples of the vector width
+  TensorListShape<> image_shape(batch_size, 3);
+  for (int i = 0; i < batch_size; i++) {
+    image_shape.set_tensor_shape(i, {50 + 7 * i, width, channels});
+  }
+  TensorList<CPUBackend> image, mean, stddev, offset;
+  image.Resize(image_shape, DALI_UINT8);
+  mean.Resize(uniform_list_shape(batch_size, {channels}), DALI_FLOAT);
+  stddev.Resize(uniform_list_shape(batch_size, {channels}), DALI_FLOAT);
+  offset.Resize(uniform_list_shape(batch_size, TensorShape<>{}), DALI_INT32);
+  for (int i = 0; i < batch_size; i++) {
+    auto *img = image.mutable_tensor<uint8_t>(i);
+    for (int64_t j = 0; j < image_shape[i].num_elements(); j++) {
+      img[j] = (j * 7 + i) % 256;
+    }
+    for (int c = 0; c < channels; c++) {
+      mean.mutable_tensor<float>(i)[c] = 100.0f + 10 * c + i;
+      stddev.mutable_tensor<float>(i)[c] = 50.0f + 3 * c;
+    }
+    *offset.mutable_tensor<int32_t>(i) = i - 3;
+  }
+
+  pipe.SetExternalInput("image", image);
+  pipe.SetExternalInput("mean", mean);
+  pipe.SetExternalInput("stddev", stddev);
+  pipe.SetExternalInput("offset", offset);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  Workspace ws;
+  pipe.Outputs(&ws);
+  auto &result = ws.Output<CPUBackend>(0);
+  ASSERT_EQ(result.type(), DALI_FLOAT);
+  ASSERT_EQ(result.shape(), image_shape);
+
+  for (int i = 0; i < batch_size; i++) {
+    const auto *img = image.tensor<uint8_t>(i);
+    const auto *m = mean.tensor<float>(i);
+    const auto *sd = stddev.tensor<float>(i);
+    float off = *offset.tensor<int32_t>(i) * multiplier;
+    const auto *out = result.tensor<float>(i);
+    for (int64_t j = 0; j < image_shape[i].num_elements(); j++) {
+      int c = j % channels;
+      ASSERT_EQ(out[j], (img[j] - m[c]) / sd[c] * scale + off) << "sample " << i << " at " << j;
+    }
+  }
+}
+
 }  // namespace expr
 }  // namespace dali
@@ -15,8 +15,11 @@
 #ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_H_
 #define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_CPU_H_
 
+#include <type_traits>
 #include <vector>
 
+#include "dali/core/force_inline.h"
+#include "dali/kernels/common/simd.h"
 #include "dali/pipeline/data/types.h"
 #include "dali/operators/math/expressions/arithmetic_meta.h"
 #include "dali/operators/math/expressions/expression_impl_factory.h"
@@ -28,6 +31,125 @@
 namespace dali {
 namespace expr {
 
+namespace expression_detail {
+
+#ifdef __SSE2__
+
+/**
+ * @brief Single precision SSE implementation of a binary op; `value` is false if there's none.
+ *
+ * The vectorized implementation must give exactly the same results as the scalar one.
+ */
+template <ArithmeticOp op>
+struct simd_op : std::false_type {};
+
+template <>
+struct simd_op<ArithmeticOp::add> : std::true_type {
+  static DALI_FORCEINLINE __m128 apply(__m128 l, __m128 r) { return _mm_add_ps(l, r); }
+};
+
+template <>
+struct simd_op<ArithmeticOp::sub> : std::true_type {
+  static DALI_FORCEINLINE __m128 apply(__m128 l, __m128 r) { return _mm_sub_ps(l, r); }
+};
+
+template <>
+struct simd_op<ArithmeticOp::mul> : std::true_type {
+  static DALI_FORCEINLINE __m128 apply(__m128 l, __m128 r) { return _mm_mul_ps(l, r); }
+};
+
+template <>
+struct simd_op<ArithmeticOp::div> : std::true_type {
+  static DALI_FORCEINLINE __m128 apply(__m128 l, __m128 r) { return _mm_div_ps(l, r); }
+};
+
+template <>
+struct simd_op<ArithmeticOp::fdiv> : std::true_type {
+  static DALI_FORCEINLINE __m128 apply(__m128 l, __m128 r) { return _mm_div_ps(l, r); }
+};
+
+// _mm_min_ps and _mm_max_ps return the second operand if either is NaN, just like
+// `l < r ? l : r` and `l > r ? l : r`
+template <>
+struct simd_op<ArithmeticOp::min> : std::true_type {
+  static DALI_FORCEINLINE __m128 apply(__m128 l, __m128 r) { return _mm_min_ps(l, r); }
+};
+
+template <>
+struct simd_op<ArithmeticOp::max> : std::true_type {
+  static DALI_FORCEINLINE __m128 apply(__m128 l, __m128 r) { return _mm_max_ps(l, r); }
+};
+
+/**
+ * @brief Types which can be loaded and exactly converted to float with kernels::simd::multivec
+ */
+template <typename T>
+constexpr bool is_simd_loadable_v =
+    std::is_same<T, float>::value || std::is_same<T, int32_t>::value ||
+    std::is_same<T, int16_t>::value || std::is_same<T, uint16_t>::value ||
+    std::is_same<T, int8_t>::value || std::is_same<T, uint8_t>::value;
+
+template <ArithmeticOp op, typename Result, typename Left, typename Right>
+constexpr bool can_use_simd_v = std::is_same<Result, float>::value && simd_op<op>::value &&
+                                is_simd_loadable_v<Left> && is_simd_loadable_v<Right>;
+
+constexpr int kSimdVecs = 4;
+constexpr int kSimdLanes = kSimdVecs * 4;
+using simd_vec = kernels::simd::multivec<kSimdVecs>;
+
+template <typename T>
+DALI_FORCEINLINE const T *SimdOperand(const T *tensor) {
+  return tensor;
+}
+
+template <typename T>
+DALI_FORCEINLINE simd_vec SimdOperand(T scalar) {
+  simd_vec m;
+  for (int i = 0; i < kSimdVecs; i++)
+    m.v[i] = _mm_set1_ps(static_cast<float>(scalar));
+  return m;
+}
+
+template <typename T>
+DALI_FORCEINLINE simd_vec SimdLoad(const T *tensor, int64_t idx) {
+  return simd_vec::load(tensor + idx);
+}
+
+DALI_FORCEINLINE simd_vec SimdLoad(const simd_vec &scalar, int64_t) {
+  return scalar;
+}
+
+#endif  // __SSE2__
+
+template <typename T>
+using operand_value_t = std::remove_cv_t<std::remove_pointer_t<T>>;
+
+/**
+ * @brief Evaluates the binary op with SSE for as many whole vectors as fit in [offset, end)
+ *        and returns the index of the first element left for the scalar loop.
+ *
+ * The operands are either pointers to tensors or scalar values.
+ */
+template <ArithmeticOp op, typename Result, typename Left, typename Right>
+DALI_FORCEINLINE int64_t ExecuteSimd(Result *result, Left l, Right r,
+                                     int64_t offset, int64_t end) {
+#ifdef __SSE2__
+  if constexpr (can_use_simd_v<op, Result, operand_value_t<Left>, operand_value_t<Right>>) {
+    auto l_op = SimdOperand(l);
+    auto r_op = SimdOperand(r);
+    for (; offset + kSimdLanes <= end; offset += kSimdLanes) {
+      simd_vec l_vec = SimdLoad(l_op, offset);
+      simd_vec r_vec = SimdLoad(r_op, offset);
+      for (int i = 0; i < kSimdVecs; i++)
+        _mm_storeu_ps(result + offset + 4 * i, simd_op<op>::apply(l_vec.v[i], r_vec.v[i]));
+    }
+  }
+#endif  // __SSE2__
+  return offset;
+}
+
+}  // namespace expression_detail
+
 template <ArithmeticOp op, typename Result, typename Input>
 class ExprImplCpuT : public ExprImplBase {
  public:
@@ -91,7 +213,8 @@ class ExprImplCpuTT : public ExprImplBase {
   static void Execute(Result *result, const Left *l, const Right *r,
                       int64_t offset, int64_t extent) {
     int64_t end = offset + extent;
-    for (int64_t i = offset; i < end; i++) {
+    int64_t i = expression_detail::ExecuteSimd<op>(result, l, r, offset, end);
+    for (; i < end; i++) {
       result[i] = meta_t::impl(l[i], r[i]);
     }
   }
@@ -158,7 +281,8 @@ class ExprImplCpuCT : public ExprImplBase {
 
   static void Execute(Result *result, Left l, const Right *r, int64_t offset, int64_t extent) {
     int64_t end = offset + extent;
-    for (int64_t i = offset; i < end; i++) {
+    int64_t i = expression_detail::ExecuteSimd<op>(result, l, r, offset, end);
+    for (; i < end; i++) {
       result[i] = meta_t::impl(l, r[i]);
     }
   }
@@ -185,7 +309,8 @@ class ExprImplCpuTC : public ExprImplBase {
 
   static void Execute(Result *result, const Left *l, Right r, int64_t offset, int64_t extent) {
     int64_t end = offset + extent;
-    for (int64_t i = offset; i < end; i++) {
+    int64_t i = expression_detail::ExecuteSimd<op>(result, l, r, offset, end);
+    for (; i < end; i++) {
       result[i] = meta_t::impl(l[i], r);
     }
   }
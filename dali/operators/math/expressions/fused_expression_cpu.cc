@@ -0,0 +1,256 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/math/expressions/fused_expression_cpu.h"
+#include <algorithm>
+#include <utility>
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/common/type_erasure.h"
+#include "dali/kernels/common/utils.h"
+#include "dali/operators/math/expressions/broadcasting.h"
+
+namespace dali {
+namespace expr {
+
+namespace {
+
+/**
+ * @brief Copies the elements [start, start + n) of a broadcast tensor to a contiguous buffer
+ *
+ * @param shape   the output shape
+ * @param strides the strides of the input, 0 in the broadcast dimensions
+ */
+template <typename T>
+void GatherBroadcast(T *out, const T *in, const TensorShape<> &shape,
+                     const TensorShape<> &strides, int64_t start, int64_t n) {
+  int ndim = shape.sample_dim();
+  SmallVector<int64_t, 6> idx;
+  idx.resize(ndim);
+  int64_t in_offset = 0;
+  for (int d = ndim - 1; d >= 0; d--) {
+    idx[d] = start % shape[d];
+    start /= shape[d];
+    in_offset += idx[d] * strides[d];
+  }
+
+  int inner = ndim - 1;
+  int64_t inner_stride = strides[inner];
+  for (int64_t i = 0; i < n; ) {
+    int64_t count = std::min(n - i, shape[inner] - idx[inner]);
+    const T *src = in + in_offset;
+    if (inner_stride == 0) {
+      std::fill(out + i, out + i + count, *src);
+    } else {
+      for (int64_t j = 0; j < count; j++)
+        out[i + j] = src[j * inner_stride];
+    }
+    i += count;
+    idx[inner] += count;
+    in_offset += count * inner_stride;
+    for (int d = inner; d > 0 && idx[d] == shape[d]; d--) {
+      in_offset -= idx[d] * strides[d];
+      idx[d] = 0;
+      idx[d - 1]++;
+      in_offset += strides[d - 1];
+    }
+  }
+}
+
+}  // namespace
+
+void FusedExpressionCpu::Compile(const ExprNode &root, ExprImplCache &cache) {
+  nodes_.clear();
+  scratch_size_ = 0;
+  AddNode(root, cache);
+  // The root writes directly to the output - release its chunk buffer, allocated last
+  auto &root_node = nodes_.back();
+  if (root_node.scratch_offset >= 0) {
+    scratch_size_ = root_node.scratch_offset;
+    root_node.scratch_offset = -1;
+  }
+}
+
+int FusedExpressionCpu::AddNode(const ExprNode &expr, ExprImplCache &cache) {
+  Node node;
+  node.expr = &expr;
+  node.node_type = expr.GetNodeType();
+  node.dtype = expr.GetTypeId();
+  node.type_size = TypeTable::GetTypeInfo(node.dtype).size();
+  node.scalar_like = IsScalarLike(expr);
+  if (node.node_type == NodeType::Function) {
+    auto &func = dynamic_cast<const ExprFunc &>(expr);
+    for (int i = 0; i < func.GetSubexpressionCount(); i++)
+      node.args.push_back(AddNode(func[i], cache));
+    node.impl = cache.GetExprImpl<CPUBackend>(func);
+  }
+  // The subexpressions store their results in the scratch memory; the tensor inputs
+  // may need it for gathering the broadcast values.
+  bool needs_scratch = node.node_type == NodeType::Function ||
+                       (node.node_type == NodeType::Tensor && !node.scalar_like);
+  if (needs_scratch) {
+    node.scratch_offset = scratch_size_;
+    scratch_size_ += align_up(kChunkSize * node.type_size, 64);
+  }
+  nodes_.push_back(std::move(node));
+  return nodes_.size() - 1;
+}
+
+void FusedExpressionCpu::PrepareSamples(Workspace &ws,
+                                        const ConstantStorage<CPUBackend> &constants,
+                                        int num_threads) {
+  auto &out = ws.Output<CPUBackend>(0);
+  int nsamples = out.num_samples();
+  int nnodes = nodes_.size();
+  outputs_.resize(nsamples);
+  leaves_.clear();
+  leaves_.resize(nsamples * nnodes);
+
+  std::vector<TensorShape<>> leaf_shapes(nnodes);
+  SmallVector<TensorShape<> *, 8> shapes;
+  for (int s = 0; s < nsamples; s++) {
+    auto &output = outputs_[s];
+    output.data = out.raw_mutable_tensor(s);
+    output.shape = out.tensor_shape(s);
+    shapes.clear();
+    shapes.push_back(&output.shape);
+    for (int i = 0; i < nnodes; i++) {
+      auto &node = nodes_[i];
+      auto &leaf = Leaf(s, i);
+      if (node.node_type == NodeType::Constant) {
+        auto &constant = dynamic_cast<const ExprConstant &>(*node.expr);
+        leaf.data = constants.GetPointer(constant.GetConstIndex(), constant.GetTypeId());
+      } else if (node.node_type == NodeType::Tensor) {
+        auto &tensor = dynamic_cast<const ExprTensor &>(*node.expr);
+        auto &in = ws.Input<CPUBackend>(tensor.GetInputIndex());
+        leaf.data = in.raw_tensor(s);
+        if (!node.scalar_like) {
+          leaf_shapes[i] = in.tensor_shape(s);
+          shapes.push_back(&leaf_shapes[i]);
+        }
+      }
+    }
+    if (volume(output.shape) == 0)
+      continue;
+
+    SimplifyShapesForBroadcasting(make_span(shapes));
+    int ndim = 1;
+    for (auto *shape : shapes)
+      ndim = std::max(ndim, shape->sample_dim());
+    ExpandToNDims(output.shape, ndim);
+    for (int i = 0; i < nnodes; i++) {
+      if (nodes_[i].node_type != NodeType::Tensor || nodes_[i].scalar_like)
+        continue;
+      auto &leaf = Leaf(s, i);
+      auto &shape = leaf_shapes[i];
+      ExpandToNDims(shape, ndim);
+      leaf.in_place = shape == output.shape;
+      if (!leaf.in_place) {
+        TensorShape<> strides;
+        kernels::CalcStrides(strides, shape);
+        leaf.strides = StridesForBroadcasting(output.shape, shape, strides);
+      }
+    }
+  }
+
+  thread_ctx_.resize(num_threads);
+  for (auto &ctx : thread_ctx_)
+    PrepareThreadContext(ctx);
+}
+
+void FusedExpressionCpu::PrepareThreadContext(ThreadContext &ctx) const {
+  int nnodes = nodes_.size();
+  ctx.scratch.resize(scratch_size_);
+  ctx.values.resize(nnodes);
+  ctx.descs.resize(nnodes);
+  for (int i = 0; i < nnodes; i++) {
+    auto &node = nodes_[i];
+    if (node.node_type != NodeType::Function)
+      continue;
+    // The implementations are given contiguous 1D operands; the number of elements
+    // to process is passed in the tile.
+    auto &desc = ctx.descs[i];
+    desc.output.dtype = node.dtype;
+    desc.output.shape = TensorShape<>(kChunkSize);
+    desc.output.strides = TensorShape<>(1);
+    desc.args.resize(node.args.size());
+    for (size_t a = 0; a < node.args.size(); a++) {
+      auto &arg = nodes_[node.args[a]];
+      desc.args[a].dtype = arg.dtype;
+      desc.args[a].shape = TensorShape<>(arg.scalar_like ? 1 : kChunkSize);
+      desc.args[a].strides = TensorShape<>(1);
+    }
+  }
+}
+
+void FusedExpressionCpu::GatherChunk(void *out, const Node &node, const LeafSample &leaf,
+                                     const OutputSample &output, int64_t start,
+                                     int64_t n) const {
+  VALUE_SWITCH(node.type_size, size, (1, 2, 4, 8), (
+    using T = kernels::type_of_size<size>;
+    GatherBroadcast(static_cast<T *>(out), static_cast<const T *>(leaf.data),
+                    output.shape, leaf.strides, start, n);
+  ), DALI_FAIL(make_string("Unexpected element size: ", node.type_size)));  // NOLINT
+}
+
+void FusedExpressionCpu::Execute(const TileDesc &tile, int thread_idx) {
+  auto &ctx = thread_ctx_[thread_idx];
+  auto &output = outputs_[tile.sample_idx];
+  int root = nodes_.size() - 1;
+  int64_t end = tile.offset + tile.size;
+  for (int64_t start = tile.offset; start < end; start += kChunkSize) {
+    int64_t n = std::min<int64_t>(kChunkSize, end - start);
+    // The nodes are stored in post-order, so the operands are always ready
+    for (int i = 0; i <= root; i++) {
+      auto &node = nodes_[i];
+      void *scratch = node.scratch_offset >= 0 ? ctx.scratch.data() + node.scratch_offset
+                                                : nullptr;
+      switch (node.node_type) {
+        case NodeType::Constant:
+          ctx.values[i] = Leaf(tile.sample_idx, i).data;
+          break;
+        case NodeType::Tensor: {
+          auto &leaf = Leaf(tile.sample_idx, i);
+          if (node.scalar_like) {
+            ctx.values[i] = leaf.data;
+          } else if (leaf.in_place) {
+            ctx.values[i] = static_cast<const uint8_t *>(leaf.data) + start * node.type_size;
+          } else {
+            GatherChunk(scratch, node, leaf, output, start, n);
+            ctx.values[i] = scratch;
+          }
+          break;
+        }
+        case NodeType::Function: {
+          void *result = i == root
+                       ? static_cast<uint8_t *>(output.data) + start * node.type_size
+                       : scratch;
+          auto &desc = ctx.descs[i];
+          desc.output.data = result;
+          for (size_t a = 0; a < node.args.size(); a++)
+            desc.args[a].data = ctx.values[node.args[a]];
+          // Scalar-like subexpressions are evaluated for a single element
+          TileDesc chunk = {0, 0, node.scalar_like ? 1 : n};
+          ExprImplContext expr_ctx = {0, node.expr};
+          node.impl->Execute(expr_ctx, make_cspan(&desc, 1), make_cspan(&chunk, 1));
+          ctx.values[i] = result;
+          break;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace expr
+}  // namespace dali
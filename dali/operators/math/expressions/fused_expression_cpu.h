@@ -0,0 +1,126 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_MATH_EXPRESSIONS_FUSED_EXPRESSION_CPU_H_
+#define DALI_OPERATORS_MATH_EXPRESSIONS_FUSED_EXPRESSION_CPU_H_
+
+#include <vector>
+
+#include "dali/core/small_vector.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/operators/math/expressions/constant_storage.h"
+#include "dali/operators/math/expressions/expression_impl_factory.h"
+#include "dali/operators/math/expressions/expression_tile.h"
+#include "dali/operators/math/expressions/expression_tree.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+namespace expr {
+
+/**
+ * @brief Evaluates a whole expression tree in a single pass over the output.
+ *
+ * The output is processed in chunks of kChunkSize elements. For every chunk, the function nodes
+ * are executed in post-order by the same per-node implementations that execute simple
+ * expressions. The intermediate results are written to chunk-sized scratch buffers, which stay
+ * in the L1 cache, instead of full-size temporary tensors.
+ *
+ * Tensor inputs with the same shape as the output are accessed in place; the broadcast ones are
+ * gathered to a scratch buffer first. Scalar-like subexpressions are evaluated for a single
+ * element and passed to their parents as scalars.
+ */
+class DLL_PUBLIC FusedExpressionCpu {
+ public:
+  static constexpr int kChunkSize = 256;
+
+  /**
+   * @brief Flattens the expression tree, with the types and shapes already propagated, and
+   *        obtains the implementations of its function nodes from the `cache`.
+   */
+  void Compile(const ExprNode &root, ExprImplCache &cache);
+
+  /**
+   * @brief Collects the pointers to the inputs and outputs of the current iteration and
+   *        computes the broadcasting strides of the inputs.
+   */
+  void PrepareSamples(Workspace &ws, const ConstantStorage<CPUBackend> &constants,
+                      int num_threads);
+
+  /**
+   * @brief Evaluates the expression over a tile of the output.
+   *
+   * Can be called concurrently for different tiles, as long as the `thread_idx` differs.
+   */
+  void Execute(const TileDesc &tile, int thread_idx);
+
+ private:
+  struct Node {
+    const ExprNode *expr = nullptr;
+    NodeType node_type = NodeType::Function;
+    DALIDataType dtype = DALI_NO_TYPE;
+    int type_size = 0;
+    bool scalar_like = false;
+    /** The implementation of a function node */
+    ExprImplBase *impl = nullptr;
+    /** The indices of the subexpressions of a function node */
+    SmallVector<int, kMaxArity> args;
+    /** The offset of the chunk buffer in the scratch memory, -1 if the node doesn't need one */
+    int64_t scratch_offset = -1;
+  };
+
+  /**
+   * @brief Per-sample location of a leaf node
+   */
+  struct LeafSample {
+    const void *data = nullptr;
+    /** Whether the input has the same shape as the output and can be accessed in place */
+    bool in_place = true;
+    /** Broadcasting strides, matching the simplified shape of the output */
+    TensorShape<> strides;
+  };
+
+  struct OutputSample {
+    void *data = nullptr;
+    /** Output shape, simplified for broadcasting */
+    TensorShape<> shape;
+  };
+
+  struct ThreadContext {
+    std::vector<uint8_t> scratch;
+    /** The operand pointers for the current chunk */
+    std::vector<const void *> values;
+    /** The 1D sample descriptors passed to the implementations of the function nodes */
+    std::vector<SampleDesc> descs;
+  };
+
+  int AddNode(const ExprNode &expr, ExprImplCache &cache);
+  void PrepareThreadContext(ThreadContext &ctx) const;
+  void GatherChunk(void *out, const Node &node, const LeafSample &leaf,
+                   const OutputSample &output, int64_t start, int64_t n) const;
+
+  LeafSample &Leaf(int sample_idx, int node_idx) {
+    return leaves_[sample_idx * nodes_.size() + node_idx];
+  }
+
+  std::vector<Node> nodes_;
+  int64_t scratch_size_ = 0;
+  std::vector<LeafSample> leaves_;
+  std::vector<OutputSample> outputs_;
+  std::vector<ThreadContext> thread_ctx_;
+};
+
+}  // namespace expr
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_MATH_EXPRESSIONS_FUSED_EXPRESSION_CPU_H_
@@ -25,6 +25,7 @@ The shape and data type of the output will match the input.
 )code")
     .NumInput(1)
     .NumOutput(1)
+    .AddParent("RNGEngineAttr")
     .AddOptionalArg<float>("mean",
       R"code(Mean of the distribution.)code",
       0.f, true)
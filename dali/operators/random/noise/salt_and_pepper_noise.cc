@@ -25,6 +25,7 @@ The shape and data type of the output will match the input.
 )code")
     .NumInput(1)
     .NumOutput(1)
+    .AddParent("RNGEngineAttr")
     .AddOptionalArg<float>("prob",
       R"code(Probability of an output value to take a salt or pepper value.)code",
       0.05f, true)
@@ -42,6 +42,7 @@ The shape and data type of the output will match the input.
 )code")
     .NumInput(1)
     .NumOutput(1)
+    .AddParent("RNGEngineAttr")
     .AddOptionalArg<float>("factor",
       R"code(Factor parameter.)code",
      20.0f, true);
@@ -0,0 +1,205 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_RANDOM_PHILOX_H_
+#define DALI_OPERATORS_RANDOM_PHILOX_H_
+
+#include <cstdint>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace dali {
+namespace rng {
+
+/**
+ * @brief Counter-based Philox4x32-10 random bit generator
+ *
+ * Philox (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3") computes each block of
+ * four 32-bit numbers directly from a 128-bit counter and a 64-bit key, so any position in the
+ * stream can be reached in constant time.
+ * The upper half of the counter is the subsequence and the lower half is the index of the block
+ * within the subsequence - the subsequences of one key are independent streams of 2^66 numbers.
+ *
+ * The blocks are generated in batches of kBatchBlocks, one block per SIMD lane.
+ *
+ * The class satisfies the UniformRandomBitGenerator requirements and can be used with
+ * the standard distributions.
+ */
+class Philox4x32_10 {
+ public:
+  using result_type = uint32_t;
+
+  /// Number of 32-bit values in a block
+  static constexpr int kBlockSize = 4;
+  /// Number of blocks generated at once
+  static constexpr int kBatchBlocks = 4;
+  static constexpr int kBufferSize = kBlockSize * kBatchBlocks;
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xffffffffu; }
+
+  Philox4x32_10() = default;
+
+  /**
+   * @param key         the seed
+   * @param subsequence the index of the stream
+   * @param offset      the position in the stream, in 32-bit numbers
+   */
+  explicit Philox4x32_10(uint64_t key, uint64_t subsequence = 0, uint64_t offset = 0) {
+    init(key, subsequence, offset);
+  }
+
+  void init(uint64_t key, uint64_t subsequence = 0, uint64_t offset = 0) {
+    key_ = key;
+    subsequence_ = subsequence;
+    seek(offset);
+  }
+
+  result_type operator()() {
+    if (pos_ == kBufferSize)
+      refill();
+    return buffer_[pos_++];
+  }
+
+  /**
+   * @brief Skips `n` numbers in constant time
+   */
+  void discard(uint64_t n) {
+    seek(offset() + n);
+  }
+
+  /**
+   * @brief The position in the stream, in 32-bit numbers
+   */
+  uint64_t offset() const {
+    return next_block_ * kBlockSize - (kBufferSize - pos_);
+  }
+
+  /**
+   * @brief Computes a single block of the stream
+   */
+  static void Block(uint32_t *out, uint64_t key, uint64_t subsequence, uint64_t block) {
+    uint32_t c[4] = { Lo(block), Hi(block), Lo(subsequence), Hi(subsequence) };
+    uint32_t k0 = Lo(key), k1 = Hi(key);
+    for (int r = 0; r < kRounds; r++) {
+      if (r > 0) {
+        k0 += kW0;
+        k1 += kW1;
+      }
+      uint64_t p0 = uint64_t(kM0) * c[0];
+      uint64_t p1 = uint64_t(kM1) * c[2];
+      uint32_t n0 = Hi(p1) ^ c[1] ^ k0;
+      uint32_t n2 = Hi(p0) ^ c[3] ^ k1;
+      c[0] = n0;
+      c[1] = Lo(p1);
+      c[2] = n2;
+      c[3] = Lo(p0);
+    }
+    for (int i = 0; i < 4; i++)
+      out[i] = c[i];
+  }
+
+  /**
+   * @brief Computes kBatchBlocks consecutive blocks of the stream, starting with `first_block`
+   */
+  static void Blocks(uint32_t *out, uint64_t key, uint64_t subsequence, uint64_t first_block) {
+#ifdef __SSE2__
+    uint64_t b1 = first_block + 1, b2 = first_block + 2, b3 = first_block + 3;
+    // each vector holds one word of the counter of the consecutive blocks
+    __m128i c0 = _mm_setr_epi32(Lo(first_block), Lo(b1), Lo(b2), Lo(b3));
+    __m128i c1 = _mm_setr_epi32(Hi(first_block), Hi(b1), Hi(b2), Hi(b3));
+    __m128i c2 = _mm_set1_epi32(Lo(subsequence));
+    __m128i c3 = _mm_set1_epi32(Hi(subsequence));
+    uint32_t k0 = Lo(key), k1 = Hi(key);
+    const __m128i m0 = _mm_set1_epi32(kM0), m1 = _mm_set1_epi32(kM1);
+    for (int r = 0; r < kRounds; r++) {
+      if (r > 0) {
+        k0 += kW0;
+        k1 += kW1;
+      }
+      __m128i hi0, lo0, hi1, lo1;
+      MulHiLo(c0, m0, hi0, lo0);
+      MulHiLo(c2, m1, hi1, lo1);
+      c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(k0));
+      c1 = lo1;
+      c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(k1));
+      c3 = lo0;
+    }
+    // transpose, so that each block is stored contiguously
+    __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+    __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+    __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+    __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+    __m128i *vout = reinterpret_cast<__m128i *>(out);
+    _mm_storeu_si128(vout + 0, _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128(vout + 1, _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128(vout + 2, _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128(vout + 3, _mm_unpackhi_epi64(t2, t3));
+#else
+    for (int b = 0; b < kBatchBlocks; b++)
+      Block(out + b * kBlockSize, key, subsequence, first_block + b);
+#endif
+  }
+
+ private:
+  static constexpr int kRounds = 10;
+  static constexpr uint32_t kM0 = 0xD2511F53u;
+  static constexpr uint32_t kM1 = 0xCD9E8D57u;
+  static constexpr uint32_t kW0 = 0x9E3779B9u;
+  static constexpr uint32_t kW1 = 0xBB67AE85u;
+
+  static constexpr uint32_t Lo(uint64_t x) { return static_cast<uint32_t>(x); }
+  static constexpr uint32_t Hi(uint64_t x) { return static_cast<uint32_t>(x >> 32); }
+
+#ifdef __SSE2__
+  /**
+   * @brief Full 32x32->64 bit multiplication of 4 lanes
+   */
+  static inline void MulHiLo(__m128i a, __m128i b, __m128i &hi, __m128i &lo) {
+    const __m128i lo_mask = _mm_set_epi32(0, -1, 0, -1);
+    __m128i even = _mm_mul_epu32(a, b);                                        // lanes 0, 2
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));  // lanes 1, 3
+    lo = _mm_or_si128(_mm_and_si128(even, lo_mask), _mm_slli_epi64(odd, 32));
+    hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(lo_mask, odd));
+  }
+#endif
+
+  void seek(uint64_t offset) {
+    next_block_ = offset / kBufferSize * kBatchBlocks;
+    pos_ = kBufferSize;
+    int in_batch = offset % kBufferSize;
+    if (in_batch) {
+      refill();
+      pos_ = in_batch;
+    }
+  }
+
+  void refill() {
+    Blocks(buffer_, key_, subsequence_, next_block_);
+    next_block_ += kBatchBlocks;
+    pos_ = 0;
+  }
+
+  uint64_t key_ = 0;
+  uint64_t subsequence_ = 0;
+  uint64_t next_block_ = 0;
+  int pos_ = kBufferSize;
+  uint32_t buffer_[kBufferSize];
+};
+
+}  // namespace rng
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_RANDOM_PHILOX_H_
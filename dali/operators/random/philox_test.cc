@@ -0,0 +1,114 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/random/philox.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace dali {
+namespace rng {
+namespace test {
+
+TEST(Philox4x32_10Test, KnownAnswers) {
+  // Known answer tests from the Random123 library; the counter words are given from the lowest
+  struct {
+    uint32_t ctr[4], key[2], result[4];
+  } kats[] = {
+    {{ 0, 0, 0, 0 }, { 0, 0 }, { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }},
+    {{ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff },
+     { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }},
+    {{ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 },
+     { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }},
+  };
+  for (auto &kat : kats) {
+    uint64_t key = kat.key[0] | uint64_t(kat.key[1]) << 32;
+    uint64_t block = kat.ctr[0] | uint64_t(kat.ctr[1]) << 32;
+    uint64_t subsequence = kat.ctr[2] | uint64_t(kat.ctr[3]) << 32;
+    uint32_t out[4];
+    Philox4x32_10::Block(out, key, subsequence, block);
+    for (int i = 0; i < 4; i++)
+      EXPECT_EQ(out[i], kat.result[i]);
+
+    if (block < (uint64_t(1) << 62)) {  // the offset is expressed in 32-bit numbers
+      Philox4x32_10 rng(key, subsequence, block * Philox4x32_10::kBlockSize);
+      for (int i = 0; i < 4; i++)
+        EXPECT_EQ(rng(), kat.result[i]);
+    }
+  }
+}
+
+TEST(Philox4x32_10Test, BatchMatchesBlocks) {
+  // the counter crosses the 32-bit boundary within the batch
+  uint64_t first = 0xfffffffeu;
+  uint32_t batch[Philox4x32_10::kBufferSize], block[Philox4x32_10::kBlockSize];
+  Philox4x32_10::Blocks(batch, 1234, 5678, first);
+  for (int b = 0; b < Philox4x32_10::kBatchBlocks; b++) {
+    Philox4x32_10::Block(block, 1234, 5678, first + b);
+    for (int i = 0; i < Philox4x32_10::kBlockSize; i++)
+      EXPECT_EQ(batch[b * Philox4x32_10::kBlockSize + i], block[i]);
+  }
+}
+
+TEST(Philox4x32_10Test, SkipAhead) {
+  constexpr int kN = 1000;
+  Philox4x32_10 rng(42, 7);
+  std::vector<uint32_t> ref(kN);
+  for (auto &x : ref)
+    x = rng();
+  EXPECT_EQ(rng.offset(), static_cast<uint64_t>(kN));
+
+  for (int offset : { 0, 1, 3, 4, 15, 16, 17, 500, 999 }) {
+    Philox4x32_10 seeked(42, 7, offset);
+    EXPECT_EQ(seeked.offset(), static_cast<uint64_t>(offset));
+    for (int i = offset; i < kN; i++)
+      ASSERT_EQ(seeked(), ref[i]) << "offset " << offset << " position " << i;
+
+    Philox4x32_10 discarded(42, 7);
+    discarded();
+    discarded.discard(offset);
+    for (int i = offset + 1; i < kN; i++)
+      ASSERT_EQ(discarded(), ref[i]) << "discarded " << offset << " position " << i;
+  }
+}
+
+TEST(Philox4x32_10Test, Streams) {
+  Philox4x32_10 a(42, 0), b(42, 1), c(43, 0);
+  int same_ab = 0, same_ac = 0;
+  for (int i = 0; i < 1000; i++) {
+    auto x = a(), y = b(), z = c();
+    same_ab += x == y;
+    same_ac += x == z;
+  }
+  EXPECT_LT(same_ab, 2);
+  EXPECT_LT(same_ac, 2);
+}
+
+TEST(Philox4x32_10Test, StdDistribution) {
+  Philox4x32_10 rng(1);
+  std::uniform_real_distribution<float> dist(0, 1);
+  constexpr int kN = 100000;
+  double sum = 0;
+  for (int i = 0; i < kN; i++) {
+    float x = dist(rng);
+    ASSERT_GE(x, 0.0f);
+    ASSERT_LT(x, 1.0f);
+    sum += x;
+  }
+  EXPECT_NEAR(sum / kN, 0.5, 0.01);
+}
+
+}  // namespace test
+}  // namespace rng
+}  // namespace dali
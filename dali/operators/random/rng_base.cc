@@ -17,10 +17,33 @@
 
 namespace dali {
 
+DALI_SCHEMA(RNGEngineAttr)
+    .DocStr(R"code(Random number generator engine attributes.
+
+It should be added as parent to all RNG and noise operators.)code")
+    .AddOptionalArg<std::string>("rng_engine",
+      R"code(Random number generator engine used by the CPU operator.
+
+Supported values:
+
+* ``"mt19937"`` - a Mersenne Twister engine is seeded for each sample (and for each chunk of
+  a large sample).
+* ``"philox"`` - the counter-based Philox4x32-10 engine. The samples are split into chunks that
+  are generated in parallel and each chunk uses a stream of its own, positioned directly in the
+  sequence instead of being seeded. It is faster, especially for large outputs.
+
+The engines produce different random sequences for the same seed. In both cases, the results are
+deterministic and don't depend on the number of threads.
+
+.. note::
+  The GPU operators support only the default engine.
+)code", "mt19937");
+
 DALI_SCHEMA(RNGAttr)
     .DocStr(R"code(Random Number Generator attributes.
 
 It should be added as parent to all RNG operators.)code")
+    .AddParent("RNGEngineAttr")
     .AddOptionalArg<std::vector<int>>("shape",
       R"code(Shape of the output data.)code", nullptr, true)
     .AddOptionalArg<DALIDataType>("dtype",
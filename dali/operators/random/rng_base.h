@@ -72,6 +72,14 @@ class RNGBase : public Operator<Backend> {
       : Operator<Backend>(spec),
         rng_(spec.GetArgument<int64_t>("seed"), max_batch_size_),
         backend_data_(spec.GetArgument<int64_t>("seed"), max_batch_size_) {
+    auto engine = spec.GetArgument<std::string>("rng_engine");
+    DALI_ENFORCE(engine == "mt19937" || engine == "philox",
+                 make_string("Unsupported random number generator engine: \"", engine,
+                             "\". Supported engines are \"mt19937\" and \"philox\"."));
+    use_philox_ = engine == "philox";
+    constexpr bool is_cpu = std::is_same<Backend, CPUBackend>::value;
+    DALI_ENFORCE(!use_philox_ || is_cpu,
+                 "The \"philox\" engine is supported only by the CPU operators.");
   }
 
   Impl &This() noexcept { return static_cast<Impl&>(*this); }
@@ -148,6 +156,8 @@ class RNGBase : public Operator<Backend> {
   using Operator<Backend>::max_batch_size_;
 
   DALIDataType dtype_ = DALI_NO_TYPE;
+  // With the Philox engine, rng_ only provides the per-sample keys
+  bool use_philox_ = false;
   BatchRNG<std::mt19937_64> rng_;
   TensorListShape<> shape_;
   RNGBaseFields<Backend, IsNoiseGen> backend_data_;
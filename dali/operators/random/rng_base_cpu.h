@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 #include "dali/operators/random/rng_base.h"
+#include "dali/operators/random/philox.h"
 #include "dali/core/convert.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/util/batch_rng.h"
@@ -161,16 +162,34 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(Workspace &ws, CPUBackend)
       p_stride = channel_dim == 0 ? 1 : nchannels;
     }
 
-    if (total_p_count < kThreshold) {
+    auto generate = [=](auto &rng, int64_t p_offset, int64_t p_count) {
+      auto dist = use_default_dist ? Dist() : dists[sample_id];
+      if (independent_channels) {
+        dist_gen_.template gen<T>(out_span, in_span, dist, rng, p_offset, p_count);
+      } else {
+        dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, rng, p_offset, p_count,
+                                               nchannels, c_stride, p_stride);
+      }
+    };
+
+    if (use_philox_) {
+      // Each chunk uses a separate subsequence of the sample's stream, so no seeding is needed
+      // and the chunks can be small
+      uint64_t key = rng_[sample_id]();
+      int chunks = div_ceil(total_p_count, kChunkSize);
+      for (int c = 0; c < chunks; c++) {
+        int64_t p_offset, p_count;
+        std::tie(p_offset, p_count) = get_chunk<T>(total_p_count, c, chunks);
+        tp.AddWork(
+          [=](int thread_id) {
+            Philox4x32_10 chunk_rng(key, c);
+            generate(chunk_rng, p_offset, p_count);
+          }, p_count);
+      }
+    } else if (total_p_count < kThreshold) {
       tp.AddWork(
         [=](int thread_id) {
-          auto dist = use_default_dist ? Dist() : dists[sample_id];
-          if (independent_channels) {
-            dist_gen_.template gen<T>(out_span, in_span, dist, rng_[sample_id], 0, total_p_count);
-          } else {
-            dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, rng_[sample_id], 0,
-                                                   total_p_count, nchannels, c_stride, p_stride);
-          }
+          generate(rng_[sample_id], 0, total_p_count);
         }, total_p_count);
     } else {
       int chunks = div_ceil(total_p_count, kChunkSize);
@@ -184,14 +203,7 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(Workspace &ws, CPUBackend)
           [=](int thread_id) {
             std::seed_seq seq(seed.begin(), seed.end());
             std::mt19937_64 chunk_rng(seq);
-            auto dist = use_default_dist ? Dist() : dists[sample_id];
-            if (independent_channels) {
-              dist_gen_.template gen<T>(out_span, in_span, dist, chunk_rng,
-                                        p_offset, p_count);
-            } else {
-              dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, chunk_rng, p_offset,
-                                                     p_count, nchannels, c_stride, p_stride);
-            }
+            generate(chunk_rng, p_offset, p_count);
           }, p_count);
       }
     }
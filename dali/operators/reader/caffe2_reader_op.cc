@@ -63,6 +63,15 @@ Here is a list of the available values:
       R"code(Additional auxiliary data tensors that are provided for each sample.)code", 0)
   .AddOptionalArg("bbox",
       R"code(Denotes whether the bounding-box information is present.)code", false)
+  .AddOptionalArg("index_cache_path",
+      R"code(Path of a file caching the key tables of the databases between the runs.
+
+To access the entries in an arbitrary order, for example when starting from a shard other than
+the first one, the reader builds a table of the keys of each database with a single pass
+over it. If the file exists, the tables of the databases whose data files didn't change are loaded
+from it. The tables of the other databases are built and the file is updated.
+
+If empty, the tables are not cached.)code", "")
   .AddParent("LoaderBase");
 
 // Deprecated alias
@@ -75,6 +75,14 @@ The file names can contain spaces in the middle, but cannot contain trailing whi
 
 3. Use file names and labels provided as a list of strings and integers, respectively.
 
+4. Use file names and labels stored in a binary file index.
+
+``file_index`` argument points to an index generated with the ``file2idx`` tool
+(``tools/file2idx.py``) from a directory or from a ``file_list``. The index is memory-mapped, so
+opening it takes the same time regardless of the number of files, and the shuffling and sharding
+operate on the indices of the entries, rather than on copies of the file names. This mode is
+recommended for datasets with many millions of files.
+
 As with other readers, the (file, label) pairs returned by this operator can be randomly shuffled
 and various sharding strategies can be applied. See documentation of this operator's arguments
 for details.
@@ -84,8 +92,8 @@ for details.
   .AddOptionalArg<string>("file_root",
       R"(Path to a directory that contains the data files.
 
-If not using ``file_list`` or ``files``, this directory is traversed to discover the files.
-``file_root`` is required in this mode of operation.)",
+If not using ``file_list``, ``file_index`` or ``files``, this directory is traversed to discover
+the files. ``file_root`` is required in this mode of operation.)",
       nullptr)
   .AddOptionalArg<string>("file_list",
       R"(Path to a text file that contains one whitespace-separated ``filename label``
@@ -93,6 +101,14 @@ pair per line. The filenames are relative to the location of that file or to ``f
 if specified.
 
 This argument is mutually exclusive with ``files``.)", nullptr)
+  .AddOptionalArg<string>("file_index",
+      R"(Path to a binary index of file names and labels, generated with the ``file2idx`` tool.
+
+The file names are relative to the location of the index or to ``file_root``, if specified.
+The files are in the same order as when reading the directory or the ``file_list`` which
+the index was generated from.
+
+This argument is mutually exclusive with ``files`` and ``file_list``.)", nullptr)
 .AddOptionalArg("shuffle_after_epoch",
       R"(If set to True, the reader shuffles the entire dataset after each epoch.
 
@@ -104,7 +120,7 @@ If ``file_root`` is provided, the paths are treated as being relative to it.
 When using ``files``, the labels are taken from ``labels`` argument or, if it was not supplied,
 contain indices at which given file appeared in the ``files`` list.
 
-This argument is mutually exclusive with ``file_list``.)", nullptr)
+This argument is mutually exclusive with ``file_list`` and ``file_index``.)", nullptr)
   .AddOptionalArg<vector<int>>("labels", R"(Labels accompanying contents of files listed in
 ``files`` argument.
 
@@ -112,7 +128,8 @@ If not used, sequential 0-based indices are used as labels)", nullptr)
   .AddOptionalArg<string>("file_filters", R"(A list of glob strings to filter the
 list of files in the sub-directories of the ``file_root``.
 
-This argument is ignored when file paths are taken from ``file_list`` or ``files``.)",
+This argument is ignored when file paths are taken from ``file_list``, ``file_index``
+or ``files``.)",
       kKnownExtensionsGlob)
   .AddOptionalArg<bool>("case_sensitive_filter", R"(If set to True, the filter will be matched
 case-sensitively, otherwise case-insensitively.)", false)
@@ -0,0 +1,119 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_BLOCK_SHUFFLE_H_
+#define DALI_OPERATORS_READER_LOADER_BLOCK_SHUFFLE_H_
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/pipeline/operator/op_spec.h"
+
+namespace dali {
+
+/**
+ * @brief Returns a permutation of [0, size) which keeps the reads mostly sequential.
+ *
+ * The range is split into blocks of `block_size` consecutive indices and the blocks are
+ * shuffled. Then, the indices in each window of `window_size` consecutive positions of
+ * the result are shuffled. A window spans only a few blocks, so the samples read one after another
+ * come from a small number of contiguous regions of the data.
+ *
+ * The permutation depends only on the arguments.
+ */
+inline std::vector<Index> BlockShuffle(Index size, Index block_size, Index window_size,
+                                       std::seed_seq &seed) {
+  std::mt19937_64 rng(seed);
+  Index num_blocks = (size + block_size - 1) / block_size;
+  std::vector<Index> blocks(num_blocks);
+  std::iota(blocks.begin(), blocks.end(), 0);
+  std::shuffle(blocks.begin(), blocks.end(), rng);
+
+  std::vector<Index> order;
+  order.reserve(size);
+  for (Index block : blocks) {
+    Index block_end = std::min(size, (block + 1) * block_size);
+    for (Index idx = block * block_size; idx < block_end; idx++)
+      order.push_back(idx);
+  }
+  if (window_size > 1) {
+    for (Index start = 0; start < size; start += window_size) {
+      Index end = std::min(size, start + window_size);
+      std::shuffle(order.begin() + start, order.begin() + end, rng);
+    }
+  }
+  return order;
+}
+
+/**
+ * @brief The order of the samples of an indexed reader with ``global_shuffle`` enabled
+ *
+ * The samples are permuted with BlockShuffle, seeded with the reader's ``seed`` and the epoch
+ * number. The seed populated by the pipeline differs between the processes when the pipeline's
+ * seed is not set, while every shard must compute the same permutation - so, unless the user sets
+ * the reader's ``seed``, kDaliDataloaderSeed is used instead (like ``shuffle_after_epoch`` of
+ * the file reader). The order of any epoch can be restored from a checkpoint.
+ */
+class GlobalShuffleOrder {
+ public:
+  explicit GlobalShuffleOrder(const OpSpec &spec)
+      : enabled_(spec.GetArgument<bool>("global_shuffle")),
+        block_size_(spec.GetArgument<int>("shuffle_block_size")),
+        window_size_(spec.GetArgument<int>("shuffle_window_size")),
+        seed_(spec.ArgumentDefined("seed") && !spec.GetArgument<bool>("seed_from_pipeline")
+                  ? spec.GetArgument<int64_t>("seed")
+                  : kDaliDataloaderSeed) {
+    DALI_ENFORCE(block_size_ > 0, make_string(
+        "``shuffle_block_size`` must be positive, got: ", block_size_));
+    DALI_ENFORCE(window_size_ > 0, make_string(
+        "``shuffle_window_size`` must be positive, got: ", window_size_));
+  }
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  /**
+   * @brief Computes the order of the `size` samples for the given epoch
+   */
+  void Shuffle(Index size, int epoch) {
+    if (!enabled_)
+      return;
+    std::seed_seq seed({static_cast<uint32_t>(seed_ + epoch)});
+    order_ = BlockShuffle(size, block_size_, window_size_, seed);
+  }
+
+  /**
+   * @brief Returns the index of the sample at position `idx` of the current order
+   */
+  Index operator[](Index idx) const {
+    return order_.empty() ? idx : order_[idx];
+  }
+
+ private:
+  bool enabled_;
+  Index block_size_, window_size_;
+  int64_t seed_;
+  // empty if the samples are not shuffled
+  std::vector<Index> order_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_BLOCK_SHUFFLE_H_
@@ -0,0 +1,79 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/block_shuffle.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace dali {
+
+namespace {
+
+std::vector<Index> Shuffle(Index size, Index block_size, Index window_size, uint32_t seed) {
+  std::seed_seq seq({seed});
+  return BlockShuffle(size, block_size, window_size, seq);
+}
+
+void ExpectPermutation(std::vector<Index> order, Index size) {
+  ASSERT_EQ(static_cast<Index>(order.size()), size);
+  std::sort(order.begin(), order.end());
+  for (Index i = 0; i < size; i++)
+    ASSERT_EQ(order[i], i);
+}
+
+}  // namespace
+
+TEST(BlockShuffleTest, Permutation) {
+  for (Index size : { 1, 10, 1000, 1001 }) {
+    ExpectPermutation(Shuffle(size, 1, 1, 42), size);
+    ExpectPermutation(Shuffle(size, 16, 1, 42), size);
+    ExpectPermutation(Shuffle(size, 16, 100, 42), size);
+    ExpectPermutation(Shuffle(size, 2000, 2000, 42), size);
+  }
+}
+
+TEST(BlockShuffleTest, Deterministic) {
+  EXPECT_EQ(Shuffle(1000, 16, 64, 42), Shuffle(1000, 16, 64, 42));
+  EXPECT_NE(Shuffle(1000, 16, 64, 42), Shuffle(1000, 16, 64, 43));
+}
+
+TEST(BlockShuffleTest, BlocksStayContiguous) {
+  // without the windows, the blocks are only reordered
+  Index size = 1003, block_size = 10;
+  auto order = Shuffle(size, block_size, 1, 42);
+  std::vector<Index> identity(size);
+  std::iota(identity.begin(), identity.end(), 0);
+  EXPECT_NE(order, identity);
+  for (Index i = 0; i < size; i++) {
+    if (order[i] % block_size != 0)
+      ASSERT_EQ(order[i], order[i - 1] + 1) << "at position " << i;
+  }
+}
+
+TEST(BlockShuffleTest, WindowsSpanFewBlocks) {
+  Index size = 1000, block_size = 10, window_size = 40;
+  auto order = Shuffle(size, block_size, window_size, 42);
+  for (Index start = 0; start < size; start += window_size) {
+    std::vector<Index> blocks;
+    for (Index i = start; i < std::min(size, start + window_size); i++)
+      blocks.push_back(order[i] / block_size);
+    std::sort(blocks.begin(), blocks.end());
+    blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+    EXPECT_LE(blocks.size(), 4u);
+  }
+}
+
+}  // namespace dali
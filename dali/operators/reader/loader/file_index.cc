@@ -0,0 +1,112 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/file_index.h"
+#include <cstring>
+#include <fstream>
+#include "dali/core/error_handling.h"
+#include "dali/core/util.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+constexpr char FileIndex::kMagic[8];
+
+namespace {
+
+int64_t LabelsSize(uint64_t num_files) {
+  return align_up(num_files * sizeof(int32_t), sizeof(uint64_t));
+}
+
+}  // namespace
+
+FileIndex::FileIndex(const std::string &path, bool use_mmap) : path_(path) {
+  auto file = FileStream::Open(path, false, use_mmap);
+  size_t size = file->Size();
+  FileIndexHeader header;
+  DALI_ENFORCE(size >= sizeof(header) && file->Read(&header, sizeof(header)) == sizeof(header) &&
+               !std::memcmp(header.magic, kMagic, sizeof(kMagic)),
+               make_string("\"", path, "\" is not a file index."));
+  DALI_ENFORCE(header.version == kVersion,
+               make_string("Unsupported version of the file index \"", path, "\": ",
+                           header.version, ", expected ", kVersion, "."));
+  // Each file takes at least its offset - this keeps the computed size from overflowing
+  DALI_ENFORCE(header.num_files < size / sizeof(uint64_t) && header.blob_size <= size,
+               make_string("Corrupted file index \"", path, "\": invalid header."));
+  uint64_t expected_size = sizeof(header) + (header.num_files + 1) * sizeof(uint64_t) +
+                           LabelsSize(header.num_files) + header.blob_size;
+  DALI_ENFORCE(size == expected_size,
+               make_string("Corrupted file index \"", path, "\": expected ", expected_size,
+                           " bytes, got ", size, "."));
+
+  file->SeekRead(0);
+  if (use_mmap) {
+    data_ = file->Get(size);
+    DALI_ENFORCE(data_ != nullptr, make_string("Failed to read the file index \"", path, "\"."));
+  } else {
+    std::shared_ptr<uint64_t> buffer(new uint64_t[div_ceil(size, sizeof(uint64_t))],
+                                     std::default_delete<uint64_t[]>());
+    DALI_ENFORCE(file->Read(buffer.get(), size) == size,
+                 make_string("Failed to read the file index \"", path, "\"."));
+    data_ = std::move(buffer);
+  }
+  file->Close();
+
+  auto *ptr = static_cast<const char *>(data_.get()) + sizeof(header);
+  num_files_ = header.num_files;
+  offsets_ = reinterpret_cast<const uint64_t *>(ptr);
+  ptr += (header.num_files + 1) * sizeof(uint64_t);
+  labels_ = reinterpret_cast<const int32_t *>(ptr);
+  ptr += LabelsSize(header.num_files);
+  blob_ = ptr;
+  blob_size_ = header.blob_size;
+  DALI_ENFORCE(offsets_[0] == 0 && offsets_[num_files_] == blob_size_,
+               make_string("Corrupted file index \"", path, "\": invalid offsets."));
+}
+
+std::string FileIndex::path(int64_t idx) const {
+  uint64_t begin = offsets_[idx], end = offsets_[idx + 1];
+  // The offsets are validated lazily, so that opening the index doesn't touch all its pages
+  DALI_ENFORCE(begin <= end && end <= blob_size_,
+               make_string("Corrupted file index \"", path_, "\": invalid offset of the entry ",
+                           idx, "."));
+  return std::string(blob_ + begin, end - begin);
+}
+
+void FileIndex::Write(const std::string &path,
+                      const std::vector<std::pair<std::string, int>> &file_label_pairs) {
+  FileIndexHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.num_files = file_label_pairs.size();
+  std::vector<uint64_t> offsets = { 0 };
+  std::vector<int32_t> labels;
+  for (auto &entry : file_label_pairs) {
+    offsets.push_back(offsets.back() + entry.first.size());
+    labels.push_back(entry.second);
+  }
+  header.blob_size = offsets.back();
+  labels.resize(LabelsSize(header.num_files) / sizeof(int32_t), 0);
+
+  std::ofstream f(path, std::ios::binary);
+  DALI_ENFORCE(f.is_open(), make_string("Cannot open \"", path, "\" for writing."));
+  f.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  f.write(reinterpret_cast<const char *>(offsets.data()), offsets.size() * sizeof(uint64_t));
+  f.write(reinterpret_cast<const char *>(labels.data()), labels.size() * sizeof(int32_t));
+  for (auto &entry : file_label_pairs)
+    f.write(entry.first.data(), entry.first.size());
+  DALI_ENFORCE(f.good(), make_string("Failed to write the file index \"", path, "\"."));
+}
+
+}  // namespace dali
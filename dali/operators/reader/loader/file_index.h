@@ -0,0 +1,88 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_FILE_INDEX_H_
+#define DALI_OPERATORS_READER_LOADER_FILE_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/core/common.h"
+
+namespace dali {
+
+/**
+ * @brief Binary index of (file, label) pairs, generated with `tools/file2idx.py`
+ *
+ * The file consists of (all values are little endian):
+ *   - the header (FileIndexHeader),
+ *   - `num_files + 1` uint64 offsets of the paths in the blob,
+ *   - `num_files` int32 labels, padded to a multiple of 8 bytes,
+ *   - the blob with the paths, which are not null-terminated.
+ *
+ * The index is memory-mapped, so loading it doesn't depend on the number of files and the pages
+ * are shared between the processes reading the same index.
+ */
+class DLL_PUBLIC FileIndex {
+ public:
+  static constexpr char kMagic[8] = {'D', 'A', 'L', 'I', 'F', 'I', 'D', 'X'};
+  static constexpr uint32_t kVersion = 1;
+
+  struct FileIndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t num_files;
+    uint64_t blob_size;
+  };
+
+  /**
+   * @brief Opens and validates the index
+   *
+   * @param use_mmap if false, the index is read to memory instead
+   */
+  explicit FileIndex(const std::string &path, bool use_mmap = true);
+
+  int64_t size() const {
+    return num_files_;
+  }
+
+  std::string path(int64_t idx) const;
+
+  int label(int64_t idx) const {
+    return labels_[idx];
+  }
+
+  /**
+   * @brief Writes the index of `file_label_pairs`; used by the tests
+   */
+  static void Write(const std::string &path,
+                    const std::vector<std::pair<std::string, int>> &file_label_pairs);
+
+ private:
+  std::string path_;
+  std::shared_ptr<void> data_;
+  int64_t num_files_ = 0;
+  const uint64_t *offsets_ = nullptr;
+  const int32_t *labels_ = nullptr;
+  const char *blob_ = nullptr;
+  uint64_t blob_size_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_FILE_INDEX_H_
@@ -0,0 +1,93 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/file_index.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dali {
+namespace test {
+
+class FileIndexTest : public ::testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    path_ = "/tmp/dali_file_index_XXXXXX";
+    int fd = mkstemp(&path_[0]);
+    ASSERT_NE(-1, fd);
+    close(fd);
+  }
+
+  void TearDown() override {
+    std::remove(path_.c_str());
+  }
+
+  void Truncate(int64_t size) {
+    ASSERT_EQ(0, truncate(path_.c_str(), size));
+  }
+
+  std::string path_;
+  std::vector<std::pair<std::string, int>> pairs_ = {
+    { "0/a.jpg", 0 }, { "0/cute kitten.jpg", 0 }, { "1/b.png", 1 }, { "", 5 }, { "2/c.jpg", 2 }
+  };
+};
+
+TEST_P(FileIndexTest, WriteRead) {
+  FileIndex::Write(path_, pairs_);
+  FileIndex index(path_, GetParam());
+  ASSERT_EQ(index.size(), static_cast<int64_t>(pairs_.size()));
+  for (size_t i = 0; i < pairs_.size(); i++) {
+    EXPECT_EQ(index.path(i), pairs_[i].first);
+    EXPECT_EQ(index.label(i), pairs_[i].second);
+  }
+}
+
+TEST_P(FileIndexTest, Truncated) {
+  FileIndex::Write(path_, pairs_);
+  Truncate(100);
+  EXPECT_THROW(FileIndex(path_, GetParam()), std::runtime_error);
+  Truncate(4);
+  EXPECT_THROW(FileIndex(path_, GetParam()), std::runtime_error);
+}
+
+TEST_P(FileIndexTest, NotAnIndex) {
+  std::FILE *f = std::fopen(path_.c_str(), "w");
+  ASSERT_NE(nullptr, f);
+  std::fputs("0/a.jpg 0\n1/b.jpg 1\n2/c.jpg 2\n3/d.jpg 3\n", f);
+  std::fclose(f);
+  EXPECT_THROW(FileIndex(path_, GetParam()), std::runtime_error);
+}
+
+TEST_P(FileIndexTest, SizeOverflow) {
+  FileIndex::Write(path_, pairs_);
+  // the header and a single zero offset
+  Truncate(32 + 8);
+  std::FILE *f = std::fopen(path_.c_str(), "r+b");
+  ASSERT_NE(nullptr, f);
+  // with this number of files, the size of the offsets and the labels wraps around to 8 bytes
+  uint64_t num_files = uint64_t(1) << 62, blob_size = 0;
+  std::fseek(f, 16, SEEK_SET);
+  std::fwrite(&num_files, sizeof(num_files), 1, f);
+  std::fwrite(&blob_size, sizeof(blob_size), 1, f);
+  std::fclose(f);
+  EXPECT_THROW(FileIndex(path_, GetParam()), std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(FileIndexTest, FileIndexTest, ::testing::Values(true, false));
+
+}  // namespace test
+}  // namespace dali
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <memory>
+#include <string>
 
 #include "dali/core/common.h"
 #include "dali/operators/reader/loader/file_label_loader.h"
@@ -30,7 +31,7 @@ void FileLabelLoaderBase<checkpointing_supported>::PrepareEmpty(ImageLabelWrappe
 
 template<bool checkpointing_supported>
 void FileLabelLoaderBase<checkpointing_supported>::ReadSample(ImageLabelWrapper &image_label) {
-  auto image_pair = image_label_pairs_[current_index_++];
+  auto image_pair = GetFileLabelPair(current_index_++);
 
   // handle wrap-around
   MoveToNextShard(current_index_);
@@ -50,33 +51,44 @@ void FileLabelLoaderBase<checkpointing_supported>::ReadSample(ImageLabelWrapper
     return;
   }
 
-  auto current_image = FileStream::Open(filesystem::join_path(file_root_, image_pair.first),
-                                        read_ahead_, !copy_read_data_);
+  this->ReadOrDefer([this, &image_label, meta = std::move(meta),
+                     path = filesystem::join_path(file_root_, image_pair.first)]() {
+    ReadImage(image_label.image, path, meta);
+  });
+}
+
+template<bool checkpointing_supported>
+void FileLabelLoaderBase<checkpointing_supported>::ReadImage(Tensor<CPUBackend> &image,
+                                                             const std::string &path,
+                                                             const DALIMeta &meta) {
+  auto current_image = FileStream::Open(path, read_ahead_, !copy_read_data_);
   Index image_size = current_image->Size();
 
   if (copy_read_data_) {
-    if (image_label.image.shares_data()) {
-      image_label.image.Reset();
+    if (image.shares_data()) {
+      image.Reset();
     }
-    image_label.image.Resize({image_size}, DALI_UINT8);
+    image.Resize({image_size}, DALI_UINT8);
     // copy the image
-    Index ret = current_image->Read(image_label.image.mutable_data<uint8_t>(), image_size);
-    DALI_ENFORCE(ret == image_size, make_string("Failed to read file: ", image_pair.first));
+    Index ret = current_image->Read(image.mutable_data<uint8_t>(), image_size);
+    DALI_ENFORCE(ret == image_size, make_string("Failed to read file: ", meta.GetSourceInfo()));
   } else {
     auto p = current_image->Get(image_size);
-    DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", image_pair.first));
+    DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", meta.GetSourceInfo()));
     // Wrap the raw data in the Tensor object.
-    image_label.image.ShareData(p, image_size, false, {image_size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
+    image.ShareData(p, image_size, false, {image_size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
   }
 
   // close the file handle
   current_image->Close();
 
-  image_label.image.SetMeta(meta);
+  image.SetMeta(meta);
 }
 
 template<bool checkpointing_supported>
 Index FileLabelLoaderBase<checkpointing_supported>::SizeImpl() {
+  if (file_index_)
+    return file_index_->size();
   return static_cast<Index>(image_label_pairs_.size());
 }
 
@@ -20,6 +20,9 @@
 #include <errno.h>
 
 #include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -28,6 +31,7 @@
 
 #include "dali/core/common.h"
 #include "dali/operators/reader/loader/loader.h"
+#include "dali/operators/reader/loader/file_index.h"
 #include "dali/operators/reader/loader/filesystem.h"
 #include "dali/util/file.h"
 
@@ -57,6 +61,7 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
     has_files_arg_ = spec.TryGetRepeatedArgument(files, "files");
     has_labels_arg_ = spec.TryGetRepeatedArgument(labels, "labels");
     has_file_list_arg_ = spec.TryGetArgument(file_list_, "file_list");
+    has_file_index_arg_ = spec.TryGetArgument(file_index_path_, "file_index");
     has_file_root_arg_ = spec.TryGetArgument(file_root_, "file_root");
     bool has_file_filters_arg = spec.TryGetRepeatedArgument(filters_, "file_filters");
 
@@ -64,11 +69,13 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
     // GetArgument.
     spec.TryGetArgument(case_sensitive_filter_, "case_sensitive_filter");
 
-    DALI_ENFORCE(has_file_root_arg_ || has_files_arg_ || has_file_list_arg_,
-      "``file_root`` argument is required when not using ``files`` or ``file_list``.");
+    DALI_ENFORCE(has_file_root_arg_ || has_files_arg_ || has_file_list_arg_ || has_file_index_arg_,
+      "``file_root`` argument is required when not using ``files``, ``file_list`` "
+      "or ``file_index``.");
 
-    DALI_ENFORCE(has_files_arg_ + has_file_list_arg_ <= 1,
-      "File paths can be provided through ``files`` or ``file_list`` but not both.");
+    DALI_ENFORCE(has_files_arg_ + has_file_list_arg_ + has_file_index_arg_ <= 1,
+      "File paths can be provided through only one of ``files``, ``file_list`` "
+      "and ``file_index``.");
 
     DALI_ENFORCE(has_files_arg_ || !has_labels_arg_,
       "The argument ``labels`` is valid only when file paths "
@@ -87,6 +94,16 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
       }
     }
 
+    if (has_file_index_arg_) {
+      DALI_ENFORCE(!file_index_path_.empty(), "``file_index`` argument cannot be empty");
+      if (!has_file_root_arg_) {
+        auto idx = file_index_path_.rfind(filesystem::dir_sep);
+        if (idx != string::npos) {
+          file_root_ = file_index_path_.substr(0, idx);
+        }
+      }
+    }
+
     if (has_files_arg_) {
       DALI_ENFORCE(files.size() > 0, "``files`` specified an empty list.");
       if (has_labels_arg_) {
@@ -127,10 +144,20 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
   void PrepareEmpty(ImageLabelWrapper &tensor) override;
   void ReadSample(ImageLabelWrapper &tensor) override;
 
+  bool SupportsDeferredReads() const override {
+    return true;
+  }
+
  protected:
+  void ReadImage(Tensor<CPUBackend> &image, const std::string &path, const DALIMeta &meta);
+
   Index SizeImpl() override;
 
   void PrepareMetadataImpl() override {
+    if (has_file_index_arg_) {
+      PrepareFileIndex();
+      return;
+    }
     if (image_label_pairs_.empty()) {
       if (!has_file_list_arg_ && !has_files_arg_) {
         image_label_pairs_ =
@@ -205,7 +232,13 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
 
     current_epoch_++;
 
-    if (shuffle_after_epoch_) {
+    if (shuffle_after_epoch_ && file_index_) {
+      if (IsCheckpointingEnabled()) {
+        std::iota(file_index_order_.begin(), file_index_order_.end(), 0);
+      }
+      std::mt19937 g(kDaliDataloaderSeed + current_epoch_);
+      std::shuffle(file_index_order_.begin(), file_index_order_.end(), g);
+    } else if (shuffle_after_epoch_) {
       if (IsCheckpointingEnabled()) {
         // With checkpointing enabled, dataset order must be easy to restore.
         // The shuffling is run with different seed every epoch, so this doesn't impact
@@ -221,6 +254,43 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
     current_epoch_ = state.current_epoch;
   }
 
+  /**
+   * @brief Opens the binary file index.
+   *
+   * The (file, label) pairs are not copied - the shuffling operates on a permutation of
+   * the indices of the entries, which yields the same order as shuffling the pairs.
+   */
+  void PrepareFileIndex() {
+    file_index_ = std::make_unique<FileIndex>(file_index_path_, !dont_use_mmap_);
+    DALI_ENFORCE(SizeImpl() > 0, "No files found.");
+
+    if (shuffle_ || shuffle_after_epoch_) {
+      DALI_ENFORCE(SizeImpl() <= std::numeric_limits<uint32_t>::max(),
+                   "Shuffling is supported for file indices with up to 2^32 - 1 entries.");
+      file_index_order_.resize(SizeImpl());
+      std::iota(file_index_order_.begin(), file_index_order_.end(), 0);
+    }
+    if (shuffle_) {
+      // seeded with hardcoded value to get
+      // the same sequence on every shard
+      std::mt19937 g(kDaliDataloaderSeed);
+      std::shuffle(file_index_order_.begin(), file_index_order_.end(), g);
+    }
+
+    Reset(true);
+  }
+
+  /**
+   * @brief Returns the (file, label) pair at given position in the current order.
+   */
+  std::pair<string, int> GetFileLabelPair(Index idx) const {
+    if (file_index_) {
+      Index entry = file_index_order_.empty() ? idx : file_index_order_[idx];
+      return { file_index_->path(entry), file_index_->label(entry) };
+    }
+    return image_label_pairs_[idx];
+  }
+
   using Base::shard_id_;
   using Base::virtual_shard_id_;
   using Base::num_shards_;
@@ -235,14 +305,18 @@ class DLL_PUBLIC FileLabelLoaderBase : public Loader<CPUBackend, ImageLabelWrapp
   using Base::MoveToNextShard;
   using Base::ShouldSkipImage;
 
-  string file_root_, file_list_;
+  string file_root_, file_list_, file_index_path_;
   vector<std::pair<string, int>> image_label_pairs_;
   vector<std::pair<string, int>> backup_image_label_pairs_;
+  std::unique_ptr<FileIndex> file_index_;
+  // The order of the entries of the file index; empty if the entries are not shuffled
+  vector<uint32_t> file_index_order_;
   vector<string> filters_;
 
   bool has_files_arg_ = false;
   bool has_labels_arg_ = false;
   bool has_file_list_arg_ = false;
+  bool has_file_index_arg_ = false;
   bool has_file_root_arg_ = false;
   bool case_sensitive_filter_ = false;
 
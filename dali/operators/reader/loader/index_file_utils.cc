@@ -0,0 +1,97 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/index_file_utils.h"
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "dali/core/format.h"
+
+namespace dali {
+namespace detail {
+namespace index_file {
+
+bool Stat(const std::string &path, FileSignature &signature) {
+  struct stat file_stat;
+  if (stat(path.c_str(), &file_stat) != 0)
+    return false;
+  signature.size = file_stat.st_size;
+  signature.mtime_ns = file_stat.st_mtim.tv_sec * 1000000000LL + file_stat.st_mtim.tv_nsec;
+  return true;
+}
+
+bool ReadHeader(std::istream &in, const char (&magic)[8], uint32_t version) {
+  char file_magic[sizeof(magic)];
+  uint32_t file_version;
+  return in.read(file_magic, sizeof(file_magic)) &&
+         memcmp(file_magic, magic, sizeof(magic)) == 0 &&
+         ReadValue(in, file_version) && file_version == version;
+}
+
+void WriteHeader(std::ostream &out, const char (&magic)[8], uint32_t version) {
+  out.write(magic, sizeof(magic));
+  WriteValue(out, version);
+}
+
+bool ReadString(std::istream &in, std::string &str, uint32_t max_length) {
+  uint32_t length;
+  if (!ReadValue(in, length) || length > max_length)
+    return false;
+  str.resize(length);
+  return static_cast<bool>(in.read(&str[0], length));
+}
+
+void WriteString(std::ostream &out, const std::string &str) {
+  WriteValue(out, static_cast<uint32_t>(str.size()));
+  out.write(str.data(), str.size());
+}
+
+bool ReadSignature(std::istream &in, FileSignature &signature) {
+  return ReadValue(in, signature.size) && ReadValue(in, signature.mtime_ns);
+}
+
+void WriteSignature(std::ostream &out, const FileSignature &signature) {
+  WriteValue(out, signature.size);
+  WriteValue(out, signature.mtime_ns);
+}
+
+bool SaveAtomically(const std::string &path,
+                    const std::function<bool(std::ostream &)> &write,
+                    std::ios::openmode mode) {
+  // the same file can be saved concurrently by several threads and processes
+  static std::atomic<uint64_t> tmp_counter{0};
+  std::string tmp_path = make_string(path, ".tmp", getpid(), "_", tmp_counter++);
+  {
+    std::ofstream out(tmp_path, mode | std::ios::out);
+    if (!out.is_open())
+      return false;
+    if (!write(out) || !out.good()) {
+      out.close();
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace index_file
+}  // namespace detail
+}  // namespace dali
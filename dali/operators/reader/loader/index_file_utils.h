@@ -0,0 +1,121 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_INDEX_FILE_UTILS_H_
+#define DALI_OPERATORS_READER_LOADER_INDEX_FILE_UTILS_H_
+
+#include <cstdint>
+#include <functional>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "dali/core/api_helper.h"
+
+namespace dali {
+namespace detail {
+namespace index_file {
+
+/**
+ * @brief Size and modification time of a file, used to tell if an index built from the file
+ *        is up to date
+ */
+struct FileSignature {
+  int64_t size = 0;
+  int64_t mtime_ns = 0;
+
+  bool operator==(const FileSignature &other) const {
+    return size == other.size && mtime_ns == other.mtime_ns;
+  }
+
+  bool operator!=(const FileSignature &other) const {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @brief Reads the size and the modification time of the file
+ *
+ * @return False, if the file doesn't exist or can't be accessed.
+ */
+DLL_PUBLIC bool Stat(const std::string &path, FileSignature &signature);
+
+/**
+ * @brief Reads a trivially copyable value, in native endianness
+ */
+template <typename T>
+bool ReadValue(std::istream &in, T &value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+/**
+ * @brief Writes a trivially copyable value, in native endianness
+ */
+template <typename T>
+void WriteValue(std::ostream &out, const T &value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * @brief Reads the 8-byte magic and the uint32 version and checks that they match
+ */
+DLL_PUBLIC bool ReadHeader(std::istream &in, const char (&magic)[8], uint32_t version);
+
+/**
+ * @brief Writes the 8-byte magic and the uint32 version
+ */
+DLL_PUBLIC void WriteHeader(std::ostream &out, const char (&magic)[8], uint32_t version);
+
+/**
+ * @brief Reads a string stored as its uint32 length followed by the characters
+ *
+ * @return False, if the string can't be read or is longer than `max_length`.
+ */
+DLL_PUBLIC bool ReadString(std::istream &in, std::string &str, uint32_t max_length);
+
+/**
+ * @brief Writes a string as its uint32 length followed by the characters
+ */
+DLL_PUBLIC void WriteString(std::ostream &out, const std::string &str);
+
+/**
+ * @brief Reads the signature stored as the int64 size and modification time
+ */
+DLL_PUBLIC bool ReadSignature(std::istream &in, FileSignature &signature);
+
+/**
+ * @brief Writes the signature as the int64 size and modification time
+ */
+DLL_PUBLIC void WriteSignature(std::ostream &out, const FileSignature &signature);
+
+/**
+ * @brief Writes a file with `write`, so that the concurrent readers never see it partially
+ *        written
+ *
+ * The file is written under a temporary name, unique for each call, and then renamed to `path`.
+ * If `write` returns false or the file can't be written, the temporary file is removed and
+ * `path` is left untouched.
+ *
+ * @return False, if the file wasn't written.
+ */
+DLL_PUBLIC bool SaveAtomically(const std::string &path,
+                               const std::function<bool(std::ostream &)> &write,
+                               std::ios::openmode mode = std::ios::binary);
+
+}  // namespace index_file
+}  // namespace detail
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_INDEX_FILE_UTILS_H_
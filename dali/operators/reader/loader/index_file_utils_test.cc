@@ -0,0 +1,95 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/index_file_utils.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "dali/core/format.h"
+
+namespace dali {
+namespace detail {
+namespace index_file {
+
+namespace {
+
+constexpr char kTestMagic[8] = { 'D', 'A', 'L', 'I', 'T', 'E', 'S', 'T' };
+
+}  // namespace
+
+TEST(IndexFileUtilsTest, RoundTrip) {
+  std::stringstream stream;
+  FileSignature signature;
+  signature.size = 1234;
+  signature.mtime_ns = 5678;
+  WriteHeader(stream, kTestMagic, 3);
+  WriteString(stream, "some/path");
+  WriteSignature(stream, signature);
+  WriteValue(stream, uint64_t(42));
+
+  std::string str;
+  FileSignature read_signature;
+  uint64_t value;
+  ASSERT_TRUE(ReadHeader(stream, kTestMagic, 3));
+  ASSERT_TRUE(ReadString(stream, str, 100));
+  ASSERT_TRUE(ReadSignature(stream, read_signature));
+  ASSERT_TRUE(ReadValue(stream, value));
+  EXPECT_EQ(str, "some/path");
+  EXPECT_EQ(read_signature, signature);
+  EXPECT_EQ(value, 42u);
+  EXPECT_FALSE(ReadValue(stream, value));
+}
+
+TEST(IndexFileUtilsTest, RejectsMismatch) {
+  std::stringstream stream;
+  WriteHeader(stream, kTestMagic, 3);
+  WriteString(stream, "some/path");
+  std::string str;
+  EXPECT_FALSE(ReadHeader(stream, kTestMagic, 4));
+  stream.clear();
+  stream.seekg(0);
+  ASSERT_TRUE(ReadHeader(stream, kTestMagic, 3));
+  EXPECT_FALSE(ReadString(stream, str, 4));
+}
+
+TEST(IndexFileUtilsTest, SaveAtomically) {
+  std::string path = make_string("/tmp/dali_index_file_utils_", getpid());
+  std::remove(path.c_str());
+  FileSignature signature;
+  EXPECT_FALSE(Stat(path, signature));
+
+  EXPECT_FALSE(SaveAtomically(path, [](std::ostream &out) {
+    out << "discarded";
+    return false;
+  }));
+  EXPECT_FALSE(Stat(path, signature));
+
+  ASSERT_TRUE(SaveAtomically(path, [](std::ostream &out) {
+    out << "saved";
+    return true;
+  }));
+  ASSERT_TRUE(Stat(path, signature));
+  EXPECT_EQ(signature.size, 5);
+  std::string contents;
+  std::ifstream(path) >> contents;
+  EXPECT_EQ(contents, "saved");
+  std::remove(path.c_str());
+}
+
+}  // namespace index_file
+}  // namespace detail
+}  // namespace dali
@@ -26,20 +26,22 @@
 
 #include "dali/core/common.h"
 #include "dali/core/mm/memory.h"
+#include "dali/operators/reader/loader/block_shuffle.h"
 #include "dali/operators/reader/loader/loader.h"
 #include "dali/util/file.h"
 #include "dali/util/odirect_file.h"
 
 namespace dali {
 
-class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
+class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>, true> {
  public:
   explicit IndexedFileLoader(const OpSpec& spec)
     : Loader(spec),
       uris_(spec.GetRepeatedArgument<std::string>("path")),
       index_uris_(spec.GetRepeatedArgument<std::string>("index_path")),
       current_index_(0), current_file_index_(0), current_file_(nullptr),
-      use_o_direct_(spec.HasArgument("use_o_direct") && spec.GetArgument<bool>("use_o_direct")) {
+      use_o_direct_(spec.HasArgument("use_o_direct") && spec.GetArgument<bool>("use_o_direct")),
+      global_shuffle_(spec) {
         DALI_ENFORCE(dont_use_mmap_  || !use_o_direct_, make_string("Cannot use use_o_direct with ",
                      "``dont_use_mmap=False``."));
       if (use_o_direct_) {
@@ -47,6 +49,12 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
         o_direct_alignm_ = ODirectFileStream::GetAlignment();
         o_direct_read_len_alignm_ = ODirectFileStream::GetLenAlignment();
       }
+      if (global_shuffle_.enabled()) {
+        // Every epoch is permuted anew, so the shards can't be rotated
+        DALI_ENFORCE(!stick_to_shard_, "global_shuffle and stick_to_shard cannot be both true");
+        DALI_ENFORCE(!shuffle_, "global_shuffle and random_shuffle cannot be both true");
+        stick_to_shard_ = true;
+      }
     }
 
   void ReadSample(Tensor<CPUBackend>& tensor) override {
@@ -54,7 +62,7 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
 
     int64 seek_pos, size;
     size_t file_index;
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
+    std::tie(seek_pos, size, file_index) = indices_[global_shuffle_[current_index_]];
     ++current_index_;
 
     std::string image_key = uris_[file_index] + " at index " + to_string(seek_pos);
@@ -62,14 +70,7 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     meta.SetSourceInfo(image_key);
     meta.SetSkipSample(false);
 
-    if (file_index != current_file_index_) {
-      current_file_.reset();
-      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_,
-                                       use_o_direct_);
-      current_file_index_ = file_index;
-      // invalidate the buffer
-      if (use_o_direct_) read_buffer_.reset();
-    }
+    UseFile(file_index);
 
     // if image is cached, skip loading
     if (ShouldSkipImage(image_key)) {
@@ -213,20 +214,38 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     int64 seek_pos, size;
     size_t file_index;
     if (wrap_to_shard) {
-      current_index_ = start_index(shard_id_, num_shards_, SizeImpl());
+      current_index_ = start_index(virtual_shard_id_, num_shards_, SizeImpl());
     } else {
       current_index_ = 0;
     }
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
-    if (file_index != current_file_index_) {
-      current_file_.reset();
-      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_,
-                                       use_o_direct_);
-      current_file_index_ = file_index;
-      // invalidate the buffer
-      if (use_o_direct_) read_buffer_.reset();
-    }
+
+    current_epoch_++;
+    global_shuffle_.Shuffle(SizeImpl(), current_epoch_);
+
+    std::tie(seek_pos, size, file_index) = indices_[global_shuffle_[current_index_]];
+    UseFile(file_index);
     current_file_->SeekRead(seek_pos);
+    should_seek_ = false;
+    next_seek_pos_ = seek_pos;
+  }
+
+  void RestoreStateImpl(const LoaderStateSnapshot &state) override {
+    current_epoch_ = state.current_epoch;
+  }
+
+  /**
+   * @brief Makes the file `file_index` the current one, opening it if needed
+   */
+  void UseFile(size_t file_index) {
+    if (file_index == current_file_index_)
+      return;
+    current_file_.reset();
+    current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_,
+                                     use_o_direct_);
+    current_file_index_ = file_index;
+    should_seek_ = true;
+    // invalidate the buffer
+    if (use_o_direct_) read_buffer_.reset();
   }
 
   std::vector<std::string> uris_;
@@ -247,6 +266,9 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
   size_t read_buffer_pos_ = 0;
   size_t read_buffer_size_ = 0;
   size_t read_buffer_data_size_ = 0;
+  // order of the samples, if the whole dataset is shuffled
+  GlobalShuffleOrder global_shuffle_;
+  int current_epoch_ = 0;
 
   typedef std::function<void(void)> ReadWork;
   std::queue<ReadWork> jobs_;
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "dali/core/common.h"
+#include "dali/operators/reader/loader/lmdb_key_index.h"
 #include "dali/operators/reader/loader/loader.h"
 
 namespace dali {
@@ -32,38 +33,108 @@ namespace dali {
   } while (0)
 
 
-class IndexedLMDB {
+/**
+ * @brief Read-only LMDB environment together with its read transaction
+ *
+ * The values returned by LMDB point to the memory mapped pages of the database, which stay valid
+ * only until the transaction is finished. The object is shared by the database and all
+ * the samples pointing to its pages, so the transaction ends when the last of them is released.
+ * The environment is opened with MDB_NOTLS, so the transaction can be finished by any thread.
+ */
+class LMDBReadTransaction {
+ public:
+  explicit LMDBReadTransaction(const std::string& path) {
+    try {
+      CHECK_LMDB(mdb_env_create(&mdb_env_), path);
+      auto mdb_flags = MDB_RDONLY | MDB_NOTLS | MDB_NOLOCK;
+      CHECK_LMDB(mdb_env_open(mdb_env_, path.c_str(), mdb_flags, 0664), path);
+      CHECK_LMDB(mdb_txn_begin(mdb_env_, NULL, MDB_RDONLY, &mdb_transaction_), path);
+    } catch (...) {
+      Close();
+      throw;
+    }
+  }
+
+  ~LMDBReadTransaction() {
+    Close();
+  }
+
+  DISABLE_COPY_MOVE_ASSIGN(LMDBReadTransaction);
+
+  MDB_env* env() const { return mdb_env_; }
+  MDB_txn* txn() const { return mdb_transaction_; }
+
+ private:
+  void Close() {
+    if (mdb_transaction_) {
+      mdb_txn_abort(mdb_transaction_);
+      mdb_transaction_ = nullptr;
+    }
+    if (mdb_env_) {
+      mdb_env_close(mdb_env_);
+      mdb_env_ = nullptr;
+    }
+  }
+
   MDB_env* mdb_env_ = nullptr;
+  MDB_txn* mdb_transaction_ = nullptr;
+};
+
+class IndexedLMDB {
+  std::shared_ptr<LMDBReadTransaction> mdb_transaction_;
   MDB_cursor* mdb_cursor_ = nullptr;
   MDB_dbi mdb_dbi_;
-  MDB_txn* mdb_transaction_ = nullptr;
   int num_;
   Index mdb_index_;
   std::string db_path_;
   Index mdb_size_;
+  // keys of the entries, in the database order, used to seek with a single lookup
+  LMDBKeyIndex keys_;
 
  public:
-  void Open(const std::string& path, int num) {
-    DALI_ENFORCE(mdb_env_ == nullptr, "Previous MDB environment was not closed");
+  /**
+   * @brief Opens the database and prepares its key table
+   *
+   * The key table is taken from `key_cache`, if it holds an up-to-date one. Otherwise,
+   * it's built with a single pass over the database and inserted into `key_cache`.
+   */
+  void Open(const std::string& path, int num, LMDBKeyIndexCache* key_cache = nullptr) {
+    DALI_ENFORCE(mdb_transaction_ == nullptr, "Previous MDB environment was not closed");
     db_path_ = path;
     num_ = num;
-    CHECK_LMDB(mdb_env_create(&mdb_env_), db_path_);
-    auto mdb_flags = MDB_RDONLY | MDB_NOTLS | MDB_NOLOCK;
-    CHECK_LMDB(mdb_env_open(mdb_env_, path.c_str(), mdb_flags, 0664), db_path_);
-
-    // Create transaction and cursor
-    CHECK_LMDB(mdb_txn_begin(mdb_env_, NULL, MDB_RDONLY, &mdb_transaction_), db_path_);
-    CHECK_LMDB(mdb_dbi_open(mdb_transaction_, NULL, 0, &mdb_dbi_), db_path_);
-    CHECK_LMDB(mdb_cursor_open(mdb_transaction_, mdb_dbi_, &mdb_cursor_), db_path_);
+    mdb_transaction_ = std::make_shared<LMDBReadTransaction>(db_path_);
+    auto* txn = mdb_transaction_->txn();
+
+    // Create cursor
+    CHECK_LMDB(mdb_dbi_open(txn, NULL, 0, &mdb_dbi_), db_path_);
+    CHECK_LMDB(mdb_cursor_open(txn, mdb_dbi_, &mdb_cursor_), db_path_);
     MDB_stat stat;
-    CHECK_LMDB(mdb_stat(mdb_transaction_, mdb_dbi_, &stat), db_path_);
+    CHECK_LMDB(mdb_stat(txn, mdb_dbi_, &stat), db_path_);
     mdb_size_ = stat.ms_entries;
     LOG_LINE << "lmdb " << num_ << " " << db_path_
              << " has " << mdb_size_ << " entries" << std::endl;
+
+    if (!key_cache || !key_cache->Find(db_path_, keys_) || keys_.size() != mdb_size_) {
+      BuildKeyIndex();
+      if (key_cache)
+        key_cache->Insert(db_path_, keys_);
+    }
+    if (mdb_size_ > 0) {
+      MDB_val key;
+      CHECK_LMDB(mdb_cursor_get(mdb_cursor_, &key, nullptr, MDB_FIRST), db_path_);
+    }
     mdb_index_ = 0;
   }
   size_t GetSize() const { return mdb_size_; }
   Index GetIndex() const { return mdb_index_; }
+
+  /**
+   * @brief The transaction keeping the pages of the values returned by SeekByIndex valid
+   */
+  const std::shared_ptr<LMDBReadTransaction>& GetTransaction() const {
+    return mdb_transaction_;
+  }
+
   void SeekByIndex(Index index, MDB_val* key = nullptr, MDB_val* value = nullptr) {
     MDB_val tmp_key, tmp_value;
     if (nullptr == key) {
@@ -77,29 +148,18 @@ class IndexedLMDB {
                << " rewind to the begin from " << mdb_index_ << std::endl;
     }
     DALI_ENFORCE(index >= 0 && index < mdb_size_);
-    if (index == 0) {
-      CHECK_LMDB(mdb_cursor_get(mdb_cursor_, key, value, MDB_FIRST), db_path_);
-    } else if (index == mdb_size_ - 1) {
-      CHECK_LMDB(mdb_cursor_get(mdb_cursor_, key, value, MDB_LAST), db_path_);
-    } else if (index == mdb_index_) {
+    if (index == mdb_index_) {
       CHECK_LMDB(mdb_cursor_get(mdb_cursor_, key, value, MDB_GET_CURRENT), db_path_);
-    } else if (index == mdb_index_ - 1) {
-      CHECK_LMDB(mdb_cursor_get(mdb_cursor_, key, value, MDB_PREV), db_path_);
     } else if (index == mdb_index_ + 1) {
       CHECK_LMDB(mdb_cursor_get(mdb_cursor_, key, value, MDB_NEXT), db_path_);
-    } else if (index > mdb_index_) {
-      LOG_LINE << "lmdb " << num_ << " " << db_path_
-               << " exec a large step forward " << mdb_index_ << "->" << index << std::endl;
-      for (Index i = mdb_index_; i < index; ++i) {
-        CHECK_LMDB(mdb_cursor_get(mdb_cursor_, key, value, MDB_NEXT), db_path_);
-      }
+    } else if (index == mdb_index_ - 1) {
+      CHECK_LMDB(mdb_cursor_get(mdb_cursor_, key, value, MDB_PREV), db_path_);
     } else {
-      // index < mdb_index_
       LOG_LINE << "lmdb " << num_ << " " << db_path_
-               << " exec a large step backward " << mdb_index_ << "->" << index << std::endl;
-      for (Index i = index; i < mdb_index_; i++) {
-        CHECK_LMDB(mdb_cursor_get(mdb_cursor_, key, value, MDB_PREV), db_path_);
-      }
+               << " seek " << mdb_index_ << "->" << index << std::endl;
+      key->mv_data = const_cast<char*>(keys_.key_data(index));
+      key->mv_size = keys_.key_size(index);
+      CHECK_LMDB(mdb_cursor_get(mdb_cursor_, key, value, MDB_SET_KEY), db_path_);
     }
     mdb_index_ = index;
   }
@@ -107,17 +167,28 @@ class IndexedLMDB {
   void Close() {
     if (mdb_cursor_) {
       mdb_cursor_close(mdb_cursor_);
-      mdb_dbi_close(mdb_env_, mdb_dbi_);
       mdb_cursor_ = nullptr;
     }
-    if (mdb_transaction_) {
-      mdb_txn_abort(mdb_transaction_);
-      mdb_transaction_ = nullptr;
-    }
-    if (mdb_env_) {
-      mdb_env_close(mdb_env_);
-      mdb_env_ = nullptr;
+    // The environment is closed once the samples still pointing to its pages are released
+    mdb_transaction_.reset();
+    keys_.clear();
+  }
+
+ private:
+  void BuildKeyIndex() {
+    keys_.clear();
+    MDB_val key;
+    // only the keys are read, the pages of the values are not touched
+    int status = mdb_cursor_get(mdb_cursor_, &key, nullptr, MDB_FIRST);
+    while (status == MDB_SUCCESS) {
+      keys_.push_back(key.mv_data, key.mv_size);
+      status = mdb_cursor_get(mdb_cursor_, &key, nullptr, MDB_NEXT);
     }
+    DALI_ENFORCE(status == MDB_NOTFOUND, "LMDB Error: " + string(mdb_strerror(status)) +
+                                         ", with file: " + db_path_);
+    DALI_ENFORCE(keys_.size() == mdb_size_,
+                 make_string("LMDB Error: expected ", mdb_size_, " entries, found ", keys_.size(),
+                             ", with file: ", db_path_));
   }
 };
 
@@ -149,6 +220,9 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
       std::string path = options.GetArgument<std::string>("path");
       db_paths_.push_back(path);
     }
+    options.TryGetArgument(index_cache_path_, "index_cache_path");
+    // The values are shared with LMDB's memory mapped pages, unless told otherwise
+    copy_read_data_ = dont_use_mmap_;
   }
 
   ~LMDBLoader() override {
@@ -177,7 +251,7 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     MoveToNextShard(current_index_);
 
     std::string image_key = db_paths_[file_index] + " at key " +
-                            to_string(reinterpret_cast<char*>(key.mv_data));
+                            std::string(static_cast<char*>(key.mv_data), key.mv_size);
     DALIMeta meta;
 
     meta.SetSourceInfo(image_key);
@@ -192,11 +266,22 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
       return;
     }
 
+    Index value_size = value.mv_size;
+    if (copy_read_data_) {
+      if (tensor.shares_data()) {
+        tensor.Reset();
+      }
+      tensor.Resize({value_size}, DALI_UINT8);
+      std::memcpy(tensor.raw_mutable_data(),
+                  reinterpret_cast<uint8_t*>(value.mv_data),
+                  value.mv_size * sizeof(uint8_t));
+    } else {
+      // Wrap the mapped value in the Tensor object; the read transaction lives as long as it
+      auto transaction = mdb_[file_index].GetTransaction();
+      shared_ptr<void> p(value.mv_data, [transaction](void*) {});
+      tensor.ShareData(p, value_size, false, {value_size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
+    }
     tensor.SetMeta(meta);
-    tensor.Resize({static_cast<Index>(value.mv_size)}, DALI_UINT8);
-    std::memcpy(tensor.raw_mutable_data(),
-                reinterpret_cast<uint8_t*>(value.mv_data),
-                value.mv_size * sizeof(uint8_t));
   }
 
  protected:
@@ -208,10 +293,15 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     offsets_.resize(db_paths_.size() + 1);
     offsets_[0] = 0;
     mdb_.resize(db_paths_.size());
+    LMDBKeyIndexCache key_cache(index_cache_path_);
     for (size_t i = 0; i < db_paths_.size(); i++) {
-      mdb_[i].Open(db_paths_[i], i);
+      mdb_[i].Open(db_paths_[i], i, &key_cache);
       offsets_[i + 1] = offsets_[i] + mdb_[i].GetSize();
     }
+    if (!index_cache_path_.empty() && key_cache.IsModified() && !key_cache.Save()) {
+      DALI_WARN(make_string("The LMDB key index cache could not be written to ",
+                            index_cache_path_, "."));
+    }
     Reset(true);
   }
 
@@ -230,6 +320,8 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
   }
   using Loader<CPUBackend, Tensor<CPUBackend>>::shard_id_;
   using Loader<CPUBackend, Tensor<CPUBackend>>::num_shards_;
+  using Loader<CPUBackend, Tensor<CPUBackend>>::copy_read_data_;
+  using Loader<CPUBackend, Tensor<CPUBackend>>::dont_use_mmap_;
 
   std::vector<IndexedLMDB> mdb_;
 
@@ -239,6 +331,7 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
 
   // options
   std::vector<std::string> db_paths_;
+  std::string index_cache_path_;
 };
 
 };  // namespace dali
@@ -0,0 +1,139 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/lmdb_key_index.h"
+#include <unistd.h>
+#include <fstream>
+#include <utility>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/operators/reader/loader/filesystem.h"
+
+namespace dali {
+
+using namespace detail::index_file;  // NOLINT
+
+namespace {
+
+/*
+ * Layout of the cache file (native endianness):
+ *   char[8]  magic "DALILMDB"
+ *   uint32   version
+ *   uint64   number of databases
+ * followed by the databases:
+ *   uint32   length of the path, followed by the path
+ *   int64    size of the data file
+ *   int64    modification time of the data file, in nanoseconds
+ *   uint64   number of keys
+ *   uint64[] offsets of the keys, followed by the total length of the keys
+ *   char[]   the keys
+ */
+constexpr char kMagic[8] = { 'D', 'A', 'L', 'I', 'L', 'M', 'D', 'B' };
+constexpr uint32_t kVersion = 1;
+// Sanity limits guarding against allocating memory for a corrupted file
+constexpr uint32_t kMaxPathLength = 1 << 16;
+constexpr uint64_t kMaxKeys = uint64_t(1) << 36;
+constexpr uint64_t kMaxKeyBytes = uint64_t(1) << 40;
+
+}  // namespace
+
+LMDBKeyIndexCache::LMDBKeyIndexCache(const std::string &path) : path_(path) {
+  if (path_.empty() || access(path_.c_str(), F_OK) != 0)
+    return;
+  if (!Load()) {
+    DALI_WARN(make_string("The LMDB key index cache ", path_, " could not be read. The key "
+                          "tables will be rebuilt and the cache overwritten."));
+    tables_.clear();
+  }
+}
+
+bool LMDBKeyIndexCache::Stat(const std::string &db_path, FileSignature &signature) {
+  // The databases are opened as directories, with the entries kept in data.mdb
+  return detail::index_file::Stat(filesystem::join_path(db_path, "data.mdb"), signature);
+}
+
+bool LMDBKeyIndexCache::Load() {
+  std::ifstream in(path_, std::ios::binary);
+  if (!in.is_open())
+    return false;
+  uint64_t num_dbs;
+  if (!ReadHeader(in, kMagic, kVersion) || !ReadValue(in, num_dbs))
+    return false;
+
+  for (uint64_t i = 0; i < num_dbs; i++) {
+    std::string db_path;
+    CachedKeys cached;
+    uint64_t num_keys;
+    if (!ReadString(in, db_path, kMaxPathLength) || !ReadSignature(in, cached.signature) ||
+        !ReadValue(in, num_keys) || num_keys > kMaxKeys)
+      return false;
+    auto &offsets = cached.keys.offsets_;
+    offsets.resize(num_keys + 1);
+    if (!in.read(reinterpret_cast<char *>(offsets.data()), offsets.size() * sizeof(uint64_t)))
+      return false;
+    if (offsets[0] != 0 || offsets.back() > kMaxKeyBytes)
+      return false;
+    for (uint64_t k = 0; k < num_keys; k++) {
+      if (offsets[k] > offsets[k + 1])
+        return false;
+    }
+    cached.keys.keys_.resize(offsets.back());
+    if (!in.read(cached.keys.keys_.data(), cached.keys.keys_.size()))
+      return false;
+    tables_[db_path] = std::move(cached);
+  }
+  return true;
+}
+
+bool LMDBKeyIndexCache::Find(const std::string &db_path, LMDBKeyIndex &keys) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tables_.find(db_path);
+  if (it == tables_.end())
+    return false;
+  FileSignature signature;
+  if (!Stat(db_path, signature) || it->second.signature != signature)
+    return false;
+  keys = it->second.keys;
+  return true;
+}
+
+void LMDBKeyIndexCache::Insert(const std::string &db_path, const LMDBKeyIndex &keys) {
+  CachedKeys cached;
+  if (!Stat(db_path, cached.signature))
+    return;
+  cached.keys = keys;
+  std::lock_guard<std::mutex> lock(mutex_);
+  tables_[db_path] = std::move(cached);
+  modified_ = true;
+}
+
+bool LMDBKeyIndexCache::Save() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return SaveAtomically(path_, [&](std::ostream &out) {
+    WriteHeader(out, kMagic, kVersion);
+    WriteValue(out, static_cast<uint64_t>(tables_.size()));
+    for (auto &entry : tables_) {
+      const auto &cached = entry.second;
+      WriteString(out, entry.first);
+      WriteSignature(out, cached.signature);
+      WriteValue(out, static_cast<uint64_t>(cached.keys.size()));
+      out.write(reinterpret_cast<const char *>(cached.keys.offsets_.data()),
+                cached.keys.offsets_.size() * sizeof(uint64_t));
+      out.write(cached.keys.keys_.data(), cached.keys.keys_.size());
+    }
+    return true;
+  });
+}
+
+}  // namespace dali
@@ -0,0 +1,141 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_LMDB_KEY_INDEX_H_
+#define DALI_OPERATORS_READER_LOADER_LMDB_KEY_INDEX_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/operators/reader/loader/index_file_utils.h"
+
+namespace dali {
+
+/**
+ * @brief Keys of an LMDB database, in the order of the database
+ *
+ * The keys are stored one after another in a single buffer, so that the table of a database
+ * with millions of entries doesn't need millions of allocations.
+ */
+class DLL_PUBLIC LMDBKeyIndex {
+ public:
+  Index size() const {
+    return offsets_.size() - 1;
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  void clear() {
+    offsets_.resize(1);
+    keys_.clear();
+  }
+
+  void push_back(const void *key, size_t length) {
+    auto *key_bytes = static_cast<const char *>(key);
+    keys_.insert(keys_.end(), key_bytes, key_bytes + length);
+    offsets_.push_back(keys_.size());
+  }
+
+  const char *key_data(Index idx) const {
+    return keys_.data() + offsets_[idx];
+  }
+
+  size_t key_size(Index idx) const {
+    return offsets_[idx + 1] - offsets_[idx];
+  }
+
+ private:
+  friend class LMDBKeyIndexCache;
+
+  // key i occupies keys_[offsets_[i]] .. keys_[offsets_[i + 1] - 1]
+  std::vector<uint64_t> offsets_ = { 0 };
+  std::vector<char> keys_;
+};
+
+/**
+ * @brief Cache of the key tables of LMDB databases, kept in a file between the runs.
+ *
+ * Building the table requires a pass over all the entries of a database. An entry of the cache
+ * is valid as long as the size and the modification time of the data file of the database
+ * don't change.
+ *
+ * Find and Insert can be called concurrently.
+ */
+class DLL_PUBLIC LMDBKeyIndexCache {
+ public:
+  /**
+   * @brief Loads the cache from `path`, if the file exists.
+   *
+   * A file which can't be read or is malformed only produces a warning; the tables are then
+   * built from the databases and the file is overwritten by Save.
+   * With an empty path, the cache is kept only in memory.
+   */
+  explicit LMDBKeyIndexCache(const std::string &path);
+
+  /**
+   * @brief Looks up the key table of the database at `db_path`.
+   *
+   * @return True, if the cache holds an up-to-date table of the database.
+   */
+  bool Find(const std::string &db_path, LMDBKeyIndex &keys) const;
+
+  /**
+   * @brief Stores the key table of the database at `db_path`, replacing the previous one, if any.
+   */
+  void Insert(const std::string &db_path, const LMDBKeyIndex &keys);
+
+  /**
+   * @brief Returns true, if any table was inserted since the cache was loaded.
+   */
+  bool IsModified() const {
+    return modified_;
+  }
+
+  /**
+   * @brief Writes the cache to the file it was loaded from.
+   *
+   * The file is written under a temporary name and then renamed, so that the concurrent readers
+   * never see a partially written cache.
+   *
+   * @return False, if the file couldn't be written.
+   */
+  bool Save() const;
+
+ private:
+  struct CachedKeys {
+    detail::index_file::FileSignature signature;
+    LMDBKeyIndex keys;
+  };
+
+  /**
+   * @brief Reads the size and the modification time of the data file of the database
+   */
+  static bool Stat(const std::string &db_path, detail::index_file::FileSignature &signature);
+
+  bool Load();
+
+  std::string path_;
+  std::map<std::string, CachedKeys> tables_;
+  bool modified_ = false;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_LMDB_KEY_INDEX_H_
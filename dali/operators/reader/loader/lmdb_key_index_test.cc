@@ -0,0 +1,122 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/lmdb_key_index.h"
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "dali/core/format.h"
+
+namespace dali {
+
+class LMDBKeyIndexCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    db_path_ = make_string("/tmp/dali_lmdb_key_index_db_", getpid());
+    cache_path_ = make_string("/tmp/dali_lmdb_key_index_", getpid());
+    mkdir(db_path_.c_str(), 0755);
+    std::ofstream(DataPath()) << "not really a database";
+    std::remove(cache_path_.c_str());
+  }
+
+  void TearDown() override {
+    std::remove(DataPath().c_str());
+    rmdir(db_path_.c_str());
+    std::remove(cache_path_.c_str());
+  }
+
+  std::string DataPath() const {
+    return db_path_ + "/data.mdb";
+  }
+
+  static LMDBKeyIndex TestKeys() {
+    LMDBKeyIndex keys;
+    for (const char *key : { "00000000", "00000001", "", "a longer key" })
+      keys.push_back(key, strlen(key));
+    return keys;
+  }
+
+  static void ExpectEqual(const LMDBKeyIndex &a, const LMDBKeyIndex &b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (Index i = 0; i < a.size(); i++) {
+      EXPECT_EQ(std::string(a.key_data(i), a.key_size(i)),
+                std::string(b.key_data(i), b.key_size(i))) << "key " << i;
+    }
+  }
+
+  std::string db_path_, cache_path_;
+};
+
+TEST(LMDBKeyIndexTest, Keys) {
+  LMDBKeyIndex keys;
+  EXPECT_TRUE(keys.empty());
+  keys.push_back("abc", 3);
+  keys.push_back("", 0);
+  keys.push_back("de", 2);
+  ASSERT_EQ(keys.size(), 3);
+  EXPECT_EQ(std::string(keys.key_data(0), keys.key_size(0)), "abc");
+  EXPECT_EQ(keys.key_size(1), 0u);
+  EXPECT_EQ(std::string(keys.key_data(2), keys.key_size(2)), "de");
+  keys.clear();
+  EXPECT_TRUE(keys.empty());
+}
+
+TEST_F(LMDBKeyIndexCacheTest, SaveAndLoad) {
+  {
+    LMDBKeyIndexCache cache(cache_path_);
+    LMDBKeyIndex keys;
+    EXPECT_FALSE(cache.Find(db_path_, keys));
+    cache.Insert(db_path_, TestKeys());
+    EXPECT_TRUE(cache.IsModified());
+    ASSERT_TRUE(cache.Save());
+  }
+
+  LMDBKeyIndexCache cache(cache_path_);
+  EXPECT_FALSE(cache.IsModified());
+  LMDBKeyIndex keys;
+  ASSERT_TRUE(cache.Find(db_path_, keys));
+  ExpectEqual(keys, TestKeys());
+}
+
+TEST_F(LMDBKeyIndexCacheTest, ModifiedDatabase) {
+  LMDBKeyIndexCache cache(cache_path_);
+  cache.Insert(db_path_, TestKeys());
+  LMDBKeyIndex keys;
+  ASSERT_TRUE(cache.Find(db_path_, keys));
+
+  std::ofstream(DataPath(), std::ios::app) << ", and longer now";
+  EXPECT_FALSE(cache.Find(db_path_, keys));
+}
+
+TEST_F(LMDBKeyIndexCacheTest, CorruptedFile) {
+  {
+    LMDBKeyIndexCache cache(cache_path_);
+    cache.Insert(db_path_, TestKeys());
+    ASSERT_TRUE(cache.Save());
+  }
+  // cut the file in the middle of the keys
+  struct stat file_stat;
+  ASSERT_EQ(stat(cache_path_.c_str(), &file_stat), 0);
+  ASSERT_EQ(truncate(cache_path_.c_str(), file_stat.st_size - 4), 0);
+
+  LMDBKeyIndexCache cache(cache_path_);
+  LMDBKeyIndex keys;
+  EXPECT_FALSE(cache.Find(db_path_, keys));
+}
+
+}  // namespace dali
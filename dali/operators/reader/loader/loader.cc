@@ -51,6 +51,14 @@ decreases the time of all of the following accesses.)code", false)
 
 This value should be increased when the pipeline is CPU-stage bound, trading memory
 consumption for better interleaving with the Loader thread.)code", 1)
+  .AddOptionalArg("io_threads",
+      R"code(Number of threads used to read the samples of a prefetched batch concurrently.
+
+If set to 0, the samples are read one by one by the prefetching thread. Concurrent reads
+help when the data is kept on a high-latency storage, like network file systems or NVMe
+drives with deep queues. The order of the samples is the same as with sequential reads.
+
+Readers that do not support concurrent reads ignore this argument.)code", 0)
   .AddOptionalArg("skip_cached_images",
       R"code(If set to True, the loading data will be skipped when the sample is
 in the decoder cache.
@@ -73,6 +81,34 @@ Mapping provides a small performance benefit when accessing a local file system,
 systems, do not provide optimum performance.
 )code", false);
 
+DALI_SCHEMA(GlobalShuffleLoaderBase)
+  .AddOptionalArg("global_shuffle",
+      R"code(If set to True, the reader shuffles the entire dataset in each epoch.
+
+Unlike ``random_shuffle``, which picks the samples from a buffer of ``initial_fill`` samples read
+in order, this permutes all the samples of the dataset, without keeping them in memory.
+To keep the reads mostly sequential, the dataset is split into blocks of ``shuffle_block_size``
+consecutive samples, which are shuffled, and then the samples are shuffled within windows of
+``shuffle_window_size`` samples.
+
+The permutation depends on ``seed`` and on the epoch. All the shards must use the same
+permutation to cover the whole dataset together in every epoch, so, if ``seed`` is set, it must be
+the same in all of them. If it's not set, a fixed seed is used instead of the one populated by
+the pipeline. ``stick_to_shard`` and ``random_shuffle`` cannot be used when this argument is set
+to True.)code", false)
+  .AddOptionalArg("shuffle_block_size",
+      R"code(Number of consecutive samples shuffled together as a block when ``global_shuffle``
+is set to True.
+
+Larger blocks keep the reads more sequential, at the cost of the quality of the shuffling.)code",
+      64)
+  .AddOptionalArg("shuffle_window_size",
+      R"code(Number of consecutive samples of the shuffled blocks, which are then shuffled
+together, when ``global_shuffle`` is set to True.
+
+A window spanning several blocks mixes the samples of the blocks, while the reads are spread only
+over that few blocks.)code", 1024);
+
 size_t start_index(const size_t shard_id,
                    const size_t shard_num,
                    const size_t size) {
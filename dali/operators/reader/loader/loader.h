@@ -26,12 +26,15 @@
 #include <vector>
 #include <deque>
 #include <atomic>
+#include <functional>
 
+#include "dali/core/call_at_exit.h"
 #include "dali/core/nvtx.h"
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/pipeline/data/tensor.h"
+#include "dali/pipeline/util/thread_pool.h"
 #include "dali/operators/decoder/cache/image_cache_factory.h"
 
 namespace dali {
@@ -328,6 +331,44 @@ class Loader {
   // reads.
   virtual void ReadSample(LoadTarget& tensor) = 0;
 
+  /**
+   * @brief Returns true if the loader's `ReadSample` can hand off its I/O via `ReadOrDefer`.
+   *
+   * Such loaders do only the bookkeeping (advancing the position, assigning the metadata)
+   * in `ReadSample` itself, so the I/O of multiple samples can be done concurrently.
+   */
+  virtual bool SupportsDeferredReads() const {
+    return false;
+  }
+
+  /**
+   * @brief Makes subsequent `ReadOne` calls postpone the I/O of the samples
+   *        until `RunDeferredReads` is called.
+   *
+   * The order of the samples, sharding and the loader's state are not affected - only
+   * the contents of the returned targets are filled later.
+   */
+  void DeferReads() {
+    defer_reads_ = SupportsDeferredReads();
+  }
+
+  /**
+   * @brief Executes the I/O postponed since the last call to `DeferReads` in `thread_pool`
+   *        and waits for its completion.
+   */
+  void RunDeferredReads(ThreadPool &thread_pool) {
+    defer_reads_ = false;
+    if (deferred_reads_.empty())
+      return;
+    auto cleanup = AtScopeExit([&]() { deferred_reads_.clear(); });
+    DomainTimeRange tr("[DALI][Loader] RunDeferredReads", DomainTimeRange::kBlue1);
+    for (int64_t i = 0; i < static_cast<int64_t>(deferred_reads_.size()); i++) {
+      // negative priority - keep the reading order as close to sequential as possible
+      thread_pool.AddWork([this, i](int) { deferred_reads_[i](); }, -i);
+    }
+    thread_pool.RunAll();
+  }
+
   /**
    * @brief Advances loader position in the data source by skipping n samples.
    * @warning This generic implementation is very inefficient and should be overriden.
@@ -445,6 +486,20 @@ class Loader {
     }
   }
 
+  /**
+   * @brief Executes `read` right away or, if `DeferReads` is in effect, stores it
+   *        to be run concurrently with the I/O of other samples.
+   *
+   * `read` must not access any mutable state of the loader.
+   */
+  template <typename ReadFn>
+  void ReadOrDefer(ReadFn &&read) {
+    if (defer_reads_)
+      deferred_reads_.emplace_back(std::forward<ReadFn>(read));
+    else
+      read();
+  }
+
   bool ShouldSkipImage(const ImageCache::ImageKey& key) {
     if (!skip_cached_images_)
       return false;
@@ -586,6 +641,10 @@ class Loader {
   std::deque<ShardBoundaries> shards_;
 
  private:
+  // I/O postponed by ReadOrDefer, executed by RunDeferredReads
+  bool defer_reads_ = false;
+  std::vector<std::function<void()>> deferred_reads_;
+
   bool initial_buffer_filled_ = false;
   // Counts how many samples the reader have read already from this epoch
   Index read_sample_counter_ = 0;
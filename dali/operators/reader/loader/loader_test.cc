@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <cstring>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "dali/core/common.h"
 #include "dali/pipeline/data/backend.h"
@@ -62,6 +65,58 @@ TYPED_TEST(DataLoadStoreTest, LMDBTest) {
     auto sample = reader->ReadOne(false, false);
   }
 }
+
+TYPED_TEST(DataLoadStoreTest, LMDBSeekByIndex) {
+  IndexedLMDB db;
+  db.Open(testing::dali_extra_path() + "/db/c2lmdb/", 0);
+  Index size = db.GetSize();
+  ASSERT_GT(size, 3);
+
+  std::vector<std::string> keys(size);
+  std::vector<void *> values(size);
+  for (Index i = 0; i < size; i++) {
+    MDB_val key, value;
+    db.SeekByIndex(i, &key, &value);
+    keys[i] = std::string(static_cast<char *>(key.mv_data), key.mv_size);
+    values[i] = value.mv_data;
+  }
+
+  for (Index i : { size - 1, Index(0), size / 2, Index(1), size - 2, size / 3, size / 3 + 1 }) {
+    MDB_val key, value;
+    db.SeekByIndex(i, &key, &value);
+    EXPECT_EQ(std::string(static_cast<char *>(key.mv_data), key.mv_size), keys[i]);
+    EXPECT_EQ(value.mv_data, values[i]);
+    EXPECT_EQ(db.GetIndex(), i);
+  }
+  db.Close();
+}
+
+TYPED_TEST(DataLoadStoreTest, LMDBSharedValues) {
+  for (bool dont_use_mmap : { true, false }) {
+    shared_ptr<dali::LMDBLoader> reader(
+        new LMDBLoader(
+            OpSpec("CaffeReader")
+            .AddArg("max_batch_size", 32)
+            .AddArg("path", testing::dali_extra_path() + "/db/c2lmdb/")
+            .AddArg("device_id", 0)
+            .AddArg("dont_use_mmap", dont_use_mmap)));
+    reader->PrepareMetadata();
+
+    std::shared_ptr<void> data;
+    std::vector<uint8_t> expected;
+    {
+      auto sample = reader->ReadOne(false, false);
+      EXPECT_EQ(sample->shares_data(), !dont_use_mmap);
+      auto *sample_data = sample->template data<uint8_t>();
+      expected.assign(sample_data, sample_data + sample->size());
+      data = sample->get_data_ptr();
+    }
+    // the mapped values stay valid after the reader is destroyed
+    reader.reset();
+    ASSERT_GT(expected.size(), 0u);
+    EXPECT_EQ(std::memcmp(data.get(), expected.data(), expected.size()), 0);
+  }
+}
 #endif
 
 TYPED_TEST(DataLoadStoreTest, FileLabelLoaderMmmap) {
@@ -80,6 +135,42 @@ TYPED_TEST(DataLoadStoreTest, FileLabelLoaderMmmap) {
   }
 }
 
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderDeferredReads) {
+  for (bool dont_use_mmap : {true, false}) {
+    auto spec = OpSpec("FileReader")
+                  .AddArg("file_root", loader_test_image_folder)
+                  .AddArg("max_batch_size", 8)
+                  .AddArg("device_id", 0)
+                  .AddArg("initial_fill", 16)
+                  .AddArg("random_shuffle", true)
+                  .AddArg("seed", 123)
+                  .AddArg("dont_use_mmap", dont_use_mmap);
+    auto reference = InitLoader<FileLabelLoader>(spec);
+    auto loader = InitLoader<FileLabelLoader>(spec);
+    ASSERT_TRUE(loader->SupportsDeferredReads());
+    ThreadPool tp(4, CPU_ONLY_DEVICE_ID, false, "FileLabelLoaderDeferredReads");
+
+    for (int batch = 0; batch < 5; batch++) {
+      std::vector<std::shared_ptr<ImageLabelWrapper>> ref_batch, batch_samples;
+      loader->DeferReads();
+      for (int i = 0; i < 8; i++) {
+        ref_batch.push_back(reference->ReadOne(i == 0, i == 7));
+        batch_samples.push_back(loader->ReadOne(i == 0, i == 7));
+      }
+      loader->RunDeferredReads(tp);
+      for (int i = 0; i < 8; i++) {
+        auto &ref = *ref_batch[i];
+        auto &sample = *batch_samples[i];
+        EXPECT_EQ(sample.label, ref.label);
+        EXPECT_EQ(sample.image.GetSourceInfo(), ref.image.GetSourceInfo());
+        ASSERT_EQ(sample.image.shape(), ref.image.shape());
+        EXPECT_EQ(std::memcmp(sample.image.raw_data(), ref.image.raw_data(),
+                              ref.image.nbytes()), 0);
+      }
+    }
+  }
+}
+
 TYPED_TEST(DataLoadStoreTest, RecordIOLoaderMmmap) {
   for (bool dont_use_mmap : {true, false}) {
     std::vector<std::string> path =  {testing::dali_extra_path() + "/db/recordio/train.rec"};
@@ -0,0 +1,330 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/persistent_cache_file.h"
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace detail {
+namespace pcache {
+
+uint64_t Checksum(const void *data, size_t size) {
+  constexpr uint64_t kPrime = 0x100000001b3ull;
+  uint64_t h = 0xcbf29ce484222325ull;
+  auto *bytes = static_cast<const uint8_t *>(data);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    h = (h ^ word) * kPrime;
+  }
+  for (; i < size; i++)
+    h = (h ^ bytes[i]) * kPrime;
+  return h;
+}
+
+namespace {
+
+class IndexBuilder {
+ public:
+  template <typename T>
+  void Put(const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivial types can be stored");
+    auto *p = reinterpret_cast<const char *>(&value);
+    buf_.insert(buf_.end(), p, p + sizeof(T));
+  }
+
+  void PutString(const std::string &s) {
+    Put<uint32_t>(s.size());
+    buf_.insert(buf_.end(), s.begin(), s.end());
+  }
+
+  const std::vector<char> &data() const {
+    return buf_;
+  }
+
+ private:
+  std::vector<char> buf_;
+};
+
+class IndexParser {
+ public:
+  IndexParser(const std::vector<char> &buf, const std::string &path) : buf_(buf), path_(path) {}
+
+  template <typename T>
+  T Get() {
+    Check(sizeof(T));
+    T value;
+    std::memcpy(&value, buf_.data() + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  std::string GetString() {
+    size_t size = Get<uint32_t>();
+    Check(size);
+    std::string s(buf_.data() + pos_, size);
+    pos_ += size;
+    return s;
+  }
+
+  bool AtEnd() const {
+    return pos_ == buf_.size();
+  }
+
+ private:
+  void Check(size_t size) const {
+    DALI_ENFORCE(pos_ + size <= buf_.size(), make_string(
+      "Corrupted persistent cache file \"", path_, "\": unexpected end of the index."));
+  }
+
+  const std::vector<char> &buf_;
+  const std::string &path_;
+  size_t pos_ = 0;
+};
+
+void ReadExact(InputStream &stream, void *dst, size_t size, const std::string &path) {
+  DALI_ENFORCE(stream.Read(dst, size) == size, make_string(
+    "Error reading the persistent cache file \"", path, "\"."));
+}
+
+}  // namespace
+
+CacheIndex ReadIndex(InputStream &stream, const std::string &path) {
+  CacheIndex index;
+  auto fail = [&](const char *what) {
+    DALI_FAIL(make_string("Corrupted persistent cache file \"", path, "\": ", what));
+  };
+
+  int64_t file_size = stream.Size();
+  char magic[sizeof(kMagic)];
+  uint32_t version, num_outputs;
+  uint64_t key_len;
+  int64_t header_size = sizeof(magic) + sizeof(version) + sizeof(num_outputs) + sizeof(key_len);
+  if (file_size < header_size + kFooterSize)
+    fail("the file is too short.");
+
+  stream.SeekRead(0);
+  ReadExact(stream, magic, sizeof(magic), path);
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)))
+    fail("invalid header.");
+  ReadExact(stream, &version, sizeof(version), path);
+  DALI_ENFORCE(version == kVersion, make_string("The persistent cache file \"", path,
+    "\" has an unsupported version ", version, "; expected ", kVersion, "."));
+  ReadExact(stream, &num_outputs, sizeof(num_outputs), path);
+  if (num_outputs < 1 || num_outputs > 1024)
+    fail("invalid number of outputs.");
+  ReadExact(stream, &key_len, sizeof(key_len), path);
+  if (header_size + static_cast<int64_t>(key_len) + kFooterSize > file_size)
+    fail("invalid key length.");
+  index.key.resize(key_len);
+  ReadExact(stream, &index.key[0], key_len, path);
+  index.num_outputs = num_outputs;
+  int64_t data_start = header_size + key_len;
+
+  uint64_t index_offset, index_size, index_checksum;
+  stream.SeekRead(file_size - kFooterSize);
+  ReadExact(stream, &index_offset, sizeof(index_offset), path);
+  ReadExact(stream, &index_size, sizeof(index_size), path);
+  ReadExact(stream, &index_checksum, sizeof(index_checksum), path);
+  ReadExact(stream, magic, sizeof(magic), path);
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)))
+    fail("the footer is missing - the file is incomplete.");
+  int64_t index_end = file_size - kFooterSize;
+  if (index_offset < static_cast<uint64_t>(data_start) ||
+      index_offset > static_cast<uint64_t>(index_end) ||
+      index_size != static_cast<uint64_t>(index_end) - index_offset)
+    fail("invalid index location.");
+
+  std::vector<char> buf(index_size);
+  stream.SeekRead(index_offset);
+  ReadExact(stream, buf.data(), index_size, path);
+  if (Checksum(buf.data(), buf.size()) != index_checksum)
+    fail("index checksum mismatch.");
+
+  IndexParser parser(buf, path);
+  uint64_t num_samples = parser.Get<uint64_t>();
+  // each sample takes at least a few bytes of the index
+  if (num_samples > index_size)
+    fail("invalid number of samples.");
+  index.samples.reserve(num_samples);
+  for (uint64_t i = 0; i < num_samples; i++) {
+    SampleEntry sample;
+    sample.source_info = parser.GetString();
+    sample.outputs.resize(num_outputs);
+    for (auto &out : sample.outputs) {
+      out.type = static_cast<DALIDataType>(parser.Get<int32_t>());
+      int ndim = parser.Get<int32_t>();
+      if (ndim < 0 || ndim > 64)
+        fail("invalid number of dimensions.");
+      out.shape.resize(ndim);
+      // the volume is bounded by the file size, so that computing the size can't overflow
+      int64_t vol = 1;
+      for (int d = 0; d < ndim; d++) {
+        int64_t extent = parser.Get<int64_t>();
+        if (extent < 0)
+          fail("negative shape extent.");
+        if (extent > 0 && vol > file_size / extent)
+          fail("sample data out of bounds.");
+        vol *= extent;
+        out.shape[d] = extent;
+      }
+      std::string layout = parser.GetString();
+      if (layout.size() > static_cast<size_t>(TensorLayout::max_ndim))
+        fail("invalid layout.");
+      out.layout = layout;
+      out.offset = parser.Get<int64_t>();
+      out.nbytes = parser.Get<int64_t>();
+      out.checksum = parser.Get<uint64_t>();
+      auto *type_info = TypeTable::TryGetTypeInfo(out.type);
+      if (!type_info || out.nbytes != vol * static_cast<int64_t>(type_info->size()))
+        fail("invalid type or shape of a sample.");
+      if (out.offset < data_start || out.offset > static_cast<int64_t>(index_offset) ||
+          out.nbytes > static_cast<int64_t>(index_offset) - out.offset)
+        fail("sample data out of bounds.");
+    }
+    index.samples.push_back(std::move(sample));
+  }
+  if (!parser.AtEnd())
+    fail("unexpected data at the end of the index.");
+  return index;
+}
+
+CacheFileWriter::CacheFileWriter(std::string path, std::string key, int num_outputs)
+    : path_(std::move(path)) {
+  static std::atomic<int> counter{0};
+  tmp_path_ = make_string(path_, ".tmp.", getpid(), ".", counter++);
+  index_.key = std::move(key);
+  index_.num_outputs = num_outputs;
+  file_ = std::fopen(tmp_path_.c_str(), "wb");
+  DALI_ENFORCE(file_ != nullptr, make_string("Cannot create the persistent cache file \"",
+    tmp_path_, "\": ", std::strerror(errno)));
+
+  Write(kMagic, sizeof(kMagic));
+  uint32_t version = kVersion, n = num_outputs;
+  uint64_t key_len = index_.key.size();
+  Write(&version, sizeof(version));
+  Write(&n, sizeof(n));
+  Write(&key_len, sizeof(key_len));
+  Write(index_.key.data(), key_len);
+}
+
+CacheFileWriter::~CacheFileWriter() {
+  Discard();
+}
+
+void CacheFileWriter::Write(const void *data, size_t size) {
+  DALI_ENFORCE(std::fwrite(data, 1, size, file_) == size, make_string(
+    "Error writing the persistent cache file \"", tmp_path_, "\": ", std::strerror(errno)));
+  pos_ += size;
+}
+
+void CacheFileWriter::Pad(int64_t alignment) {
+  static const char zeros[kDataAlignment] = {};
+  assert(alignment <= kDataAlignment);
+  int64_t padding = align_up(pos_, alignment) - pos_;
+  if (padding)
+    Write(zeros, padding);
+}
+
+void CacheFileWriter::Append(const std::string &source_info,
+                             const std::vector<SampleData> &outputs) {
+  DALI_ENFORCE(file_ != nullptr, "The cache file was already committed or discarded.");
+  DALI_ENFORCE(static_cast<int>(outputs.size()) == index_.num_outputs, make_string(
+    "Expected ", index_.num_outputs, " outputs to be cached, got ", outputs.size(), "."));
+  DALI_ENFORCE(!Contains(source_info), make_string(
+    "The sample \"", source_info, "\" is already cached."));
+
+  SampleEntry sample;
+  sample.source_info = source_info;
+  sample.outputs.resize(outputs.size());
+  for (size_t i = 0; i < outputs.size(); i++) {
+    auto &in = outputs[i];
+    auto &out = sample.outputs[i];
+    Pad(kDataAlignment);
+    out.type = in.type;
+    out.shape = in.shape;
+    out.layout = in.layout;
+    out.offset = pos_;
+    out.nbytes = volume(in.shape) * TypeTable::GetTypeInfo(in.type).size();
+    out.checksum = Checksum(in.data, out.nbytes);
+    Write(in.data, out.nbytes);
+  }
+  index_.samples.push_back(std::move(sample));
+  source_infos_.insert(source_info);
+}
+
+void CacheFileWriter::Commit() {
+  DALI_ENFORCE(file_ != nullptr, "The cache file was already committed or discarded.");
+  // The order of the samples doesn't depend on the order in which they were seen
+  std::sort(index_.samples.begin(), index_.samples.end(),
+            [](const SampleEntry &a, const SampleEntry &b) {
+              return a.source_info < b.source_info;
+            });
+  IndexBuilder builder;
+  builder.Put<uint64_t>(index_.samples.size());
+  for (auto &sample : index_.samples) {
+    builder.PutString(sample.source_info);
+    for (auto &out : sample.outputs) {
+      builder.Put<int32_t>(out.type);
+      builder.Put<int32_t>(out.shape.size());
+      for (auto extent : out.shape)
+        builder.Put<int64_t>(extent);
+      builder.PutString(out.layout.str());
+      builder.Put<int64_t>(out.offset);
+      builder.Put<int64_t>(out.nbytes);
+      builder.Put<uint64_t>(out.checksum);
+    }
+  }
+  auto &buf = builder.data();
+  Pad(sizeof(uint64_t));
+  uint64_t index_offset = pos_, index_size = buf.size();
+  uint64_t index_checksum = Checksum(buf.data(), buf.size());
+  Write(buf.data(), buf.size());
+  Write(&index_offset, sizeof(index_offset));
+  Write(&index_size, sizeof(index_size));
+  Write(&index_checksum, sizeof(index_checksum));
+  Write(kMagic, sizeof(kMagic));
+
+  bool ok = std::fflush(file_) == 0 && fsync(fileno(file_)) == 0;
+  ok = (std::fclose(file_) == 0) && ok;
+  file_ = nullptr;
+  if (!ok || std::rename(tmp_path_.c_str(), path_.c_str()) != 0) {
+    int err = errno;
+    std::remove(tmp_path_.c_str());
+    DALI_FAIL(make_string("Cannot write the persistent cache file \"", path_, "\": ",
+                          std::strerror(err)));
+  }
+}
+
+void CacheFileWriter::Discard() {
+  if (!file_)
+    return;
+  std::fclose(file_);
+  file_ = nullptr;
+  std::remove(tmp_path_.c_str());
+}
+
+}  // namespace pcache
+}  // namespace detail
+}  // namespace dali
@@ -0,0 +1,136 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_PERSISTENT_CACHE_FILE_H_
+#define DALI_OPERATORS_READER_LOADER_PERSISTENT_CACHE_FILE_H_
+
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/tensor_layout.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/types.h"
+#include "dali/util/file.h"
+
+namespace dali {
+namespace detail {
+namespace pcache {
+
+/**
+ * The persistent cache file consists of:
+ *  - the header: magic, version, number of outputs and the invalidation key,
+ *  - the data of the samples, each output aligned to kDataAlignment bytes,
+ *  - the index, describing every sample (source info, and type, shape, layout, offset, size
+ *    and checksum of each output),
+ *  - the footer: offset, size and checksum of the index, followed by the magic.
+ *
+ * The footer is written last, so an interrupted write never produces a file that looks valid.
+ */
+static constexpr char kMagic[8] = {'D', 'A', 'L', 'I', 'P', 'C', 'F', '\0'};
+static constexpr uint32_t kVersion = 1;
+static constexpr int64_t kDataAlignment = 64;
+static constexpr int64_t kFooterSize = 3 * sizeof(uint64_t) + sizeof(kMagic);
+
+/**
+ * @brief A 64-bit FNV-1a-like checksum, computed over 8-byte words
+ */
+DLL_PUBLIC uint64_t Checksum(const void *data, size_t size);
+
+struct OutputEntry {
+  DALIDataType type = DALI_NO_TYPE;
+  TensorShape<> shape;
+  TensorLayout layout;
+  int64_t offset = 0;
+  int64_t nbytes = 0;
+  uint64_t checksum = 0;
+};
+
+struct SampleEntry {
+  std::string source_info;
+  std::vector<OutputEntry> outputs;
+};
+
+struct CacheIndex {
+  std::string key;
+  int num_outputs = 0;
+  std::vector<SampleEntry> samples;
+};
+
+/**
+ * @brief Reads and validates the header, the footer and the index of a cache file
+ *
+ * Throws if the file is not a complete cache file or the index is corrupted.
+ * The data checksums are not verified here - see `Checksum`.
+ */
+DLL_PUBLIC CacheIndex ReadIndex(InputStream &stream, const std::string &path);
+
+/**
+ * @brief Writes the cache file
+ *
+ * The data is written to a temporary file next to `path`, which replaces `path` only when
+ * the cache is committed. If the writer is destroyed without committing, the temporary file
+ * is removed.
+ */
+class DLL_PUBLIC CacheFileWriter {
+ public:
+  struct SampleData {
+    const void *data;
+    DALIDataType type;
+    TensorShape<> shape;
+    TensorLayout layout;
+  };
+
+  CacheFileWriter(std::string path, std::string key, int num_outputs);
+  ~CacheFileWriter();
+
+  DISABLE_COPY_MOVE_ASSIGN(CacheFileWriter);
+
+  bool Contains(const std::string &source_info) const {
+    return source_infos_.count(source_info) > 0;
+  }
+
+  int64_t NumSamples() const {
+    return index_.samples.size();
+  }
+
+  void Append(const std::string &source_info, const std::vector<SampleData> &outputs);
+
+  /**
+   * @brief Writes the index and the footer and moves the file to its final location
+   */
+  void Commit();
+
+  /**
+   * @brief Removes the temporary file; the cache is not written
+   */
+  void Discard();
+
+ private:
+  void Write(const void *data, size_t size);
+  void Pad(int64_t alignment);
+
+  std::string path_, tmp_path_;
+  std::FILE *file_ = nullptr;
+  int64_t pos_ = 0;
+  CacheIndex index_;
+  std::unordered_set<std::string> source_infos_;
+};
+
+}  // namespace pcache
+}  // namespace detail
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_PERSISTENT_CACHE_FILE_H_
@@ -0,0 +1,197 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/persistent_cache_file.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace dali {
+namespace detail {
+namespace pcache {
+namespace test {
+
+class PersistentCacheFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = "/tmp/dali_pcache_XXXXXX";
+    int fd = mkstemp(&path_[0]);
+    ASSERT_NE(-1, fd);
+    close(fd);
+    std::remove(path_.c_str());
+  }
+
+  void TearDown() override {
+    std::remove(path_.c_str());
+  }
+
+  void WriteCache(const std::string &key) {
+    CacheFileWriter writer(path_, key, 2);
+    for (int i = 0; i < kNumSamples; i++) {
+      images_[i].assign((i + 1) * 100, 10 + i);
+      labels_[i] = i;
+      int64_t len = images_[i].size();
+      writer.Append("sample" + std::to_string(kNumSamples - 1 - i), {
+        { images_[i].data(), DALI_UINT8, { len / 4, 4, 1 }, "HWC" },
+        { &labels_[i], DALI_INT32, {}, "" }
+      });
+    }
+    EXPECT_TRUE(writer.Contains("sample0"));
+    EXPECT_FALSE(writer.Contains("sample3"));
+    writer.Commit();
+  }
+
+  CacheIndex ReadCacheIndex() {
+    auto file = FileStream::Open(path_, false, false);
+    return ReadIndex(*file, path_);
+  }
+
+  void Corrupt(int64_t offset_from_end) {
+    std::FILE *f = std::fopen(path_.c_str(), "r+b");
+    ASSERT_NE(nullptr, f);
+    std::fseek(f, -offset_from_end, SEEK_END);
+    int c = std::fgetc(f);
+    std::fseek(f, -offset_from_end, SEEK_END);
+    std::fputc(c ^ 0xff, f);
+    std::fclose(f);
+  }
+
+  /**
+   * @brief Overwrites a value in the index and updates the index checksum, so that only
+   *        the validation of the entries can detect it
+   */
+  template <typename T>
+  void PatchIndex(int64_t offset_in_index, T value) {
+    std::FILE *f = std::fopen(path_.c_str(), "r+b");
+    ASSERT_NE(nullptr, f);
+    uint64_t footer[3];  // index offset, index size, index checksum
+    std::fseek(f, -kFooterSize, SEEK_END);
+    ASSERT_EQ(std::fread(footer, sizeof(footer), 1, f), 1u);
+    std::vector<char> index(footer[1]);
+    std::fseek(f, footer[0], SEEK_SET);
+    ASSERT_EQ(std::fread(index.data(), index.size(), 1, f), 1u);
+    std::memcpy(index.data() + offset_in_index, &value, sizeof(value));
+    footer[2] = Checksum(index.data(), index.size());
+    std::fseek(f, footer[0], SEEK_SET);
+    std::fwrite(index.data(), index.size(), 1, f);
+    std::fseek(f, -kFooterSize, SEEK_END);
+    std::fwrite(footer, sizeof(footer), 1, f);
+    std::fclose(f);
+  }
+
+  // The offsets in the index of the entries of the first sample's image:
+  // num_samples, source info "sample0", type and ndim precede the shape
+  static constexpr int64_t kFirstExtentOffset = 8 + 4 + 7 + 4 + 4;
+  // the shape and the layout "HWC" precede the data offset
+  static constexpr int64_t kDataOffsetOffset = kFirstExtentOffset + 3 * 8 + 4 + 3;
+
+  static constexpr int kNumSamples = 3;
+  std::string path_;
+  std::vector<uint8_t> images_[kNumSamples];
+  int labels_[kNumSamples];
+};
+
+TEST_F(PersistentCacheFileTest, WriteRead) {
+  WriteCache("key");
+  auto index = ReadCacheIndex();
+  EXPECT_EQ(index.key, "key");
+  EXPECT_EQ(index.num_outputs, 2);
+  ASSERT_EQ(index.samples.size(), static_cast<size_t>(kNumSamples));
+
+  auto file = FileStream::Open(path_, false, false);
+  for (int s = 0; s < kNumSamples; s++) {
+    // the samples are sorted by the source info
+    auto &sample = index.samples[s];
+    EXPECT_EQ(sample.source_info, "sample" + std::to_string(s));
+    int i = kNumSamples - 1 - s;
+    auto &image = sample.outputs[0];
+    EXPECT_EQ(image.type, DALI_UINT8);
+    EXPECT_EQ(image.shape, TensorShape<>(images_[i].size() / 4, 4, 1));
+    EXPECT_EQ(image.layout, "HWC");
+    EXPECT_EQ(image.offset % kDataAlignment, 0);
+    std::vector<uint8_t> data(image.nbytes);
+    file->SeekRead(image.offset);
+    ASSERT_EQ(file->Read(data.data(), data.size()), data.size());
+    EXPECT_EQ(data, images_[i]);
+    EXPECT_EQ(Checksum(data.data(), data.size()), image.checksum);
+
+    auto &label = sample.outputs[1];
+    EXPECT_EQ(label.type, DALI_INT32);
+    EXPECT_EQ(label.shape.size(), 0);
+    EXPECT_EQ(label.layout, "");
+    int value = -1;
+    file->SeekRead(label.offset);
+    ASSERT_EQ(file->Read(&value, sizeof(value)), sizeof(value));
+    EXPECT_EQ(value, labels_[i]);
+  }
+}
+
+TEST_F(PersistentCacheFileTest, NotCommitted) {
+  {
+    CacheFileWriter writer(path_, "key", 1);
+    uint8_t data[16] = {};
+    writer.Append("sample", {{ data, DALI_UINT8, { 16 }, "" }});
+  }
+  EXPECT_NE(0, access(path_.c_str(), F_OK));
+}
+
+TEST_F(PersistentCacheFileTest, CorruptedIndex) {
+  WriteCache("key");
+  Corrupt(kFooterSize + 1);
+  EXPECT_THROW(ReadCacheIndex(), std::runtime_error);
+}
+
+TEST_F(PersistentCacheFileTest, MissingFooter) {
+  WriteCache("key");
+  Corrupt(1);
+  EXPECT_THROW(ReadCacheIndex(), std::runtime_error);
+}
+
+TEST_F(PersistentCacheFileTest, InvalidEntries) {
+  WriteCache("key");
+  ASSERT_NO_THROW(ReadCacheIndex());
+  PatchIndex<int64_t>(kFirstExtentOffset, -25);
+  EXPECT_THROW(ReadCacheIndex(), std::runtime_error);
+
+  WriteCache("key");
+  PatchIndex<int64_t>(kFirstExtentOffset, int64_t(1) << 62);
+  EXPECT_THROW(ReadCacheIndex(), std::runtime_error);
+
+  WriteCache("key");
+  // offset + nbytes would overflow
+  PatchIndex<int64_t>(kDataOffsetOffset, std::numeric_limits<int64_t>::max() - 10);
+  EXPECT_THROW(ReadCacheIndex(), std::runtime_error);
+}
+
+TEST_F(PersistentCacheFileTest, Checksum) {
+  std::vector<uint8_t> data(1001);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = i * 7;
+  uint64_t checksum = Checksum(data.data(), data.size());
+  for (size_t i : { 0, 500, 1000 }) {
+    data[i] ^= 1;
+    EXPECT_NE(Checksum(data.data(), data.size()), checksum);
+    data[i] ^= 1;
+  }
+  EXPECT_EQ(Checksum(data.data(), data.size()), checksum);
+}
+
+}  // namespace test
+}  // namespace pcache
+}  // namespace detail
+}  // namespace dali
@@ -0,0 +1,100 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/persistent_cache_loader.h"
+#include <string>
+#include "dali/core/format.h"
+
+namespace dali {
+
+PersistentCacheLoader::PersistentCacheLoader(const OpSpec &spec)
+    : Loader(spec),
+      path_(spec.GetArgument<std::string>("path")),
+      key_(spec.GetArgument<std::string>("key")),
+      num_outputs_(spec.GetArgument<int>("num_outputs")),
+      check_integrity_(spec.GetArgument<bool>("check_integrity")) {
+  DALI_ENFORCE(!path_.empty(), "``path`` cannot be empty.");
+}
+
+void PersistentCacheLoader::PrepareEmpty(vector<Tensor<CPUBackend>> &sample) {
+  sample = std::vector<Tensor<CPUBackend>>(num_outputs_);
+  for (auto &tensor : sample) {
+    tensor.set_pinned(false);
+    tensor.reserve(tensor_init_bytes_);
+  }
+}
+
+void PersistentCacheLoader::ReadSample(vector<Tensor<CPUBackend>> &sample) {
+  MoveToNextShard(current_index_);
+  auto &entry = index_.samples[current_index_++];
+
+  DALIMeta meta;
+  meta.SetSourceInfo(entry.source_info);
+  for (int i = 0; i < num_outputs_; i++) {
+    auto &out = entry.outputs[i];
+    auto &tensor = sample[i];
+    file_->SeekRead(out.offset);
+    if (!copy_read_data_) {
+      auto p = file_->Get(out.nbytes);
+      DALI_ENFORCE(p != nullptr, "Error reading from a file " + path_);
+      tensor.ShareData(p, out.nbytes, false, out.shape, out.type, CPU_ONLY_DEVICE_ID);
+    } else {
+      if (tensor.shares_data())
+        tensor.Reset();
+      tensor.Resize(out.shape, out.type);
+      DALI_ENFORCE(file_->Read(tensor.raw_mutable_data(), out.nbytes) ==
+                   static_cast<size_t>(out.nbytes), "Error reading from a file " + path_);
+    }
+    if (check_integrity_) {
+      DALI_ENFORCE(detail::pcache::Checksum(tensor.raw_data(), out.nbytes) == out.checksum,
+        make_string("Corrupted persistent cache file \"", path_, "\": checksum mismatch in the "
+                    "sample \"", entry.source_info, "\"."));
+    }
+    meta.SetLayout(out.layout);
+    tensor.SetMeta(meta);
+  }
+}
+
+Index PersistentCacheLoader::SizeImpl() {
+  return index_.samples.size();
+}
+
+void PersistentCacheLoader::PrepareMetadataImpl() {
+  if (!dont_use_mmap_) {
+    mmap_reserver_ = FileStream::MappingReserver(1);
+  }
+  copy_read_data_ = dont_use_mmap_ || !mmap_reserver_.CanShareMappedData();
+
+  file_ = FileStream::Open(path_, read_ahead_, !copy_read_data_);
+  index_ = detail::pcache::ReadIndex(*file_, path_);
+  DALI_ENFORCE(key_.empty() || index_.key == key_, make_string(
+    "The persistent cache file \"", path_, "\" was created with a different key - "
+    "the cached samples are outdated."));
+  DALI_ENFORCE(index_.num_outputs == num_outputs_, make_string(
+    "The persistent cache file \"", path_, "\" contains ", index_.num_outputs,
+    " outputs per sample, but ``num_outputs`` is ", num_outputs_, "."));
+  DALI_ENFORCE(!index_.samples.empty(), make_string(
+    "The persistent cache file \"", path_, "\" is empty."));
+  Reset(true);
+}
+
+void PersistentCacheLoader::Reset(bool wrap_to_shard) {
+  if (wrap_to_shard) {
+    current_index_ = start_index(virtual_shard_id_, num_shards_, SizeImpl());
+  } else {
+    current_index_ = 0;
+  }
+}
+
+}  // namespace dali
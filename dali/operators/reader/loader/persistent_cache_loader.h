@@ -0,0 +1,59 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_PERSISTENT_CACHE_LOADER_H_
+#define DALI_OPERATORS_READER_LOADER_PERSISTENT_CACHE_LOADER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/operators/reader/loader/loader.h"
+#include "dali/operators/reader/loader/persistent_cache_file.h"
+#include "dali/pipeline/data/tensor.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief Reads the samples stored in a persistent cache file
+ *
+ * With memory mapping enabled, the samples are not copied - the tensors share the mapped data.
+ */
+class DLL_PUBLIC PersistentCacheLoader : public Loader<CPUBackend, vector<Tensor<CPUBackend>>> {
+ public:
+  explicit PersistentCacheLoader(const OpSpec &spec);
+
+  void PrepareEmpty(vector<Tensor<CPUBackend>> &sample) override;
+  void ReadSample(vector<Tensor<CPUBackend>> &sample) override;
+
+ protected:
+  Index SizeImpl() override;
+  void PrepareMetadataImpl() override;
+  void Reset(bool wrap_to_shard) override;
+
+ private:
+  std::string path_;
+  std::string key_;
+  int num_outputs_;
+  bool check_integrity_;
+
+  detail::pcache::CacheIndex index_;
+  std::unique_ptr<FileStream> file_;
+  FileStream::MappingReserver mmap_reserver_;
+  Index current_index_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_PERSISTENT_CACHE_LOADER_H_
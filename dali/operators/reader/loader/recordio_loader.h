@@ -84,7 +84,7 @@ class RecordIOLoader : public IndexedFileLoader {
 
     int64 seek_pos, size;
     size_t file_index;
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
+    std::tie(seek_pos, size, file_index) = indices_[global_shuffle_[current_index_]];
 
     ++current_index_;
 
@@ -93,6 +93,8 @@ class RecordIOLoader : public IndexedFileLoader {
     meta.SetSourceInfo(image_key);
     meta.SetSkipSample(false);
 
+    UseFile(file_index);
+
     // if image is cached, skip loading
     if (ShouldSkipImage(image_key)) {
       meta.SetSkipSample(true);
@@ -13,9 +13,12 @@
 // limitations under the License.
 
 #include "dali/operators/reader/loader/video/frames_decoder.h"
+#include <algorithm>
 #include <memory>
 #include <iomanip>
+#include <utility>
 #include "dali/core/error_handling.h"
+#include "dali/operators/reader/loader/video/frames_index_cache.h"
 
 
 namespace dali {
@@ -110,6 +113,11 @@ void FramesDecoder::InitAvState(bool init_codecs) {
   DALI_ENFORCE(av_state_->packet_, "Could not allocate av packet");
 
   if (init_codecs) {
+    if (num_codec_threads_ > 1) {
+      // FFmpeg uses frame threading when the codec supports it and slice threading otherwise
+      av_state_->codec_ctx_->thread_count = num_codec_threads_;
+      av_state_->codec_ctx_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+    }
     ret = avcodec_open2(av_state_->codec_ctx_, av_state_->codec_, nullptr);
     DALI_ENFORCE(
       ret == 0,
@@ -163,8 +171,11 @@ void FramesDecoder::FindVideoStream(bool init_codecs) {
   }
 }
 
-FramesDecoder::FramesDecoder(const std::string &filename)
-    : av_state_(std::make_unique<AvState>()), filename_(filename) {
+FramesDecoder::FramesDecoder(const std::string &filename, int num_codec_threads,
+                             FramesIndexCache *index_cache)
+    : av_state_(std::make_unique<AvState>()),
+      num_codec_threads_(num_codec_threads),
+      filename_(filename) {
 
   av_log_set_level(AV_LOG_ERROR);
 
@@ -184,14 +195,24 @@ FramesDecoder::FramesDecoder(const std::string &filename)
       " in file: ", Filename(),
       " Supported codecs: h264, HEVC."));
   InitAvState();
+
+  std::vector<IndexEntry> cached_index;
+  if (index_cache && index_cache->Find(filename, cached_index, is_vfr_)) {
+    index_ = std::move(cached_index);
+    return;
+  }
   BuildIndex();
   DetectVfr();
+  if (index_cache) {
+    index_cache->Insert(filename, *index_, is_vfr_);
+  }
 }
 
 
 FramesDecoder::FramesDecoder(const char *memory_file, int memory_file_size, bool build_index,
-                             bool init_codecs, int num_frames)
+                             bool init_codecs, int num_frames, int num_codec_threads)
   : av_state_(std::make_unique<AvState>()),
+    num_codec_threads_(num_codec_threads),
     memory_video_file_(MemoryVideoFile(memory_file, memory_file_size)) {
   DALI_ENFORCE(init_codecs || !build_index,
                "FramesDecoder doesn't support index without CPU codecs");
@@ -374,7 +395,7 @@ void FramesDecoder::CopyToOutput(uint8_t *data) {
   LazyInitSwContext();
 
   uint8_t *dest[4] = {data, nullptr, nullptr, nullptr};
-  int dest_linesize[4] = {av_state_->frame_->width * Channels(), 0, 0, 0};
+  int dest_linesize[4] = {OutputWidth() * Channels(), 0, 0, 0};
 
   int ret = sws_scale(
     av_state_->sws_ctx_,
@@ -391,20 +412,20 @@ void FramesDecoder::CopyToOutput(uint8_t *data) {
 }
 
 void FramesDecoder::LazyInitSwContext() {
-  if (av_state_->sws_ctx_ == nullptr) {
-    av_state_->sws_ctx_ = sws_getContext(
-      Width(),
-      Height(),
-      av_state_->codec_ctx_->pix_fmt,
-      Width(),
-      Height(),
-      AV_PIX_FMT_RGB24,
-      SWS_BILINEAR,
-      nullptr,
-      nullptr,
-      nullptr);
-    DALI_ENFORCE(av_state_->sws_ctx_, "Could not create sw context");
-  }
+  // The context is reused, unless the output size or the interpolation changed
+  av_state_->sws_ctx_ = sws_getCachedContext(
+    av_state_->sws_ctx_,
+    Width(),
+    Height(),
+    av_state_->codec_ctx_->pix_fmt,
+    OutputWidth(),
+    OutputHeight(),
+    AV_PIX_FMT_RGB24,
+    sws_flags_,
+    nullptr,
+    nullptr,
+    nullptr);
+  DALI_ENFORCE(av_state_->sws_ctx_, "Could not create sw context");
 }
 
 bool FramesDecoder::ReadRegularFrame(uint8_t *data, bool copy_to_output) {
@@ -555,4 +576,17 @@ const IndexEntry &FramesDecoder::Index(int frame_id) const {
 
   return (*index_)[frame_id];
 }
+
+int CodecThreadsPerDecoder(int num_threads, int concurrent_videos, int num_decoders) {
+  // Beyond that, FFmpeg frame threading adds more latency and memory than throughput
+  constexpr int kMaxCodecThreads = 16;
+  // Limit of the codec threads of all the open decoders, per thread of the thread pool
+  constexpr int kMaxTotalCodecThreadsPerThread = 4;
+  if (num_threads <= 1 || concurrent_videos <= 0 || num_decoders <= 0)
+    return 1;
+  int threads = num_threads / concurrent_videos;
+  threads = std::min(threads, kMaxTotalCodecThreadsPerThread * num_threads / num_decoders);
+  return std::max(1, std::min(threads, kMaxCodecThreads));
+}
+
 }  // namespace dali
@@ -30,6 +30,8 @@ extern "C" {
 #include "dali/core/common.h"
 
 namespace dali {
+class FramesIndexCache;
+
 struct IndexEntry {
   int64_t pts;
   int last_keyframe_id;
@@ -100,8 +102,12 @@ class DLL_PUBLIC FramesDecoder {
    * @brief Construct a new FramesDecoder object.
    *
    * @param filename Path to a video file.
+   * @param num_codec_threads Number of threads used by the FFmpeg decoder.
+   * @param index_cache If set, the index is taken from the cache, when present there,
+   * and otherwise built and inserted into the cache.
    */
-  explicit FramesDecoder(const std::string &filename);
+  explicit FramesDecoder(const std::string &filename, int num_codec_threads = 1,
+                         FramesIndexCache *index_cache = nullptr);
 
 
   /**
@@ -112,12 +118,13 @@ class DLL_PUBLIC FramesDecoder {
    * @param build_index If set to false index will not be build and some features are unavailable.
    * @param init_codecs If set to false CPU codec part is not initalized, only parser
    * @param num_frames If set, number of frames in the video.
+   * @param num_codec_threads Number of threads used by the FFmpeg decoder.
    *
    * @note This constructor assumes that the `memory_file` and
    * `memory_file_size` arguments cover the entire video file, including the header.
    */
   FramesDecoder(const char *memory_file, int memory_file_size, bool build_index = true,
-                bool init_codecs = true, int num_frames = -1);
+                bool init_codecs = true, int num_frames = -1, int num_codec_threads = 1);
 
   /**
    * @brief Number of frames in the video. It returns 0, if this information is unavailable.
@@ -152,6 +159,39 @@ class DLL_PUBLIC FramesDecoder {
     return Channels() * Width() * Height();
   }
 
+  /**
+   * @brief Sets the size of the frames returned by ReadNextFrame.
+   *
+   * The frames are scaled while being converted to RGB, in a single pass, with the `sws_flags`
+   * interpolation (e.g. SWS_BICUBIC). Applies only to the CPU decoding.
+   */
+  void SetOutputSize(int height, int width, int sws_flags = SWS_BILINEAR) {
+    output_height_ = height;
+    output_width_ = width;
+    sws_flags_ = sws_flags;
+  }
+
+  /**
+   * @brief Width of a frame returned by ReadNextFrame
+   */
+  int OutputWidth() const {
+    return output_width_ > 0 ? output_width_ : Width();
+  }
+
+  /**
+   * @brief Height of a frame returned by ReadNextFrame
+   */
+  int OutputHeight() const {
+    return output_height_ > 0 ? output_height_ : Height();
+  }
+
+  /**
+   * @brief Total number of values in a frame returned by ReadNextFrame
+   */
+  int OutputFrameSize() const {
+    return Channels() * OutputWidth() * OutputHeight();
+  }
+
   /**
    * @brief Is video variable frame rate
    */
@@ -269,6 +309,11 @@ class DLL_PUBLIC FramesDecoder {
   }
 
   int channels_ = 3;
+  int num_codec_threads_ = 1;
+  // 0 means the size of the video
+  int output_height_ = 0;
+  int output_width_ = 0;
+  int sws_flags_ = SWS_BILINEAR;
   bool flush_state_ = false;
   bool is_vfr_ = false;
 
@@ -281,6 +326,21 @@ class DLL_PUBLIC FramesDecoder {
   const int default_av_buffer_size = (1 << 15);
 };
 
+/**
+ * @brief Splits the CPU threads between decoding different videos concurrently and the threads
+ *        of each FFmpeg decoder.
+ *
+ * The videos are decoded in parallel on the thread pool, so the codec threads pay off only when
+ * fewer videos than `num_threads` are decoded at once. Each open decoder keeps its threads, so
+ * their total number is limited as well.
+ *
+ * @param num_threads Number of threads of the thread pool.
+ * @param concurrent_videos Expected number of videos decoded at once.
+ * @param num_decoders Number of decoders open at the same time.
+ * @return Number of threads for each decoder.
+ */
+DLL_PUBLIC int CodecThreadsPerDecoder(int num_threads, int concurrent_videos, int num_decoders);
+
 }  // namespace dali
 
 #endif  // DALI_OPERATORS_READER_LOADER_VIDEO_FRAMES_DECODER_H_
@@ -402,8 +402,9 @@ void FramesDecoderGpu::InitGpuParser() {
   }
 }
 
-FramesDecoderGpu::FramesDecoderGpu(const std::string &filename, cudaStream_t stream) :
-    FramesDecoder(filename),
+FramesDecoderGpu::FramesDecoderGpu(const std::string &filename, cudaStream_t stream,
+                                   FramesIndexCache *index_cache) :
+    FramesDecoder(filename, 1, index_cache),
     frame_buffer_(num_decode_surfaces_),
     stream_(stream) {
   InitGpuParser();
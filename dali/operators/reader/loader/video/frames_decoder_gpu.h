@@ -132,8 +132,11 @@ class DLL_PUBLIC FramesDecoderGpu : public FramesDecoder {
    *
    * @param filename Path to a video file.
    * @param stream Stream used for decode processing.
+   * @param index_cache If set, the index is taken from the cache, when present there,
+   * and otherwise built and inserted into the cache.
    */
-  explicit FramesDecoderGpu(const std::string &filename, cudaStream_t stream = 0);
+  explicit FramesDecoderGpu(const std::string &filename, cudaStream_t stream = 0,
+                            FramesIndexCache *index_cache = nullptr);
 
   /**
  * @brief Construct a new FramesDecoder object.
@@ -208,6 +208,28 @@ TEST_F(FramesDecoderTest_CpuOnlyTests, VariableFrameRateHevc) {
   RunTest(decoder, vfr_hevc_videos_[0]);
 }
 
+TEST_F(FramesDecoderTest_CpuOnlyTests, CodecThreads) {
+  FramesDecoder decoder(cfr_videos_paths_[0], 4);
+  RunTest(decoder, cfr_videos_[0]);
+}
+
+TEST_F(FramesDecoderTest_CpuOnlyTests, CodecThreadsHevc) {
+  FramesDecoder decoder(vfr_hevc_videos_paths_[0], 4);
+  RunTest(decoder, vfr_hevc_videos_[0]);
+}
+
+TEST(CodecThreadsPerDecoderTest, SplitsThreads) {
+  EXPECT_EQ(CodecThreadsPerDecoder(1, 1, 1), 1);
+  // Enough videos to keep all the threads busy
+  EXPECT_EQ(CodecThreadsPerDecoder(8, 8, 8), 1);
+  EXPECT_EQ(CodecThreadsPerDecoder(8, 16, 100), 1);
+  // Fewer videos than threads
+  EXPECT_EQ(CodecThreadsPerDecoder(8, 2, 2), 4);
+  EXPECT_EQ(CodecThreadsPerDecoder(64, 1, 1), 16);
+  // Many decoders are kept open at once
+  EXPECT_EQ(CodecThreadsPerDecoder(8, 2, 16), 2);
+}
+
 TEST_F(FramesDecoderTest_CpuOnlyTests, InvalidPath) {
   std::string path = "invalid_path.mp4";
 
@@ -0,0 +1,164 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/video/frames_index_cache.h"
+#include <unistd.h>
+#include <fstream>
+#include <utility>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+
+namespace dali {
+
+using namespace detail::index_file;  // NOLINT
+
+namespace {
+
+/*
+ * Layout of the cache file (native endianness):
+ *   char[8]  magic "DALIVIDX"
+ *   uint32   version
+ *   uint64   number of videos
+ * followed by the videos:
+ *   uint32   length of the path, followed by the path
+ *   int64    size of the file
+ *   int64    modification time, in nanoseconds
+ *   uint8    VFR flag
+ *   uint64   number of frames
+ *   int64[]  pts of the frames
+ *   uint8[]  flags of the frames
+ */
+constexpr char kMagic[8] = { 'D', 'A', 'L', 'I', 'V', 'I', 'D', 'X' };
+constexpr uint32_t kVersion = 1;
+// Sanity limits guarding against allocating memory for a corrupted file
+constexpr uint32_t kMaxPathLength = 1 << 16;
+constexpr uint64_t kMaxFrames = uint64_t(1) << 32;
+
+}  // namespace
+
+FramesIndexCache::FramesIndexCache(const std::string &path) : path_(path) {
+  if (path_.empty() || access(path_.c_str(), F_OK) != 0)
+    return;
+  if (!Load()) {
+    DALI_WARN(make_string("The video index cache ", path_, " could not be read. The indices "
+                          "will be rebuilt and the cache overwritten."));
+    indices_.clear();
+  }
+}
+
+bool FramesIndexCache::Load() {
+  std::ifstream in(path_, std::ios::binary);
+  if (!in.is_open())
+    return false;
+  uint64_t num_videos;
+  if (!ReadHeader(in, kMagic, kVersion) || !ReadValue(in, num_videos))
+    return false;
+
+  for (uint64_t i = 0; i < num_videos; i++) {
+    std::string filename;
+    CachedIndex cached;
+    uint8_t is_vfr;
+    uint64_t num_frames;
+    if (!ReadString(in, filename, kMaxPathLength) || !ReadSignature(in, cached.signature) ||
+        !ReadValue(in, is_vfr) || !ReadValue(in, num_frames) || num_frames > kMaxFrames)
+      return false;
+    cached.is_vfr = is_vfr;
+    cached.pts.resize(num_frames);
+    cached.flags.resize(num_frames);
+    if (!in.read(reinterpret_cast<char *>(cached.pts.data()), num_frames * sizeof(int64_t)) ||
+        !in.read(reinterpret_cast<char *>(cached.flags.data()), num_frames))
+      return false;
+    indices_[filename] = std::move(cached);
+  }
+  return true;
+}
+
+const FramesIndexCache::CachedIndex *FramesIndexCache::FindUpToDate(
+    const std::string &filename) const {
+  auto it = indices_.find(filename);
+  if (it == indices_.end())
+    return nullptr;
+  FileSignature signature;
+  if (!Stat(filename, signature) || it->second.signature != signature)
+    return nullptr;
+  return &it->second;
+}
+
+bool FramesIndexCache::Contains(const std::string &filename) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return FindUpToDate(filename) != nullptr;
+}
+
+bool FramesIndexCache::Find(const std::string &filename, std::vector<IndexEntry> &index,
+                            bool &is_vfr) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const CachedIndex *cached_ptr = FindUpToDate(filename);
+  if (!cached_ptr)
+    return false;
+  const auto &cached = *cached_ptr;
+
+  // The last keyframe is not stored, as it follows from the keyframe flags
+  index.resize(cached.pts.size());
+  int last_keyframe = -1;
+  for (size_t i = 0; i < index.size(); i++) {
+    auto &entry = index[i];
+    entry.pts = cached.pts[i];
+    entry.is_keyframe = cached.flags[i] & kKeyframe;
+    entry.is_flush_frame = cached.flags[i] & kFlushFrame;
+    if (entry.is_keyframe)
+      last_keyframe = i;
+    entry.last_keyframe_id = last_keyframe;
+  }
+  is_vfr = cached.is_vfr;
+  return true;
+}
+
+void FramesIndexCache::Insert(const std::string &filename, const std::vector<IndexEntry> &index,
+                              bool is_vfr) {
+  CachedIndex cached;
+  if (!Stat(filename, cached.signature))
+    return;
+  cached.is_vfr = is_vfr;
+  cached.pts.resize(index.size());
+  cached.flags.resize(index.size());
+  for (size_t i = 0; i < index.size(); i++) {
+    cached.pts[i] = index[i].pts;
+    cached.flags[i] = (index[i].is_keyframe ? kKeyframe : 0) |
+                      (index[i].is_flush_frame ? kFlushFrame : 0);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  indices_[filename] = std::move(cached);
+  modified_ = true;
+}
+
+bool FramesIndexCache::Save() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return SaveAtomically(path_, [&](std::ostream &out) {
+    WriteHeader(out, kMagic, kVersion);
+    WriteValue(out, static_cast<uint64_t>(indices_.size()));
+    for (auto &entry : indices_) {
+      const auto &cached = entry.second;
+      WriteString(out, entry.first);
+      WriteSignature(out, cached.signature);
+      WriteValue(out, static_cast<uint8_t>(cached.is_vfr));
+      WriteValue(out, static_cast<uint64_t>(cached.pts.size()));
+      out.write(reinterpret_cast<const char *>(cached.pts.data()),
+                cached.pts.size() * sizeof(int64_t));
+      out.write(reinterpret_cast<const char *>(cached.flags.data()), cached.flags.size());
+    }
+    return true;
+  });
+}
+
+}  // namespace dali
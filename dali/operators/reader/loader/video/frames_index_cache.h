@@ -0,0 +1,112 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_FRAMES_INDEX_CACHE_H_
+#define DALI_OPERATORS_READER_LOADER_VIDEO_FRAMES_INDEX_CACHE_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/operators/reader/loader/index_file_utils.h"
+#include "dali/operators/reader/loader/video/frames_decoder.h"
+
+namespace dali {
+
+/**
+ * @brief Cache of the frame indices built by FramesDecoder, kept in a file between the runs.
+ *
+ * Building the index requires demuxing and decoding the whole video. The cache stores,
+ * for each video, the timestamps and the keyframe and flush flags of the frames, together with
+ * the VFR flag. An entry is valid as long as the size and the modification time of the video
+ * don't change.
+ *
+ * Find and Insert can be called concurrently.
+ */
+class DLL_PUBLIC FramesIndexCache {
+ public:
+  /**
+   * @brief Loads the cache from `path`, if the file exists.
+   *
+   * A file which can't be read or is malformed only produces a warning; the indices are then
+   * built from the videos and the file is overwritten by Save.
+   * With an empty path, the cache is kept only in memory.
+   */
+  explicit FramesIndexCache(const std::string &path);
+
+  /**
+   * @brief Returns true, if the cache holds an up-to-date index of the video `filename`.
+   */
+  bool Contains(const std::string &filename) const;
+
+  /**
+   * @brief Looks up the index of the video `filename`.
+   *
+   * @return True, if the cache holds an up-to-date index of the video.
+   */
+  bool Find(const std::string &filename, std::vector<IndexEntry> &index, bool &is_vfr) const;
+
+  /**
+   * @brief Stores the index of the video `filename`, replacing the previous one, if any.
+   */
+  void Insert(const std::string &filename, const std::vector<IndexEntry> &index, bool is_vfr);
+
+  /**
+   * @brief Returns true, if any index was inserted since the cache was loaded.
+   */
+  bool IsModified() const {
+    return modified_;
+  }
+
+  /**
+   * @brief Writes the cache to the file it was loaded from.
+   *
+   * The file is written under a temporary name and then renamed, so that the concurrent readers
+   * never see a partially written cache.
+   *
+   * @return False, if the file couldn't be written.
+   */
+  bool Save() const;
+
+ private:
+  struct CachedIndex {
+    detail::index_file::FileSignature signature;
+    bool is_vfr = false;
+    std::vector<int64_t> pts;
+    // combination of kKeyframe and kFlushFrame
+    std::vector<uint8_t> flags;
+  };
+
+  static constexpr uint8_t kKeyframe = 1;
+  static constexpr uint8_t kFlushFrame = 2;
+
+  bool Load();
+
+  /**
+   * @brief Returns the cached index of the file, if it's up to date; must be called with the
+   *        mutex locked
+   */
+  const CachedIndex *FindUpToDate(const std::string &filename) const;
+
+  std::string path_;
+  std::map<std::string, CachedIndex> indices_;
+  bool modified_ = false;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_FRAMES_INDEX_CACHE_H_
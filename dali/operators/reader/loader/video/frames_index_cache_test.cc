@@ -0,0 +1,107 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/video/frames_index_cache.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "dali/core/format.h"
+
+namespace dali {
+
+class FramesIndexCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    video_path_ = make_string("/tmp/dali_frames_index_cache_video_", getpid());
+    cache_path_ = make_string("/tmp/dali_frames_index_cache_", getpid());
+    std::ofstream(video_path_) << "not really a video";
+    std::remove(cache_path_.c_str());
+  }
+
+  void TearDown() override {
+    std::remove(video_path_.c_str());
+    std::remove(cache_path_.c_str());
+  }
+
+  static std::vector<IndexEntry> TestIndex() {
+    // keyframes at 0 and 3, followed by two flush frames
+    std::vector<IndexEntry> index = {
+      { 0, 0, true, false }, { 512, 0, false, false }, { 1024, 0, false, false },
+      { 1536, 3, true, false }, { 2048, 3, false, false }, { 2560, 3, false, true },
+      { 3072, 3, false, true },
+    };
+    return index;
+  }
+
+  static void ExpectEqual(const std::vector<IndexEntry> &a, const std::vector<IndexEntry> &b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+      EXPECT_EQ(a[i].pts, b[i].pts) << "frame " << i;
+      EXPECT_EQ(a[i].last_keyframe_id, b[i].last_keyframe_id) << "frame " << i;
+      EXPECT_EQ(a[i].is_keyframe, b[i].is_keyframe) << "frame " << i;
+      EXPECT_EQ(a[i].is_flush_frame, b[i].is_flush_frame) << "frame " << i;
+    }
+  }
+
+  std::string video_path_, cache_path_;
+};
+
+TEST_F(FramesIndexCacheTest, SaveAndLoad) {
+  {
+    FramesIndexCache cache(cache_path_);
+    EXPECT_FALSE(cache.Contains(video_path_));
+    cache.Insert(video_path_, TestIndex(), true);
+    EXPECT_TRUE(cache.IsModified());
+    ASSERT_TRUE(cache.Save());
+  }
+
+  FramesIndexCache cache(cache_path_);
+  EXPECT_FALSE(cache.IsModified());
+  ASSERT_TRUE(cache.Contains(video_path_));
+  std::vector<IndexEntry> index;
+  bool is_vfr = false;
+  ASSERT_TRUE(cache.Find(video_path_, index, is_vfr));
+  EXPECT_TRUE(is_vfr);
+  ExpectEqual(index, TestIndex());
+}
+
+TEST_F(FramesIndexCacheTest, ModifiedVideo) {
+  FramesIndexCache cache(cache_path_);
+  cache.Insert(video_path_, TestIndex(), false);
+  ASSERT_TRUE(cache.Contains(video_path_));
+
+  std::ofstream(video_path_, std::ios::app) << ", and longer now";
+  EXPECT_FALSE(cache.Contains(video_path_));
+  std::vector<IndexEntry> index;
+  bool is_vfr;
+  EXPECT_FALSE(cache.Find(video_path_, index, is_vfr));
+}
+
+TEST_F(FramesIndexCacheTest, CorruptedFile) {
+  {
+    FramesIndexCache cache(cache_path_);
+    cache.Insert(video_path_, TestIndex(), false);
+    ASSERT_TRUE(cache.Save());
+  }
+  // cut the file in the middle of the index
+  ASSERT_EQ(truncate(cache_path_.c_str(), 40), 0);
+
+  FramesIndexCache cache(cache_path_);
+  EXPECT_FALSE(cache.Contains(video_path_));
+}
+
+}  // namespace dali
@@ -16,9 +16,14 @@
 #define DALI_OPERATORS_READER_LOADER_VIDEO_VIDEO_LOADER_DECODER_BASE_H_
 
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
+#include "dali/operators/reader/loader/video/frames_decoder.h"
+#include "dali/operators/reader/loader/video/frames_index_cache.h"
+#include "dali/pipeline/util/thread_pool.h"
+
 namespace dali {
 class VideoSampleDesc {
  public:
@@ -31,20 +36,15 @@ class VideoSampleDesc {
   int video_idx_ = -1;
 };
 
-template <typename Backend>
-class VideoSample {
- public:
-  Tensor<Backend> data_;
-  int label_;
-};
-
 class VideoLoaderDecoderBase {
  public:
   explicit inline VideoLoaderDecoderBase(const OpSpec &spec):
     filenames_(spec.GetRepeatedArgument<std::string>("filenames")),
     sequence_len_(spec.GetArgument<int>("sequence_length")),
     stride_(spec.GetArgument<int>("stride")),
-    step_(spec.GetArgument<int>("step")) {
+    step_(spec.GetArgument<int>("step")),
+    index_cache_path_(spec.GetArgument<std::string>("index_cache_path")),
+    num_threads_(std::max(1, spec.GetArgument<int>("num_threads"))) {
     has_labels_ = spec.TryGetRepeatedArgument(labels_, "labels");
     DALI_ENFORCE(
         !has_labels_ || labels_.size() == filenames_.size(),
@@ -58,6 +58,38 @@ class VideoLoaderDecoderBase {
 
 
  protected:
+  /**
+   * @brief Builds the frame indices of the videos missing from the cache, in parallel.
+   *
+   * The decoders can then be created with the cache, without demuxing the videos again.
+   */
+  void BuildIndices(FramesIndexCache &index_cache) {
+    int num_threads = std::min<int>(num_threads_, filenames_.size());
+    if (num_threads <= 1)
+      return;
+    ThreadPool thread_pool(num_threads, CPU_ONLY_DEVICE_ID, false, "VideoIndex");
+    for (auto &filename : filenames_) {
+      if (index_cache.Contains(filename))
+        continue;
+      thread_pool.AddWork([&filename, &index_cache](int) {
+        FramesDecoder video_file(filename, 1, &index_cache);
+      });
+    }
+    thread_pool.RunAll();
+  }
+
+  /**
+   * @brief Saves the cache, if the indices of any videos were added to it
+   */
+  void SaveIndexCache(const FramesIndexCache &index_cache) {
+    if (index_cache_path_.empty() || !index_cache.IsModified())
+      return;
+    if (!index_cache.Save()) {
+      DALI_WARN(make_string("The video index cache could not be saved to ", index_cache_path_,
+                            "."));
+    }
+  }
+
   std::vector<std::string> filenames_;
   std::vector<int> labels_;
   bool has_labels_ = false;
@@ -68,6 +100,10 @@ class VideoLoaderDecoderBase {
   int stride_;
   int step_;
 
+  // Path of the file caching the frame indices between the runs; empty if not used
+  std::string index_cache_path_;
+  int num_threads_;
+
   std::vector<VideoSampleDesc> sample_spans_;
 };
 
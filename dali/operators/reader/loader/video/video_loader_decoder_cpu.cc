@@ -15,36 +15,36 @@
 #include "dali/operators/reader/loader/video/video_loader_decoder_cpu.h"
 
 namespace dali {
-void VideoLoaderDecoderCpu::PrepareEmpty(VideoSample<CPUBackend> &sample) {
-  sample = {};
-  sample.data_.set_pinned(false);
-  sample.data_.SetLayout("FHWC");
+TensorShape<4> VideoSampleCpu::Shape() const {
+  return {sequence_len_, video_file_->Height(), video_file_->Width(), video_file_->Channels()};
 }
 
-void VideoLoaderDecoderCpu::ReadSample(VideoSample<CPUBackend> &sample) {
-  auto &sample_span = sample_spans_[current_index_];
-  auto &video_file = video_files_[sample_span.video_idx_];
-
-  ++current_index_;
-  MoveToNextShard(current_index_);
-
-  sample.data_.Resize(
-    TensorShape<4>{sequence_len_, video_file.Height(), video_file.Width(), video_file.Channels()},
-    DALIDataType::DALI_UINT8);
-  sample.data_.SetSourceInfo(video_file.Filename());
-
-  auto data = sample.data_.mutable_data<uint8_t>();
-
-  // TODO(awolant): Extract decoding outside of ReadSample (ReaderDecoder abstraction)
+void VideoSampleCpu::Decode(uint8_t *data) {
   for (int i = 0; i < sequence_len_; ++i) {
     // TODO(awolant): This seek can be optimized - for consecutive frames not needed etc.
-    video_file.SeekFrame(sample_span.start_ + i * sample_span.stride_);
-    video_file.ReadNextFrame(data + i * video_file.FrameSize());
+    video_file_->SeekFrame(span_->start_ + i * span_->stride_);
+    video_file_->ReadNextFrame(data + i * video_file_->OutputFrameSize());
   }
+}
+
+void VideoLoaderDecoderCpu::PrepareEmpty(VideoSampleCpu &sample) {
+  sample = {};
+}
+
+void VideoLoaderDecoderCpu::ReadSample(VideoSampleCpu &sample) {
+  auto &sample_span = sample_spans_[current_index_];
+
+  // Bind sample to the video and span, so it can be decoded later
+  sample.span_ = &sample_span;
+  sample.video_file_ = &video_files_[sample_span.video_idx_];
+  sample.sequence_len_ = sequence_len_;
 
   if (has_labels_) {
     sample.label_ = labels_[sample_span.video_idx_];
   }
+
+  ++current_index_;
+  MoveToNextShard(current_index_);
 }
 
 Index VideoLoaderDecoderCpu::SizeImpl() {
@@ -52,10 +52,17 @@ Index VideoLoaderDecoderCpu::SizeImpl() {
 }
 
 void VideoLoaderDecoderCpu::PrepareMetadataImpl() {
-  video_files_.reserve(filenames_.size());
+  int num_videos = filenames_.size();
+  int codec_threads = codec_threads_ > 0 ?
+      codec_threads_ :
+      CodecThreadsPerDecoder(num_threads_, std::min(num_videos, max_batch_size_), num_videos);
+  FramesIndexCache index_cache(index_cache_path_);
+  BuildIndices(index_cache);
+  video_files_.reserve(num_videos);
   for (auto &filename : filenames_) {
-    video_files_.emplace_back(filename);
+    video_files_.emplace_back(filename, codec_threads, &index_cache);
   }
+  SaveIndexCache(index_cache);
 
   for (size_t video_idx = 0; video_idx < video_files_.size(); ++video_idx) {
     for (int start = 0;
@@ -24,13 +24,36 @@
 
 
 namespace dali {
-using VideoSampleCpu = VideoSample<CPUBackend>;
+/**
+ * @brief A sequence bound to its video by the loader, decoded later by the operator
+ *
+ * The sequences of different videos can be decoded concurrently.
+ */
+class VideoSampleCpu {
+ public:
+  TensorShape<4> Shape() const;
+
+  /**
+   * @brief Decodes the sequence to `data`, with the output size of the video's decoder
+   */
+  void Decode(uint8_t *data);
+
+  FramesDecoder *video_file_ = nullptr;
+  VideoSampleDesc *span_ = nullptr;
+  int sequence_len_ = 0;
+  int label_ = -1;
+};
 
 class VideoLoaderDecoderCpu : public Loader<CPUBackend, VideoSampleCpu>, VideoLoaderDecoderBase {
  public:
   explicit inline VideoLoaderDecoderCpu(const OpSpec &spec) :
     Loader<CPUBackend, VideoSampleCpu>(spec),
-    VideoLoaderDecoderBase(spec) { }
+    VideoLoaderDecoderBase(spec),
+    codec_threads_(spec.GetArgument<int>("codec_threads")),
+    max_batch_size_(spec.GetArgument<int>("max_batch_size")) {
+    DALI_ENFORCE(codec_threads_ >= 0,
+                 make_string("``codec_threads`` must not be negative, got ", codec_threads_, "."));
+  }
 
   void ReadSample(VideoSampleCpu &sample) override;
 
@@ -45,6 +68,10 @@ class VideoLoaderDecoderCpu : public Loader<CPUBackend, VideoSampleCpu>, VideoLo
   void Reset(bool wrap_to_shard) override;
 
   std::vector<FramesDecoder> video_files_;
+
+  // 0 means that the number of codec threads is chosen automatically
+  int codec_threads_;
+  int max_batch_size_;
 };
 
 }  // namespace dali
@@ -87,10 +87,13 @@ Index VideoLoaderDecoderGpu::SizeImpl() {
 }
 
 void VideoLoaderDecoderGpu::PrepareMetadataImpl() {
+  FramesIndexCache index_cache(index_cache_path_);
+  BuildIndices(index_cache);
   video_files_.reserve(filenames_.size());
   for (auto &filename : filenames_) {
-    video_files_.emplace_back(filename, cuda_stream_);
+    video_files_.emplace_back(filename, cuda_stream_, &index_cache);
   }
+  SaveIndexCache(index_cache);
 
   for (size_t video_idx = 0; video_idx < video_files_.size(); ++video_idx) {
     for (int start = 0;
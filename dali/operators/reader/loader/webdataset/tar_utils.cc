@@ -14,6 +14,7 @@
 
 #include "dali/operators/reader/loader/webdataset/tar_utils.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdarg>
 #include <cstdlib>
 #include <cstring>
@@ -36,10 +37,12 @@ static_assert(is_pow2(kBlockSize),
 constexpr uint64_t kEmptyEofBlocks = 2;
 constexpr uint64_t kTarArchiveBufferInitSize = 1;
 
+// The archives may be created and read concurrently (e.g. when indexing the archives in parallel).
+// The registry is modified under the lock; reading an entry only requires the current array.
 std::mutex instances_mutex;
 std::list<std::vector<TarArchive*>> instances_registry = {
     std::vector<TarArchive*>(kTarArchiveBufferInitSize)};
-TarArchive** instances = instances_registry.back().data();
+std::atomic<TarArchive**> instances{instances_registry.back().data()};
 
 int Register(TarArchive* archive) {
   std::lock_guard<std::mutex> instances_lock(instances_mutex);
@@ -62,6 +65,7 @@ int Register(TarArchive* archive) {
 }
 
 inline void Unregister(int instance_handle_) {
+  std::lock_guard<std::mutex> instances_lock(instances_mutex);
   instances[instance_handle_] = nullptr;
 }
 
@@ -13,17 +13,22 @@
 // limitations under the License.
 
 #include "dali/operators/reader/loader/webdataset_loader.h"
+#include <algorithm>
+#include <cctype>
 #include <cstddef>
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <tuple>
 #include <utility>
 #include "dali/core/common.h"
 #include "dali/core/version_util.h"
 #include "dali/core/error_handling.h"
+#include "dali/operators/reader/loader/index_file_utils.h"
 #include "dali/operators/reader/loader/webdataset/tar_utils.h"
 #include "dali/pipeline/data/types.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
 
@@ -199,6 +204,67 @@ inline void ParseTarFile(std::vector<SampleDesc>& samples_container,
   tar_file = tar_archive.Release();
 }
 
+/**
+ * @brief Returns the path of the index saved next to the archive (e.g. "data/shard.tar" ->
+ *        "data/shard.tar.idx")
+ *
+ * The full name of the archive is kept, so that the archives which differ only in the extensions
+ * (e.g. "x.a.tar" and "x.b.tar") don't share the index.
+ */
+std::string GeneratedIndexPath(const std::string& archive_path) {
+  return archive_path + ".idx";
+}
+
+/**
+ * @brief Checks if the index exists and was modified after the archive
+ */
+bool IsIndexUpToDate(const std::string& index_path, const std::string& archive_path) {
+  index_file::FileSignature index_signature, archive_signature;
+  if (!index_file::Stat(index_path, index_signature) ||
+      !index_file::Stat(archive_path, archive_signature))
+    return false;
+  return index_signature.mtime_ns >= archive_signature.mtime_ns;
+}
+
+inline bool IsValidIndexToken(const std::string& token) {
+  return !token.empty() && std::none_of(token.begin(), token.end(), [](unsigned char c) {
+    return std::isspace(c);
+  });
+}
+
+/**
+ * @brief Saves the index generated from a tar archive in the format of `tools/wds2idx.py`
+ *
+ * The index is written to a temporary file, which is then renamed, so that concurrent readers
+ * never see a partially written index. Returns false if the index can't be represented in the
+ * text format or can't be written.
+ */
+bool SaveIndexFile(std::vector<SampleDesc>& samples, const std::string& index_path) {
+  std::stringstream out;
+  int64_t num_samples = 0;
+  for (auto& sample : samples) {
+    if (!sample.components.num)
+      continue;
+    num_samples++;
+    const char *sep = "";
+    for (auto& component : sample.components) {
+      if (!IsValidIndexToken(component.ext) || !IsValidIndexToken(component.filename))
+        return false;
+      out << sep << component.ext << ' ' << component.offset << ' ' << component.size << ' '
+          << component.filename;
+      sep = " ";
+    }
+    out << '\n';
+  }
+  if (!num_samples)
+    return false;
+
+  return index_file::SaveAtomically(index_path, [&](std::ostream& file) {
+    file << kCurrentIndexVersion << ' ' << num_samples << '\n' << out.rdbuf();
+    return true;
+  }, std::ios::out);
+}
+
 }  // namespace wds
 }  // namespace detail
 
@@ -223,7 +289,10 @@ WebdatasetLoader::WebdatasetLoader(const OpSpec& spec)
       index_paths_(spec.GetRepeatedArgument<std::string>("index_paths")),
       missing_component_behavior_(detail::wds::ParseMissingExtBehavior(
           spec.GetArgument<std::string>("missing_component_behavior"))),
-      case_sensitive_extensions_(spec.GetArgument<bool>("case_sensitive_extensions")) {
+      case_sensitive_extensions_(spec.GetArgument<bool>("case_sensitive_extensions")),
+      save_generated_index_(spec.GetArgument<bool>("save_generated_index")),
+      num_threads_(std::max(1, spec.GetArgument<int>("num_threads"))),
+      global_shuffle_(spec) {
   DALI_ENFORCE(paths_.size() == index_paths_.size() || index_paths_.size() == 0,
                make_string("The number of index files, if any, must match the number of archives ",
                "in the dataset"));
@@ -261,6 +330,13 @@ WebdatasetLoader::WebdatasetLoader(const OpSpec& spec)
   }
   DALI_ENFORCE(ext_.size() == dtypes_.size(),
                "Number of extensions does not match the number of provided types");
+
+  if (global_shuffle_.enabled()) {
+    // Every epoch is permuted anew, so the shards can't be rotated
+    DALI_ENFORCE(!stick_to_shard_, "global_shuffle and stick_to_shard cannot be both true");
+    DALI_ENFORCE(!shuffle_, "global_shuffle and random_shuffle cannot be both true");
+    stick_to_shard_ = true;
+  }
 }
 
 WebdatasetLoader::~WebdatasetLoader() {}
@@ -286,7 +362,7 @@ std::string WebdatasetLoader::GetSampleSource(const detail::wds::SampleDesc& sam
 
 void WebdatasetLoader::ReadSample(vector<Tensor<CPUBackend>>& sample) {
   MoveToNextShard(sample_index_);
-  detail::wds::SampleDesc& current_sample = samples_[sample_index_];
+  detail::wds::SampleDesc& current_sample = samples_[global_shuffle_[sample_index_]];
   auto& current_wds_shard = wds_shards_[current_sample.wds_shard_index];
 
   for (auto& component : current_sample.components) {
@@ -369,7 +445,7 @@ void WebdatasetLoader::PrepareMetadataImpl() {
   copy_read_data_ = dont_use_mmap_ || !mmap_reserver_.CanShareMappedData();
 
   generate_index_ = index_paths_.size() == 0;
-  if (generate_index_) {
+  if (generate_index_ && !save_generated_index_) {
     DALI_WARN("Index file not provided, it may take some time to infer it from the tar file");
   }
 
@@ -388,8 +464,6 @@ void WebdatasetLoader::PrepareMetadataImpl() {
   }
 
   // collecting and filtering the index files
-  std::vector<detail::wds::SampleDesc> unfiltered_samples;
-  std::vector<detail::wds::ComponentDesc> unfiltered_components;
   bitmask was_output_set;
   was_output_set.resize(ext_.size(), false);
   output_indicies_.reserve(ext_.size());
@@ -399,16 +473,24 @@ void WebdatasetLoader::PrepareMetadataImpl() {
     dtype_sizes_[i] = TypeTable::GetTypeInfo(dtypes_[i]).size();
   }
 
-  for (size_t wds_shard_index = 0; wds_shard_index < paths_.size(); wds_shard_index++) {
-    unfiltered_samples.resize(0);
-    unfiltered_components.resize(0);
-    if (generate_index_) {
-      detail::wds::ParseTarFile(unfiltered_samples, unfiltered_components,
-                                wds_shards_[wds_shard_index]);
-    } else {
-      detail::wds::ParseIndexFile(unfiltered_samples, unfiltered_components,
-                                  index_paths_[wds_shard_index]);
+  // The archives (or their index files) are parsed in parallel, the samples are then filtered
+  // sequentially to keep their order.
+  std::vector<ShardIndex> shard_indices(paths_.size());
+  {
+    ThreadPool thread_pool(std::min<int>(num_threads_, paths_.size()), CPU_ONLY_DEVICE_ID, false,
+                           "WebdatasetIndex");
+    for (size_t wds_shard_index = 0; wds_shard_index < paths_.size(); wds_shard_index++) {
+      int64_t priority = wds_shards_[wds_shard_index]->Size();
+      thread_pool.AddWork([this, wds_shard_index, &shard_indices](int) {
+        ParseShardIndex(shard_indices[wds_shard_index], wds_shard_index);
+      }, priority);
     }
+    thread_pool.RunAll();
+  }
+
+  for (size_t wds_shard_index = 0; wds_shard_index < paths_.size(); wds_shard_index++) {
+    auto& unfiltered_samples = shard_indices[wds_shard_index].samples;
+    auto& unfiltered_components = shard_indices[wds_shard_index].components;
 
     for (auto& sample : unfiltered_samples) {
       detail::wds::SampleDesc new_sample{
@@ -472,12 +554,51 @@ void WebdatasetLoader::PrepareMetadataImpl() {
       }
       was_output_set.fill(false);
     }
+    // release the memory of the unfiltered index
+    unfiltered_samples = {};
+    unfiltered_components = {};
+  }
+  Reset(true);
+}
+
+void WebdatasetLoader::ParseShardIndex(ShardIndex& index, size_t wds_shard_index) {
+  if (!generate_index_) {
+    detail::wds::ParseIndexFile(index.samples, index.components, index_paths_[wds_shard_index]);
+    return;
+  }
+
+  const auto& archive_path = paths_[wds_shard_index];
+  std::string saved_index_path;
+  if (save_generated_index_) {
+    saved_index_path = detail::wds::GeneratedIndexPath(archive_path);
+    if (detail::wds::IsIndexUpToDate(saved_index_path, archive_path)) {
+      try {
+        detail::wds::ParseIndexFile(index.samples, index.components, saved_index_path);
+        return;
+      } catch (const std::exception& e) {
+        DALI_WARN(make_string("Failed to read the saved index \"", saved_index_path,
+                              "\", the index will be regenerated: ", e.what()));
+        index.samples.clear();
+        index.components.clear();
+      }
+    }
+  }
+
+  detail::wds::ParseTarFile(index.samples, index.components, wds_shards_[wds_shard_index]);
+  if (save_generated_index_ && !detail::wds::SaveIndexFile(index.samples, saved_index_path)) {
+    DALI_WARN(make_string("Could not save the index of the tar file at \"", archive_path,
+                          "\" to \"", saved_index_path, "\"."));
   }
-  sample_index_ = start_index(shard_id_, num_shards_, samples_.size());
 }
 
 void WebdatasetLoader::Reset(bool wrap_to_shard) {
-  sample_index_ = wrap_to_shard ? start_index(shard_id_, num_shards_, samples_.size()) : 0;
+  sample_index_ = wrap_to_shard ? start_index(virtual_shard_id_, num_shards_, samples_.size()) : 0;
+  current_epoch_++;
+  global_shuffle_.Shuffle(samples_.size(), current_epoch_);
+}
+
+void WebdatasetLoader::RestoreStateImpl(const LoaderStateSnapshot& state) {
+  current_epoch_ = state.current_epoch;
 }
 
 }  // namespace dali
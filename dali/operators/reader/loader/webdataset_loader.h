@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 #include "dali/core/bitmask.h"
+#include "dali/operators/reader/loader/block_shuffle.h"
 #include "dali/operators/reader/loader/loader.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/util/file.h"
@@ -87,7 +88,8 @@ struct SampleDesc {
 }  // namespace wds
 }  // namespace detail
 
-class DLL_PUBLIC WebdatasetLoader : public Loader<CPUBackend, vector<Tensor<CPUBackend>>> {
+class DLL_PUBLIC WebdatasetLoader
+    : public Loader<CPUBackend, vector<Tensor<CPUBackend>>, true> {
  public:
   explicit WebdatasetLoader(const OpSpec& spec);
   ~WebdatasetLoader() override;
@@ -99,6 +101,7 @@ class DLL_PUBLIC WebdatasetLoader : public Loader<CPUBackend, vector<Tensor<CPUB
   Index SizeImpl() override;
   void PrepareMetadataImpl() override;
   void Reset(bool wrap_to_shard) override;
+  void RestoreStateImpl(const LoaderStateSnapshot& state) override;
 
   std::vector<std::string> paths_;
   std::vector<std::string> index_paths_;
@@ -113,6 +116,22 @@ class DLL_PUBLIC WebdatasetLoader : public Loader<CPUBackend, vector<Tensor<CPUB
   std::vector<size_t> empty_outputs_;  // indices of empty outputs to fill in for space optimization
   std::vector<size_t> output_indicies_;  // indices of outputs that a component corresponds to
 
+  /**
+   * @brief The unfiltered index of one archive
+   */
+  struct ShardIndex {
+    std::vector<detail::wds::SampleDesc> samples;
+    std::vector<detail::wds::ComponentDesc> components;
+  };
+
+  /**
+   * @brief Parses the index file of the archive or, if not provided, the archive itself.
+   *
+   * With `save_generated_index_`, the index generated from the archive is saved next to it and
+   * reused in the subsequent runs, as long as the archive isn't modified.
+   */
+  void ParseShardIndex(ShardIndex& index, size_t wds_shard_index);
+
   std::vector<std::unique_ptr<FileStream>> wds_shards_;
   size_t sample_index_ = 0;
   FileStream::MappingReserver mmap_reserver_;
@@ -121,6 +140,11 @@ class DLL_PUBLIC WebdatasetLoader : public Loader<CPUBackend, vector<Tensor<CPUB
   bool generate_index_ = true;
   std::string GetSampleSource(const detail::wds::SampleDesc& sample);
   bool case_sensitive_extensions_ = true;
+  bool save_generated_index_ = false;
+  int num_threads_ = 1;
+  // order of the samples, if the whole dataset is shuffled
+  GlobalShuffleOrder global_shuffle_;
+  int current_epoch_ = 0;
 };
 
 }  // namespace dali
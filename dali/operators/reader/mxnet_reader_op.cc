@@ -32,7 +32,8 @@ DALI_SCHEMA(readers__MXNet)
 The file is generated by the MXNet's ``im2rec.py`` script with the RecordIO file. The list can
 also be generated by using the ``rec2idx`` script that is distributed with DALI.)code",
       DALI_STRING_VEC)
-  .AddParent("LoaderBase");
+  .AddParent("LoaderBase")
+  .AddParent("GlobalShuffleLoaderBase");
 
 
 // Deprecated alias
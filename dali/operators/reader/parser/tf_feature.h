@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "dali/core/common.h"
+#include "dali/core/error_handling.h"
 #include "dali/pipeline/proto/dali_proto_utils.h"
 
 namespace dali {
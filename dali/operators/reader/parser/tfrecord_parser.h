@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -27,7 +27,7 @@
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/operators/reader/parser/parser.h"
 #include "dali/operators/reader/parser/tf_feature.h"
-#include "dali/operators/reader/parser/example.pb.h"
+#include "dali/operators/reader/parser/tfrecord_scanner.h"
 
 namespace dali {
 
@@ -47,8 +47,6 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
   }
 
   void Parse(const Tensor<CPUBackend>& data, SampleWorkspace* ws) override {
-    tensorflow::Example example;
-
     uint64_t length;
     uint32_t crc;
 
@@ -58,16 +56,22 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
 
     // Omit length and crc
     raw_data = raw_data + sizeof(length) + sizeof(crc);
-    DALI_ENFORCE(example.ParseFromArray(raw_data, length),
+
+    // Only the requested features are located in the record - the values are decoded
+    // (or, for bytes, copied) straight to the outputs. The bytes are views into the record
+    // until then, but they can't be passed on as they are: the loader recycles the record
+    // buffer for the next read as soon as the sample is parsed.
+    SmallVector<tfrecord::FeatureView, 8> views;
+    views.resize(features_.size());
+    DALI_ENFORCE(tfrecord::ScanExample(make_cspan(raw_data, length), make_cspan(feature_names_),
+                                       make_span(views)),
       make_string("Error while parsing TFRecord file: ", data.GetSourceInfo(),
                   " (raw data length: ", length, " bytes)."));
 
     for (size_t i = 0; i < features_.size(); ++i) {
       auto& output = ws->Output<CPUBackend>(i);
       Feature& f = features_[i];
-      std::string& name = feature_names_[i];
-      auto& feature = example.features().feature();
-      auto it = feature.find(name);
+      auto& encoded_feature = views[i];
       // set type
       switch (f.GetType()) {
         case FeatureType::int64:
@@ -80,49 +84,45 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
             output.set_type(DALI_FLOAT);
           break;
       }
-      if (it == feature.end()) {
+      if (!encoded_feature.found()) {
         output.Resize({});
         output.SetSourceInfo(data.GetSourceInfo());
         continue;
       }
-      auto& encoded_feature = it->second;
       if (f.HasShape() && f.GetType() != FeatureType::string) {
         output.Resize(f.Shape());
       }
-      ssize_t number_of_elms = 0;
+      ssize_t number_of_elms = encoded_feature.NumValues(f.GetType());
       switch (f.GetType()) {
         case FeatureType::int64:
-          number_of_elms = encoded_feature.int64_list().value().size();
           if (!f.HasShape()) {
             output.Resize(InferShape(f, number_of_elms));
           }
           DALI_ENFORCE(number_of_elms <= output.size(), make_string("Output tensor shape is too "
                        "small: [", output.shape(), "]. Expected at least ", number_of_elms,
                        " elements."));
-          std::memcpy(output.mutable_data<int64_t>(),
-              encoded_feature.int64_list().value().data(),
-              encoded_feature.int64_list().value().size()*sizeof(int64_t));
+          encoded_feature.CopyValues(output.mutable_data<int64_t>());
           break;
-        case FeatureType::string:
+        case FeatureType::string: {
           if (!f.HasShape() || volume(f.Shape()) > 1) {
             DALI_FAIL("Tensors of strings are not supported.");
           }
-          output.Resize({static_cast<Index>(encoded_feature.bytes_list().value(0).size())});
-          std::memcpy(output.mutable_data<uint8_t>(),
-              encoded_feature.bytes_list().value(0).c_str(),
-              encoded_feature.bytes_list().value(0).size()*sizeof(uint8_t));
+          DALI_ENFORCE(number_of_elms > 0, make_string("Feature \"", feature_names_[i],
+                       "\" in TFRecord file: ", data.GetSourceInfo(), " is not a bytes list or "
+                       "is empty."));
+          auto value = encoded_feature.BytesValue(0);
+          output.Resize({static_cast<Index>(value.size())});
+          std::memcpy(output.mutable_data<uint8_t>(), value.data(), value.size());
           break;
+        }
         case FeatureType::float32:
-          number_of_elms = encoded_feature.float_list().value().size();
           if (!f.HasShape()) {
             output.Resize(InferShape(f, number_of_elms));
           }
           DALI_ENFORCE(number_of_elms <= output.size(), make_string("Output tensor shape is too "
                        "small: [", output.shape(), "]. Expected at least ", number_of_elms,
                        " elements."));
-          std::memcpy(output.mutable_data<float>(),
-              encoded_feature.float_list().value().data(),
-              number_of_elms * sizeof(float));
+          encoded_feature.CopyValues(output.mutable_data<float>());
           break;
       }
       output.SetSourceInfo(data.GetSourceInfo());
@@ -0,0 +1,373 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef DALI_BUILD_PROTO3
+
+#include <cassert>
+#include <cstring>
+#include <string>
+
+#include "dali/operators/reader/parser/tfrecord_scanner.h"
+
+namespace dali {
+namespace tfrecord {
+
+namespace {
+
+// protobuf wire types
+enum WireType : int {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+  kFixed32 = 5
+};
+
+// field numbers of the kinds of `tensorflow.Feature`
+enum FeatureKind : int {
+  kBytesList = 1,
+  kFloatList = 2,
+  kInt64List = 3
+};
+
+/**
+ * @brief Reads the protobuf wire format from a buffer, with bounds checking.
+ *
+ * All the reading functions return false if the data is malformed.
+ */
+class WireReader {
+ public:
+  explicit WireReader(span<const uint8_t> data)
+  : ptr_(data.data()), end_(data.data() + data.size()) {}
+
+  bool empty() const { return ptr_ == end_; }
+
+  bool ReadVarint(uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (ptr_ == end_)
+        return false;
+      uint8_t byte = *ptr_++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadTag(int &field, int &wire_type) {
+    uint64_t tag;
+    if (!ReadVarint(tag) || (tag >> 3) == 0 || (tag >> 3) > INT32_MAX)
+      return false;
+    field = tag >> 3;
+    wire_type = tag & 7;
+    return true;
+  }
+
+  bool ReadLengthDelimited(span<const uint8_t> &value) {
+    uint64_t length;
+    if (!ReadVarint(length) || length > static_cast<uint64_t>(end_ - ptr_))
+      return false;
+    value = make_cspan(ptr_, length);
+    ptr_ += length;
+    return true;
+  }
+
+  bool ReadFixed32(uint32_t &value) {
+    if (end_ - ptr_ < 4)
+      return false;
+    std::memcpy(&value, ptr_, 4);
+    ptr_ += 4;
+    return true;
+  }
+
+  bool Skip(int wire_type) {
+    uint64_t varint;
+    span<const uint8_t> data;
+    switch (wire_type) {
+      case kVarint:
+        return ReadVarint(varint);
+      case kFixed64:
+        if (end_ - ptr_ < 8)
+          return false;
+        ptr_ += 8;
+        return true;
+      case kLengthDelimited:
+        return ReadLengthDelimited(data);
+      case kFixed32:
+        if (end_ - ptr_ < 4)
+          return false;
+        ptr_ += 4;
+        return true;
+      default:  // groups are not used by the Example proto
+        return false;
+    }
+  }
+
+ private:
+  const uint8_t *ptr_, *end_;
+};
+
+int KindOf(TFUtil::FeatureType type) {
+  switch (type) {
+    case TFUtil::FeatureType::int64:
+      return kInt64List;
+    case TFUtil::FeatureType::float32:
+      return kFloatList;
+    case TFUtil::FeatureType::string:
+      return kBytesList;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Calls `visit(reader, wire_type)` for each `value` field of an encoded list message.
+ *
+ * Packed repeated fields are unpacked, so that the visitor always gets a single element.
+ * The Feature has already been validated by FeatureView::Merge, so this cannot fail.
+ */
+template <typename Visitor>
+void ForEachValue(span<const uint8_t> list, int kind, Visitor &&visit) {
+  WireReader reader(list);
+  int field, wire_type;
+  while (!reader.empty()) {
+    bool ok = reader.ReadTag(field, wire_type);
+    assert(ok);
+    if (field == 1 && kind != kBytesList && wire_type == kLengthDelimited) {
+      span<const uint8_t> packed;
+      ok = reader.ReadLengthDelimited(packed);
+      assert(ok);
+      WireReader packed_reader(packed);
+      int element_wire_type = kind == kFloatList ? kFixed32 : kVarint;
+      while (!packed_reader.empty())
+        visit(packed_reader, element_wire_type);
+    } else if (field == 1 && wire_type == (kind == kBytesList ? kLengthDelimited :
+                                           kind == kFloatList ? kFixed32 : kVarint)) {
+      visit(reader, wire_type);
+    } else {
+      ok = reader.Skip(wire_type);
+      assert(ok);
+    }
+    (void)ok;
+  }
+}
+
+/**
+ * @brief Checks if the encoded list message is well formed
+ */
+bool ValidateList(span<const uint8_t> list, int kind) {
+  WireReader reader(list);
+  int field, wire_type;
+  while (!reader.empty()) {
+    if (!reader.ReadTag(field, wire_type))
+      return false;
+    if (field == 1 && kind != kBytesList && wire_type == kLengthDelimited) {
+      span<const uint8_t> packed;
+      if (!reader.ReadLengthDelimited(packed))
+        return false;
+      if (kind == kFloatList) {
+        if (packed.size() % sizeof(float) != 0)
+          return false;
+      } else {
+        WireReader packed_reader(packed);
+        uint64_t value;
+        while (!packed_reader.empty())
+          if (!packed_reader.ReadVarint(value))
+            return false;
+      }
+    } else if (!reader.Skip(wire_type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, typename U>
+void DecodeValues(span<const span<const uint8_t>> lists, int kind, T *out) {
+  for (auto list : lists) {
+    ForEachValue(list, kind, [&](WireReader &reader, int wire_type) {
+      U value;
+      bool ok;
+      if (wire_type == kFixed32) {
+        uint32_t bits;
+        ok = reader.ReadFixed32(bits);
+        std::memcpy(&value, &bits, sizeof(value));
+      } else {
+        uint64_t bits;
+        ok = reader.ReadVarint(bits);
+        value = static_cast<U>(bits);
+      }
+      assert(ok);
+      (void)ok;
+      *out++ = value;
+    });
+  }
+}
+
+}  // namespace
+
+bool FeatureView::Merge(span<const uint8_t> feature_msg) {
+  WireReader reader(feature_msg);
+  int field, wire_type;
+  while (!reader.empty()) {
+    if (!reader.ReadTag(field, wire_type))
+      return false;
+    if (field >= kBytesList && field <= kInt64List && wire_type == kLengthDelimited) {
+      span<const uint8_t> list;
+      if (!reader.ReadLengthDelimited(list) || !ValidateList(list, field))
+        return false;
+      // setting a different member of the oneof clears the previous one,
+      // the occurrences of the same member are merged
+      if (field != kind_) {
+        lists_.clear();
+        kind_ = field;
+      }
+      lists_.push_back(list);
+    } else if (!reader.Skip(wire_type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t FeatureView::NumValues(TFUtil::FeatureType type) const {
+  int kind = KindOf(type);
+  if (!found_ || kind != kind_)
+    return 0;
+  int64_t count = 0;
+  for (auto list : lists_) {
+    ForEachValue(list, kind, [&](WireReader &reader, int wire_type) {
+      bool ok = reader.Skip(wire_type);
+      assert(ok);
+      (void)ok;
+      count++;
+    });
+  }
+  return count;
+}
+
+void FeatureView::CopyValues(int64_t *out) const {
+  if (kind_ == kInt64List)
+    DecodeValues<int64_t, int64_t>(make_cspan(lists_), kind_, out);
+}
+
+void FeatureView::CopyValues(float *out) const {
+  if (kind_ != kFloatList)
+    return;
+  // the packed floats are copied directly - that's how protobuf stores them in the memory, too
+  if (lists_.size() == 1) {
+    WireReader reader(lists_[0]);
+    int field, wire_type;
+    span<const uint8_t> packed;
+    if (reader.ReadTag(field, wire_type) && field == 1 && wire_type == kLengthDelimited &&
+        reader.ReadLengthDelimited(packed) && reader.empty()) {
+      std::memcpy(out, packed.data(), packed.size());
+      return;
+    }
+  }
+  DecodeValues<float, float>(make_cspan(lists_), kind_, out);
+}
+
+span<const uint8_t> FeatureView::BytesValue(int64_t idx) const {
+  assert(kind_ == kBytesList);
+  span<const uint8_t> result;
+  int64_t i = 0;
+  for (auto list : lists_) {
+    ForEachValue(list, kind_, [&](WireReader &reader, int) {
+      span<const uint8_t> value;
+      bool ok = reader.ReadLengthDelimited(value);
+      assert(ok);
+      (void)ok;
+      if (i++ == idx)
+        result = value;
+    });
+    if (i > idx)
+      break;
+  }
+  return result;
+}
+
+bool ScanExample(span<const uint8_t> record, span<const std::string> names,
+                 span<FeatureView> features) {
+  assert(names.size() == features.size());
+  for (auto &f : features)
+    f.Reset();
+
+  WireReader example(record);
+  int field, wire_type;
+  while (!example.empty()) {
+    if (!example.ReadTag(field, wire_type))
+      return false;
+    if (field != 1 || wire_type != kLengthDelimited) {  // not Example.features
+      if (!example.Skip(wire_type))
+        return false;
+      continue;
+    }
+    span<const uint8_t> features_msg;
+    if (!example.ReadLengthDelimited(features_msg))
+      return false;
+    // repeated occurrences of Example.features are merged - the map entries accumulate
+    WireReader map(features_msg);
+    while (!map.empty()) {
+      if (!map.ReadTag(field, wire_type))
+        return false;
+      if (field != 1 || wire_type != kLengthDelimited) {  // not a map entry
+        if (!map.Skip(wire_type))
+          return false;
+        continue;
+      }
+      span<const uint8_t> entry_msg;
+      if (!map.ReadLengthDelimited(entry_msg))
+        return false;
+      // the key can follow the value, so the whole entry is read first
+      span<const uint8_t> key;
+      SmallVector<span<const uint8_t>, 1> values;
+      WireReader entry(entry_msg);
+      while (!entry.empty()) {
+        if (!entry.ReadTag(field, wire_type))
+          return false;
+        if (field == 1 && wire_type == kLengthDelimited) {
+          if (!entry.ReadLengthDelimited(key))
+            return false;
+        } else if (field == 2 && wire_type == kLengthDelimited) {
+          span<const uint8_t> value;
+          if (!entry.ReadLengthDelimited(value))
+            return false;
+          values.push_back(value);
+        } else if (!entry.Skip(wire_type)) {
+          return false;
+        }
+      }
+      for (int64_t i = 0; i < names.size(); i++) {
+        const std::string &name = names[i];
+        if (name.size() != static_cast<size_t>(key.size()) ||
+            std::memcmp(name.data(), key.data(), key.size()) != 0)
+          continue;
+        // a repeated key replaces the previous entry
+        auto &f = features[i];
+        f.Reset();
+        f.found_ = true;
+        for (auto value : values)
+          if (!f.Merge(value))
+            return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace tfrecord
+}  // namespace dali
+
+#endif  // DALI_BUILD_PROTO3
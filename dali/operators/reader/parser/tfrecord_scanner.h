@@ -0,0 +1,106 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_PARSER_TFRECORD_SCANNER_H_
+#define DALI_OPERATORS_READER_PARSER_TFRECORD_SCANNER_H_
+
+#ifdef DALI_BUILD_PROTO3
+
+#include <cstdint>
+#include <string>
+
+#include "dali/core/api_helper.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/span.h"
+#include "dali/operators/reader/parser/tf_feature.h"
+
+namespace dali {
+namespace tfrecord {
+
+class FeatureView;
+
+/**
+ * @brief Finds the features called `names` in a serialized `tensorflow.Example` without
+ *        parsing the rest of the message.
+ *
+ * This is equivalent to `Example::ParseFromArray` followed by the lookup of the features,
+ * but nothing is copied and the features that are not requested are skipped.
+ *
+ * @param record serialized `tensorflow.Example`
+ * @param names  names of the requested features
+ * @param features the views of the features corresponding to `names`
+ * @return false if the record is malformed
+ */
+DLL_PUBLIC bool ScanExample(span<const uint8_t> record, span<const std::string> names,
+                            span<FeatureView> features);
+
+/**
+ * @brief A lazily decoded `tensorflow.Feature` found in a serialized `tensorflow.Example`
+ *
+ * Holds views into the encoded record (which must outlive the FeatureView) and decodes
+ * the values only when they are requested.
+ */
+class DLL_PUBLIC FeatureView {
+ public:
+  bool found() const { return found_; }
+
+  /**
+   * @brief The number of values in the feature, or 0 if the feature holds values
+   *        of a different kind than `type` (that's what the protobuf accessors would return)
+   */
+  int64_t NumValues(TFUtil::FeatureType type) const;
+
+  /**
+   * @brief Decodes the int64 values to `out`, which must fit `NumValues(int64)` elements
+   */
+  void CopyValues(int64_t *out) const;
+
+  /**
+   * @brief Decodes the float values to `out`, which must fit `NumValues(float32)` elements
+   */
+  void CopyValues(float *out) const;
+
+  /**
+   * @brief Returns the view of `idx`-th value of a `bytes_list` feature
+   */
+  span<const uint8_t> BytesValue(int64_t idx) const;
+
+ private:
+  friend bool ScanExample(span<const uint8_t>, span<const std::string>, span<FeatureView>);
+
+  void Reset() {
+    found_ = false;
+    kind_ = 0;
+    lists_.clear();
+  }
+
+  /**
+   * @brief Applies the (possibly repeated) encoded `Feature` message to the view, following
+   *        the protobuf merging semantics.
+   */
+  bool Merge(span<const uint8_t> feature_msg);
+
+  bool found_ = false;
+  /// field number of the `kind` oneof that is set: 1 - bytes, 2 - float, 3 - int64
+  int kind_ = 0;
+  /// encoded BytesList/FloatList/Int64List messages - usually there's just one
+  SmallVector<span<const uint8_t>, 1> lists_;
+};
+
+}  // namespace tfrecord
+}  // namespace dali
+
+#endif  // DALI_BUILD_PROTO3
+
+#endif  // DALI_OPERATORS_READER_PARSER_TFRECORD_SCANNER_H_
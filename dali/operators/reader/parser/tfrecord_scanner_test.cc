@@ -0,0 +1,224 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef DALI_BUILD_PROTO3
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "dali/operators/reader/parser/example.pb.h"
+#include "dali/operators/reader/parser/tfrecord_scanner.h"
+
+namespace dali {
+namespace tfrecord {
+
+namespace {
+
+/**
+ * @brief A minimal protobuf encoder, used to build records that protobuf itself wouldn't produce
+ *        (unpacked lists, repeated keys, etc.)
+ */
+struct Encoder {
+  std::string buf;
+
+  Encoder &Varint(uint64_t v) {
+    while (v >= 0x80) {
+      buf.push_back(static_cast<char>(v | 0x80));
+      v >>= 7;
+    }
+    buf.push_back(static_cast<char>(v));
+    return *this;
+  }
+
+  Encoder &Tag(int field, int wire_type) {
+    return Varint(static_cast<uint64_t>(field) << 3 | wire_type);
+  }
+
+  Encoder &Bytes(int field, const std::string &data) {
+    Tag(field, 2).Varint(data.size());
+    buf += data;
+    return *this;
+  }
+
+  Encoder &Float(int field, float value) {
+    Tag(field, 5);
+    char bytes[sizeof(float)];
+    std::memcpy(bytes, &value, sizeof(float));
+    buf.append(bytes, sizeof(float));
+    return *this;
+  }
+};
+
+std::string MapEntry(const std::string &key, const std::string &feature) {
+  return Encoder().Bytes(1, key).Bytes(2, feature).buf;
+}
+
+std::string Record(const std::vector<std::string> &entries) {
+  Encoder features;
+  for (auto &e : entries)
+    features.Bytes(1, e);
+  return Encoder().Bytes(1, features.buf).buf;
+}
+
+span<const uint8_t> AsSpan(const std::string &s) {
+  return make_cspan(reinterpret_cast<const uint8_t *>(s.data()), s.size());
+}
+
+/**
+ * @brief Checks that the scanner finds the same features as a full protobuf parse
+ */
+void CheckAgainstProtobuf(const std::string &record, const std::vector<std::string> &names) {
+  tensorflow::Example example;
+  ASSERT_TRUE(example.ParseFromString(record));
+  std::vector<FeatureView> views(names.size());
+  ASSERT_TRUE(ScanExample(AsSpan(record), make_cspan(names), make_span(views)));
+
+  auto &map = example.features().feature();
+  for (size_t i = 0; i < names.size(); i++) {
+    auto it = map.find(names[i]);
+    auto &view = views[i];
+    ASSERT_EQ(view.found(), it != map.end()) << names[i];
+    if (it == map.end())
+      continue;
+    auto &ref = it->second;
+
+    auto &ints = ref.int64_list().value();
+    ASSERT_EQ(view.NumValues(TFUtil::FeatureType::int64), ints.size()) << names[i];
+    std::vector<int64_t> int_values(ints.size());
+    view.CopyValues(int_values.data());
+    for (int j = 0; j < ints.size(); j++)
+      EXPECT_EQ(int_values[j], ints[j]) << names[i] << " at " << j;
+
+    auto &floats = ref.float_list().value();
+    ASSERT_EQ(view.NumValues(TFUtil::FeatureType::float32), floats.size()) << names[i];
+    std::vector<float> float_values(floats.size());
+    view.CopyValues(float_values.data());
+    for (int j = 0; j < floats.size(); j++)
+      EXPECT_EQ(float_values[j], floats[j]) << names[i] << " at " << j;
+
+    auto &strings = ref.bytes_list().value();
+    ASSERT_EQ(view.NumValues(TFUtil::FeatureType::string), strings.size()) << names[i];
+    for (int j = 0; j < strings.size(); j++) {
+      auto value = view.BytesValue(j);
+      EXPECT_EQ(std::string(reinterpret_cast<const char *>(value.data()), value.size()),
+                strings[j]) << names[i] << " at " << j;
+      // the values are views into the record
+      if (!strings[j].empty()) {
+        EXPECT_GE(reinterpret_cast<const char *>(value.data()), record.data());
+        EXPECT_LE(reinterpret_cast<const char *>(value.data() + value.size()),
+                  record.data() + record.size());
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TFRecordScannerTest, SerializedExample) {
+  tensorflow::Example example;
+  auto &map = *example.mutable_features()->mutable_feature();
+  auto &ints = *map["ints"].mutable_int64_list();
+  for (int64_t v : {0L, 1L, -1L, 300L, INT64_MAX, INT64_MIN})
+    ints.add_value(v);
+  auto &floats = *map["floats"].mutable_float_list();
+  for (float v : {0.0f, -1.5f, 3.25e10f})
+    floats.add_value(v);
+  map["image"].mutable_bytes_list()->add_value(std::string("\0\1\2\3jpeg", 8));
+  map["strings"].mutable_bytes_list()->add_value("first");
+  map["strings"].mutable_bytes_list()->add_value("");
+  map["strings"].mutable_bytes_list()->add_value("third");
+  map["empty"];
+  map["empty_list"].mutable_float_list();
+  for (int i = 0; i < 20; i++)
+    map["other" + std::to_string(i)].mutable_int64_list()->add_value(i);
+  std::string record;
+  ASSERT_TRUE(example.SerializeToString(&record));
+
+  CheckAgainstProtobuf(record, {"ints", "floats", "image", "strings", "empty", "empty_list",
+                                "other7", "missing", ""});
+}
+
+TEST(TFRecordScannerTest, UnpackedAndSplitLists) {
+  std::string unpacked_ints = Encoder().Tag(1, 0).Varint(5).Tag(1, 0).Varint(-7L).buf;
+  std::string packed_ints = Encoder().Tag(1, 2).Varint(2).Varint(1).Varint(2).buf;
+  std::string unpacked_floats = Encoder().Float(1, 1.5f).Float(1, -2.0f).buf;
+  std::string packed_floats = Encoder().Tag(1, 2).Varint(4).buf + std::string("\0\0\200\77", 4);
+  // the same kind of the oneof repeated within a Feature is merged
+  std::string ints = Encoder().Bytes(3, unpacked_ints).Bytes(3, packed_ints)
+                              .Bytes(3, unpacked_ints).buf;
+  std::string floats = Encoder().Bytes(2, packed_floats).Bytes(2, unpacked_floats).buf;
+  std::string record = Record({MapEntry("ints", ints), MapEntry("floats", floats)});
+  CheckAgainstProtobuf(record, {"ints", "floats"});
+}
+
+TEST(TFRecordScannerTest, MergingSemantics) {
+  std::string ints = Encoder().Bytes(3, Encoder().Tag(1, 0).Varint(42).buf).buf;
+  std::string bytes = Encoder().Bytes(1, Encoder().Bytes(1, "abc").buf).buf;
+  std::string floats = Encoder().Bytes(2, Encoder().Float(1, 4.0f).buf).buf;
+  // a different kind of the oneof replaces the previous one
+  std::string switched = ints + bytes;
+  // the value of a map entry repeated in the entry is merged
+  std::string entry_with_two_values = Encoder().Bytes(2, floats).Bytes(1, "merged")
+                                               .Bytes(2, floats).buf;
+  // unknown fields are skipped
+  std::string unknown = Encoder().Tag(15, 0).Varint(1).Tag(16, 1).buf + std::string(8, 'x');
+  std::string record = Record({
+    MapEntry("replaced", ints),
+    MapEntry("switched", switched),
+    unknown + MapEntry("key_last", floats),
+    Encoder().Bytes(2, floats).Bytes(1, "key_last").buf,
+    entry_with_two_values,
+    MapEntry("replaced", bytes),
+  });
+  // the Features message repeated in the Example is merged, too
+  record += Record({MapEntry("second", floats), MapEntry("switched", floats)});
+  record += unknown;
+  CheckAgainstProtobuf(record, {"replaced", "switched", "key_last", "merged", "second"});
+
+  // the same name requested twice
+  std::vector<std::string> names = {"second", "second"};
+  std::vector<FeatureView> views(2);
+  ASSERT_TRUE(ScanExample(AsSpan(record), make_cspan(names), make_span(views)));
+  EXPECT_EQ(views[0].NumValues(TFUtil::FeatureType::float32), 1);
+  EXPECT_EQ(views[1].NumValues(TFUtil::FeatureType::float32), 1);
+}
+
+TEST(TFRecordScannerTest, Malformed) {
+  std::string floats = Encoder().Bytes(2, Encoder().Float(1, 4.0f).buf).buf;
+  std::string record = Record({MapEntry("a", floats), MapEntry("b", floats)});
+  std::vector<std::string> names = {"b"};
+  std::vector<FeatureView> views(1);
+  ASSERT_TRUE(ScanExample(AsSpan(record), make_cspan(names), make_span(views)));
+  for (size_t length = 0; length < record.size(); length++) {
+    tensorflow::Example example;
+    bool ref_ok = example.ParseFromArray(record.data(), length);
+    bool ok = ScanExample(make_cspan(AsSpan(record).data(), length), make_cspan(names),
+                          make_span(views));
+    EXPECT_EQ(ok, ref_ok) << "Truncated to " << length << " bytes";
+  }
+  // packed floats with a size that's not a multiple of 4
+  std::string bad_floats = Encoder().Bytes(2, Encoder().Tag(1, 2).Varint(3).buf + "abc").buf;
+  std::string bad_record = Record({MapEntry("b", bad_floats)});
+  EXPECT_FALSE(ScanExample(AsSpan(bad_record), make_cspan(names), make_span(views)));
+  // a group
+  std::string group_record = Encoder().Tag(3, 3).Tag(3, 4).buf;
+  EXPECT_FALSE(ScanExample(AsSpan(group_record), make_cspan(names), make_span(views)));
+}
+
+}  // namespace tfrecord
+}  // namespace dali
+
+#endif  // DALI_BUILD_PROTO3
@@ -0,0 +1,114 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/persistent_cache_reader_op.h"
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace dali {
+
+bool PersistentCacheReader::SetupImpl(std::vector<OutputDesc>& output_desc, const Workspace &ws) {
+  DataReader<CPUBackend, std::vector<Tensor<CPUBackend>>>::SetupImpl(output_desc, ws);
+  int num_outputs = ws.NumOutput();
+  int num_samples = GetCurrBatchSize();
+
+  output_desc.resize(num_outputs);
+  for (int output_idx = 0; output_idx < num_outputs; output_idx++) {
+    auto &first = GetSample(0)[output_idx];
+    output_desc[output_idx].shape = TensorListShape<>(num_samples, first.ndim());
+    output_desc[output_idx].type = first.type();
+  }
+
+  for (int data_idx = 0; data_idx < num_samples; data_idx++) {
+    auto& sample = GetSample(data_idx);
+    for (int output_idx = 0; output_idx < num_outputs; output_idx++) {
+      auto &desc = output_desc[output_idx];
+      auto &tensor = sample[output_idx];
+      DALI_ENFORCE(tensor.type() == desc.type && tensor.ndim() == desc.shape.sample_dim() &&
+                   tensor.GetLayout() == GetSample(0)[output_idx].GetLayout(),
+                   make_string("The samples in the persistent cache differ in type, "
+                               "dimensionality or layout. Output ", output_idx, ", sample \"",
+                               tensor.GetSourceInfo(), "\"."));
+      desc.shape.set_tensor_shape(data_idx, tensor.shape());
+    }
+  }
+  return true;
+}
+
+void PersistentCacheReader::RunImpl(Workspace &ws) {
+  int num_outputs = ws.NumOutput();
+  int num_samples = GetCurrBatchSize();
+
+  bool threaded = ws.GetThreadPool().NumThreads() > 1;
+
+  for (int output_idx = 0; output_idx < num_outputs; output_idx++) {
+    auto& output = ws.Output<CPUBackend>(output_idx);
+    output.SetLayout(GetSample(0)[output_idx].GetLayout());
+    for (int data_idx = 0; data_idx < num_samples; data_idx++) {
+      auto& sample = GetSample(data_idx);
+      ThreadPool::Work copy_task = [output_idx = output_idx, data_idx = data_idx, &output,
+                                    &sample](int) {
+        output.SetMeta(data_idx, sample[output_idx].GetMeta());
+        std::memcpy(output.raw_mutable_tensor(data_idx), sample[output_idx].raw_data(),
+                    sample[output_idx].nbytes());
+      };
+      if (threaded) {
+        ws.GetThreadPool().AddWork(std::move(copy_task), -data_idx);
+      } else {
+        copy_task(0);
+      }
+    }
+  }
+  if (threaded) {
+    ws.GetThreadPool().RunAll();
+  }
+}
+
+DALI_SCHEMA(experimental__readers__PersistentCache)
+  .DocStr(R"code(Reads the samples stored in a persistent cache file.
+
+The cache file is written by :meth:`nvidia.dali.fn.experimental.persistent_cache_writer`
+and contains the outputs of a deterministic part of a pipeline (for example, decoding and
+resizing) for every sample that was seen when the cache was created. Reading the cached samples
+replaces both the original reader and the cached processing.
+
+The file is memory-mapped, unless ``dont_use_mmap`` is set, and the samples are not copied
+before they are written to the outputs. The source info of the samples is the same as that of
+the original samples.
+
+Usually, this operator is not used directly - see :meth:`nvidia.dali.experimental.persistent_cache`.
+
+.. note::
+  The samples are read in the order of their source info - the order in which the original
+  reader returned them is not preserved.)code")
+  .NumInput(0)
+  .OutputFn([](const OpSpec& spec) {
+    return spec.GetArgument<int>("num_outputs");
+  })
+  .AddArg("path", R"code(Path to the cache file.)code", DALI_STRING)
+  .AddOptionalArg("key", R"code(The invalidation key of the cache.
+
+If not empty, it must be equal to the key with which the cache file was written.)code",
+    std::string())
+  .AddOptionalArg("num_outputs", R"code(Number of outputs stored in the cache file.)code", 1)
+  .AddOptionalArg("check_integrity", R"code(If set to True, the checksums of the samples are
+verified when they are read.
+
+The structure of the file is always validated when it is opened.)code", false)
+  .AddParent("LoaderBase");
+
+DALI_REGISTER_OPERATOR(experimental__readers__PersistentCache, PersistentCacheReader, CPU);
+
+}  // namespace dali
@@ -0,0 +1,151 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/persistent_cache_writer_op.h"
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "dali/core/format.h"
+#include "dali/operators/reader/loader/loader.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Checks if `path` contains a valid cache file, written with the same key
+ */
+bool IsCacheValid(const std::string &path, const std::string &key, int num_outputs) {
+  if (access(path.c_str(), R_OK) != 0)
+    return false;
+  try {
+    auto file = FileStream::Open(path, false, false);
+    auto index = detail::pcache::ReadIndex(*file, path);
+    return index.key == key && index.num_outputs == num_outputs;
+  } catch (std::exception &e) {
+    DALI_WARN(make_string("The persistent cache file \"", path, "\" will be overwritten: ",
+                          e.what()));
+    return false;
+  }
+}
+
+}  // namespace
+
+PersistentCacheWriter::PersistentCacheWriter(const OpSpec &spec)
+    : Operator<CPUBackend>(spec),
+      path_(spec.GetArgument<std::string>("path")),
+      reader_name_(spec.GetArgument<std::string>("reader_name")) {
+  DALI_ENFORCE(!path_.empty(), "``path`` cannot be empty.");
+  auto key = spec.GetArgument<std::string>("key");
+  int num_inputs = spec.NumRegularInput();
+  if (!IsCacheValid(path_, key, num_inputs))
+    writer_ = std::make_unique<detail::pcache::CacheFileWriter>(path_, key, num_inputs);
+}
+
+PersistentCacheWriter::~PersistentCacheWriter() {
+  if (!writer_)
+    return;
+  if (writer_->NumSamples() != epoch_size_) {
+    if (writer_->NumSamples() > 0)
+      DALI_WARN(make_string("The persistent cache \"", path_, "\" is not written - "
+                            "it contains only ", writer_->NumSamples(), " of ", epoch_size_,
+                            " samples of the reader \"", reader_name_, "\"."));
+    return;  // the writer removes the incomplete file
+  }
+  try {
+    writer_->Commit();
+  } catch (std::exception &e) {
+    DALI_WARN(e.what());
+  }
+}
+
+void PersistentCacheWriter::SetPipelineReaderMeta(
+    const std::map<std::string, ReaderMeta> &meta) {
+  auto it = meta.find(reader_name_);
+  DALI_ENFORCE(it != meta.end(), make_string("The reader \"", reader_name_,
+               "\" was not found in the pipeline."));
+  const auto &reader = it->second;
+  DALI_ENFORCE(reader.number_of_shards == 1 || reader.stick_to_shard, make_string(
+               "The persistent cache of a sharded reader requires ``stick_to_shard=True``, "
+               "otherwise the samples of the shard change with each epoch."));
+  // the samples of the padding are repeated, so they are not counted
+  epoch_size_ = start_index(reader.shard_id + 1, reader.number_of_shards, reader.epoch_size) -
+                start_index(reader.shard_id, reader.number_of_shards, reader.epoch_size);
+}
+
+void PersistentCacheWriter::RunImpl(Workspace &ws) {
+  int num_inputs = ws.NumInput();
+  for (int i = 0; i < num_inputs; i++)
+    ws.Output<CPUBackend>(i).ShareData(ws.Input<CPUBackend>(i));
+
+  if (!writer_)
+    return;
+
+  auto &keys = ws.Input<CPUBackend>(0);
+  int num_samples = keys.num_samples();
+  std::vector<detail::pcache::CacheFileWriter::SampleData> data(num_inputs);
+  for (int sample_idx = 0; sample_idx < num_samples; sample_idx++) {
+    const auto &source_info = keys.GetMeta(sample_idx).GetSourceInfo();
+    DALI_ENFORCE(!source_info.empty(), make_string("The sample ", sample_idx, " has no source "
+                 "info. The persistent cache can only store the samples produced by readers."));
+    if (writer_->Contains(source_info))
+      continue;
+    for (int i = 0; i < num_inputs; i++) {
+      auto &input = ws.Input<CPUBackend>(i);
+      data[i] = { input.raw_tensor(sample_idx), input.type(), input.tensor_shape(sample_idx),
+                  input.GetLayout() };
+    }
+    writer_->Append(source_info, data);
+  }
+}
+
+DALI_SCHEMA(experimental__PersistentCacheWriter)
+  .DocStr(R"code(Passes the inputs through and stores them in a persistent cache file.
+
+The samples are identified by the source info of the first input, so the inputs must be derived
+from a reader, named with ``reader_name``. Each sample is stored once. The file is written to
+a temporary location and moved to ``path`` when the pipeline is destroyed, but only if it contains
+all the samples of the shard of the reader (as reported by its epoch size). When the reader
+shuffles the data, it may take more than one epoch until all the samples are seen.
+
+.. note::
+  The samples with the same source info (for example, a file listed twice) are stored once,
+  so the cache of such a reader is never complete and it is never written.
+
+If ``path`` already contains a cache written with the same ``key``, nothing is written.
+
+The cache can be read with :meth:`nvidia.dali.fn.experimental.readers.persistent_cache`.
+Usually, this operator is not used directly - see :meth:`nvidia.dali.experimental.persistent_cache`.
+
+.. note::
+  The cache only contains the samples that were processed by this pipeline. When the data is
+  sharded, use a separate ``path`` for each shard, together with ``stick_to_shard=True``.)code")
+  .NumInput(1, 64)
+  .OutputFn([](const OpSpec& spec) {
+    return spec.NumRegularInput();
+  })
+  .SamplewisePassThrough()
+  .AddArg("path", R"code(Path to the cache file.)code", DALI_STRING)
+  .AddArg("reader_name", R"code(Name of the reader which produces the inputs.
+
+Its epoch size decides when the cache is complete.)code", DALI_STRING)
+  .AddOptionalArg("key", R"code(The invalidation key of the cache.
+
+It should describe the processing which produced the inputs. An existing cache file written with
+a different key is overwritten.)code", std::string());
+
+DALI_REGISTER_OPERATOR(experimental__PersistentCacheWriter, PersistentCacheWriter, CPU);
+
+}  // namespace dali
@@ -0,0 +1,60 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_PERSISTENT_CACHE_WRITER_OP_H_
+#define DALI_OPERATORS_READER_PERSISTENT_CACHE_WRITER_OP_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/operators/reader/loader/persistent_cache_file.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Passes the inputs through and stores them in a persistent cache file
+ *
+ * The samples are identified by the source info of the first input. The file is committed
+ * when the operator is destroyed, provided that it contains all the samples of the shard
+ * of the reader named with the `reader_name` argument.
+ */
+class DLL_PUBLIC PersistentCacheWriter : public Operator<CPUBackend> {
+ public:
+  explicit PersistentCacheWriter(const OpSpec &spec);
+  ~PersistentCacheWriter() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(PersistentCacheWriter);
+
+  void SetPipelineReaderMeta(const std::map<std::string, ReaderMeta> &meta) override;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
+    return false;
+  }
+
+  void RunImpl(Workspace &ws) override;
+
+ private:
+  std::string path_;
+  std::string reader_name_;
+  std::unique_ptr<detail::pcache::CacheFileWriter> writer_;
+  /// The number of samples in the shard of the reader, -1 if not known yet
+  Index epoch_size_ = -1;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_PERSISTENT_CACHE_WRITER_OP_H_
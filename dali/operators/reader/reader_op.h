@@ -61,6 +61,7 @@ class DataReader : public Operator<Backend> {
         finished_(false),
         prefetch_queue_depth_(spec.GetArgument<int>("prefetch_queue_depth")),
         skip_cached_images_(spec.GetArgument<bool>("skip_cached_images")),
+        io_threads_(spec.GetArgument<int>("io_threads")),
         prefetched_batch_queue_(prefetch_queue_depth_),
         curr_batch_consumer_(0),
         curr_batch_producer_(0),
@@ -75,6 +76,8 @@ class DataReader : public Operator<Backend> {
           if (std::is_same<Backend, GPUBackend>::value) {
             device_id_ = spec.GetArgument<int>("device_id");
           }
+          DALI_ENFORCE(io_threads_ >= 0, make_string("`io_threads` must not be negative, got: ",
+                                                     io_threads_));
         }
 
   ~DataReader() noexcept override {
@@ -94,9 +97,14 @@ class DataReader : public Operator<Backend> {
     auto &curr_batch = prefetched_batch_queue_[curr_batch_producer_];
     curr_batch.clear();
     curr_batch.reserve(max_batch_size_);
+    auto *io_thread_pool = GetIOThreadPool();
+    if (io_thread_pool)
+      loader_->DeferReads();
     for (int i = 0; i < max_batch_size_; ++i) {
       curr_batch.push_back(loader_->ReadOne(i == 0, i == max_batch_size_ - 1));
     }
+    if (io_thread_pool)
+      loader_->RunDeferredReads(*io_thread_pool);
     SaveLoaderSnapshot();
   }
 
@@ -269,6 +277,24 @@ class DataReader : public Operator<Backend> {
   }
 
  protected:
+  /**
+   * @brief Returns the thread pool used to read the samples of a batch concurrently
+   *        or nullptr, if the samples should be read sequentially.
+   *
+   * The pool is created on the first use, from the prefetching thread.
+   */
+  ThreadPool *GetIOThreadPool() {
+    if (io_threads_ == 0 || !loader_->SupportsDeferredReads())
+      return nullptr;
+    if (!io_thread_pool_)
+      io_thread_pool_ = std::make_unique<ThreadPool>(io_threads_,
+                                                     device_id_ >= 0 ? device_id_
+                                                                     : CPU_ONLY_DEVICE_ID,
+                                                     false,
+                                                     make_string("IOWorker ", spec_.name()));
+    return io_thread_pool_.get();
+  }
+
   int SnapshotQueueDepth() {
     // we keep the snapshots of loader state after producing each of `prefetch_queue_depth_`
     // batches + 1 snapshot before that.
@@ -435,6 +461,9 @@ class DataReader : public Operator<Backend> {
   // prefetched batch
   int prefetch_queue_depth_;
   bool skip_cached_images_;
+  // number of threads reading the samples of a prefetched batch, 0 for sequential reads
+  int io_threads_;
+  std::unique_ptr<ThreadPool> io_thread_pool_;
   using BatchQueueElement = std::vector<LoadTargetPtr>;
   std::vector<BatchQueueElement> prefetched_batch_queue_;
   int curr_batch_consumer_;
@@ -65,6 +65,7 @@ DALI_SCHEMA(readers___TFRecord)
       DALI_TF_FEATURE_VEC)
   .AddParent("readers___TFRecordBase")
   .AddParent("LoaderBase")
+  .AddParent("GlobalShuffleLoaderBase")
   .MakeInternal();
 
 // Schema for the actual readers.tfrecord op exposed in Python.
@@ -85,7 +86,8 @@ If the named feature doesn't exists in the processed TFRecord entry an empty ten
 )code",
       DALI_TF_FEATURE_DICT)
   .AddParent("readers___TFRecordBase")
-  .AddParent("LoaderBase");
+  .AddParent("LoaderBase")
+  .AddParent("GlobalShuffleLoaderBase");
 
 
 // Deprecated alias for internal op. Necessary for deprecation warning.
@@ -119,7 +121,7 @@ void TFRecordReader::Prefetch() {
   // We actually prepare the next batch
   DomainTimeRange tr("[DALI][TFRecordReader] Prefetch #" + to_string(curr_batch_producer_),
                      DomainTimeRange::kRed);
-  DataReader<CPUBackend, Tensor<CPUBackend>>::Prefetch();
+  DataReader<CPUBackend, Tensor<CPUBackend>, Tensor<CPUBackend>, true>::Prefetch();
 
   auto idx_loader = dynamic_cast<IndexedFileLoader*>(loader_.get());
   while (idx_loader->AnyWorkLeft()) {
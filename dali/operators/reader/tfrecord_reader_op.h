@@ -23,10 +23,10 @@
 
 namespace dali {
 
-class TFRecordReader : public DataReader<CPUBackend, Tensor<CPUBackend>> {
+class TFRecordReader : public DataReader<CPUBackend, Tensor<CPUBackend>, Tensor<CPUBackend>, true> {
  public:
   explicit TFRecordReader(const OpSpec& spec)
-  : DataReader<CPUBackend, Tensor<CPUBackend>>(spec),
+  : DataReader<CPUBackend, Tensor<CPUBackend>, Tensor<CPUBackend>, true>(spec),
     dont_use_mmap_(spec.GetArgument<bool>("dont_use_mmap")),
     use_o_direct_(spec.GetArgument<bool>("use_o_direct")),
     thread_pool_(num_threads_, spec.GetArgument<int>("device_id"), false, "TFRecordReader") {
@@ -52,7 +52,7 @@ class TFRecordReader : public DataReader<CPUBackend, Tensor<CPUBackend>> {
   void Prefetch() override;
 
  protected:
-  USE_READER_OPERATOR_MEMBERS(CPUBackend, Tensor<CPUBackend>);
+  USE_READER_OPERATOR_MEMBERS(CPUBackend, Tensor<CPUBackend>, Tensor<CPUBackend>, true);
   bool dont_use_mmap_ = false;
   bool use_o_direct_ = false;
   size_t o_direct_chunk_size_ = 0;
@@ -13,6 +13,7 @@
 // limitations under the License.
 #include "dali/operators/reader/video_reader_decoder_cpu_op.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -24,25 +25,62 @@ VideoReaderDecoderCpu::VideoReaderDecoderCpu(const OpSpec &spec)
       loader_ = InitLoader<VideoLoaderDecoderCpu>(spec);
 }
 
-void VideoReaderDecoderCpu::RunImpl(SampleWorkspace &ws) {
-  const auto &sample = GetSample(ws.data_idx());
-  auto &video_output = ws.Output<CPUBackend>(0);
+bool VideoReaderDecoderCpu::SetupImpl(
+  std::vector<OutputDesc> &output_desc, const Workspace &ws) {
+  DataReader<CPUBackend, VideoSampleCpu>::SetupImpl(output_desc, ws);
+
+  output_desc.resize(has_labels_ ? 2 : 1);
+  int batch_size = GetCurrBatchSize();
 
-  video_output.Copy(sample.data_);
-  video_output.SetSourceInfo(sample.data_.GetSourceInfo());
+  TensorListShape<4> video_shape(batch_size);
+  for (int sample_id = 0; sample_id < batch_size; ++sample_id) {
+    video_shape.set_tensor_shape(sample_id, GetSample(sample_id).Shape());
+  }
+  output_desc[0] = { video_shape, DALI_UINT8 };
 
   if (has_labels_) {
-    auto &label_output = ws.Output<CPUBackend>(1);
-    label_output.Resize({}, DALIDataType::DALI_INT32);
-    label_output.mutable_data<int>()[0] = sample.label_;
+    output_desc[1] = { TensorListShape<0>(batch_size), DALI_INT32 };
   }
+  return true;
 }
 
-namespace detail {
-inline int VideoReaderDecoderOutputFn(const OpSpec &spec) {
-  return spec.HasArgument("labels") ? 2 : 1;
+void VideoReaderDecoderCpu::RunImpl(Workspace &ws) {
+  auto &video_output = ws.Output<CPUBackend>(0);
+  auto &thread_pool = ws.GetThreadPool();
+  int batch_size = GetCurrBatchSize();
+  video_output.SetLayout("FHWC");
+
+  // The samples of the same video share its decoder, so they are decoded by the same task;
+  // the different videos are decoded concurrently
+  std::map<FramesDecoder *, std::vector<int>> samples_by_video;
+  for (int sample_id = 0; sample_id < batch_size; ++sample_id) {
+    auto &sample = GetSample(sample_id);
+    samples_by_video[sample.video_file_].push_back(sample_id);
+    video_output.SetSourceInfo(sample_id, sample.video_file_->Filename());
+  }
+  for (auto &video_samples : samples_by_video) {
+    auto &sample_ids = video_samples.second;
+    int64_t cost = 0;
+    for (int sample_id : sample_ids)
+      cost += volume(GetSample(sample_id).Shape());
+    thread_pool.AddWork([&, sample_ids](int tid) {
+      for (int sample_id : sample_ids) {
+        auto &sample = GetSample(sample_id);
+        auto shape = video_output.tensor_shape(sample_id);
+        sample.video_file_->SetOutputSize(shape[1], shape[2], SwsFlags(sample_id));
+        sample.Decode(video_output.mutable_tensor<uint8_t>(sample_id));
+      }
+    }, cost);
+  }
+  thread_pool.RunAll();
+
+  if (has_labels_) {
+    auto &label_output = ws.Output<CPUBackend>(1);
+    for (int sample_id = 0; sample_id < batch_size; ++sample_id) {
+      label_output.mutable_tensor<int>(sample_id)[0] = GetSample(sample_id).label_;
+    }
+  }
 }
-}  // namespace detail
 
 DALI_REGISTER_OPERATOR(experimental__readers__Video, VideoReaderDecoderCpu, CPU);
 
@@ -74,6 +112,23 @@ When the value is less than 0, ``step`` is set to ``sequence_length``.)code",
       -1)
   .AddOptionalArg("stride",
       R"code(Distance between consecutive frames in the sequence.)code", 1u, false)
+  .AddOptionalArg("codec_threads",
+      R"code(Applies only to the CPU backend type.
+
+Number of threads used by each FFmpeg decoder, in addition to decoding the sequences of different
+videos concurrently on the pipeline's thread pool.
+
+If set to 0, the pipeline's threads are split between the two levels automatically: the decoders
+get more threads when there are fewer videos than the pipeline's threads.)code", 0)
+  .AddOptionalArg("index_cache_path",
+      R"code(Path of a file caching the frame indices of the videos between the runs.
+
+Before the first batch, each video is demuxed to find its frames and keyframes, which takes long
+for big datasets. If the file exists, the indices of the videos whose size and modification time
+didn't change are loaded from it. The indices of the other videos are built, using ``num_threads``
+threads, and the file is updated.
+
+If empty, the indices are not cached.)code", "")
   .AddParent("LoaderBase");
 
 }  // namespace dali
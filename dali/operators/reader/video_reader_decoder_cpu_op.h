@@ -15,16 +15,37 @@
 #ifndef DALI_OPERATORS_READER_VIDEO_READER_DECODER_CPU_OP_H_
 #define DALI_OPERATORS_READER_VIDEO_READER_DECODER_CPU_OP_H_
 
+#include <vector>
+
 #include "dali/operators/reader/reader_op.h"
 #include "dali/operators/reader/loader/video/video_loader_decoder_cpu.h"
 
 namespace dali {
-class VideoReaderDecoderCpu : public DataReader<CPUBackend, VideoSample<CPUBackend>> {
+namespace detail {
+inline int VideoReaderDecoderOutputFn(const OpSpec &spec) {
+  return spec.HasArgument("labels") ? 2 : 1;
+}
+}  // namespace detail
+
+class VideoReaderDecoderCpu : public DataReader<CPUBackend, VideoSampleCpu> {
  public:
   explicit VideoReaderDecoderCpu(const OpSpec &spec);
 
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
  protected:
-  void RunImpl(SampleWorkspace &ws) override;
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override;
+
+  void RunImpl(Workspace &ws) override;
+
+  /**
+   * @brief Interpolation used to scale the frames of the sample to the output shape
+   */
+  virtual int SwsFlags(int sample_id) const {
+    return SWS_BILINEAR;
+  }
 
  private:
   bool has_labels_ = false;
@@ -0,0 +1,102 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/video_reader_decoder_resize_cpu_op.h"
+
+#include <vector>
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Translates the resampling filter to the closest swscale interpolation
+ *
+ * The swscale filters are widened when downscaling, so the antialiased linear filter (Triangular)
+ * is the regular bilinear interpolation, while the plain Linear filter is the fast one.
+ */
+int ToSwsFlags(kernels::ResamplingFilterType filter, bool downscaling) {
+  using kernels::ResamplingFilterType;
+  switch (filter) {
+    case ResamplingFilterType::Nearest:
+      return SWS_POINT;
+    case ResamplingFilterType::Linear:
+      return downscaling ? SWS_FAST_BILINEAR : SWS_BILINEAR;
+    case ResamplingFilterType::Triangular:
+      return SWS_BILINEAR;
+    case ResamplingFilterType::Gaussian:
+      return SWS_GAUSS;
+    case ResamplingFilterType::Cubic:
+      return SWS_BICUBIC;
+    case ResamplingFilterType::Lanczos3:
+      return SWS_LANCZOS;
+    default:
+      DALI_FAIL(make_string("Unsupported resampling filter: ", kernels::FilterName(filter)));
+  }
+}
+
+}  // namespace
+
+VideoReaderDecoderResizeCpu::VideoReaderDecoderResizeCpu(const OpSpec &spec)
+    : VideoReaderDecoderCpu(spec) {
+  DALI_ENFORCE(!spec.ArgumentDefined("roi_start") && !spec.ArgumentDefined("roi_end"),
+               "The region of interest is not supported when reading videos.");
+  DALIDataType dtype = DALI_UINT8;
+  spec.TryGetArgument(dtype, "dtype");
+  DALI_ENFORCE(dtype == DALI_UINT8, "Only the uint8 output is supported when reading videos.");
+}
+
+bool VideoReaderDecoderResizeCpu::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                            const Workspace &ws) {
+  VideoReaderDecoderCpu::SetupImpl(output_desc, ws);
+  int batch_size = GetCurrBatchSize();
+
+  TensorListShape<> input_shape = output_desc[0].shape;
+  resize_attr_.PrepareResizeParams(spec_, ws, input_shape, "FHWC");
+  resampling_attr_.PrepareFilterParams(spec_, ws, batch_size);
+  resize_attr_.GetResizedShape(output_desc[0].shape, input_shape);
+
+  sws_flags_.resize(batch_size);
+  for (int sample_id = 0; sample_id < batch_size; ++sample_id) {
+    auto in_shape = input_shape.tensor_shape_span(sample_id);
+    auto out_shape = output_desc[0].shape.tensor_shape_span(sample_id);
+    DALI_ENFORCE(out_shape[1] > 0 && out_shape[2] > 0,
+                 make_string("The frames can't be resized to an empty shape, got ",
+                             out_shape[1], "x", out_shape[2], "."));
+    bool downscaling = out_shape[1] * out_shape[2] < in_shape[1] * in_shape[2];
+    auto filter = downscaling ? resampling_attr_.min_filter_[sample_id]
+                              : resampling_attr_.mag_filter_[sample_id];
+    sws_flags_[sample_id] = ToSwsFlags(filter, downscaling);
+  }
+  return true;
+}
+
+DALI_REGISTER_OPERATOR(experimental__readers__VideoResize, VideoReaderDecoderResizeCpu, CPU);
+
+DALI_SCHEMA(experimental__readers__VideoResize)
+  .DocStr(R"code(Loads, decodes and resizes video files using FFmpeg.
+
+This operator combines the features of :meth:`nvidia.dali.fn.experimental.readers.video` and
+:meth:`nvidia.dali.fn.resize`. The frames are scaled while being converted to RGB, in a single
+pass, so no full resolution RGB frames are produced.
+
+The resampling filters are mapped to the closest ones available in FFmpeg, so the result can differ
+slightly from :meth:`nvidia.dali.fn.resize`. The region of interest is not supported.)code")
+  .NumInput(0)
+  .OutputFn(detail::VideoReaderDecoderOutputFn)
+  .AddParent("experimental__readers__Video")
+  .AddParent("ResizeAttr")
+  .AddParent("ResamplingFilterAttr");
+
+}  // namespace dali
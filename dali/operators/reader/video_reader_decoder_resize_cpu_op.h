@@ -0,0 +1,51 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_VIDEO_READER_DECODER_RESIZE_CPU_OP_H_
+#define DALI_OPERATORS_READER_VIDEO_READER_DECODER_RESIZE_CPU_OP_H_
+
+#include <vector>
+
+#include "dali/operators/image/resize/resampling_attr.h"
+#include "dali/operators/image/resize/resize_attr.h"
+#include "dali/operators/reader/video_reader_decoder_cpu_op.h"
+
+namespace dali {
+
+/**
+ * @brief Reads and resizes video sequences on the CPU.
+ *
+ * The frames are scaled by FFmpeg while being converted from YUV to RGB, so no full resolution
+ * RGB frame is produced.
+ */
+class VideoReaderDecoderResizeCpu : public VideoReaderDecoderCpu {
+ public:
+  explicit VideoReaderDecoderResizeCpu(const OpSpec &spec);
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override;
+
+  int SwsFlags(int sample_id) const override {
+    return sws_flags_[sample_id];
+  }
+
+ private:
+  ResizeAttr resize_attr_;
+  ResamplingFilterAttr resampling_attr_;
+  std::vector<int> sws_flags_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_VIDEO_READER_DECODER_RESIZE_CPU_OP_H_
@@ -21,7 +21,7 @@
 namespace dali {
 
 bool WebdatasetReader::SetupImpl(std::vector<OutputDesc>& output_desc, const Workspace &ws) {
-  DataReader<CPUBackend, std::vector<Tensor<CPUBackend>>>::SetupImpl(output_desc, ws);
+  Base::SetupImpl(output_desc, ws);
   int num_outputs = ws.NumOutput();
   int num_samples = GetCurrBatchSize();
 
@@ -95,7 +95,9 @@ The index file can be generated using a dedicated script::
     <path_to_dali>/tools/wds2idx.py <path_to_archive> <path_to_index_file>
 
 If the index file is not provided, it will be automatically inferred from the tar file.
-Keep in mind though that it will add considerable startup time for big datasets.
+Keep in mind though that it will add considerable startup time for big datasets. The archives are
+scanned in parallel, using ``num_threads`` threads. With ``save_generated_index``, the inferred
+index files are saved next to the archives and reused by the subsequent runs.
 
 The format of the index file is::
 
@@ -138,6 +140,15 @@ is undefined.
 Has to be the same length as the ``paths`` argument. In case it is not provided,
 it will be inferred automatically from the webdataset archive.)code",
             std::vector<std::string>())
+    .AddOptionalArg("save_generated_index",
+            R"code(If set to True and ``index_paths`` are not provided, the index files inferred
+from the archives are saved next to them and reused in the subsequent runs.
+
+The index of the archive ``<name>`` is saved as ``<name>.idx`` (e.g. ``shard.tar.idx``), in the
+format generated by ``wds2idx.py``. A saved index is used only if it was modified after
+the archive. If the index can't be saved (e.g. the directory is read-only), a warning is issued
+and the reading continues.)code",
+            false)
     .AddOptionalArg(
         "missing_component_behavior",
         R"code(Specifies what to do in case there is not any file in a sample corresponding to a certain output.
@@ -154,7 +165,8 @@ Moreover, the tar file should be constructed so that it will only output a sampl
 divisible by the size of the data type.)code",
                     DALI_DATA_TYPE_VEC,
                     nullptr)  // default is a vector of uint8
-    .AddParent("LoaderBase");
+    .AddParent("LoaderBase")
+    .AddParent("GlobalShuffleLoaderBase");
 
 DALI_REGISTER_OPERATOR(readers__Webdataset, WebdatasetReader, CPU);
 
@@ -22,10 +22,12 @@
 
 namespace dali {
 
-class DLL_PUBLIC WebdatasetReader : public DataReader<CPUBackend, vector<Tensor<CPUBackend>>> {
+class DLL_PUBLIC WebdatasetReader
+    : public DataReader<CPUBackend, vector<Tensor<CPUBackend>>, vector<Tensor<CPUBackend>>, true> {
  public:
-  explicit WebdatasetReader(const OpSpec& spec)
-      : DataReader<CPUBackend, vector<Tensor<CPUBackend>>>(spec) {
+  using Base = DataReader<CPUBackend, vector<Tensor<CPUBackend>>, vector<Tensor<CPUBackend>>, true>;
+
+  explicit WebdatasetReader(const OpSpec& spec) : Base(spec) {
     loader_ = InitLoader<WebdatasetLoader>(spec);
   }
 
@@ -36,7 +38,8 @@ class DLL_PUBLIC WebdatasetReader : public DataReader<CPUBackend, vector<Tensor<
   }
 
  protected:
-  USE_READER_OPERATOR_MEMBERS(CPUBackend, vector<Tensor<CPUBackend>>);
+  USE_READER_OPERATOR_MEMBERS(CPUBackend, vector<Tensor<CPUBackend>>, vector<Tensor<CPUBackend>>,
+                              true);
 };
 
 }  // namespace dali
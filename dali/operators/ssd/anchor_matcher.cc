@@ -0,0 +1,200 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/ssd/anchor_matcher.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "dali/core/math_util.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Width class of an anchor; the anchors of similar width are grouped together
+ */
+int WidthClass(const Box<2, float> &anchor) {
+  float w = anchor.hi.x - anchor.lo.x;
+  if (!(w > 0))
+    return -100;
+  return clamp(std::ilogb(w), -64, 64);
+}
+
+/**
+ * @brief Computes IoU with the same operations as `intersection_over_union(box, anchor)`
+ */
+inline float IoU(float blx, float bly, float bhx, float bhy, float box_area,
+                 float alx, float aly, float ahx, float ahy, float anchor_area) {
+  float ilx = std::max(blx, alx), ily = std::max(bly, aly);
+  float ihx = std::min(bhx, ahx), ihy = std::min(bhy, ahy);
+  if (!(ihx > ilx && ihy > ily))
+    return 0.0f;
+  float intersection = (ihx - ilx) * (ihy - ily);
+  if (intersection == 0)
+    return 0.0f;
+  return intersection / (box_area + anchor_area - intersection);
+}
+
+}  // namespace
+
+AnchorMatcher::AnchorMatcher(span<const BoundingBox> anchors) {
+  int n = anchors.size();
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::vector<int> width_class(n);
+  for (int i = 0; i < n; i++)
+    width_class[i] = WidthClass(anchors[i]);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    if (width_class[a] != width_class[b])
+      return width_class[a] < width_class[b];
+    return anchors[a].lo.x < anchors[b].lo.x;
+  });
+
+  lo_x_.resize(n);
+  lo_y_.resize(n);
+  hi_x_.resize(n);
+  hi_y_.resize(n);
+  area_.resize(n);
+  max_hi_x_.resize(n);
+  index_ = order;
+  for (int i = 0; i < n; i++) {
+    const auto &anchor = anchors[order[i]];
+    lo_x_[i] = anchor.lo.x;
+    lo_y_[i] = anchor.lo.y;
+    hi_x_[i] = anchor.hi.x;
+    hi_y_[i] = anchor.hi.y;
+    area_[i] = volume(anchor);
+    bool group_start = i == 0 || width_class[order[i]] != width_class[order[i - 1]];
+    if (group_start)
+      groups_.push_back({i, i});
+    max_hi_x_[i] = group_start ? hi_x_[i] : std::max(max_hi_x_[i - 1], hi_x_[i]);
+    groups_.back().end = i + 1;
+  }
+}
+
+void AnchorMatcher::FindCandidates(std::vector<std::pair<int, float>> &candidates,
+                                   const BoundingBox &box, float box_area,
+                                   int begin, int end) const {
+  int i = begin;
+#ifdef __SSE2__
+  const __m128 blx = _mm_set1_ps(box.lo.x), bly = _mm_set1_ps(box.lo.y);
+  const __m128 bhx = _mm_set1_ps(box.hi.x), bhy = _mm_set1_ps(box.hi.y);
+  const __m128 barea = _mm_set1_ps(box_area);
+  const __m128 zero = _mm_setzero_ps();
+  for (; i + 4 <= end; i += 4) {
+    // _mm_max_ps(a, b) and _mm_min_ps(a, b) return b for equal values, like std::max(b, a)
+    // and std::min(b, a)
+    __m128 ilx = _mm_max_ps(_mm_loadu_ps(&lo_x_[i]), blx);
+    __m128 ily = _mm_max_ps(_mm_loadu_ps(&lo_y_[i]), bly);
+    __m128 ihx = _mm_min_ps(_mm_loadu_ps(&hi_x_[i]), bhx);
+    __m128 ihy = _mm_min_ps(_mm_loadu_ps(&hi_y_[i]), bhy);
+    __m128 valid = _mm_and_ps(_mm_cmpgt_ps(ihx, ilx), _mm_cmpgt_ps(ihy, ily));
+    if (!_mm_movemask_ps(valid))
+      continue;
+    __m128 intersection = _mm_mul_ps(_mm_sub_ps(ihx, ilx), _mm_sub_ps(ihy, ily));
+    __m128 sum = _mm_add_ps(barea, _mm_loadu_ps(&area_[i]));
+    __m128 iou = _mm_and_ps(_mm_div_ps(intersection, _mm_sub_ps(sum, intersection)), valid);
+    int mask = _mm_movemask_ps(_mm_cmpgt_ps(iou, zero));
+    if (!mask)
+      continue;
+    float ious[4];
+    _mm_storeu_ps(ious, iou);
+    for (int k = 0; k < 4; k++) {
+      if (mask & (1 << k))
+        candidates.emplace_back(index_[i + k], ious[k]);
+    }
+  }
+#endif
+  for (; i < end; i++) {
+    float iou = IoU(box.lo.x, box.lo.y, box.hi.x, box.hi.y, box_area,
+                    lo_x_[i], lo_y_[i], hi_x_[i], hi_y_[i], area_[i]);
+    if (iou > 0)
+      candidates.emplace_back(index_[i], iou);
+  }
+}
+
+void AnchorMatcher::MatchBoxes(PartialMatch &match, span<const BoundingBox> boxes,
+                               int first_box_idx) const {
+  int n = num_anchors();
+  match.best_iou.assign(n, 0.0f);
+  match.best_box.assign(n, -1);
+  if (n == 0)
+    return;
+
+  auto update = [&](int anchor_idx, float iou, int box_idx) {
+    if (iou >= match.best_iou[anchor_idx]) {
+      match.best_iou[anchor_idx] = iou;
+      match.best_box[anchor_idx] = box_idx;
+    }
+  };
+
+  auto &candidates = match.candidates;
+  for (int b = 0; b < boxes.size(); b++) {
+    const auto &box = boxes[b];
+    float box_area = volume(box);
+    candidates.clear();
+    for (auto &group : groups_) {
+      // Only the anchors with lo.x < box.hi.x and hi.x > box.lo.x can overlap the box
+      const float *max_hi_x = max_hi_x_.data(), *lo_x = lo_x_.data();
+      int begin = std::upper_bound(max_hi_x + group.begin, max_hi_x + group.end, box.lo.x) -
+                  max_hi_x;
+      int end = std::lower_bound(lo_x + begin, lo_x + group.end, box.hi.x) - lo_x;
+      FindCandidates(candidates, box, box_area, begin, end);
+    }
+
+    // The box is forcibly matched with its best anchor; if it doesn't overlap any,
+    // all IoUs are 0 and the last anchor is the best one
+    int best_anchor = n - 1;
+    float best_iou = 0;
+    for (auto &c : candidates) {
+      if (c.second > best_iou || (c.second == best_iou && c.first > best_anchor)) {
+        best_iou = c.second;
+        best_anchor = c.first;
+      }
+    }
+    for (auto &c : candidates) {
+      if (c.first != best_anchor)
+        update(c.first, c.second, first_box_idx + b);
+    }
+    update(best_anchor, 2.0f, first_box_idx + b);
+  }
+}
+
+void AnchorMatcher::Merge(PartialMatch &acc, const PartialMatch &next) {
+  assert(acc.best_iou.size() == next.best_iou.size());
+  for (size_t a = 0; a < acc.best_iou.size(); a++) {
+    if (next.best_box[a] >= 0 && next.best_iou[a] >= acc.best_iou[a]) {
+      acc.best_iou[a] = next.best_iou[a];
+      acc.best_box[a] = next.best_box[a];
+    }
+  }
+}
+
+std::vector<std::pair<unsigned, unsigned>> AnchorMatcher::GetMatches(const PartialMatch &match,
+                                                                     float criteria) const {
+  std::vector<std::pair<unsigned, unsigned>> matches;
+  for (int a = 0; a < num_anchors(); a++) {
+    // criteria is not negative, so the anchors which don't overlap any box are never matched
+    if (match.best_box[a] >= 0 && match.best_iou[a] > criteria)
+      matches.push_back({match.best_box[a], a});
+  }
+  return matches;
+}
+
+}  // namespace dali
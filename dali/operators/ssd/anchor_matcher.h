@@ -0,0 +1,103 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_SSD_ANCHOR_MATCHER_H_
+#define DALI_OPERATORS_SSD_ANCHOR_MATCHER_H_
+
+#include <utility>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/geom/box.h"
+#include "dali/core/span.h"
+
+namespace dali {
+
+/**
+ * @brief Matches bounding boxes with a fixed set of anchors, as in SSD
+ *
+ * Each anchor is matched with the box with which it has the highest IoU, as long as the IoU
+ * exceeds the criteria. Additionally, each box is forcibly matched with the anchor with which it
+ * has the highest IoU. The ties are resolved in favor of the boxes and anchors with higher indices.
+ *
+ * The result is identical to computing the dense boxes x anchors IoU matrix, but only the pairs
+ * that can overlap are visited: the anchors are grouped by width and sorted by the left
+ * coordinate, so the candidates for each box form a contiguous range in each group, found with
+ * binary search. The IoUs in the range are computed with SIMD.
+ *
+ * The boxes can be matched in parts (e.g. in parallel) and the partial results merged.
+ */
+class DLL_PUBLIC AnchorMatcher {
+ public:
+  using BoundingBox = Box<2, float>;
+
+  /**
+   * @brief The best match for each anchor among a range of boxes
+   */
+  struct PartialMatch {
+    /// IoU with the best box, or 2 if the anchor was forcibly matched
+    std::vector<float> best_iou;
+    /// Index of the best box; -1 if the anchor doesn't overlap any box
+    std::vector<int> best_box;
+    /// Scratch buffer with the (anchor, IoU) pairs of the current box
+    std::vector<std::pair<int, float>> candidates;
+  };
+
+  AnchorMatcher() = default;
+
+  explicit AnchorMatcher(span<const BoundingBox> anchors);
+
+  int num_anchors() const {
+    return index_.size();
+  }
+
+  /**
+   * @brief Matches the anchors with the boxes with indices
+   *        [first_box_idx, first_box_idx + boxes.size())
+   */
+  void MatchBoxes(PartialMatch &match, span<const BoundingBox> boxes, int first_box_idx) const;
+
+  /**
+   * @brief Merges the match of the boxes following the ones matched in `acc` into `acc`
+   */
+  static void Merge(PartialMatch &acc, const PartialMatch &next);
+
+  /**
+   * @brief Returns the (box, anchor) pairs of the anchors matched with IoU above `criteria`
+   */
+  std::vector<std::pair<unsigned, unsigned>> GetMatches(const PartialMatch &match,
+                                                        float criteria) const;
+
+ private:
+  struct AnchorGroup {
+    int begin, end;
+  };
+
+  /**
+   * @brief Appends the anchors from the range [begin, end) which overlap the box
+   */
+  void FindCandidates(std::vector<std::pair<int, float>> &candidates, const BoundingBox &box,
+                      float box_area, int begin, int end) const;
+
+  // The anchors, grouped and sorted, as a structure of arrays
+  std::vector<float> lo_x_, lo_y_, hi_x_, hi_y_, area_;
+  // The maximum of hi_x_ from the beginning of the group
+  std::vector<float> max_hi_x_;
+  // Original index of the anchor
+  std::vector<int> index_;
+  std::vector<AnchorGroup> groups_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_SSD_ANCHOR_MATCHER_H_
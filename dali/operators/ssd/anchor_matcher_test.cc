@@ -0,0 +1,149 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/ssd/anchor_matcher.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <utility>
+#include <vector>
+#include "dali/pipeline/util/bounding_box_utils.h"
+
+namespace dali {
+namespace test {
+
+namespace {
+
+using BoundingBox = AnchorMatcher::BoundingBox;
+using Matches = std::vector<std::pair<unsigned, unsigned>>;
+
+/**
+ * @brief Reference matching, with the dense boxes x anchors IoU matrix
+ */
+Matches DenseMatch(const std::vector<BoundingBox> &boxes,
+                   const std::vector<BoundingBox> &anchors, float criteria) {
+  int nboxes = boxes.size(), nanchors = anchors.size();
+  std::vector<float> ious(nboxes * nanchors);
+  for (int b = 0; b < nboxes; b++) {
+    float *row = &ious[b * nanchors];
+    int best_idx = 0;
+    for (int a = 0; a < nanchors; a++) {
+      row[a] = intersection_over_union(boxes[b], anchors[a]);
+      if (row[a] >= row[best_idx])
+        best_idx = a;
+    }
+    row[best_idx] = 2;
+  }
+  Matches matches;
+  for (int a = 0; a < nanchors; a++) {
+    int best_idx = 0;
+    for (int b = 1; b < nboxes; b++) {
+      if (ious[b * nanchors + a] >= ious[best_idx * nanchors + a])
+        best_idx = b;
+    }
+    if (ious[best_idx * nanchors + a] > criteria)
+      matches.push_back({best_idx, a});
+  }
+  return matches;
+}
+
+/**
+ * @brief Anchors similar to the ones used by SSD300, with some duplicates
+ */
+std::vector<BoundingBox> SsdLikeAnchors() {
+  std::vector<BoundingBox> anchors;
+  for (int fsize : { 38, 19, 10, 5, 3, 1 }) {
+    float scale = 1.5f / fsize;
+    for (int y = 0; y < fsize; y++) {
+      for (int x = 0; x < fsize; x++) {
+        float cx = (x + 0.5f) / fsize, cy = (y + 0.5f) / fsize;
+        for (float aspect : { 1.0f, 1.0f, 2.0f, 0.5f }) {
+          float w = scale * std::sqrt(aspect), h = scale / std::sqrt(aspect);
+          BoundingBox anchor;
+          anchor.lo = { std::max(cx - w / 2, 0.0f), std::max(cy - h / 2, 0.0f) };
+          anchor.hi = { std::min(cx + w / 2, 1.0f), std::min(cy + h / 2, 1.0f) };
+          anchors.push_back(anchor);
+        }
+      }
+    }
+  }
+  return anchors;
+}
+
+std::vector<BoundingBox> RandomBoxes(std::mt19937 &rng, int n) {
+  std::uniform_real_distribution<float> pos(0, 1), size(0, 0.3f);
+  // quantized coordinates produce IoU ties and boxes sharing edges with the anchors
+  std::uniform_int_distribution<int> quantized(0, 19);
+  std::bernoulli_distribution quantize(0.3);
+  std::vector<BoundingBox> boxes(n);
+  for (auto &box : boxes) {
+    if (quantize(rng)) {
+      box.lo = { quantized(rng) / 20.0f, quantized(rng) / 20.0f };
+      box.hi = box.lo + vec2(0.05f * (1 + quantized(rng) % 4), 0.05f * (1 + quantized(rng) % 4));
+    } else {
+      box.lo = { pos(rng), pos(rng) };
+      box.hi = box.lo + vec2(size(rng), size(rng));
+    }
+    box.hi = min(box.hi, vec2(1.0f, 1.0f));
+  }
+  return boxes;
+}
+
+Matches SparseMatch(const AnchorMatcher &matcher, const std::vector<BoundingBox> &boxes,
+                    int nchunks, float criteria) {
+  std::vector<AnchorMatcher::PartialMatch> chunks(nchunks);
+  int nboxes = boxes.size();
+  for (int c = 0; c < nchunks; c++) {
+    int begin = nboxes * c / nchunks, end = nboxes * (c + 1) / nchunks;
+    matcher.MatchBoxes(chunks[c], make_cspan(boxes.data() + begin, end - begin), begin);
+  }
+  for (int c = 1; c < nchunks; c++)
+    AnchorMatcher::Merge(chunks[0], chunks[c]);
+  return matcher.GetMatches(chunks[0], criteria);
+}
+
+}  // namespace
+
+TEST(AnchorMatcherTest, MatchesDense) {
+  std::mt19937 rng(1234);
+  auto anchors = SsdLikeAnchors();
+  AnchorMatcher matcher(make_cspan(anchors));
+  ASSERT_EQ(matcher.num_anchors(), static_cast<int>(anchors.size()));
+  for (int nboxes : { 1, 2, 7, 50, 200 }) {
+    auto boxes = RandomBoxes(rng, nboxes);
+    for (float criteria : { 0.0f, 0.5f }) {
+      auto ref = DenseMatch(boxes, anchors, criteria);
+      for (int nchunks : { 1, 3 }) {
+        if (nchunks > nboxes)
+          continue;
+        EXPECT_EQ(SparseMatch(matcher, boxes, nchunks, criteria), ref)
+            << nboxes << " boxes, criteria " << criteria << ", " << nchunks << " chunks";
+      }
+    }
+  }
+}
+
+TEST(AnchorMatcherTest, NoOverlap) {
+  // The box doesn't overlap any anchor, so it's matched with the last one
+  std::vector<BoundingBox> anchors = {
+    {{0.0f, 0.0f}, {0.1f, 0.1f}}, {{0.2f, 0.2f}, {0.3f, 0.3f}}, {{0.0f, 0.2f}, {0.1f, 0.3f}}
+  };
+  std::vector<BoundingBox> boxes = { {{0.5f, 0.5f}, {0.9f, 0.9f}} };
+  AnchorMatcher matcher(make_cspan(anchors));
+  Matches expected = { {0, 2} };
+  EXPECT_EQ(SparseMatch(matcher, boxes, 1, 0.5f), expected);
+  EXPECT_EQ(DenseMatch(boxes, anchors, 0.5f), expected);
+}
+
+}  // namespace test
+}  // namespace dali
@@ -21,68 +21,6 @@ namespace dali {
 
 using BoundingBox = BoxEncoder<CPUBackend>::BoundingBox;
 
-void BoxEncoder<CPUBackend>::CalculateIousForBox(float *ious, const BoundingBox &box) const {
-  ious[0] = intersection_over_union(box, anchors_[0]);
-  unsigned best_idx = 0;
-  float best_iou = ious[0];
-
-  for (unsigned anchor_idx = 1; anchor_idx < anchors_.size(); ++anchor_idx) {
-    ious[anchor_idx] = intersection_over_union(box, anchors_[anchor_idx]);
-
-    if (ious[anchor_idx] >= best_iou) {
-      best_iou = ious[anchor_idx];
-      best_idx = anchor_idx;
-    }
-  }
-
-  // For best default box matched with current object let iou = 2, to make sure there is a match,
-  // as this object will be the best (highest IoU), for this default box
-  ious[best_idx] = 2.;
-}
-
-vector<float> BoxEncoder<CPUBackend>::CalculateIous(const vector<BoundingBox> &boxes) const {
-  vector<float> ious(boxes.size() * anchors_.size());
-
-  for (unsigned bbox_idx = 0; bbox_idx < boxes.size(); ++bbox_idx) {
-    auto ious_row = ious.data() + bbox_idx * anchors_.size();
-    CalculateIousForBox(ious_row, boxes[bbox_idx]);
-  }
-
-  return ious;
-}
-
-unsigned BoxEncoder<CPUBackend>::FindBestBoxForAnchor(
-  unsigned anchor_idx, const vector<float> &ious, unsigned num_boxes) const {
-  unsigned best_idx = 0;
-  float best_iou = ious[anchor_idx];
-
-  for (unsigned bbox_idx = 1; bbox_idx < num_boxes; ++bbox_idx) {
-    if (ious[bbox_idx * anchors_.size() + anchor_idx] >= best_iou) {
-      best_iou = ious[bbox_idx * anchors_.size() + anchor_idx];
-      best_idx = bbox_idx;
-    }
-  }
-
-  return best_idx;
-}
-
-vector<std::pair<unsigned, unsigned>> BoxEncoder<CPUBackend>::MatchBoxesWithAnchors(
-  const vector<BoundingBox> &boxes) const {
-  const auto ious = CalculateIous(boxes);
-  vector<std::pair<unsigned, unsigned>> matches;
-
-  for (unsigned anchor_idx = 0; anchor_idx < anchors_.size(); ++anchor_idx) {
-    const auto best_idx = FindBestBoxForAnchor(anchor_idx, ious, boxes.size());
-
-    // Filter matches by criteria
-    if (ious[best_idx * anchors_.size() + anchor_idx] > criteria_) {
-      matches.push_back({best_idx, anchor_idx});
-    }
-  }
-
-  return matches;
-}
-
 template <int ndim>
 void WriteBoxToOutput(float *out_box_data, const vec<ndim, float> &center,
                       const vec<ndim, float> &extent) {
@@ -157,31 +95,54 @@ void BoxEncoder<CPUBackend>::WriteMatchesToOutput(
   }
 }
 
-void BoxEncoder<CPUBackend>::RunImpl(SampleWorkspace &ws) {
+void BoxEncoder<CPUBackend>::RunImpl(Workspace &ws) {
   const auto &bboxes_input = ws.Input<CPUBackend>(kBoxesInId);
   const auto &labels_input = ws.Input<CPUBackend>(kLabelsInId);
-  const auto num_boxes = bboxes_input.dim(0);
-  const auto labels = labels_input.data<int>();
-
-  vector<BoundingBox> boxes;
-  boxes.resize(num_boxes);
-  ReadBoxes(make_span(boxes), make_cspan(bboxes_input.data<float>(), bboxes_input.size()), {}, {});
-
-  // Create output
   auto &bboxes_output = ws.Output<CPUBackend>(kBoxesOutId);
-  bboxes_output.Resize({static_cast<int>(anchors_.size()), BoundingBox::size}, bboxes_input.type());
-  auto out_boxes = bboxes_output.mutable_data<float>();
-
   auto &labels_output = ws.Output<CPUBackend>(kLabelsOutId);
-  labels_output.Resize({static_cast<int>(anchors_.size())}, labels_input.type());
-  auto out_labels = labels_output.mutable_data<int>();
-
-  WriteAnchorsToOutput(out_boxes, out_labels);
-  if (num_boxes == 0)
-    return;
-
-  const auto matches = MatchBoxesWithAnchors(boxes);
-  WriteMatchesToOutput(matches, boxes, labels, out_boxes, out_labels);
+  auto &tp = ws.GetThreadPool();
+  int nsamples = bboxes_input.num_samples();
+  samples_.resize(nsamples);
+
+  // The boxes of large samples are matched in chunks, in parallel
+  for (int sample_idx = 0; sample_idx < nsamples; sample_idx++) {
+    auto &sample = samples_[sample_idx];
+    const auto num_boxes = bboxes_input.tensor_shape_span(sample_idx)[0];
+    sample.boxes.resize(num_boxes);
+    ReadBoxes(make_span(sample.boxes),
+              make_cspan(bboxes_input.tensor<float>(sample_idx), num_boxes * BoundingBox::size),
+              {}, {});
+
+    int nchunks = std::min<int>(div_ceil(num_boxes, kMinBoxesPerChunk), tp.NumThreads());
+    sample.chunks.resize(nchunks);
+    for (int chunk_idx = 0; chunk_idx < nchunks; chunk_idx++) {
+      int begin = num_boxes * chunk_idx / nchunks;
+      int end = num_boxes * (chunk_idx + 1) / nchunks;
+      tp.AddWork([this, &sample, chunk_idx, begin, end](int thread_id) {
+        matcher_.MatchBoxes(sample.chunks[chunk_idx],
+                            make_cspan(sample.boxes.data() + begin, end - begin), begin);
+      }, static_cast<int64_t>(end - begin) * anchors_.size());
+    }
+  }
+  tp.RunAll();
+
+  for (int sample_idx = 0; sample_idx < nsamples; sample_idx++) {
+    tp.AddWork([&, sample_idx](int thread_id) {
+      auto &sample = samples_[sample_idx];
+      auto out_boxes = bboxes_output.mutable_tensor<float>(sample_idx);
+      auto out_labels = labels_output.mutable_tensor<int>(sample_idx);
+      WriteAnchorsToOutput(out_boxes, out_labels);
+      if (sample.chunks.empty())
+        return;
+
+      for (size_t chunk_idx = 1; chunk_idx < sample.chunks.size(); chunk_idx++)
+        AnchorMatcher::Merge(sample.chunks[0], sample.chunks[chunk_idx]);
+      const auto matches = matcher_.GetMatches(sample.chunks[0], criteria_);
+      WriteMatchesToOutput(matches, sample.boxes, labels_input.tensor<int>(sample_idx),
+                           out_boxes, out_labels);
+    }, anchors_.size());
+  }
+  tp.RunAll();
 }
 
 DALI_REGISTER_OPERATOR(BoxEncoder, BoxEncoder<CPUBackend>, CPU);
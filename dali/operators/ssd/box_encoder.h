@@ -21,6 +21,7 @@
 #include <utility>
 #include "dali/core/cuda_error.h"
 #include "dali/core/tensor_shape.h"
+#include "dali/operators/ssd/anchor_matcher.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/util/bounding_box_utils.h"
 
@@ -53,6 +54,7 @@ class BoxEncoder<CPUBackend>: public Operator<CPUBackend> {
 
     anchors_.resize(nanchors);
     ReadBoxes(make_span(anchors_), make_cspan(anchors), {}, {});
+    matcher_ = AnchorMatcher(make_cspan(anchors_));
 
     means_ = spec.GetArgument<vector<float>>("means");
     DALI_ENFORCE(means_.size() == 4,
@@ -70,38 +72,54 @@ class BoxEncoder<CPUBackend>: public Operator<CPUBackend> {
   DISABLE_COPY_MOVE_ASSIGN(BoxEncoder);
 
  protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
   bool SetupImpl(std::vector<OutputDesc> &output_desc, const Workspace &ws) override {
-    return false;
+    const auto &bboxes_input = ws.Input<CPUBackend>(kBoxesInId);
+    const auto &labels_input = ws.Input<CPUBackend>(kLabelsInId);
+    int nsamples = bboxes_input.num_samples();
+    int nanchors = anchors_.size();
+    output_desc.resize(2);
+    output_desc[kBoxesOutId].shape =
+        uniform_list_shape(nsamples, TensorShape<2>{nanchors, BoundingBox::size});
+    output_desc[kBoxesOutId].type = bboxes_input.type();
+    output_desc[kLabelsOutId].shape = uniform_list_shape(nsamples, TensorShape<1>{nanchors});
+    output_desc[kLabelsOutId].type = labels_input.type();
+    return true;
   }
 
-  void RunImpl(SampleWorkspace &ws) override;
-  using Operator<CPUBackend>::RunImpl;
+  void RunImpl(Workspace &ws) override;
 
  private:
+  /**
+   * @brief The boxes of a sample and the partial matches of its chunks
+   */
+  struct SampleMatch {
+    vector<BoundingBox> boxes;
+    vector<AnchorMatcher::PartialMatch> chunks;
+  };
+
+  // Minimum number of boxes per chunk, when the boxes of a sample are matched in parallel
+  static constexpr int kMinBoxesPerChunk = 32;
+
   const float criteria_;
   vector<BoundingBox> anchors_;
+  AnchorMatcher matcher_;
+  vector<SampleMatch> samples_;
 
   bool offset_;
   vector<float> means_;
   vector<float> stds_;
   float scale_;
 
-  vector<float> CalculateIous(const vector<BoundingBox> &boxes) const;
-
-  void CalculateIousForBox(float *ious, const BoundingBox &box) const;
-
   void WriteAnchorsToOutput(float *out_boxes, int *out_labels) const;
 
   void WriteMatchesToOutput(const vector<std::pair<unsigned, unsigned>> &matches,
                             const vector<BoundingBox> &boxes, const int *labels,
                             float *out_boxes, int *out_labels) const;
 
-  vector<std::pair<unsigned, unsigned>> MatchBoxesWithAnchors(
-    const vector<BoundingBox> &boxes) const;
-
-  unsigned FindBestBoxForAnchor(
-    unsigned anchor_idx, const vector<float> &ious, unsigned num_boxes) const;
-
   static const int kBoxesInId = 0;
   static const int kLabelsInId = 1;
   static const int kBoxesOutId = 0;
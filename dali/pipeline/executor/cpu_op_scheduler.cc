@@ -0,0 +1,105 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/executor/cpu_op_scheduler.h"
+
+#include <algorithm>
+
+#include "dali/core/small_vector.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+
+CPUOpScheduler::CPUOpScheduler(const OpGraph &graph, int num_threads, int device_id)
+    : runner_(std::max<int>(1, std::min<int>(num_threads, graph.NumOp(OpType::CPU))), device_id,
+              false, "CPU ops") {
+  int num_ops = graph.NumOp(OpType::CPU);
+  num_parents_.resize(num_ops, 0);
+  children_.resize(num_ops);
+  pending_parents_ = std::make_unique<std::atomic<int>[]>(num_ops);
+  for (int i = 0; i < num_ops; i++) {
+    const OpNode &node = graph.Node(OpType::CPU, i);
+    for (OpNodeId child_id : node.children) {
+      const OpNode &child = graph.Node(child_id);
+      if (child.op_type != OpType::CPU)
+        continue;
+      children_[i].push_back(child.partition_index);
+      num_parents_[child.partition_index]++;
+    }
+  }
+
+  int num_tensors = graph.NumTensor();
+  shared_.resize(num_tensors, false);
+  needs_lock_.resize(num_tensors, false);
+  tensor_mutexes_ = std::make_unique<std::mutex[]>(num_tensors);
+  for (int t = 0; t < num_tensors; t++) {
+    const TensorNode &tensor = graph.Tensor(t);
+    int cpu_consumers = 0;
+    for (auto &consumer : tensor.consumers) {
+      if (graph.Node(consumer.node).op_type == OpType::CPU)
+        cpu_consumers++;
+    }
+    shared_[t] = cpu_consumers > 1;
+  }
+}
+
+void CPUOpScheduler::Run(const std::function<void(int cpu_op_id)> &run_op) {
+  int num_ops = num_parents_.size();
+  for (int i = 0; i < num_ops; i++)
+    pending_parents_[i] = num_parents_[i];
+  std::fill(needs_lock_.begin(), needs_lock_.end(), false);
+
+  std::function<void(int)> run = [&](int op_id) {
+    run_op(op_id);
+    for (int child : children_[op_id]) {
+      // The operators which come first in the topological order are preferred
+      if (--pending_parents_[child] == 0) {
+        runner_.AddWork([&run, child](int) { run(child); }, -child, true);
+      }
+    }
+  };
+  for (int i = 0; i < num_ops; i++) {
+    if (num_parents_[i] == 0) {
+      runner_.AddWork([&run, i](int) { run(i); }, -i);
+    }
+  }
+  runner_.RunAll();
+}
+
+CPUOpScheduler::InputLocks CPUOpScheduler::LockInputs(const OpNode &node) {
+  SmallVector<TensorNodeId, 8> tensors;
+  for (TensorNodeId t : node.parent_tensors) {
+    if (needs_lock_[t])
+      tensors.push_back(t);
+  }
+  // A consistent order prevents deadlocks; the same tensor can be used as more than one input
+  std::sort(tensors.begin(), tensors.end());
+  tensors.erase(std::unique(tensors.begin(), tensors.end()), tensors.end());
+  InputLocks locks;
+  for (TensorNodeId t : tensors)
+    locks.emplace_back(tensor_mutexes_[t]);
+  return locks;
+}
+
+void CPUOpScheduler::MarkOutputs(const OpNode &node, const Workspace &ws) {
+  for (size_t i = 0; i < node.children_tensors.size(); i++) {
+    TensorNodeId t = node.children_tensors[i];
+    if (!shared_[t] || !ws.OutputIsType<CPUBackend>(i))
+      continue;
+    // The consumers are not running yet - reading the layout is safe
+    needs_lock_[t] = ws.Output<CPUBackend>(i).GetLayout().empty();
+  }
+}
+
+}  // namespace dali
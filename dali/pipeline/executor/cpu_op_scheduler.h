@@ -0,0 +1,94 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_CPU_OP_SCHEDULER_H_
+#define DALI_PIPELINE_EXECUTOR_CPU_OP_SCHEDULER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/pipeline/graph/op_graph.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+
+class Workspace;
+
+/**
+ * @brief Runs the operators of the CPU stage as soon as their inputs are ready, so that
+ *        independent branches of the graph are executed concurrently.
+ *
+ * The operators are called from a small pool of runner threads. The operators still schedule
+ * their work in the executor's thread pool - the caller is expected to run each operator
+ * in a ThreadPool::ScopedJob, so that the operators share the pool, but wait only for their
+ * own work.
+ *
+ * The consumers of a tensor may temporarily set its layout (when the operator's schema
+ * defines the default one). A tensor which has no layout and more than one consumer
+ * is therefore used by its consumers one at a time, @see LockInputs, @see MarkOutputs.
+ */
+class DLL_PUBLIC CPUOpScheduler {
+ public:
+  /**
+   * @param graph       the graph to execute; must not change while the scheduler is used
+   * @param num_threads maximum number of operators run concurrently
+   * @param device_id   the device set in the runner threads
+   */
+  CPUOpScheduler(const OpGraph &graph, int num_threads, int device_id);
+
+  /**
+   * @brief Calls `run_op` with the partition index of each CPU operator, after all
+   *        the producers of its inputs have finished, and waits for all of them.
+   *
+   * `run_op` must not throw.
+   */
+  void Run(const std::function<void(int cpu_op_id)> &run_op);
+
+  using InputLocks = std::vector<std::unique_lock<std::mutex>>;
+
+  /**
+   * @brief Locks the inputs of the operator which other operators could modify concurrently.
+   *
+   * Must be called (and the locks kept) while the operator is run by `run_op`.
+   */
+  InputLocks LockInputs(const OpNode &node);
+
+  /**
+   * @brief Checks which outputs of the operator need to be locked by their consumers.
+   *
+   * Must be called by `run_op` after the operator has run.
+   */
+  void MarkOutputs(const OpNode &node, const Workspace &ws);
+
+ private:
+  /// The number of CPU operators producing the inputs of each CPU operator
+  std::vector<int> num_parents_;
+  std::vector<std::vector<int>> children_;
+  std::unique_ptr<std::atomic<int>[]> pending_parents_;
+  /// Tensors consumed by more than one CPU operator
+  std::vector<uint8_t> shared_;
+  /// Shared tensors without a layout in the current iteration - not std::vector<bool>,
+  /// as the elements are written concurrently
+  std::vector<uint8_t> needs_lock_;
+  std::unique_ptr<std::mutex[]> tensor_mutexes_;
+  ThreadPool runner_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_CPU_OP_SCHEDULER_H_
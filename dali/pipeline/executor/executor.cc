@@ -14,11 +14,15 @@
 
 #include <algorithm>
 #include <condition_variable>
+#include <functional>
 #include <iterator>
 #include <mutex>
 #include <set>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/executor/executor.h"
@@ -173,19 +177,24 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunCPUImpl(size_t iteration_id) {
 
   DeviceGuard g(device_id_);
 
+  bool profiling = enable_profiling_;
+  auto wait_start = std::chrono::steady_clock::time_point();
+  if (profiling)
+    wait_start = std::chrono::steady_clock::now();
   auto cpu_idxs = QueuePolicy::AcquireIdxs(OpType::CPU);
+  int64_t queue_wait_time = profiling ? ElapsedNs(wait_start) : 0;
   if (exec_error_ || QueuePolicy::IsStopSignaled() ||
       !QueuePolicy::template AreValid<OpType::CPU>(cpu_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::CPU, cpu_idxs);
     return;
   }
+  if (profiling)
+    FillStageProfile(OpType::CPU, "CPU", queue_wait_time);
 
   int stage_batch_size = batch_sizes_cpu_.front();
   batch_sizes_cpu_.pop();
 
-  // Run the cpu-ops in the thread
-  // Process each CPU Op in batch
-  for (int cpu_op_id = 0; cpu_op_id < graph_->NumOp(OpType::CPU) && !exec_error_; ++cpu_op_id) {
+  auto run_op = [&](int cpu_op_id) {
     OpNode &op_node = graph_->Node(OpType::CPU, cpu_op_id);
     decltype(auto) ws = ws_policy_.template GetWorkspace<OpType::CPU>(cpu_idxs, *graph_, cpu_op_id);
 
@@ -195,13 +204,50 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunCPUImpl(size_t iteration_id) {
     DomainTimeRange tr("[DALI][CPU op] " + op_node.instance_name, DomainTimeRange::kBlue1);
 
     try {
-      RunHelper(op_node, ws, iteration_id);
+      ExecutorOpProfile op_profile;
+      RunHelper(op_node, ws, iteration_id, profiling ? &op_profile : nullptr);
       FillStats(cpu_memory_stats_, ws, "CPU_" + op_node.instance_name, cpu_memory_stats_mutex_);
+      if (profiling)
+        FillProfile(ws, "CPU_" + op_node.instance_name, op_profile);
     } catch (std::exception &e) {
       HandleError("CPU", op_node, e.what());
     } catch (...) {
       HandleError();
     }
+  };
+
+  if (cpu_op_scheduler_) {
+    // The operators add their traces concurrently - the map itself must not be modified
+    auto &operator_traces = *GetCurrentIterationData(iteration_id).operator_traces;
+    for (int cpu_op_id = 0; cpu_op_id < graph_->NumOp(OpType::CPU); ++cpu_op_id)
+      operator_traces[graph_->Node(OpType::CPU, cpu_op_id).instance_name];
+
+    cpu_op_scheduler_->Run([&](int cpu_op_id) {
+      if (exec_error_)
+        return;
+      OpNode &op_node = graph_->Node(OpType::CPU, cpu_op_id);
+      {
+        auto locks = cpu_op_scheduler_->LockInputs(op_node);
+        // Each operator waits only for its own work in the shared thread pool
+        ThreadPool::ScopedJob job(thread_pool_);
+        run_op(cpu_op_id);
+      }
+      decltype(auto) ws =
+          ws_policy_.template GetWorkspace<OpType::CPU>(cpu_idxs, *graph_, cpu_op_id);
+      cpu_op_scheduler_->MarkOutputs(op_node, ws);
+    });
+  } else {
+    // Run the cpu-ops in the thread
+    // Process each CPU Op in batch
+    for (int cpu_op_id = 0; cpu_op_id < graph_->NumOp(OpType::CPU) && !exec_error_; ++cpu_op_id) {
+      int chain_length = sample_streaming_ ? SampleChainLength(cpu_idxs, cpu_op_id) : 1;
+      if (chain_length > 1 && RunSampleChain(cpu_idxs, cpu_op_id, chain_length, stage_batch_size,
+                                             iteration_id, profiling)) {
+        cpu_op_id += chain_length - 1;
+        continue;
+      }
+      run_op(cpu_op_id);
+    }
   }
 
   // Pass the work to the mixed stage
@@ -209,17 +255,189 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunCPUImpl(size_t iteration_id) {
 }
 
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::CanStreamSamples(QueueIdxs idxs,
+                                                              const OpNode &producer,
+                                                              const OpNode &consumer) {
+  auto *producer_op = dynamic_cast<const Operator<CPUBackend> *>(producer.op.get());
+  auto *consumer_op = dynamic_cast<const Operator<CPUBackend> *>(consumer.op.get());
+  if (!producer_op || !consumer_op ||
+      !producer_op->SupportsSampleStreaming() || !consumer_op->SupportsSampleStreaming() ||
+      !producer_op->RunsSampleWise() || !consumer_op->RunsSampleWise())
+    return false;
+  // The consumer is set up before the producer has processed any sample, so it can infer
+  // the shapes of its outputs only from the shapes inferred by the producer
+  if (consumer_op->CanInferOutputs() && !producer_op->CanInferOutputs())
+    return false;
+  if (producer.children_tensors.empty())
+    return false;
+  for (auto tensor_id : producer.children_tensors) {
+    const auto &tensor = graph_->Tensor(tensor_id);
+    if (tensor.consumers.empty())
+      return false;
+    for (auto &consumer_edge : tensor.consumers) {
+      // The argument inputs are accessed as whole batches
+      if (consumer_edge.node != consumer.id ||
+          consumer_edge.index >= consumer.spec.NumRegularInput())
+        return false;
+    }
+  }
+  // Without a layout, the consumer would set the default one on the whole batch before
+  // the samples are produced - it's checked with the layout from the previous iteration
+  decltype(auto) ws =
+      ws_policy_.template GetWorkspace<OpType::CPU>(idxs, *graph_, producer.partition_index);
+  for (int i = 0; i < ws.NumOutput(); i++) {
+    if (ws.template Output<CPUBackend>(i).GetLayout().empty())
+      return false;
+  }
+  return true;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+int Executor<WorkspacePolicy, QueuePolicy>::SampleChainLength(QueueIdxs idxs, int first_op) {
+  // The operators in conditional scopes can receive partial batches
+  if (HasConditionals())
+    return 1;
+  int num_ops = graph_->NumOp(OpType::CPU);
+  int length = 1;
+  while (first_op + length < num_ops &&
+         CanStreamSamples(idxs, graph_->Node(OpType::CPU, first_op + length - 1),
+                          graph_->Node(OpType::CPU, first_op + length)))
+    length++;
+  return length;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::RunSampleChain(QueueIdxs idxs, int first_op,
+                                                            int num_ops, int stage_batch_size,
+                                                            size_t iteration_id, bool profiling) {
+  using WsRef = decltype(ws_policy_.template GetWorkspace<OpType::CPU>(idxs, *graph_, first_op));
+  // The JIT policy creates the workspaces on the fly - they're kept for the whole chain
+  using WsHolder = std::conditional_t<std::is_lvalue_reference_v<WsRef>,
+                                      std::reference_wrapper<Workspace>, Workspace>;
+  SmallVector<WsHolder, 8> wss;
+  SmallVector<OpNode *, 8> nodes;
+  SmallVector<Operator<CPUBackend> *, 8> ops;
+  for (int k = 0; k < num_ops; k++) {
+    nodes.push_back(&graph_->Node(OpType::CPU, first_op + k));
+    ops.push_back(dynamic_cast<Operator<CPUBackend> *>(nodes[k]->op.get()));
+    wss.push_back(ws_policy_.template GetWorkspace<OpType::CPU>(idxs, *graph_, first_op + k));
+  }
+  auto ws = [&](int k) -> Workspace & { return wss[k]; };
+
+  int batch_size = InferBatchSizeFromInput(ws(0), stage_batch_size);
+  if (batch_size == 0)
+    return false;
+
+  DomainTimeRange tr("[DALI][Executor] Sample-wise chain of " + nodes[0]->instance_name,
+                     DomainTimeRange::kBlue1);
+  std::vector<ExecutorOpProfile> op_profiles(num_ops);
+  std::vector<SmallVector<int, 16>> empty_layout_in_idxs(num_ops);
+  for (int k = 0; k < num_ops; k++) {
+    try {
+      ws(k).SetBatchSizes(InferBatchSizeFromInput(ws(k), stage_batch_size));
+      bool ready = SetupHelper(*nodes[k], ws(k), iteration_id, empty_layout_in_idxs[k],
+                               profiling ? &op_profiles[k] : nullptr);
+      DALI_ENFORCE(ready, "Unexpected empty input in a sample-wise chain of operators.");
+      // Sets the size of the outputs - the batch size of the next operator
+      ops[k]->BeginSampleWiseRun(ws(k));
+    } catch (std::exception &e) {
+      HandleError("CPU", *nodes[k], e.what());
+      return true;
+    } catch (...) {
+      HandleError();
+      return true;
+    }
+  }
+
+  // The first error of each operator
+  std::vector<std::string> errors(num_ops);
+  std::mutex errors_mutex;
+  std::vector<std::atomic<int64_t>> busy_time(num_ops);
+  auto run_start = std::chrono::steady_clock::time_point();
+  if (profiling)
+    run_start = std::chrono::steady_clock::now();
+  for (int data_idx = 0; data_idx < batch_size; data_idx++) {
+    thread_pool_.AddWork([&, data_idx](int thread_idx) {
+      for (int k = 0; k < num_ops; k++) {
+        try {
+          auto start = std::chrono::steady_clock::time_point();
+          if (profiling)
+            start = std::chrono::steady_clock::now();
+          ops[k]->RunSingleSample(ws(k), data_idx, thread_idx);
+          if (profiling)
+            busy_time[k] += ElapsedNs(start);
+        } catch (std::exception &e) {
+          std::lock_guard<std::mutex> guard(errors_mutex);
+          if (errors[k].empty())
+            errors[k] = make_string("Error in thread ", thread_idx, ": ", e.what());
+          return;
+        } catch (...) {
+          std::lock_guard<std::mutex> guard(errors_mutex);
+          if (errors[k].empty())
+            errors[k] = make_string("Error in thread ", thread_idx, ": Unknown exception");
+          return;
+        }
+      }
+    }, -data_idx);  // -data_idx for FIFO order
+  }
+  thread_pool_.RunAll();
+  int64_t run_time = profiling ? ElapsedNs(run_start) : 0;
+  for (int k = 0; k < num_ops; k++) {
+    if (!errors[k].empty()) {
+      HandleError("CPU", *nodes[k], errors[k]);
+      return true;
+    }
+  }
+
+  int64_t total_busy_time = 0;
+  for (auto &t : busy_time)
+    total_busy_time += t;
+  for (int k = 0; k < num_ops; k++) {
+    try {
+      ops[k]->EndSampleWiseRun(ws(k));
+      FinishHelper(*nodes[k], ws(k), iteration_id, empty_layout_in_idxs[k]);
+      FillStats(cpu_memory_stats_, ws(k), "CPU_" + nodes[k]->instance_name,
+                cpu_memory_stats_mutex_);
+      if (profiling) {
+        auto &op_profile = op_profiles[k];
+        op_profile.thread_pool_busy_time = busy_time[k];
+        op_profile.streamed_iterations = 1;
+        // The operators run interleaved - the wall time is split according to their busy time
+        if (total_busy_time > 0)
+          op_profile.run_time = static_cast<int64_t>(
+              run_time * (static_cast<double>(busy_time[k]) / total_busy_time));
+        FillProfile(ws(k), "CPU_" + nodes[k]->instance_name, op_profile);
+      }
+    } catch (std::exception &e) {
+      HandleError("CPU", *nodes[k], e.what());
+      return true;
+    } catch (...) {
+      HandleError();
+      return true;
+    }
+  }
+  return true;
+}
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::RunMixedImpl(size_t iteration_id) {
   DomainTimeRange tr("[DALI][Executor] RunMixed");
   DeviceGuard g(device_id_);
 
+  bool profiling = enable_profiling_;
+  auto wait_start = std::chrono::steady_clock::time_point();
+  if (profiling)
+    wait_start = std::chrono::steady_clock::now();
   auto mixed_idxs = QueuePolicy::AcquireIdxs(OpType::MIXED);
+  int64_t queue_wait_time = profiling ? ElapsedNs(wait_start) : 0;
   if (exec_error_ || QueuePolicy::IsStopSignaled() ||
      !QueuePolicy::template AreValid<OpType::MIXED>(mixed_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::MIXED, mixed_idxs);
     return;
   }
+  if (profiling)
+    FillStageProfile(OpType::MIXED, "MIXED", queue_wait_time);
 
   // Enforce our assumed dependency between consecutive
   // iterations of a stage of the pipeline.
@@ -239,9 +457,12 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunMixedImpl(size_t iteration_id) {
       ws.SetBatchSizes(batch_size);
 
       DomainTimeRange tr("[DALI][Mixed op] " + op_node.instance_name, DomainTimeRange::kOrange);
-      RunHelper(op_node, ws, iteration_id);
+      ExecutorOpProfile op_profile;
+      RunHelper(op_node, ws, iteration_id, profiling ? &op_profile : nullptr);
       FillStats(mixed_memory_stats_, ws, "MIXED_" + op_node.instance_name,
                 mixed_memory_stats_mutex_);
+      if (profiling)
+        FillProfile(ws, "MIXED_" + op_node.instance_name, op_profile);
       if (device_id_ != CPU_ONLY_DEVICE_ID) {
         if (ws.has_stream() && ws.has_event()) {
             CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
@@ -274,7 +495,12 @@ template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl(size_t iteration_id) {
   DomainTimeRange tr("[DALI][Executor] RunGPU");
 
+  bool profiling = enable_profiling_;
+  auto wait_start = std::chrono::steady_clock::time_point();
+  if (profiling)
+    wait_start = std::chrono::steady_clock::now();
   auto gpu_idxs = QueuePolicy::AcquireIdxs(OpType::GPU);
+  int64_t queue_wait_time = profiling ? ElapsedNs(wait_start) : 0;
   if (exec_error_ || QueuePolicy::IsStopSignaled() ||
       !QueuePolicy::template AreValid<OpType::GPU>(gpu_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::GPU, gpu_idxs);
@@ -287,6 +513,8 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl(size_t iteration_id) {
     QueuePolicy::QueueOutputIdxs(gpu_idxs, gpu_op_stream_);
     return;
   }
+  if (profiling)
+    FillStageProfile(OpType::GPU, "GPU", queue_wait_time);
   DeviceGuard g(device_id_);
 
   // Enforce our assumed dependency between consecutive
@@ -311,8 +539,11 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl(size_t iteration_id) {
       }
 
       DomainTimeRange tr("[DALI][GPU op] " + op_node.instance_name, DomainTimeRange::knvGreen);
-      RunHelper(op_node, ws, iteration_id);
+      ExecutorOpProfile op_profile;
+      RunHelper(op_node, ws, iteration_id, profiling ? &op_profile : nullptr);
       FillStats(gpu_memory_stats_, ws, "GPU_" + op_node.instance_name, gpu_memory_stats_mutex_);
+      if (profiling)
+        FillProfile(ws, "GPU_" + op_node.instance_name, op_profile);
       if (ws.has_event()) {
         CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
       }
@@ -376,14 +607,14 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPU() {
 
 
 template<typename WorkspacePolicy, typename QueuePolicy>
-void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspace &ws,
-                                                       size_t iteration_id) {
+bool Executor<WorkspacePolicy, QueuePolicy>::SetupHelper(
+    OpNode &op_node, Workspace &ws, size_t iteration_id,
+    SmallVector<int, 16> &empty_layout_in_idxs, ExecutorOpProfile *profile) {
   auto &output_desc = op_node.output_desc;
   auto &op = *op_node.op;
   output_desc.clear();
   const auto &spec = op.GetSpec();
   const auto &schema = spec.GetSchema();
-  SmallVector<int, 16> empty_layout_in_idxs;
 
   ws.InjectOperatorTraces(GetCurrentIterationData(iteration_id).operator_traces);
   ws.ClearOperatorTraces();
@@ -425,7 +656,7 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
       ClearOutputs(ws, spec);
       // TODO(klecki): Instead of skipping the execution, rework all DALI operators to correctly
       // propagate the dim, type and do validation (arguments, types, etc) with empty input batches.
-      return;
+      return false;
     }
   }
 
@@ -464,10 +695,15 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
     if (had_empty_layout) empty_layout_in_idxs.push_back(i);
   }
 
+  auto start = std::chrono::steady_clock::time_point();
   bool should_allocate = false;
   {
     DomainTimeRange tr("[DALI][Executor] Setup");
+    if (profile)
+      start = std::chrono::steady_clock::now();
     should_allocate = op.Setup(output_desc, ws);
+    if (profile)
+      profile->setup_time += ElapsedNs(start);
   }
   {
     DomainTimeRange tr("[DALI][Executor] Allocate outputs");
@@ -496,12 +732,40 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
   }
 
   ClearOutputSourceInfo(ws);
+  return true;
+}
+
+template<typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspace &ws,
+                                                       size_t iteration_id,
+                                                       ExecutorOpProfile *profile) {
+  auto &op = *op_node.op;
+  SmallVector<int, 16> empty_layout_in_idxs;
+  if (!SetupHelper(op_node, ws, iteration_id, empty_layout_in_idxs, profile))
+    return;
 
   {
     DomainTimeRange tr("[DALI][Executor] Run");
+    // Only the CPU stage runs its operators' work in the executor's thread pool
+    bool count_busy_time = profile && op_node.op_type == OpType::CPU;
+    int64_t busy_start = count_busy_time ? thread_pool_.BusyTime() : 0;
+    auto start = std::chrono::steady_clock::time_point();
+    if (profile)
+      start = std::chrono::steady_clock::now();
     op.Run(ws);
+    if (profile)
+      profile->run_time += ElapsedNs(start);
+    if (count_busy_time)
+      profile->thread_pool_busy_time += thread_pool_.BusyTime() - busy_start;
   }
 
+  FinishHelper(op_node, ws, iteration_id, empty_layout_in_idxs);
+}
+
+template<typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::FinishHelper(
+    OpNode &op_node, Workspace &ws, size_t iteration_id,
+    const SmallVector<int, 16> &empty_layout_in_idxs) {
   PropagateSourceInfo(ws);
 
   /* TODO(michalz): Find a way to make this valid in presence of passthrough between stages
@@ -692,6 +956,18 @@ void Executor<WorkspacePolicy, QueuePolicy>::InitCheckpointing() {
   CreateInitialCheckpoints();
 }
 
+template<typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::PropagateReaderMeta() {
+  std::map<std::string, ReaderMeta> reader_meta;
+  for (const auto &node : graph_->GetOpNodes()) {
+    auto meta = node.op->GetReaderMeta();
+    if (meta)
+      reader_meta.emplace(node.instance_name, meta);
+  }
+  for (auto &node : graph_->GetOpNodes())
+    node.op->SetPipelineReaderMeta(reader_meta);
+}
+
 template<typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::CreateCheckpoint(const OpNode &op_node,
                                                               int iteration_id,
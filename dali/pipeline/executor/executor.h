@@ -16,6 +16,7 @@
 #define DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <queue>
@@ -30,6 +31,7 @@
 #include "dali/core/error_handling.h"
 #include "dali/core/nvtx.h"
 #include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/executor/cpu_op_scheduler.h"
 #include "dali/pipeline/executor/queue_metadata.h"
 #include "dali/pipeline/executor/queue_policy.h"
 #include "dali/pipeline/executor/workspace_policy.h"
@@ -56,6 +58,28 @@ struct DLL_PUBLIC ExecutorMeta {
 };
 using ExecutorMetaMap = std::unordered_map<std::string, std::vector<ExecutorMeta>>;
 
+/**
+ * @brief Execution profile of an operator, accumulated over the iterations run with
+ *        the profiling enabled. The times are in nanoseconds.
+ *
+ * The times are measured on the host - for the GPU operators, they cover issuing the work,
+ * not its execution on the device.
+ */
+struct DLL_PUBLIC ExecutorOpProfile {
+  size_t iterations = 0;
+  int64_t setup_time = 0;             ///< wall time of Operator::Setup
+  int64_t run_time = 0;               ///< wall time of Operator::Run
+  int64_t thread_pool_busy_time = 0;  ///< time the threads of the pool spent running the work
+                                      ///< of the operator, summed over the threads (CPU only)
+  int64_t queue_wait_time = 0;        ///< time the stage waited for the queues before starting
+                                      ///< the iterations (only in the entries of the stages)
+  size_t streamed_iterations = 0;     ///< number of the iterations in which the operator ran
+                                      ///< in a chain of streamed operators (CPU only)
+  size_t samples = 0;                 ///< number of samples produced
+  size_t bytes = 0;                   ///< size of the outputs produced, in bytes
+};
+using ExecutorProfileMap = std::unordered_map<std::string, ExecutorOpProfile>;
+
 namespace detail {
 // This is stream callback used on GPU stream to indicate that GPU work for this
 // pipeline run is finished
@@ -79,7 +103,12 @@ class DLL_PUBLIC ExecutorBase {
   DLL_PUBLIC virtual void ReleaseOutputs() = 0;
   DLL_PUBLIC virtual void EnableMemoryStats(bool enable_memory_stats = false) = 0;
   DLL_PUBLIC virtual void EnableCheckpointing(bool checkpointing = false) = 0;
+  DLL_PUBLIC virtual void EnableWorkStealing(bool work_stealing = false) = 0;
+  DLL_PUBLIC virtual void EnableParallelCPUOps(bool parallel = false) = 0;
+  DLL_PUBLIC virtual void EnableSampleStreaming(bool streaming = false) = 0;
   DLL_PUBLIC virtual ExecutorMetaMap GetExecutorMeta() = 0;
+  DLL_PUBLIC virtual void EnableProfiling(bool profiling = false) = 0;
+  DLL_PUBLIC virtual ExecutorProfileMap GetExecutorProfile() = 0;
   DLL_PUBLIC virtual void Shutdown() = 0;
   DLL_PUBLIC virtual Checkpoint& GetCurrentCheckpoint() = 0;
   DLL_PUBLIC virtual void RestoreStateFromCheckpoint(const Checkpoint &cpt) = 0;
@@ -132,6 +161,19 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
   DLL_PUBLIC void EnableCheckpointing(bool checkpointing = false) override {
     checkpointing_ = checkpointing;
   }
+  DLL_PUBLIC void EnableWorkStealing(bool work_stealing = false) override {
+    thread_pool_.SetWorkStealing(work_stealing);
+  }
+  DLL_PUBLIC void EnableParallelCPUOps(bool parallel = false) override {
+    parallel_cpu_ops_ = parallel;
+  }
+  DLL_PUBLIC void EnableSampleStreaming(bool streaming = false) override {
+    sample_streaming_ = streaming;
+  }
+  DLL_PUBLIC void EnableProfiling(bool profiling = false) override {
+    thread_pool_.SetBusyTimeTracking(profiling);
+    enable_profiling_ = profiling;
+  }
   DLL_PUBLIC void Build(OpGraph *graph, vector<string> output_names) override;
   DLL_PUBLIC void Init() override {}
   DLL_PUBLIC void RunCPU() override;
@@ -141,6 +183,7 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
   DLL_PUBLIC void ShareOutputs(Workspace *ws) override;
   DLL_PUBLIC void ReleaseOutputs() override;
   DLL_PUBLIC ExecutorMetaMap GetExecutorMeta() override;
+  DLL_PUBLIC ExecutorProfileMap GetExecutorProfile() override;
   DLL_PUBLIC void Shutdown() override;
 
   DLL_PUBLIC void ShutdownQueue() {
@@ -239,6 +282,50 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
       }
   }
 
+  /**
+   * @brief Adds the times measured in one iteration of an operator and the size of its
+   *        outputs to the operator's profile
+   */
+  inline void FillProfile(Workspace &ws, const std::string &op_name,
+                          const ExecutorOpProfile &iteration_profile) {
+    size_t bytes = 0;
+    for (int i = 0; i < ws.NumOutput(); ++i) {
+      if (ws.OutputIsType<CPUBackend>(i))
+        bytes += ws.Output<CPUBackend>(i).nbytes();
+      else
+        bytes += ws.Output<GPUBackend>(i).nbytes();
+    }
+    std::lock_guard<std::mutex> lck(profile_mutex_);
+    auto &profile = profile_[op_name];
+    profile.iterations++;
+    profile.setup_time += iteration_profile.setup_time;
+    profile.run_time += iteration_profile.run_time;
+    profile.thread_pool_busy_time += iteration_profile.thread_pool_busy_time;
+    profile.streamed_iterations += iteration_profile.streamed_iterations;
+    profile.samples += ws.NumOutput() > 0 ? ws.GetRequestedBatchSize(0) : 0;
+    profile.bytes += bytes;
+  }
+
+  /**
+   * @brief Adds the time a stage waited for the queues in one iteration to the profile of
+   *        the stage, kept under the stage name
+   *
+   * The wait is shared by all the operators of the stage, so it's reported once per stage.
+   */
+  inline void FillStageProfile(OpType stage, const char *stage_name, int64_t queue_wait_time) {
+    if (graph_->NumOp(stage) == 0)
+      return;
+    std::lock_guard<std::mutex> lck(profile_mutex_);
+    auto &profile = profile_[stage_name];
+    profile.iterations++;
+    profile.queue_wait_time += queue_wait_time;
+  }
+
+  static int64_t ElapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+  }
+
   void HandleError(const std::string &stage, const OpNode &op_node, const std::string &message) {
     // handle internal Operator names that start with underscore
     const auto &op_name =
@@ -368,6 +455,18 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
   std::atomic<bool> enable_memory_stats_;
   ExecutorMetaMap cpu_memory_stats_, mixed_memory_stats_, gpu_memory_stats_;
 
+  std::atomic<bool> enable_profiling_{false};
+  ExecutorProfileMap profile_;
+  std::mutex profile_mutex_;
+
+  /// If set, the independent CPU operators are run concurrently, @see CPUOpScheduler
+  bool parallel_cpu_ops_ = false;
+  std::unique_ptr<CPUOpScheduler> cpu_op_scheduler_;
+
+  /// If set, the chains of sample-wise CPU operators pass each sample through the whole chain
+  /// at once, @see RunSampleChain
+  bool sample_streaming_ = false;
+
 
   /// Graph nodes, which define batch size for the entire graph
   std::vector<BatchSizeProvider *> batch_size_providers_;
@@ -385,7 +484,59 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
   int checkpointing_epoch_size_ = 0;
 
  private:
-  void RunHelper(OpNode &op_node, Workspace &ws, size_t iteration_id);
+  /**
+   * @param profile if not null, receives the times measured in this iteration
+   */
+  void RunHelper(OpNode &op_node, Workspace &ws, size_t iteration_id,
+                 ExecutorOpProfile *profile = nullptr);
+
+  /**
+   * @brief Prepares the operator to run: sets the order of the outputs and the default layouts
+   *        of the inputs, runs the Setup and allocates the outputs.
+   *
+   * @param empty_layout_in_idxs receives the inputs which got a default layout;
+   *                             to be restored by FinishHelper
+   * @return false, if the operator is to be skipped, because all its inputs are empty
+   */
+  bool SetupHelper(OpNode &op_node, Workspace &ws, size_t iteration_id,
+                   SmallVector<int, 16> &empty_layout_in_idxs, ExecutorOpProfile *profile);
+
+  /**
+   * @brief Propagates the source info, restores the input layouts and creates the checkpoint,
+   *        if needed, after the operator has run.
+   */
+  void FinishHelper(OpNode &op_node, Workspace &ws, size_t iteration_id,
+                    const SmallVector<int, 16> &empty_layout_in_idxs);
+
+  /**
+   * @brief Returns true if the samples can be passed from the producer to the consumer
+   *        one by one.
+   *
+   * The consumer must immediately follow the producer in the CPU stage and be the only consumer
+   * of its outputs. Both operators must opt in, @see OperatorBase::SupportsSampleStreaming,
+   * and run sample-wise, @see Operator<CPUBackend>::RunsSampleWise. A consumer which infers
+   * the shapes of its outputs can only follow a producer which does it too.
+   */
+  bool CanStreamSamples(QueueIdxs idxs, const OpNode &producer, const OpNode &consumer);
+
+  /**
+   * @brief Returns the number of CPU operators, starting with `first_op`, which can be run
+   *        with RunSampleChain.
+   */
+  int SampleChainLength(QueueIdxs idxs, int first_op);
+
+  /**
+   * @brief Runs a chain of sample-wise CPU operators, passing each sample through the whole chain
+   *        in a single task.
+   *
+   * The operators are set up one after another (the consumer before the producer has run), then
+   * the samples are processed, then the batches are finalized, as in RunHelper. The iteration
+   * is counted in the operators' `streamed_iterations` when profiling.
+   *
+   * @return false, if the batch is empty and the operators should be run separately
+   */
+  bool RunSampleChain(QueueIdxs idxs, int first_op, int num_ops, int stage_batch_size,
+                      size_t iteration_id, bool profiling);
 
   void RethrowError() const {
     std::lock_guard<std::mutex> errors_lock(errors_mutex_);
@@ -471,6 +622,12 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
 
   void InitCheckpointing();
 
+  /**
+   * @brief Passes the metadata of the readers to all the operators,
+   *        @see OperatorBase::SetPipelineReaderMeta
+   */
+  void PropagateReaderMeta();
+
   /**
    * @brief Create a checkpoint for the OpNode in the given iteration
    *        and save it in iteration data.
@@ -497,6 +654,12 @@ ExecutorMetaMap Executor<WorkspacePolicy, QueuePolicy>::GetExecutorMeta() {
   return ret;
 }
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+ExecutorProfileMap Executor<WorkspacePolicy, QueuePolicy>::GetExecutorProfile() {
+  std::lock_guard<std::mutex> lck(profile_mutex_);
+  return profile_;
+}
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string> output_names) {
   DALI_ENFORCE(graph != nullptr, "Input graph is nullptr.");
@@ -566,6 +729,15 @@ void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string
   AssignOperatorInstanceNames<OpType::GPU>();
 
   InitCheckpointing();
+  PropagateReaderMeta();
+
+  DALI_ENFORCE(!(parallel_cpu_ops_ && sample_streaming_),
+               "The sample streaming cannot be used together with the parallel execution "
+               "of the CPU operators.");
+  if (parallel_cpu_ops_ && graph_->NumOp(OpType::CPU) > 1) {
+    cpu_op_scheduler_ =
+        std::make_unique<CPUOpScheduler>(*graph_, thread_pool_.NumThreads(), device_id_);
+  }
 }
 
 template <typename WorkspacePolicy, typename QueuePolicy>
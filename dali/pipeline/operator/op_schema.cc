@@ -63,6 +63,8 @@ OpSchema::OpSchema(const std::string &name) : name_(name) {
   AddInternalArg("inplace", "Whether Op can be run in place", false);
   AddInternalArg("default_cuda_stream_priority", "Default cuda stream priority", 0);
   AddInternalArg("checkpointing", "Setting to `true` enables checkpointing", false);
+  AddInternalArg("seed_from_pipeline",
+                 "Set to `true` if the seed was populated by the pipeline, not by the user", false);
 
   AddOptionalArg("seed", R"code(Random seed.
 
@@ -17,6 +17,7 @@
 
 #include <any>
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -92,6 +93,20 @@ class DLL_PUBLIC OperatorBase {
     return false;
   }
 
+  /**
+   * @brief If true, the executor may pass the samples through this CPU operator one by one,
+   * interleaved with its neighbours, when sample streaming is enabled.
+   *
+   * An operator opts in only if it processes the samples with `RunImpl(SampleWorkspace &)`
+   * and keeps all the batch-level work in `SetupSharedSampleParams(Workspace &)`. The operators
+   * which override Run (e.g. the readers) must not opt in. An operator which infers the shapes
+   * of its outputs is set up before its input samples are produced, so it is streamed only after
+   * an operator which infers them too.
+   */
+  DLL_PUBLIC virtual bool SupportsSampleStreaming() const {
+    return false;
+  }
+
   /**
    * @brief Executes the operator on a batch of samples.
    */
@@ -116,6 +131,14 @@ class DLL_PUBLIC OperatorBase {
     return {};
   }
 
+  /**
+   * @brief Called when the pipeline is built, with the metadata of all its readers,
+   * keyed by the instance names of the readers.
+   *
+   * For the operators which depend on the epoch of a reader.
+   */
+  DLL_PUBLIC virtual void SetPipelineReaderMeta(const std::map<std::string, ReaderMeta> &meta) {}
+
   DLL_PUBLIC const OpSpec& GetSpec() const {
     return spec_;
   }
@@ -312,19 +335,12 @@ class Operator<CPUBackend> : public OperatorBase {
   virtual void RunImpl(Workspace &ws) {
     // This is implemented, as a default, using the RunImpl that accepts SampleWorkspace,
     // allowing for fallback to old per-sample implementations.
-
-    auto curr_batch_size = ws.NumInput() > 0 ? ws.GetInputBatchSize(0) : max_batch_size_;
-    for (int i = 0; i < ws.NumOutput(); i++) {
-      auto &output = ws.Output<CPUBackend>(i);
-      output.SetSize(curr_batch_size);
-    }
+    runs_sample_wise_ = true;
+    auto curr_batch_size = ResizeSampleWiseOutputs(ws);
     auto &thread_pool = ws.GetThreadPool();
     for (int data_idx = 0; data_idx < curr_batch_size; ++data_idx) {
       thread_pool.AddWork([this, &ws, data_idx](int tid) {
-        SampleWorkspace sample;
-        MakeSampleView(sample, ws, data_idx, tid);
-        this->SetupSharedSampleParams(sample);
-        this->RunImpl(sample);
+        RunSingleSample(ws, data_idx, tid);
       }, -data_idx);  // -data_idx for FIFO order
     }
     // Run all tasks and wait for them to finish
@@ -334,6 +350,44 @@ class Operator<CPUBackend> : public OperatorBase {
     FixBatchPropertiesConsistency(ws, CanInferOutputs());
   }
 
+  /**
+   * @brief Returns true if the operator was found to run each sample separately, with
+   *        `RunImpl(SampleWorkspace &)`.
+   *
+   * It's known after the operator has run once. If the operator also opts in with
+   * SupportsSampleStreaming, the executor can run it sample by sample, with BeginSampleWiseRun,
+   * RunSingleSample and EndSampleWiseRun, which is equivalent to calling Run.
+   */
+  bool RunsSampleWise() const {
+    return runs_sample_wise_;
+  }
+
+  /**
+   * @brief Prepares the outputs for running the samples with RunSingleSample
+   */
+  void BeginSampleWiseRun(Workspace &ws) {
+    SetupSharedSampleParams(ws);
+    ResizeSampleWiseOutputs(ws);
+  }
+
+  /**
+   * @brief Processes a single sample of the batch
+   */
+  void RunSingleSample(Workspace &ws, int data_idx, int thread_idx) {
+    SampleWorkspace sample;
+    MakeSampleView(sample, ws, data_idx, thread_idx);
+    this->SetupSharedSampleParams(sample);
+    this->RunImpl(sample);
+  }
+
+  /**
+   * @brief Updates the batch properties of the outputs after all the samples were processed
+   */
+  void EndSampleWiseRun(Workspace &ws) {
+    FixBatchPropertiesConsistency(ws, CanInferOutputs());
+    EnforceUniformOutputBatchSize<CPUBackend>(ws);
+  }
+
   /**
    * @brief Shared param setup. Legacy implementation for per-sample approach
    *
@@ -349,6 +403,18 @@ class Operator<CPUBackend> : public OperatorBase {
    * should be used instead.
    */
   virtual void SetupSharedSampleParams(Workspace &ws) {}
+
+ private:
+  int ResizeSampleWiseOutputs(Workspace &ws) {
+    auto curr_batch_size = ws.NumInput() > 0 ? ws.GetInputBatchSize(0) : max_batch_size_;
+    for (int i = 0; i < ws.NumOutput(); i++) {
+      auto &output = ws.Output<CPUBackend>(i);
+      output.SetSize(curr_batch_size);
+    }
+    return curr_batch_size;
+  }
+
+  bool runs_sample_wise_ = false;
 };
 
 template <>
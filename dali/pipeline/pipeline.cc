@@ -451,6 +451,10 @@ void Pipeline::Build(std::vector<PipelineOutputDesc> output_descs) {
                   default_cuda_stream_priority_, prefetch_queue_depth_);
   executor_->EnableMemoryStats(enable_memory_stats_);
   executor_->EnableCheckpointing(checkpointing_);
+  executor_->EnableWorkStealing(work_stealing_);
+  executor_->EnableParallelCPUOps(parallel_cpu_ops_);
+  executor_->EnableSampleStreaming(sample_streaming_);
+  executor_->EnableProfiling(profiling_);
   executor_->Init();
 
   // Creating the graph
@@ -673,10 +677,12 @@ void Pipeline::PrepareOpSpec(OpSpec *spec, int logical_id) {
   if (logical_id_to_seed_.find(logical_id) == logical_id_to_seed_.end()) {
     logical_id_to_seed_[logical_id] = seed_[current_seed_];
   }
+  bool seed_from_pipeline = !spec->HasArgument("seed");
   spec->AddArg("max_batch_size", max_batch_size_)
     .AddArg("num_threads", num_threads_)
     .AddArg("device_id", device_id_)
     .AddArg("checkpointing", checkpointing_)
+    .AddArgIfNotExisting("seed_from_pipeline", seed_from_pipeline)
     .AddArgIfNotExisting("seed", logical_id_to_seed_[logical_id]);
   string dev = spec->GetArgument<string>("device");
   if (dev == "cpu" || dev == "mixed")
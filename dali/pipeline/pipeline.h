@@ -311,6 +311,67 @@ class DLL_PUBLIC Pipeline {
     }
   }
 
+  /**
+   * @brief Set if the CPU operators should run on a work stealing thread pool
+   *
+   * @param work_stealing If true, each thread of the pool gets its own work queue,
+   *                      otherwise all threads share a single queue.
+   * Reduces the contention on the thread pool when there are many threads
+   * and the operators schedule many small tasks.
+   */
+  DLL_PUBLIC void EnableWorkStealing(bool work_stealing = true) {
+    work_stealing_ = work_stealing;
+    if (executor_) {
+      executor_->EnableWorkStealing(work_stealing_);
+    }
+  }
+
+  /**
+   * @brief Set if the independent CPU operators should run concurrently
+   *
+   * @param parallel If true, a CPU operator is started as soon as the operators producing
+   *                 its inputs have finished, instead of waiting for all the preceding
+   *                 operators. The operators share the thread pool.
+   * Useful for wide graphs with many small operators.
+   */
+  DLL_PUBLIC void EnableParallelCPUOps(bool parallel = true) {
+    parallel_cpu_ops_ = parallel;
+    if (executor_) {
+      executor_->EnableParallelCPUOps(parallel_cpu_ops_);
+    }
+  }
+
+  /**
+   * @brief Set if the samples should be streamed through chains of sample-wise CPU operators
+   *
+   * @param streaming If true, when a CPU operator processing each sample separately is the only
+   *                  consumer of another such operator, and both support streaming, each sample
+   *                  is passed through both of them in one task, without waiting for the whole
+   *                  batch in between.
+   * The results are the same as without streaming.
+   */
+  DLL_PUBLIC void EnableSampleStreaming(bool streaming = true) {
+    sample_streaming_ = streaming;
+    if (executor_) {
+      executor_->EnableSampleStreaming(sample_streaming_);
+    }
+  }
+
+  /**
+   * @brief Set if the executor should measure the time spent in each operator
+   *
+   * @param profiling If true, the executor accumulates the Setup and Run times, the thread pool
+   *                  busy time, the queue wait time and the size of the outputs of each
+   *                  operator. When disabled, the overhead is a single flag check per stage.
+   * @see GetOperatorProfile
+   */
+  DLL_PUBLIC void EnableOperatorProfiling(bool profiling = true) {
+    profiling_ = profiling;
+    if (executor_) {
+      executor_->EnableProfiling(profiling_);
+    }
+  }
+
   /**
    * @brief Returns a serialized Checkpoint
    */
@@ -366,6 +427,21 @@ class DLL_PUBLIC Pipeline {
     }
   }
 
+  /**
+   * @brief Obtains the profile of the operators, accumulated over the iterations run with
+   *        the profiling enabled
+   *
+   * The keys are the operator instance names, prefixed with the stage (CPU_, MIXED_, GPU_),
+   * as in GetExecutorMeta.
+   */
+  DLL_PUBLIC ExecutorProfileMap GetOperatorProfile() {
+    if (executor_) {
+      return executor_->GetExecutorProfile();
+    } else {
+      return {};
+    }
+  }
+
   /**
    * @brief Set queue sizes for Pipeline using Separated Queues
    *
@@ -679,6 +755,10 @@ class DLL_PUBLIC Pipeline {
   QueueSizes prefetch_queue_depth_;
   bool enable_memory_stats_ = false;
   bool checkpointing_ = false;
+  bool work_stealing_ = false;
+  bool parallel_cpu_ops_ = false;
+  bool sample_streaming_ = false;
+  bool profiling_ = false;
 
   std::vector<int64_t> seed_;
   int original_seed_;
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <utility>
 #include "dali/pipeline/util/thread_pool.h"
@@ -25,9 +27,34 @@
 
 namespace dali {
 
+class ThreadPool::Job {
+ public:
+  // Guards `pending` and `started`
+  spinlock lock;
+  // The work added before the job was started
+  std::vector<PrioritizedWork> pending;
+  bool started = false;
+  // Errors of the job's work; guarded by ThreadPool::mutex_
+  std::queue<std::string> errors;
+  // Number of work items added, but not finished yet
+  std::atomic<int64_t> outstanding{0};
+  std::atomic<int64_t> busy_time{0};
+};
+
+namespace {
+
+/// The job of the calling thread, set by ThreadPool::ScopedJob
+struct ThreadJob {
+  ThreadPool *pool = nullptr;
+  ThreadPool::Job *job = nullptr;
+};
+
+thread_local ThreadJob tls_job;
+
+}  // namespace
+
 ThreadPool::ThreadPool(int num_thread, int device_id, bool set_affinity, const char* name)
-    : threads_(num_thread), running_(true), work_complete_(true), started_(false)
-    , active_threads_(0) {
+    : threads_(num_thread), running_(true), default_job_(std::make_unique<Job>()) {
   DALI_ENFORCE(num_thread > 0, "Thread pool must have non-zero size");
 #if NVML_ENABLED
   // only for the CPU pipeline
@@ -35,12 +62,12 @@ ThreadPool::ThreadPool(int num_thread, int device_id, bool set_affinity, const c
     nvml::Init();
   }
 #endif
+  worker_queues_.reset(new WorkerQueue[num_thread]);
   // Start the threads in the main loop
   for (int i = 0; i < num_thread; ++i) {
     threads_[i] = std::thread(std::bind(&ThreadPool::ThreadMain, this, i, device_id, set_affinity,
                                         make_string("[DALI][TP", i, "]", name)));
   }
-  tl_errors_.resize(num_thread);
 }
 
 ThreadPool::~ThreadPool() {
@@ -59,52 +86,192 @@ ThreadPool::~ThreadPool() {
 #endif
 }
 
+ThreadPool::ScopedJob::ScopedJob(ThreadPool &pool)
+    : pool_(pool), job_(std::make_unique<Job>()),
+      prev_pool_(tls_job.pool), prev_job_(tls_job.job) {
+  tls_job = {&pool_, job_.get()};
+}
+
+ThreadPool::ScopedJob::~ScopedJob() {
+  pool_.WaitForWork(false);
+  tls_job = {prev_pool_, prev_job_};
+}
+
+ThreadPool::Job &ThreadPool::CurrentJob() {
+  return tls_job.pool == this ? *tls_job.job : *default_job_;
+}
+
 void ThreadPool::AddWork(Work work, int64_t priority, bool start_immediately) {
-  bool started_before = false;
+  Job &job = CurrentJob();
+  bool started_before, started;
+  job.outstanding++;
+  outstanding_work_++;
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    work_queue_.push({priority, std::move(work)});
-    work_complete_ = false;
-    started_before = started_;
-    started_ |= start_immediately;
+    std::lock_guard<spinlock> lock(job.lock);
+    started_before = job.started;
+    started = job.started = started_before || start_immediately;
+    job.pending.push_back({priority, WorkItem{std::move(work), &job}});
+    // the work is already running - start the new work (along with anything added
+    // before the start) right away
+    if (started)
+      StartPendingWork(job);
+  }
+  if (started)
+    WakeWorkers(!started_before);
+}
+
+void ThreadPool::WakeWorkers(bool all) {
+  if (sleeping_ == 0)
+    return;
+  // A thread which found no work may not be blocked on the condition yet - it holds the mutex
+  // until it is, so taking the mutex here guarantees that the notification is not lost.
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  if (all)
+    condition_.notify_all();
+  else
+    condition_.notify_one();
+}
+
+void ThreadPool::StartPendingWork(Job &job) {
+  if (!work_stealing_) {
+    std::lock_guard<spinlock> g(queue_lock_);
+    queued_work_ += job.pending.size();
+    for (auto &w : job.pending)
+      work_queue_.push(std::move(w));
+    job.pending.clear();
+    return;
+  }
+  // highest priority first; the round-robin keeps each queue sorted, too
+  std::stable_sort(job.pending.begin(), job.pending.end(),
+                   [](const auto &a, const auto &b) {
+                     return a.first > b.first;
+                   });
+  int n = threads_.size();
+  // account for the work before it becomes visible to the workers
+  queued_work_ += job.pending.size();
+  for (auto &w : job.pending) {
+    auto &q = worker_queues_[next_queue_++ % n];
+    std::lock_guard<spinlock> g(q.lock);
+    q.work.push_back(std::move(w.second));
+  }
+  job.pending.clear();
+}
+
+bool ThreadPool::TryPopWork(int thread_id, WorkItem &item) {
+  if (queued_work_.load(std::memory_order_relaxed) <= 0)
+    return false;
+  if (!work_stealing_) {
+    std::lock_guard<spinlock> g(queue_lock_);
+    if (work_queue_.empty())
+      return false;
+    item = std::move(const_cast<PrioritizedWork &>(work_queue_.top()).second);
+    work_queue_.pop();
+    queued_work_--;
+    return true;
+  }
+  int n = threads_.size();
+  // start with own queue, then look for the work in the other threads' queues
+  for (int i = 0, q_idx = thread_id; i < n; i++, q_idx = q_idx + 1 == n ? 0 : q_idx + 1) {
+    auto &q = worker_queues_[q_idx];
+    std::lock_guard<spinlock> g(q.lock);
+    if (!q.work.empty()) {
+      // the queues are sorted by priority - take the most important work first
+      item = std::move(q.work.front());
+      q.work.pop_front();
+      queued_work_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::InvokeWork(int thread_id, WorkItem &item) {
+  if (!track_busy_time_.load(std::memory_order_relaxed)) {
+    item.work(thread_id);
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
+  auto add_busy_time = [&]() {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    item.job->busy_time += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  };
+  try {
+    item.work(thread_id);
+  } catch (...) {
+    add_busy_time();
+    throw;
+  }
+  add_busy_time();
+}
+
+void ThreadPool::RunWork(int thread_id, WorkItem &item) {
+  // If an error occurs, we save it in the job. When WaitForWork is called,
+  // we will check for any errors in the job and throw if one occurred.
+  try {
+    InvokeWork(thread_id, item);
+  } catch (std::exception &e) {
+    PushError(*item.job, make_string("Error in thread ", thread_id, ": ", e.what()));
+  } catch (...) {
+    PushError(*item.job, make_string("Error in thread ", thread_id,
+                                     ": Caught unknown exception"));
   }
-  if (started_) {
-    if (!started_before)
-      condition_.notify_all();
-    else
-      condition_.notify_one();
+  item.work = {};
+
+  outstanding_work_--;
+  if (item.job->outstanding.fetch_sub(1) == 1) {
+    // the waiting thread checks the counter with the mutex held - take it, so that
+    // the notification cannot be missed
+    std::lock_guard<std::mutex> lock(mutex_);
+    completed_.notify_all();
   }
 }
 
-// Blocks until all work issued to the thread pool is complete
+void ThreadPool::PushError(Job &job, std::string error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  job.errors.push(std::move(error));
+}
+
+// Blocks until all work issued to the thread pool by the calling thread's job is complete
 void ThreadPool::WaitForWork(bool checkForErrors) {
+  Job &job = CurrentJob();
   std::unique_lock<std::mutex> lock(mutex_);
-  completed_.wait(lock, [this] { return this->work_complete_; });
-  started_ = false;
-  if (checkForErrors) {
-    // Check for errors
-    for (size_t i = 0; i < threads_.size(); ++i) {
-      if (!tl_errors_[i].empty()) {
-        // Throw the first error that occurred
-        string error = make_string("Error in thread ", i, ": ", tl_errors_[i].front());
-        tl_errors_[i].pop();
-        throw std::runtime_error(error);
-      }
-    }
+  completed_.wait(lock, [&job] { return job.outstanding == 0; });
+  {
+    std::lock_guard<spinlock> job_lock(job.lock);
+    job.started = false;
+  }
+  if (checkForErrors && !job.errors.empty()) {
+    // Throw the first error that occurred
+    string error = std::move(job.errors.front());
+    job.errors.pop();
+    throw std::runtime_error(error);
   }
 }
 
 void ThreadPool::RunAll(bool wait) {
+  Job &job = CurrentJob();
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    started_ = true;
+    std::lock_guard<spinlock> lock(job.lock);
+    job.started = true;
+    StartPendingWork(job);
   }
-  condition_.notify_all();  // other threads will be waken up if needed
+  WakeWorkers(true);  // other threads will be waken up if needed
   if (wait) {
     WaitForWork();
   }
 }
 
+void ThreadPool::SetWorkStealing(bool work_stealing) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  DALI_ENFORCE(outstanding_work_ == 0,
+               "Cannot change the scheduling mode of a thread pool with pending work.");
+  work_stealing_ = work_stealing;
+}
+
+int64_t ThreadPool::BusyTime() {
+  return CurrentJob().busy_time;
+}
+
 int ThreadPool::NumThreads() const {
   return threads_.size();
 }
@@ -141,50 +308,29 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity,
     }
 #endif
   } catch (std::exception &e) {
-    tl_errors_[thread_id].push(e.what());
+    PushError(*default_job_, make_string("Error in thread ", thread_id, ": ", e.what()));
   } catch (...) {
-    tl_errors_[thread_id].push("Caught unknown exception");
+    PushError(*default_job_, make_string("Error in thread ", thread_id,
+                                         ": Caught unknown exception"));
   }
 
   while (running_) {
+    // The work is taken without locking the mutex
+    WorkItem item;
+    if (TryPopWork(thread_id, item)) {
+      RunWork(thread_id, item);
+      continue;
+    }
+
     // Block on the condition to wait for work
     std::unique_lock<std::mutex> lock(mutex_);
-    condition_.wait(lock, [this] { return !running_ || (!work_queue_.empty() && started_); });
+    sleeping_++;
+    condition_.wait(lock, [this] {
+      return !running_ || queued_work_ > 0;
+    });
+    sleeping_--;
     // If we're no longer running, exit the run loop
     if (!running_) break;
-
-    // Get work from the queue & mark
-    // this thread as active
-    Work work = std::move(work_queue_.top().second);
-    work_queue_.pop();
-    ++active_threads_;
-
-    // Unlock the lock
-    lock.unlock();
-
-    // If an error occurs, we save it in tl_errors_. When
-    // WaitForWork is called, we will check for any errors
-    // in the threads and return an error if one occured.
-    try {
-      work(thread_id);
-    } catch (std::exception &e) {
-      lock.lock();
-      tl_errors_[thread_id].push(e.what());
-      lock.unlock();
-    } catch (...) {
-      lock.lock();
-      tl_errors_[thread_id].push("Caught unknown exception");
-      lock.unlock();
-    }
-
-    // Mark this thread as idle & check for complete work
-    lock.lock();
-    --active_threads_;
-    if (work_queue_.empty() && active_threads_ == 0) {
-      work_complete_ = true;
-      lock.unlock();
-      completed_.notify_one();
-    }
   }
 }
 
@@ -15,16 +15,20 @@
 #ifndef DALI_PIPELINE_UTIL_THREAD_POOL_H_
 #define DALI_PIPELINE_UTIL_THREAD_POOL_H_
 
+#include <atomic>
 #include <cstdlib>
+#include <deque>
 #include <utility>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <vector>
 #include <string>
 #include "dali/core/common.h"
+#include "dali/core/spinlock.h"
 
 
 namespace dali {
@@ -67,32 +71,157 @@ class DLL_PUBLIC ThreadPool {
 
   DLL_PUBLIC std::vector<std::thread::id> GetThreadIds() const;
 
+  /**
+   * @brief Switches between a single shared work queue (default) and per-thread work queues
+   *        with work stealing.
+   *
+   * With work stealing, the work added before `RunAll` is sorted by priority and dealt out
+   * round-robin to per-thread queues. Each thread takes the work from its own queue and, when
+   * it runs out of work, steals from the other threads' queues. This removes the contention
+   * on the shared queue when there are many threads and the work items are cheap.
+   * The contract of `AddWork`, `RunAll` and `WaitForWork` is the same in both modes, but
+   * the priority is only honored within the work dealt to a single thread.
+   *
+   * Can be called only when there's no work pending.
+   */
+  DLL_PUBLIC void SetWorkStealing(bool work_stealing);
+
+  DLL_PUBLIC bool IsWorkStealing() const {
+    return work_stealing_;
+  }
+
+  /**
+   * @brief Enables or disables measuring the time the threads spend running work
+   *
+   * @see BusyTime
+   */
+  DLL_PUBLIC void SetBusyTimeTracking(bool enable) {
+    track_busy_time_ = enable;
+  }
+
+  /**
+   * @brief Returns the total time, in nanoseconds, that the threads spent running the work
+   *        of the calling thread's job while the tracking was enabled
+   *
+   * The time of all the threads is summed up - it can exceed the wall time.
+   *
+   * @see ScopedJob
+   */
+  DLL_PUBLIC int64_t BusyTime();
+
+  /// The state of a set of work started and waited for together, @see ScopedJob
+  class Job;
+
+  /**
+   * @brief Gives the calling thread a job of its own - the work it adds is started and waited
+   *        for independently of the work added by other threads.
+   *
+   * While the object exists, AddWork, RunAll, WaitForWork and BusyTime called from the thread
+   * which created it refer only to the work added by this thread. The jobs share the threads
+   * of the pool. The threads without a ScopedJob share a common, default job.
+   *
+   * This allows several clients (e.g. operators executed concurrently) to use one pool,
+   * each waiting only for its own work and receiving only its own errors.
+   * The destructor waits for the remaining work of the job, ignoring the errors.
+   */
+  class DLL_PUBLIC ScopedJob {
+   public:
+    explicit ScopedJob(ThreadPool &pool);
+    ~ScopedJob();
+    DISABLE_COPY_MOVE_ASSIGN(ScopedJob);
+
+   private:
+    ThreadPool &pool_;
+    std::unique_ptr<Job> job_;
+    ThreadPool *prev_pool_;
+    Job *prev_job_;
+  };
+
   DISABLE_COPY_MOVE_ASSIGN(ThreadPool);
 
  private:
+  struct WorkItem {
+    Work work;
+    Job *job = nullptr;
+  };
+  using PrioritizedWork = std::pair<int64_t, WorkItem>;
+
   DLL_PUBLIC void ThreadMain(int thread_id, int device_id, bool set_affinity,
                              const std::string &name);
 
+  /**
+   * @brief Returns the job of the calling thread - the one from its ScopedJob or the default one
+   */
+  Job &CurrentJob();
+
+  /**
+   * @brief Makes the work added to the job before it was started available to the threads
+   *
+   * In the work stealing mode, the work is sorted by priority and dealt out to the per-thread
+   * queues. Must be called with the lock of the job held.
+   */
+  void StartPendingWork(Job &job);
+
+  /**
+   * @brief Wakes up one or all the threads waiting for work, if there are any
+   */
+  void WakeWorkers(bool all);
+
+  /**
+   * @brief Takes work from the shared queue or, in the work stealing mode, from the thread's
+   *        own queue or another thread's queue
+   */
+  bool TryPopWork(int thread_id, WorkItem &item);
+
+  /**
+   * @brief Runs a piece of work, records its error (if any) and marks it as done
+   */
+  void RunWork(int thread_id, WorkItem &item);
+
+  /**
+   * @brief Runs the work, measuring its time if the busy time tracking is enabled
+   */
+  void InvokeWork(int thread_id, WorkItem &item);
+
+  void PushError(Job &job, std::string error);
+
   vector<std::thread> threads_;
 
-  using PrioritizedWork = std::pair<int64_t, Work>;
   struct SortByPriority {
     bool operator() (const PrioritizedWork &a, const PrioritizedWork &b) {
       return a.first < b.first;
     }
   };
+  // The started work of all the jobs (when not in the work stealing mode); guarded by queue_lock_
   std::priority_queue<PrioritizedWork, std::vector<PrioritizedWork>, SortByPriority> work_queue_;
+  spinlock queue_lock_;
 
-  bool running_;
-  bool work_complete_;
-  bool started_;
-  int active_threads_;
+  std::atomic<bool> running_;
+  // Used only to put the threads to sleep and wake them up, and to wait for the completion;
+  // the work is added and taken without it
   std::mutex mutex_;
   std::condition_variable condition_;
   std::condition_variable completed_;
+  // Number of threads blocked (or about to block) waiting for work
+  std::atomic<int> sleeping_{0};
 
-  //  Stored error strings for each thread
-  vector<std::queue<string>> tl_errors_;
+  std::unique_ptr<Job> default_job_;
+
+  // Work stealing mode
+  struct alignas(64) WorkerQueue {
+    spinlock lock;
+    std::deque<WorkItem> work;
+  };
+  std::atomic<bool> work_stealing_{false};
+  std::unique_ptr<WorkerQueue[]> worker_queues_;
+  // Number of work items in the shared queue or the per-thread queues
+  std::atomic<int64_t> queued_work_{0};
+  // Number of work items added to any of the jobs, but not finished yet
+  std::atomic<int64_t> outstanding_work_{0};
+  // Queue to receive the next work item dealt out (modulo the number of threads)
+  std::atomic<uint32_t> next_queue_{0};
+
+  std::atomic<bool> track_busy_time_{false};
 };
 
 }  // namespace dali
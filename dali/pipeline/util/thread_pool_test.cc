@@ -15,6 +15,10 @@
 #include "dali/pipeline/util/thread_pool.h"
 #include <gtest/gtest.h>
 #include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace dali {
 
@@ -87,6 +91,190 @@ TEST(ThreadPool, CheckName) {
                       std::min(sizeof(full_thread_pool_name), sizeof(read_thread_pool_name)) - 1));
 }
 
+TEST(ThreadPool, WorkStealing) {
+  ThreadPool tp(16, 0, false, "ThreadPool test");
+  tp.SetWorkStealing(true);
+  ASSERT_TRUE(tp.IsWorkStealing());
+  std::atomic<int> count{0};
+  auto increase = [&count](int thread_id) { count++; };
+  for (int iter = 0; iter < 10; iter++) {
+    for (int i = 0; i < 1000; i++) {
+      tp.AddWork(increase, i % 7);
+    }
+    ASSERT_EQ(count, iter * 1000);
+    tp.RunAll();
+    ASSERT_EQ(count, (iter + 1) * 1000);
+  }
+}
+
+TEST(ThreadPool, WorkStealingImmediateStart) {
+  ThreadPool tp(16, 0, false, "ThreadPool test");
+  tp.SetWorkStealing(true);
+  std::atomic<int> count{0};
+  auto increase = [&count](int thread_id) { count++; };
+  for (int i = 0; i < 64; i++) {
+    tp.AddWork(increase, 0, true);
+  }
+  tp.WaitForWork();
+  ASSERT_EQ(count, 64);
+}
+
+TEST(ThreadPool, WorkStealingWithPriority) {
+  // only one thread to ensure deterministic behavior
+  ThreadPool tp(1, 0, false, "ThreadPool test");
+  tp.SetWorkStealing(true);
+  std::atomic<int> count{0};
+  auto set_to_1 = [&count](int thread_id) {
+    count = 1;
+  };
+  auto increase_by_1 = [&count](int thread_id) {
+    count++;
+  };
+  auto mult_by_2 = [&count](int thread_id) {
+    int val = count.load();
+    while (!count.compare_exchange_weak(val, val * 2)) {}
+  };
+  tp.AddWork(increase_by_1, 2);
+  tp.AddWork(mult_by_2, 7);
+  tp.AddWork(mult_by_2, 9);
+  tp.AddWork(mult_by_2, 8);
+  tp.AddWork(increase_by_1, 100);
+  tp.AddWork(set_to_1, 1000);
+
+  tp.RunAll();
+  ASSERT_EQ(((1+1) << 3) + 1, count);
+}
+
+TEST(ThreadPool, WorkStealingError) {
+  ThreadPool tp(4, 0, false, "ThreadPool test");
+  tp.SetWorkStealing(true);
+  std::atomic<int> count{0};
+  for (int i = 0; i < 16; i++) {
+    tp.AddWork([&count, i](int) {
+      count++;
+      if (i == 5)
+        throw std::runtime_error("Test error");
+    });
+  }
+  EXPECT_THROW(tp.RunAll(), std::runtime_error);
+  EXPECT_EQ(count, 16);
+  // the pool is usable after an error
+  tp.AddWork([&count](int) { count++; });
+  tp.RunAll();
+  EXPECT_EQ(count, 17);
+}
+
+TEST(ThreadPool, SwitchWorkStealing) {
+  ThreadPool tp(4, 0, false, "ThreadPool test");
+  std::atomic<int> count{0};
+  auto increase = [&count](int thread_id) { count++; };
+  for (int iter = 0; iter < 4; iter++) {
+    tp.SetWorkStealing(iter % 2 == 1);
+    for (int i = 0; i < 100; i++)
+      tp.AddWork(increase);
+    EXPECT_THROW(tp.SetWorkStealing(iter % 2 == 0), std::exception);
+    tp.RunAll();
+  }
+  EXPECT_EQ(count, 400);
+}
+
+TEST(ThreadPool, ConcurrentSubmission) {
+  for (bool work_stealing : { false, true }) {
+    ThreadPool tp(4, 0, false, "ThreadPool test");
+    tp.SetWorkStealing(work_stealing);
+    std::atomic<int> count{0};
+    std::vector<std::thread> clients;
+    for (int c = 0; c < 4; c++) {
+      clients.emplace_back([&]() {
+        ThreadPool::ScopedJob job(tp);
+        for (int iter = 0; iter < 10; iter++) {
+          for (int i = 0; i < 100; i++)
+            tp.AddWork([&count](int) { count++; }, i % 3, i == 50);
+          tp.RunAll();
+        }
+      });
+    }
+    for (auto &client : clients)
+      client.join();
+    EXPECT_EQ(count, 4 * 10 * 100) << "work stealing: " << work_stealing;
+  }
+}
+
+TEST(ThreadPool, BusyTime) {
+  ThreadPool tp(4, 0, false, "ThreadPool test");
+  auto sleep = [](int) { std::this_thread::sleep_for(std::chrono::milliseconds(10)); };
+  tp.AddWork(sleep);
+  tp.RunAll();
+  EXPECT_EQ(tp.BusyTime(), 0) << "The tracking is disabled by default";
+
+  for (bool work_stealing : {false, true}) {
+    tp.SetWorkStealing(work_stealing);
+    tp.SetBusyTimeTracking(true);
+    int64_t start = tp.BusyTime();
+    for (int i = 0; i < 8; i++)
+      tp.AddWork(sleep);
+    tp.RunAll();
+    int64_t busy = tp.BusyTime() - start;
+    EXPECT_GE(busy, 8 * 10'000'000);
+    tp.SetBusyTimeTracking(false);
+    tp.AddWork(sleep);
+    tp.RunAll();
+    EXPECT_EQ(tp.BusyTime() - start, busy);
+  }
+}
+
+TEST(ThreadPool, ScopedJobs) {
+  for (bool work_stealing : {false, true}) {
+    ThreadPool tp(4, 0, false, "ThreadPool test");
+    tp.SetWorkStealing(work_stealing);
+    std::atomic<bool> release{false};
+    std::atomic<int> slow_count{0}, fast_count{0};
+    std::thread slow_client([&]() {
+      ThreadPool::ScopedJob job(tp);
+      tp.AddWork([&](int) {
+        while (!release)
+          std::this_thread::yield();
+        slow_count++;
+      });
+      tp.RunAll();
+      EXPECT_EQ(slow_count, 1);
+    });
+    {
+      // this job doesn't wait for the work of the other one
+      ThreadPool::ScopedJob job(tp);
+      for (int i = 0; i < 32; i++)
+        tp.AddWork([&](int) { fast_count++; });
+      tp.RunAll();
+      EXPECT_EQ(fast_count, 32);
+      EXPECT_EQ(slow_count, 0);
+    }
+    release = true;
+    slow_client.join();
+    EXPECT_EQ(slow_count, 1);
+  }
+}
+
+TEST(ThreadPool, ScopedJobErrors) {
+  ThreadPool tp(4, 0, false, "ThreadPool test");
+  std::atomic<int> count{0};
+  {
+    ThreadPool::ScopedJob job(tp);
+    tp.AddWork([](int) { throw std::runtime_error("Test error"); });
+    EXPECT_THROW(tp.RunAll(), std::runtime_error);
+  }
+  std::thread other([&]() {
+    ThreadPool::ScopedJob job(tp);
+    tp.AddWork([](int) { throw std::runtime_error("Test error"); });
+    // not waited for - the error is discarded with the job
+    tp.RunAll(false);
+  });
+  other.join();
+  // the errors of other jobs don't affect the default one
+  tp.AddWork([&count](int) { count++; });
+  EXPECT_NO_THROW(tp.RunAll());
+  EXPECT_EQ(count, 1);
+}
+
 }  // namespace test
 
 }  // namespace dali
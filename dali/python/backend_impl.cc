@@ -1537,6 +1537,24 @@ py::dict ExecutorMetaToDict(const ExecutorMetaMap &meta) {
   return d;
 }
 
+py::dict ExecutorProfileToDict(const ExecutorProfileMap &profile) {
+  py::dict d;
+  for (const auto &entry : profile) {
+    py::dict op_dict;
+    const auto &stats = entry.second;
+    op_dict["iterations"] = stats.iterations;
+    op_dict["setup_time"] = stats.setup_time * 1e-9;
+    op_dict["run_time"] = stats.run_time * 1e-9;
+    op_dict["thread_pool_busy_time"] = stats.thread_pool_busy_time * 1e-9;
+    op_dict["queue_wait_time"] = stats.queue_wait_time * 1e-9;
+    op_dict["streamed_iterations"] = stats.streamed_iterations;
+    op_dict["samples"] = stats.samples;
+    op_dict["bytes"] = stats.bytes;
+    d[entry.first.c_str()] = op_dict;
+  }
+  return d;
+}
+
 template <typename Backend>
 void ExposeEagerOperator(py::module &m, const char *name) {
   py::class_<EagerOperator<Backend>>(m, name)
@@ -1858,6 +1876,26 @@ PYBIND11_MODULE(backend_impl, m) {
           p->EnableCheckpointing(checkpointing);
         },
         "checkpointing"_a = true)
+    .def("EnableWorkStealing",
+        [](Pipeline *p, bool work_stealing) {
+          p->EnableWorkStealing(work_stealing);
+        },
+        "work_stealing"_a = true)
+    .def("EnableParallelCPUOps",
+        [](Pipeline *p, bool parallel) {
+          p->EnableParallelCPUOps(parallel);
+        },
+        "parallel"_a = true)
+    .def("EnableSampleStreaming",
+        [](Pipeline *p, bool streaming) {
+          p->EnableSampleStreaming(streaming);
+        },
+        "streaming"_a = true)
+    .def("EnableOperatorProfiling",
+        [](Pipeline *p, bool profiling) {
+          p->EnableOperatorProfiling(profiling);
+        },
+        "profiling"_a = true)
     .def("SerializedCheckpoint",
         [](Pipeline *p) -> py::bytes {
           return p->SerializedCheckpoint();
@@ -1871,6 +1909,11 @@ PYBIND11_MODULE(backend_impl, m) {
           auto ret = p->GetExecutorMeta();
           return ExecutorMetaToDict(ret);
         })
+    .def("operator_profile",
+        [](Pipeline *p) {
+          auto ret = p->GetOperatorProfile();
+          return ExecutorProfileToDict(ret);
+        })
     .def("SetQueueSizes",
         [](Pipeline *p, int cpu_size, int gpu_size) {
           p->SetQueueSizes(cpu_size, gpu_size);
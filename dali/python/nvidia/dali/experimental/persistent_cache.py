@@ -0,0 +1,171 @@
+# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import hashlib
+import os
+import struct
+
+from nvidia.dali.data_node import DataNode as _DataNode
+
+# Must match dali/operators/reader/loader/persistent_cache_file.h
+_MAGIC = b"DALIPCF\0"
+_VERSION = 1
+_HEADER = struct.Struct("<8sIIQ")  # magic, version, number of outputs, key length
+
+# The arguments of the original reader which also apply to the cache reader. The sharding
+# arguments are not forwarded - the cache file contains only the samples of one shard.
+_FORWARDED_READER_ARGS = [
+    "random_shuffle", "initial_fill", "read_ahead", "prefetch_queue_depth", "dont_use_mmap",
+    "tensor_init_bytes", "seed"
+]
+
+
+def _describe_op(op_instance):
+    """Describes the operator and its arguments.
+
+    The names of the inputs and outputs are generated anew for every pipeline, so they are
+    omitted, and the arguments are sorted to make the description independent of their order.
+    """
+    lines = repr(op_instance.spec).splitlines()
+    args_start = lines.index("  Arguments:") + 1
+    return "\n".join([lines[0]] + sorted(lines[args_start:]))
+
+
+def _walk_graph(nodes):
+    """Computes the invalidation key of the graph producing `nodes` and finds its readers."""
+    keys = {}
+    readers = []
+
+    def node_key(node):
+        op = node.source
+        if op is None:
+            raise ValueError(f"The data node \"{node.name}\" is not produced by an operator.")
+        if id(op) not in keys:
+            input_keys = [node_key(inp) for inp in op.inputs]
+            description = "\n".join([_describe_op(op)] + input_keys)
+            keys[id(op)] = hashlib.sha256(description.encode()).hexdigest()
+            schema = getattr(op._op, "schema", None)
+            if schema is not None and "random_shuffle" in schema.GetArgumentNames():
+                readers.append(op)
+        output_idx = next(i for i, out in enumerate(op.outputs) if out is node)
+        return f"{keys[id(op)]}:{output_idx}"
+
+    key = hashlib.sha256("\n".join(node_key(node) for node in nodes).encode()).hexdigest()
+    return key, readers
+
+
+def _is_cache_complete(path, key, num_outputs):
+    """Checks whether `path` holds a committed cache file written with `key`.
+
+    The index is fully validated by the reader when the pipeline is built.
+    """
+    try:
+        with open(path, "rb") as f:
+            magic, version, n, key_len = _HEADER.unpack(f.read(_HEADER.size))
+            if (magic != _MAGIC or version != _VERSION or n != num_outputs
+                    or f.read(key_len) != key.encode()):
+                return False
+            f.seek(-len(_MAGIC), os.SEEK_END)
+            return f.read(len(_MAGIC)) == _MAGIC
+    except (OSError, struct.error):
+        return False
+
+
+def persistent_cache(*inputs, path, key="", check_integrity=False):
+    """Caches the outputs of a deterministic part of the pipeline in a file.
+
+    The first time the pipeline is run, the inputs are passed through and stored in the file
+    at ``path`` by :meth:`nvidia.dali.fn.experimental.persistent_cache_writer`. The file is
+    written when the pipeline is destroyed, provided that it contains all the samples of the
+    reader (as reported by its epoch size).
+    In the following runs, the processing which produced the inputs (including the reader) is
+    replaced with :meth:`nvidia.dali.fn.experimental.readers.persistent_cache`, which reads the
+    memory-mapped file.
+
+    The cache is invalidated when the processing changes - the invalidation key is computed
+    from the specifications of all the operators which produced the inputs. The ``key`` argument
+    is included in the invalidation key, so it can describe what the operators can't, like the
+    version of the dataset.
+
+    The inputs must be computed on the CPU by deterministic operators from the outputs of
+    a single reader. The samples are identified by their source info. The cache reader
+    inherits the shuffling arguments of the original reader and its name, so the reader name
+    can still be used to query the epoch size.
+
+    Example::
+
+        @pipeline_def
+        def pipe():
+            jpegs, labels = fn.readers.file(file_root=root, random_shuffle=True, name="Reader")
+            images = fn.decoders.image(jpegs, device="cpu")
+            images = fn.resize(images, resize_shorter=256)
+            images, labels = persistent_cache(images, labels, path="/data/cache/train.dpc")
+            images = fn.random_resized_crop(images, size=224)
+            return images, labels
+
+    .. note::
+        The cache only contains the samples processed by the pipeline which wrote it. When the
+        data is sharded, use a different ``path`` for each shard and ``stick_to_shard=True``.
+
+    .. note::
+        This is an experimental feature, subject to change without notice.
+
+    Parameters
+    ----------
+    *inputs : DataNode
+        The outputs of the part of the pipeline to be cached.
+    path : str
+        Path to the cache file.
+    key : str, optional
+        Additional invalidation key.
+    check_integrity : bool, optional
+        If True, the checksums of the cached samples are verified when they are read.
+
+    Returns
+    -------
+    DataNode or list of DataNode
+        The outputs corresponding to the inputs.
+    """
+    from nvidia.dali import fn
+
+    if not inputs:
+        raise ValueError("At least one input is required.")
+    for inp in inputs:
+        if not isinstance(inp, _DataNode):
+            raise TypeError(f"Expected inputs of type `DataNode`, got `{type(inp).__name__}`.")
+        if inp.device != "cpu":
+            raise ValueError("Only the data on the CPU can be cached.")
+
+    graph_key, readers = _walk_graph(inputs)
+    if len(readers) != 1:
+        raise ValueError(f"The cached inputs must be produced from exactly one reader, "
+                         f"found {len(readers)}.")
+    full_key = hashlib.sha256(f"{graph_key}\n{key}".encode()).hexdigest()
+
+    if _is_cache_complete(path, full_key, len(inputs)):
+        reader_op = readers[0]._op
+        reader_args = {
+            name: value
+            for name, value in reader_op._init_args.items() if name in _FORWARDED_READER_ARGS
+        }
+        if reader_op._name is not None:
+            reader_args["name"] = reader_op._name
+        outputs = fn.experimental.readers.persistent_cache(path=path, key=full_key,
+                                                           num_outputs=len(inputs),
+                                                           check_integrity=check_integrity,
+                                                           **reader_args)
+    else:
+        outputs = fn.experimental.persistent_cache_writer(*inputs, path=path, key=full_key,
+                                                          reader_name=readers[0].name)
+    return outputs
@@ -180,16 +180,103 @@ def _generate_input_desc(categories_idx, integers, reals):
     return input_desc
 
 
+# ArithmeticGenericOp accepts at most 64 inputs
+_MAX_FUSED_INPUTS = 64
+# Limits the size of the fused expressions, as the intermediate results which are inlined in
+# more than one expression are recomputed
+_MAX_FUSED_FUNCTIONS = 32
+
+
+class _ArithmExpr:
+    """
+    Expression tree of the arithmetic operations computing a CPU DataNode.
+
+    The arguments are nested expressions, DataNodes or scalar constants.
+    """
+
+    def __init__(self, name, args):
+        self.name = name
+        self.args = args
+        self.num_functions = 1 + sum(arg.num_functions for arg in args
+                                     if isinstance(arg, _ArithmExpr))
+
+
+def _fuse_inputs(name, categories_idxs, edges, integers, reals):
+    """
+    Build the expression tree of the operation, inlining the expressions which computed
+    the CPU inputs. An input used more than once by the operation is not inlined.
+    """
+    args = []
+    num_functions = 1
+    for category, idx in categories_idxs:
+        if category == "edge":
+            arg = edges[idx]
+            expr = getattr(arg, "_arithm_expr", None)
+            used_once = sum(edge is arg for edge in edges) == 1
+            if (expr is not None and used_once
+                    and num_functions + expr.num_functions <= _MAX_FUSED_FUNCTIONS):
+                arg = expr
+                num_functions += expr.num_functions
+        elif category == "integer":
+            arg = integers[idx]
+        else:
+            arg = reals[idx]
+        args.append(arg)
+    return _ArithmExpr(name, args)
+
+
+def _generate_fused_desc(expr, edges, integers, reals):
+    """
+    Generate the expression_desc of the expression tree, collecting its inputs and constants.
+    The inputs are deduplicated.
+    """
+    arg_descs = []
+    for arg in expr.args:
+        if isinstance(arg, _ArithmExpr):
+            arg_descs.append(_generate_fused_desc(arg, edges, integers, reals))
+        elif isinstance(arg, _DataNode):
+            # DataNode overloads `==`, compare the identity
+            idx = next((i for i, edge in enumerate(edges) if edge is arg), len(edges))
+            if idx == len(edges):
+                edges.append(arg)
+            arg_descs.append("&{}".format(idx))
+        elif _is_integer_like(arg):
+            arg_descs.append("${}:{}".format(len(integers), _to_type_desc(arg)))
+            integers.append(arg)
+        else:
+            arg_descs.append("${}:{}".format(len(reals), _to_type_desc(arg)))
+            reals.append(arg)
+    return "{}({})".format(expr.name, " ".join(arg_descs))
+
+
 def _arithm_op(name, *inputs):
     """
     Create arguments for ArithmeticGenericOp and call it with supplied inputs.
     Select the `gpu` device if at least one of the inputs is `gpu`, otherwise `cpu`.
+
+    On the CPU, the operations computing the inputs are fused with this one: their expressions
+    are inlined, so the whole expression is evaluated by a single operator, without storing the
+    intermediate results. The operators computing the intermediate results are pruned from
+    the pipeline, unless their outputs are used elsewhere.
     """
     import nvidia.dali.ops  # Allow for late binding of the ArithmeticGenericOp from parent module.
     categories_idxs, edges, integers, reals = _group_inputs(inputs)
-    input_desc = _generate_input_desc(categories_idxs, integers, reals)
-    expression_desc = "{}({})".format(name, input_desc)
     dev = nvidia.dali.ops._choose_device(edges)
+    fused_expr = None
+    if dev == "cpu" and not _conditionals.conditionals_enabled():
+        fused_expr = _fuse_inputs(name, categories_idxs, edges, integers, reals)
+        fused_edges, fused_integers, fused_reals = [], [], []
+        expression_desc = _generate_fused_desc(fused_expr, fused_edges, fused_integers,
+                                               fused_reals)
+        if len(fused_edges) > _MAX_FUSED_INPUTS:
+            fused_expr = None
+    if fused_expr is None:
+        input_desc = _generate_input_desc(categories_idxs, integers, reals)
+        expression_desc = "{}({})".format(name, input_desc)
+    else:
+        edges = fused_edges
+        integers = fused_integers or None
+        reals = fused_reals or None
     # Create "instance" of operator
     op = nvidia.dali.ops.ArithmeticGenericOp(device=dev, expression_desc=expression_desc,
                                              integer_constants=integers, real_constants=reals)
@@ -201,6 +288,8 @@ def _arithm_op(name, *inputs):
 
     # Call it immediately
     result = op(*dev_inputs)
+    if fused_expr is not None:
+        result._arithm_expr = fused_expr
     if _conditionals.conditionals_enabled():
         _conditionals.register_data_nodes(result, dev_inputs)
     return result
@@ -133,6 +133,29 @@ Parameters
         Currently, some operators do not support checkpointing. The state of the pipeline
         can be saved at the beginning of an epoch only.
 
+`enable_work_stealing`: bool, optional, default = False
+    If True, the CPU operators run on a thread pool in which each thread has its own
+    work queue and steals work from the other threads when its queue is empty.
+    This reduces the overhead of scheduling when ``num_threads`` is large and the operators
+    process many small samples. The results are the same as with the default thread pool.
+`enable_parallel_cpu_ops`: bool, optional, default = False
+    If True, a CPU operator starts as soon as the operators producing its inputs are done,
+    so independent branches of the graph (e.g. image, label and bounding box processing) run
+    concurrently, sharing the thread pool. The results are the same as with the sequential
+    execution. Operators with hidden dependencies (e.g. Python functions with shared state)
+    may need the sequential execution.
+`enable_sample_streaming`: bool, optional, default = False
+    If True, the samples are passed through chains of CPU operators which process each sample
+    separately (e.g. ``fn.decoders.image`` followed by ``fn.resize_crop_mirror``) one by one,
+    without waiting for the whole batch between the operators. Only the operators which support
+    it form the chains. An operator which knows the shapes of its outputs before it runs
+    (e.g. ``fn.flip``) can only follow another such operator. This keeps the sample's data in
+    the cache and a slow sample doesn't hold back the next operator. The results are the same as
+    without streaming. Cannot be used together with ``enable_parallel_cpu_ops``.
+`enable_operator_profiling`: bool, optional, default = False
+    If True, the executor measures the time spent in each operator and the size of its
+    outputs. The results can be obtained with the ``operator_profile`` method.
+    When disabled, the profiling has no measurable overhead.
 `py_num_workers`: int, optional, default = 1
     The number of Python workers that will process ``ExternalSource`` callbacks.
     The pool starts only if there is at least one ExternalSource with ``parallel`` set to True.
@@ -215,6 +238,10 @@ Parameters
                  enable_memory_stats=False,
                  enable_checkpointing=False,
                  checkpoint=None,
+                 enable_work_stealing=False,
+                 enable_parallel_cpu_ops=False,
+                 enable_sample_streaming=False,
+                 enable_operator_profiling=False,
                  py_num_workers=1,
                  py_start_method="fork",
                  py_callback_pickler=None,
@@ -270,6 +297,10 @@ Parameters
         self._enable_memory_stats = enable_memory_stats
         self._enable_checkpointing = enable_checkpointing
         self._checkpoint = checkpoint
+        self._enable_work_stealing = enable_work_stealing
+        self._enable_parallel_cpu_ops = enable_parallel_cpu_ops
+        self._enable_sample_streaming = enable_sample_streaming
+        self._enable_operator_profiling = enable_operator_profiling
         self._prefetch_queue_depth = prefetch_queue_depth
         if type(prefetch_queue_depth) is dict:
             self._exec_separated = True
@@ -465,6 +496,44 @@ Parameters
             raise RuntimeError("Pipeline must be built first.")
         return self._pipe.executor_statistics()
 
+    def operator_profile(self):
+        """Returns the execution profile of the operators as a dictionary.
+        Each key in the dictionary is the operator name, prefixed with the stage it runs in
+        (``CPU_``, ``MIXED_`` or ``GPU_``). The profile is gathered only when the pipeline
+        is created with ``enable_operator_profiling`` set to True and it covers all
+        the iterations run so far.
+
+        The keys ``CPU``, ``MIXED`` and ``GPU`` hold the profile of the stages with any
+        operators. Only ``iterations`` and ``queue_wait_time`` are set for them.
+
+        Available keys for each operator:
+
+            * ``iterations`` - the number of the iterations profiled.
+
+            * ``setup_time``, ``run_time`` - total time, in seconds, spent in the setup
+              and in the run of the operator. For the GPU operators, it is the time of issuing
+              the work, not of its execution on the device.
+
+            * ``thread_pool_busy_time`` - total time, in seconds, the threads of the pool
+              spent running the operator's work, summed over the threads. Only for the CPU
+              operators.
+
+            * ``queue_wait_time`` - total time, in seconds, the stage waited for
+              the prefetch queues before starting the iterations. The wait is shared by all
+              the operators of the stage, so it is reported only for the stages.
+
+            * ``streamed_iterations`` - the number of the iterations in which the operator
+              processed the samples in a chain of operators, see ``enable_sample_streaming``.
+              Only for the CPU operators.
+
+            * ``samples`` - the number of samples produced.
+
+            * ``bytes`` - the size of the outputs produced, in bytes.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.operator_profile()
+
     def external_source_shm_statistics(self):
         """Returns parallel external source's statistics regarding shared memory consumption.
         The returned dictionary contains following keys:
@@ -737,6 +806,10 @@ Parameters
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
         self._pipe.EnableCheckpointing(self._enable_checkpointing)
+        self._pipe.EnableWorkStealing(self._enable_work_stealing)
+        self._pipe.EnableParallelCPUOps(self._enable_parallel_cpu_ops)
+        self._pipe.EnableSampleStreaming(self._enable_sample_streaming)
+        self._pipe.EnableOperatorProfiling(self._enable_operator_profiling)
 
         # Add the ops to the graph and build the backend
         related_logical_id = {}
@@ -1319,6 +1392,11 @@ Parameters
         pipeline._pipe.SetQueueSizes(pipeline._cpu_queue_size, pipeline._gpu_queue_size)
         pipeline._pipe.EnableExecutorMemoryStats(pipeline._enable_memory_stats)
         pipeline._pipe.EnableCheckpointing(pipeline._enable_checkpointing)
+        pipeline._pipe.EnableWorkStealing(kw.get("enable_work_stealing", False))
+        pipeline._pipe.EnableParallelCPUOps(kw.get("enable_parallel_cpu_ops", False))
+        pipeline._pipe.EnableSampleStreaming(kw.get("enable_sample_streaming", False))
+        pipeline._enable_operator_profiling = kw.get("enable_operator_profiling", False)
+        pipeline._pipe.EnableOperatorProfiling(pipeline._enable_operator_profiling)
         pipeline._backend_prepared = True
         pipeline._pipe.Build()
         pipeline._restore_state_from_checkpoint()
@@ -1360,6 +1438,10 @@ Parameters
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
         self._pipe.EnableCheckpointing(self._enable_checkpointing)
+        self._pipe.EnableWorkStealing(self._enable_work_stealing)
+        self._pipe.EnableParallelCPUOps(self._enable_parallel_cpu_ops)
+        self._pipe.EnableSampleStreaming(self._enable_sample_streaming)
+        self._pipe.EnableOperatorProfiling(self._enable_operator_profiling)
         self._backend_prepared = True
         self._pipe.Build()
         self._restore_state_from_checkpoint()
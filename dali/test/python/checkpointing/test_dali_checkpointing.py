@@ -226,6 +226,47 @@ def test_file_reader_pytorch(
                 assert (d1[key] == d2[key]).all()
 
 
+def check_reader_checkpointing(reader, num_epochs, batch_size, shard_id, num_shards, **kwargs):
+    @pipeline_def(batch_size=batch_size, device_id=0,
+                  num_threads=4, enable_checkpointing=True)
+    def pipeline():
+        data = reader(name="Reader", pad_last_batch=True,
+                      shard_id=shard_id, num_shards=num_shards, seed=123, **kwargs)
+        return data[0] if isinstance(data, list) else data
+
+    p = pipeline()
+    p.build()
+
+    iterations_in_epoch = calculate_iterations_in_epoch(p, batch_size, num_shards)
+    for _ in range(num_epochs * iterations_in_epoch):
+        p.run()
+
+    restored = pipeline(checkpoint=p.checkpoint())
+    restored.build()
+
+    compare_pipelines(p, restored, batch_size, (num_shards + 1) * iterations_in_epoch)
+
+
+recordio_path = os.path.join(data_root, 'db', 'recordio')
+
+
+@cartesian_params(((1, 3, 0, 1), (2, 16, 1, 3)), (True, False))
+def test_mxnet_reader(epoch_description, global_shuffle):
+    check_reader_checkpointing(
+        fn.readers.mxnet, *epoch_description,
+        path=[os.path.join(recordio_path, 'train.rec')],
+        index_path=[os.path.join(recordio_path, 'train.idx')],
+        global_shuffle=global_shuffle, shuffle_block_size=4, shuffle_window_size=16)
+
+
+@cartesian_params(((1, 3, 0, 1), (2, 16, 1, 3)), (True, False))
+def test_webdataset_reader(epoch_description, global_shuffle):
+    check_reader_checkpointing(
+        fn.readers.webdataset, *epoch_description,
+        paths=[os.path.join(data_root, 'db', 'webdataset', 'MNIST', 'devel-0.tar')],
+        ext=['jpg'], global_shuffle=global_shuffle, shuffle_block_size=4, shuffle_window_size=16)
+
+
 # Randomized operators section
 # note: fn.decoders.image_random_crop is tested by
 # `check_single_input_operator`
@@ -232,6 +232,40 @@ def test_fancy_upsampling(batch_size):
         batch_size=batch_size, N_iterations=3, eps=1)
 
 
+@pipeline_def(batch_size=8, num_threads=3, device_id=0)
+def decoder_hint_size_pipe(data_path, hint_size):
+    encoded, _ = fn.readers.file(file_root=data_path)
+    full = fn.experimental.decoders.image(encoded, device='cpu')
+    scaled = fn.experimental.decoders.image(encoded, device='cpu', hint_size=[hint_size])
+    return full, scaled
+
+
+def _testimpl_image_decoder_hint_size(img_type, hint_size):
+    data_path = os.path.join(test_data_root, good_path, img_type)
+    pipe = decoder_hint_size_pipe(data_path, hint_size)
+    pipe.build()
+    full, scaled = pipe.run()
+    for i in range(len(full)):
+        full_shape = full.at(i).shape
+        scaled_shape = scaled.at(i).shape
+        if img_type != 'jpeg':
+            assert full_shape == scaled_shape, f"{full_shape} vs {scaled_shape}"
+            continue
+        # the largest of the JPEG scaling factors that keeps the image at least hint_size large
+        scale = 1
+        while scale < 8 and all(math.ceil(full_shape[d] / (2 * scale)) >= hint_size
+                                for d in range(2)):
+            scale *= 2
+        expected = (math.ceil(full_shape[0] / scale), math.ceil(full_shape[1] / scale),
+                    full_shape[2])
+        assert scaled_shape == expected, f"{scaled_shape} vs {expected} for {full_shape}"
+
+
+@params(('jpeg', 64), ('jpeg', 200), ('jpeg', 10000), ('png', 64))
+def test_image_decoder_hint_size(img_type, hint_size):
+    _testimpl_image_decoder_hint_size(img_type, hint_size)
+
+
 batch_size_test = 16
 
 
@@ -18,6 +18,8 @@ import numpy as np
 import cv2
 import nvidia.dali.types as types
 import glob
+import os
+import tempfile
 from itertools import cycle
 from test_utils import get_dali_extra_path, is_mulit_gpu
 from nvidia.dali.backend import TensorListGPU
@@ -217,3 +219,78 @@ def test_source_info(device):
         for idx, t in enumerate(o[0]):
             assert t.source_info() == files[(samples_read + idx) % len(files)]
         samples_read += batch_size
+
+
+@params(0, 1, 4)
+def test_cpu_reader_codec_threads(codec_threads):
+    files = sorted(glob.glob(f'{get_dali_extra_path()}/db/video/[cv]fr/test_[12]*.mp4'))
+    files = [filename for filename in files if 'mpeg4' not in filename]
+
+    @pipeline_def(batch_size=5, device_id=0)
+    def reader_pipeline(codec_threads):
+        return fn.experimental.readers.video(
+            device='cpu', filenames=files, sequence_length=8, stride=2, step=13,
+            random_shuffle=True, initial_fill=16, seed=42, codec_threads=codec_threads)
+
+    # the sequences of different videos are decoded concurrently with more threads
+    pipe = reader_pipeline(num_threads=4, codec_threads=codec_threads)
+    ref_pipe = reader_pipeline(num_threads=1, codec_threads=1)
+    pipe.build()
+    ref_pipe.build()
+    for _ in range(5):
+        out, = pipe.run()
+        ref_out, = ref_pipe.run()
+        for sample, ref_sample in zip(out, ref_out):
+            assert sample.source_info() == ref_sample.source_info()
+            assert np.array_equal(np.array(sample), np.array(ref_sample))
+
+
+def test_reader_index_cache():
+    files = sorted(glob.glob(f'{get_dali_extra_path()}/db/video/[cv]fr/test_[12].mp4'))
+
+    @pipeline_def(batch_size=4, num_threads=4, device_id=0)
+    def reader_pipeline(index_cache_path):
+        return fn.experimental.readers.video(
+            device='cpu', filenames=files, sequence_length=5, step=7,
+            index_cache_path=index_cache_path)
+
+    def run(index_cache_path):
+        pipe = reader_pipeline(index_cache_path=index_cache_path)
+        pipe.build()
+        return [np.array(sample) for _ in range(4) for sample in pipe.run()[0]]
+
+    ref = run('')
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        index_cache_path = os.path.join(tmp_dir, 'index_cache')
+        # the first run builds and saves the indices, the second one loads them
+        for _ in range(2):
+            out = run(index_cache_path)
+            assert os.path.exists(index_cache_path)
+            for sample, ref_sample in zip(out, ref):
+                assert np.array_equal(sample, ref_sample)
+
+
+@params((dict(resize_x=200, resize_y=120),),
+        (dict(resize_shorter=64, interp_type=types.INTERP_CUBIC),),
+        (dict(size=(100, 300), interp_type=types.INTERP_NN),))
+def test_cpu_reader_resize(resize_args):
+    files = sorted(glob.glob(f'{get_dali_extra_path()}/db/video/cfr/test_[12].mp4'))
+
+    @pipeline_def(batch_size=4, num_threads=4, device_id=0)
+    def resize_pipeline():
+        reader_args = dict(filenames=files, sequence_length=4, step=11)
+        fused = fn.experimental.readers.video_resize(device='cpu', name='fused', **reader_args,
+                                                     **resize_args)
+        frames = fn.experimental.readers.video(device='cpu', name='ref', **reader_args)
+        return fused, fn.resize(frames, **resize_args)
+
+    pipe = resize_pipeline()
+    pipe.build()
+    for _ in range(3):
+        out, ref = pipe.run()
+        for sample, ref_sample in zip(out, ref):
+            sample, ref_sample = np.array(sample), np.array(ref_sample)
+            assert sample.shape == ref_sample.shape, f"{sample.shape} != {ref_sample.shape}"
+            # FFmpeg filters differ from the ones of fn.resize
+            diff = np.abs(sample.astype(np.float32) - ref_sample.astype(np.float32))
+            assert np.mean(diff) < 8, f"Mean difference {np.mean(diff)}"
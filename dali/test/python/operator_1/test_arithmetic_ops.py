@@ -1037,3 +1037,54 @@ def test_broadcasting_incompatible_shapes():
     for device in ['cpu', 'gpu']:
         with assert_raises(RuntimeError, glob=error_msg2):
             impl(device, shape_a2, shape_b2)
+
+
+def test_fused_expressions_cpu():
+    mean = np.array([10, 20, 30], dtype=np.float32)
+    stddev = np.array([2, 4, 8], dtype=np.float32)
+
+    def get_data():
+        rng = np.random.default_rng(42)
+        return [rng.integers(0, 256, size=(10 + i, 7, 3), dtype=np.uint8)
+                for i in range(batch_size)]
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=None)
+    def pipe():
+        img = fn.external_source(source=get_data, cycle=True)
+        normalized = (img - types.Constant(mean)) / types.Constant(stddev) * 255
+        centered = img - 128
+        # `centered` is used twice - it's not inlined
+        squared = centered * centered + 1
+        return normalized, math.clamp(normalized, -1.5, 1.5) + 2, squared
+
+    p = pipe()
+    p.build()
+    # The operations computing each of the outputs are fused with the ones they consume
+    arithm_ops = [op for op in p._ops if op.spec.name == "ArithmeticGenericOp"]
+    assert len(arithm_ops) == 4, f"Expected 4 fused operators, got {len(arithm_ops)}"
+    normalized, clamped, squared = p.run()
+    for img, norm, clamp, sq in zip(get_data(), normalized, clamped, squared):
+        ref_norm = (img - mean) / stddev * 255
+        np.testing.assert_allclose(np.array(norm), ref_norm, rtol=1e-6)
+        np.testing.assert_allclose(np.array(clamp), np.clip(ref_norm, -1.5, 1.5) + 2, rtol=1e-6)
+        centered = img.astype(np.int32) - 128
+        np.testing.assert_array_equal(np.array(sq), centered * centered + 1)
+
+
+def test_fused_expression_size_limit():
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=None)
+    def pipe():
+        x = fn.random.uniform(range=[0.5, 1.5], shape=[100])
+        ref = x
+        for _ in range(100):
+            x = x * 0.5 + 0.5
+        return x, ref
+
+    p = pipe()
+    p.build()
+    out, ref = p.run()
+    for o, r in zip(out, ref):
+        expected = np.array(r)
+        for _ in range(100):
+            expected = expected * np.float32(0.5) + np.float32(0.5)
+        np.testing.assert_allclose(np.array(o), expected, rtol=1e-6)
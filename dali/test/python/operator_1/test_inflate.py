@@ -1,4 +1,4 @@
-# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 import numpy as np
 
 from nvidia.dali import pipeline_def, fn, types
+from nvidia.dali.tensors import TensorListGPU
 from test_utils import np_type_to_dali, has_operator, restrict_platform
 from nose_utils import assert_raises
 from nose2.tools import params
@@ -26,11 +27,54 @@ def sample_to_lz4(sample):
     return np.frombuffer(deflated_buf, dtype=np.uint8)
 
 
+def sample_to_zstd(sample):
+    import zstandard
+    deflated_buf = zstandard.ZstdCompressor().compress(np.ascontiguousarray(sample))
+    return np.frombuffer(deflated_buf, dtype=np.uint8)
+
+
+def sample_to_deflate(sample):
+    import zlib
+    compressor = zlib.compressobj(wbits=-zlib.MAX_WBITS)  # raw deflate stream, no header
+    deflated_buf = compressor.compress(np.ascontiguousarray(sample)) + compressor.flush()
+    return np.frombuffer(deflated_buf, dtype=np.uint8)
+
+
+compressors = {"LZ4": sample_to_lz4, "zstd": sample_to_zstd, "deflate": sample_to_deflate}
+
+
+def cpu_inflate_algorithms():
+    """Returns the algorithms supported by the CPU operator in this build of DALI."""
+
+    @pipeline_def(batch_size=1, num_threads=1, device_id=None)
+    def pipeline(algorithm):
+        inp = fn.external_source(source=lambda: np.array([0], dtype=np.uint8), batch=False)
+        return fn.experimental.inflate(inp, shape=0, algorithm=algorithm)
+
+    supported = []
+    for algorithm in compressors:
+        pipe = pipeline(algorithm)
+        try:
+            pipe.build()
+            pipe.run()
+        except RuntimeError as e:
+            if "not registered for cpu" in str(e):
+                # the build has no CPU codecs at all
+                return []
+            if "is not supported by the CPU inflate operator" not in str(e):
+                raise
+        else:
+            supported.append(algorithm)
+    return supported
+
+
 def check_batch(inflated, baseline, batch_size, layout=None, oversized_shape=False):
     layout = layout or ""
     assert inflated.layout() == layout, (f"The batch layout '({inflated.layout()})' does "
                                          f"not match the expected layout ({layout})")
-    inflated_samples = [np.array(sample) for sample in inflated.as_cpu()]
+    if isinstance(inflated, TensorListGPU):
+        inflated = inflated.as_cpu()
+    inflated_samples = [np.array(sample) for sample in inflated]
     baseline_samples = [np.array(sample) for sample in baseline]
     assert batch_size == len(inflated) == len(baseline)
     if not oversized_shape:
@@ -147,7 +191,7 @@ def test_scalar_shape():
             yield _test_scalar_shape, dtype, shape, layout
 
 
-def seq_source(rng, ndim, dtype, mode, permute, oversized_shape):
+def seq_source(rng, ndim, dtype, mode, permute, oversized_shape, compress=sample_to_lz4):
 
     def uniform(shape):
         return dtype(rng.uniform(-2**31, 2**31 - 1, shape))
@@ -170,7 +214,7 @@ def seq_source(rng, ndim, dtype, mode, permute, oversized_shape):
         shape = np.int32(rng.uniform(0, max_extent_size, ndim))
         sample = np.array([(distrs[i % len(distrs)])(shape) for i in range(num_chunks)],
                           dtype=dtype)
-        chunks = [sample_to_lz4(chunk) for chunk in sample]
+        chunks = [compress(chunk) for chunk in sample]
         sizes = [len(chunk) for chunk in chunks]
         offsets = np.int32(np.cumsum([0] + sizes[:-1]))
         sizes = np.array(sizes, dtype=np.int32)
@@ -195,9 +239,10 @@ def seq_source(rng, ndim, dtype, mode, permute, oversized_shape):
 
 
 def _test_chunks(seed, batch_size, ndim, dtype, layout, mode, permute, oversized_shape,
-                 sequence_axis_name):
+                 sequence_axis_name, device="gpu", algorithm="LZ4"):
     rng = np.random.default_rng(seed=seed)
-    source = seq_source(rng, ndim, dtype, mode, permute, oversized_shape)
+    source = seq_source(rng, ndim, dtype, mode, permute, oversized_shape,
+                        compress=compressors[algorithm])
 
     @pipeline_def
     def pipeline():
@@ -211,13 +256,17 @@ def _test_chunks(seed, batch_size, ndim, dtype, layout, mode, permute, oversized
             offsets = None
         else:
             offsets, sizes = rest
-        inflated = fn.experimental.inflate(deflated.gpu(), shape=reported_shape,
+        if device == "gpu":
+            deflated = deflated.gpu()
+        inflated = fn.experimental.inflate(deflated, shape=reported_shape,
                                            dtype=np_type_to_dali(dtype), chunk_offsets=offsets,
                                            chunk_sizes=sizes, layout=layout,
-                                           sequence_axis_name=sequence_axis_name)
+                                           sequence_axis_name=sequence_axis_name,
+                                           algorithm=algorithm)
         return inflated, baseline
 
-    pipe = pipeline(batch_size=batch_size, num_threads=4, device_id=0)
+    device_id = 0 if device == "gpu" else None
+    pipe = pipeline(batch_size=batch_size, num_threads=4, device_id=device_id)
     pipe.build()
     if layout:
         layout = (sequence_axis_name or "F") + layout
@@ -243,6 +292,49 @@ def test_chunks():
                 seed += 1
 
 
+@has_operator("experimental.inflate")
+def test_chunks_cpu():
+    seed = 101
+    batch_sizes = [1, 9, 31]
+    for algorithm in cpu_inflate_algorithms():
+        for dtype in [np.uint8, np.int16, np.float32]:
+            for ndim, layout, sequence_axis_name in [(0, None, None), (2, "XY", "Q"),
+                                                     (3, "ABC", None)]:
+                for mode, permute in [("offset_only", False), ("size_only", False),
+                                      ("offset_and_size", True)]:
+                    batch_size = batch_sizes[seed % len(batch_sizes)]
+                    oversized_shape = ndim > 0 and seed % 2 == 1
+                    yield _test_chunks, seed, batch_size, ndim, dtype, layout, mode, \
+                        permute, oversized_shape, sequence_axis_name, "cpu", algorithm
+                    seed += 1
+
+
+def _test_cpu_truncated_input(algorithm):
+    sample = np.arange(4096, dtype=np.int32)
+    deflated = compressors[algorithm](sample)
+    deflated = deflated[:len(deflated) // 2]
+
+    @pipeline_def
+    def pipeline():
+        inp = fn.external_source(source=lambda: deflated, batch=False)
+        return fn.experimental.inflate(inp, shape=sample.shape, dtype=types.INT32,
+                                       algorithm=algorithm)
+
+    with assert_raises(RuntimeError, glob=f"Failed to inflate {algorithm} chunk of sample of idx"):
+        pipe = pipeline(batch_size=2, num_threads=2, device_id=None)
+        pipe.build()
+        pipe.run()
+
+
+@has_operator("experimental.inflate")
+def test_cpu_truncated_input():
+    # LZ4 block format has no end marker, a truncated chunk is indistinguishable from
+    # a shorter one - the missing part is filled with 0s just like in the GPU operator
+    for algorithm in cpu_inflate_algorithms():
+        if algorithm != "LZ4":
+            yield _test_cpu_truncated_input, algorithm
+
+
 @has_operator("experimental.inflate")
 @restrict_platform(min_compute_cap=6.0, platforms=["x86_64"])
 @params({"chunk_offsets": []}, {"chunk_sizes": []}, {"chunk_offsets": np.array([], dtype=np.int32)},
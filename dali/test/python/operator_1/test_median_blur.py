@@ -54,16 +54,16 @@ def reference_pipe(data_src, layout, ksize_src):
 
 
 @dali.pipeline_def(num_threads=NUM_THREADS, device_id=DEV_ID)
-def median_blur_pipe(data_src, layout, ksize_src):
-    img = fn.external_source(source=data_src, batch=True, layout=layout, device='gpu')
+def median_blur_pipe(data_src, layout, ksize_src, device):
+    img = fn.external_source(source=data_src, batch=True, layout=layout, device=device)
     ksize = fn.external_source(source=ksize_src)
     ksize = fn.cat(ksize, ksize)
     return fn.experimental.median_blur(img, window_size=ksize)
 
 
 @dali.pipeline_def(num_threads=NUM_THREADS, device_id=DEV_ID)
-def median_blur_cksize_pipe(data_src, layout, ksize):
-    img = fn.external_source(source=data_src, batch=True, layout=layout, device='gpu')
+def median_blur_cksize_pipe(data_src, layout, ksize, device):
+    img = fn.external_source(source=data_src, batch=True, layout=layout, device=device)
     return fn.experimental.median_blur(img, window_size=ksize)
 
 
@@ -79,12 +79,18 @@ def ksize_src(bs, lo, hi, seed):
         yield ksize
 
 
-@params((32, 'HWC', np.uint8, 3, 9),
-        (32, 'CHW', np.float32, 4, 5),
-        (32, 'HWC', np.uint16, 1, 5),
-        (4, 'FHWC', np.float32, 3, 5),
-        (4, 'FCHW', np.uint8, 1, 9))
-def test_median_blur_vs_ocv(bs, layout, dtype, channels, max_ksize):
+@params(('gpu', 32, 'HWC', np.uint8, 3, 9),
+        ('gpu', 32, 'CHW', np.float32, 4, 5),
+        ('gpu', 32, 'HWC', np.uint16, 1, 5),
+        ('gpu', 4, 'FHWC', np.float32, 3, 5),
+        ('gpu', 4, 'FCHW', np.uint8, 1, 9),
+        ('cpu', 32, 'HWC', np.uint8, 3, 9),
+        ('cpu', 32, 'CHW', np.float32, 4, 5),
+        ('cpu', 32, 'HWC', np.uint16, 1, 5),
+        ('cpu', 4, 'FHWC', np.float32, 3, 5),
+        ('cpu', 4, 'FCHW', np.uint8, 1, 9),
+        ('cpu', 8, 'HWC', np.uint8, 1, 15))
+def test_median_blur_vs_ocv(device, bs, layout, dtype, channels, max_ksize):
     cdim = layout.find('C')
     min_shape = [64 for c in layout]
     min_shape[cdim] = channels
@@ -100,16 +106,19 @@ def test_median_blur_vs_ocv(bs, layout, dtype, channels, max_ksize):
                                                   max_shape=max_shape, dtype=dtype, seed=SEED)
     ksize1 = ksize_src(bs, 3, max_ksize, SEED)
     ksize2 = ksize_src(bs, 3, max_ksize, SEED)
-    pipe1 = median_blur_pipe(data_src=data1, layout=layout, ksize_src=ksize1,
+    pipe1 = median_blur_pipe(data_src=data1, layout=layout, ksize_src=ksize1, device=device,
                              batch_size=bs, prefetch_queue_depth=1)
     pipe2 = reference_pipe(data_src=data2, layout=layout, ksize_src=ksize2, batch_size=bs)
     test_utils.compare_pipelines(pipe1, pipe2, batch_size=bs, N_iterations=10)
 
 
-@params((32, 'HWC', np.uint8, 3, (7, 7)),
-        (32, 'CHW', np.float32, 4, 3),
-        (4, 'FCHW', np.uint8, 1, (9, 9)))
-def test_median_blur_const_ksize_vs_ocv(bs, layout, dtype, channels, ksize):
+@params(('gpu', 32, 'HWC', np.uint8, 3, (7, 7)),
+        ('gpu', 32, 'CHW', np.float32, 4, 3),
+        ('gpu', 4, 'FCHW', np.uint8, 1, (9, 9)),
+        ('cpu', 32, 'HWC', np.uint8, 3, (7, 7)),
+        ('cpu', 32, 'CHW', np.float32, 4, 3),
+        ('cpu', 4, 'FCHW', np.uint8, 1, (9, 9)))
+def test_median_blur_const_ksize_vs_ocv(device, bs, layout, dtype, channels, ksize):
     cdim = layout.find('C')
     min_shape = [64 for c in layout]
     min_shape[cdim] = channels
@@ -128,7 +137,7 @@ def test_median_blur_const_ksize_vs_ocv(bs, layout, dtype, channels, ksize):
     else:
         cv_ksize = ksize
     ksize1 = ksize_src(bs, cv_ksize, cv_ksize, SEED)
-    pipe1 = median_blur_cksize_pipe(data_src=data1, layout=layout, ksize=ksize,
+    pipe1 = median_blur_cksize_pipe(data_src=data1, layout=layout, ksize=ksize, device=device,
                                     batch_size=bs, prefetch_queue_depth=1)
     pipe2 = reference_pipe(data_src=data2, layout=layout, ksize_src=ksize1, batch_size=bs)
     test_utils.compare_pipelines(pipe1, pipe2, batch_size=bs, N_iterations=10)
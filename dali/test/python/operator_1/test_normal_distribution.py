@@ -19,6 +19,7 @@ import nvidia.dali.types as types
 import numpy as np
 import scipy.stats as st
 import random
+from nose_utils import assert_raises
 
 test_types = [types.INT8, types.INT16, types.INT32, types.FLOAT, types.FLOAT64]
 
@@ -179,3 +180,38 @@ def test_normal_distribution_empty_shapes():
             mean, stddev, False, None, niter, batch_size
         yield check_normal_distribution, device, dtype, None, False, False, \
             mean, stddev, False, lambda: random_shape_or_empty(max_shape), niter, batch_size
+
+
+def _philox_normal_pipe(num_threads, rng_engine="philox", device="cpu", shape=(300, 1000)):
+    pipe = Pipeline(batch_size=4, device_id=0, num_threads=num_threads, seed=1234)
+    with pipe:
+        pipe.set_outputs(fn.random.normal(device=device, shape=shape, rng_engine=rng_engine,
+                                          mean=10.0, stddev=2.0, seed=4321))
+    pipe.build()
+    return pipe
+
+
+def test_normal_distribution_philox():
+    pipes = [_philox_normal_pipe(num_threads) for num_threads in (1, 4)]
+    mt_pipe = _philox_normal_pipe(4, rng_engine="mt19937")
+    for _ in range(2):
+        out1, = pipes[0].run()
+        out4, = pipes[1].run()
+        mt_out, = mt_pipe.run()
+        for sample_idx in range(len(out1)):
+            sample = np.array(out1[sample_idx])
+            # the result doesn't depend on the number of threads
+            np.testing.assert_array_equal(sample, np.array(out4[sample_idx]))
+            # the engines produce different random streams
+            assert not np.array_equal(sample, np.array(mt_out[sample_idx]))
+            assert abs(np.mean(sample) - 10.0) < 0.05
+            assert abs(np.std(sample) - 2.0) < 0.05
+        # the samples and the iterations are not correlated
+        assert not np.array_equal(np.array(out1[0]), np.array(out1[1]))
+
+
+def test_rng_engine_errors():
+    with assert_raises(RuntimeError, glob="Unsupported random number generator engine"):
+        _philox_normal_pipe(1, rng_engine="xorshift")
+    with assert_raises(RuntimeError, glob="supported only by the CPU operators"):
+        _philox_normal_pipe(1, device="gpu")
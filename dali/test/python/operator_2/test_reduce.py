@@ -564,3 +564,33 @@ def test_std_dev_large_data():
                 axes = tuple(filter(lambda x: x >= 0,
                                     (i if axis_mask & (1 << i) else -1 for i in range(rank))))
                 yield _test_std_dev_large_data, rank, axes, device, layout
+
+
+@nottest
+def _test_reduce_outer_dim_split(reduction, shapes, axes, keep_dims):
+    # fewer samples than threads and a large, non-reduced outermost dimension - the CPU operator
+    # splits the samples along that dimension
+    batch_size = len(shapes)
+    rng = np.random.default_rng(4321)
+    data = [rng.uniform(-1, 1, size=shape).astype(np.float32) for shape in shapes]
+
+    pipe = Pipeline(batch_size=batch_size, num_threads=8, device_id=None)
+    input = fn.external_source(lambda: data, device='cpu')
+    reduce_fn = getattr(fn.reductions, reduction)
+    pipe.set_outputs(reduce_fn(input, axes=axes, keep_dims=keep_dims))
+    pipe.build()
+
+    np_fn = getattr(np, reduction)
+    out, = pipe.run()
+    for i in range(batch_size):
+        ref = np_fn(data[i].astype(np.float64), axis=axes, keepdims=keep_dims)
+        assert out[i].shape() == list(ref.shape)
+        assert np.allclose(out[i], ref, 1e-5, 1e-5)
+
+
+def test_reduce_outer_dim_split():
+    for reduction in ['sum', 'mean', 'min', 'max']:
+        for keep_dims in [False, True]:
+            yield _test_reduce_outer_dim_split, reduction, [(1003, 64), (1500, 48)], (1,), keep_dims
+            yield _test_reduce_outer_dim_split, reduction, [(777, 3, 50)], (1, 2), keep_dims
+            yield _test_reduce_outer_dim_split, reduction, [(777, 3, 50)], (-1,), keep_dims
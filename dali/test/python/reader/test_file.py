@@ -210,3 +210,47 @@ def test_invalid_number_of_shards():
     pipe = get_test_pipe()
     assert_raises(RuntimeError, pipe.build,
                   glob="The number of input samples: *, needs to be at least equal to the requested number of shards:*.")  # noqa: E501
+
+
+@pipeline_def(batch_size=4, device_id=None, num_threads=4)
+def file_index_pipe(shard_id=0, num_shards=1, **kwargs):
+    files, labels = fn.readers.file(shard_id=shard_id, num_shards=num_shards, **kwargs)
+    return files, labels, fn.get_property(files, key="source_info")
+
+
+def _test_file_index(source_kwargs, reader_kwargs):
+    from file2idx import IndexCreator
+    with tempfile.TemporaryDirectory() as idx_dir:
+        index = os.path.join(idx_dir, "index.fidx")
+        creator = IndexCreator(index, verbose=False)
+        if "file_list" in source_kwargs:
+            creator.from_file_list(source_kwargs["file_list"])
+            file_root = os.path.dirname(source_kwargs["file_list"])
+        else:
+            creator.from_directory(source_kwargs["file_root"])
+            file_root = source_kwargs["file_root"]
+        ref_pipe = file_index_pipe(**source_kwargs, **reader_kwargs)
+        pipe = file_index_pipe(file_index=index, file_root=file_root, **reader_kwargs)
+        compare_pipelines(ref_pipe, pipe, 4, 10)
+
+
+def test_file_index():
+    images_root = os.path.join(os.environ['DALI_EXTRA_PATH'], 'db/single/jpeg')
+    file_list = os.path.join(g_root, "index_list.txt")
+    with open(file_list, "w") as f:
+        for i, name in enumerate(g_files):
+            f.write("{0} {1}\n".format(name, 10000 - i))
+    for source_kwargs in [{"file_root": images_root}, {"file_list": file_list}]:
+        for reader_kwargs in [{}, {"random_shuffle": True, "initial_fill": 8},
+                              {"shuffle_after_epoch": True},
+                              {"shard_id": 1, "num_shards": 3},
+                              {"shard_id": 1, "num_shards": 3, "stick_to_shard": True}]:
+            yield _test_file_index, source_kwargs, reader_kwargs
+
+
+def test_file_index_exclusive_args():
+    with tempfile.NamedTemporaryFile() as index:
+        pipe = file_index_pipe(file_index=index.name, files=g_files)
+        with assert_raises(RuntimeError, glob="*only one of ``files``, ``file_list`` and "
+                                              "``file_index``*"):
+            pipe.build()
@@ -336,3 +336,77 @@ def test_conditionals():
     for pipe in [pipe_base, pipe_cond]:
         pipe.build()
     compare_pipelines(pipe_base, pipe_cond, 32, 5)
+
+
+def read_source_infos(pipe, num_shards, batch_size, num_epochs):
+    pipe.build()
+    shard_size = pipe.reader_meta("Reader")["epoch_size_padded"] // num_shards
+    iters = (shard_size + batch_size - 1) // batch_size
+    epochs = []
+    for _ in range(num_epochs):
+        infos = []
+        for _ in range(iters):
+            out, = pipe.run()
+            infos += [out[i].source_info() for i in range(len(out))]
+        # drop the padding
+        epochs.append(infos[:shard_size])
+    return epochs
+
+
+@cartesian_params(('tfrecord', 'mxnet'), (1, 3))
+def test_global_shuffle(reader, num_shards):
+    batch_size = 16
+    if reader == 'tfrecord':
+        reader_fn = fn.readers.tfrecord
+        path = os.path.join(get_dali_extra_path(), 'db', 'tfrecord', 'train')
+        reader_args = {
+            'path': path, 'index_path': path + '.idx',
+            'features': {'image/encoded': tfrec.FixedLenFeature((), tfrec.string, "")}}
+    else:
+        reader_fn = fn.readers.mxnet
+        path = os.path.join(get_dali_extra_path(), 'db', 'recordio', 'train')
+        reader_args = {'path': path + '.rec', 'index_path': path + '.idx'}
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4)
+    def pipe(shard_id, num_shards, global_shuffle, reader_seed=123):
+        seed_arg = {} if reader_seed is None else {'seed': reader_seed}
+        inputs = reader_fn(name="Reader", shard_id=shard_id, num_shards=num_shards,
+                           pad_last_batch=True, global_shuffle=global_shuffle,
+                           shuffle_block_size=4, shuffle_window_size=16, **seed_arg,
+                           **reader_args)
+        return inputs['image/encoded'] if reader == 'tfrecord' else inputs[0]
+
+    ref, = read_source_infos(pipe(0, 1, False), 1, batch_size, 1)
+
+    shards = [read_source_infos(pipe(shard_id, num_shards, True), num_shards, batch_size, 2)
+              for shard_id in range(num_shards)]
+    for epoch in range(2):
+        # the shards of each epoch cover the whole dataset
+        epoch_infos = sum([shard[epoch] for shard in shards], [])
+        assert sorted(set(epoch_infos)) == sorted(ref)
+    # the order changes between the epochs
+    assert shards[0][0] != shards[0][1]
+    assert shards[0][0] != ref[:len(shards[0][0])]
+    # the same seed gives the same order and a different one changes it
+    assert shards[0] == read_source_infos(pipe(0, num_shards, True), num_shards, batch_size, 2)
+    assert shards[0] != read_source_infos(pipe(0, num_shards, True, reader_seed=321),
+                                          num_shards, batch_size, 2)
+    # without the reader's seed, the order doesn't depend on the pipeline's seed, which differs
+    # between the processes of the shards when not set
+    unseeded = [read_source_infos(pipe(0, num_shards, True, reader_seed=None, seed=pipe_seed),
+                                  num_shards, batch_size, 2) for pipe_seed in (1, 2)]
+    assert unseeded[0] == unseeded[1]
+
+
+def test_global_shuffle_random_shuffle_conflict():
+    path = os.path.join(get_dali_extra_path(), 'db', 'recordio', 'train')
+
+    @pipeline_def(batch_size=1, device_id=0, num_threads=4)
+    def pipe():
+        data, _ = fn.readers.mxnet(path=path + '.rec', index_path=path + '.idx',
+                                   global_shuffle=True, random_shuffle=True)
+        return data
+
+    with assert_raises(RuntimeError,
+                       glob="*global_shuffle and random_shuffle cannot be both true*"):
+        pipe().build()
@@ -0,0 +1,145 @@
+# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import glob
+import numpy as np
+import nvidia.dali.fn as fn
+import os
+import tempfile
+from nvidia.dali import pipeline_def
+from nvidia.dali.experimental import persistent_cache
+
+from nose_utils import assert_raises
+from test_utils import get_dali_extra_path
+
+images_dir = os.path.join(get_dali_extra_path(), 'db', 'single', 'jpeg')
+batch_size = 8
+
+
+@pipeline_def(batch_size=batch_size, num_threads=4, device_id=None)
+def cached_pipe(path, size=64, random_shuffle=False, key=""):
+    jpegs, labels = fn.readers.file(file_root=images_dir, random_shuffle=random_shuffle,
+                                    name="Reader")
+    images = fn.decoders.image(jpegs, device="cpu")
+    images = fn.resize(images, size=size)
+    if path is not None:
+        images, labels = persistent_cache(images, labels, path=path, key=key)
+    return images, labels
+
+
+def run_epoch(pipe):
+    """Runs one epoch and returns the outputs indexed by the source info."""
+    pipe.build()
+    samples = {}
+    epoch_size = pipe.epoch_size("Reader")
+    for _ in range((epoch_size + batch_size - 1) // batch_size):
+        images, labels = pipe.run()
+        for i in range(len(images)):
+            samples[images[i].source_info()] = (np.array(images[i]), np.array(labels[i]),
+                                                images[i].layout())
+    assert len(samples) == epoch_size
+    return samples
+
+
+def fill_cache(path, **kwargs):
+    pipe = cached_pipe(path, **kwargs)
+    run_epoch(pipe)
+    # with random_shuffle, some samples of the epoch stay in the shuffling buffer of the reader
+    run_epoch(pipe)
+    # the cache is written when the writer is destroyed
+    del pipe
+    assert os.path.exists(path)
+
+
+def is_cache_reader(pipe):
+    if not pipe._py_graph_built:
+        pipe._build_graph()
+    return any(op.spec.name == "experimental__readers__PersistentCache" for op in pipe._ops)
+
+
+def check_outputs(random_shuffle):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "cache.dpc")
+        ref = run_epoch(cached_pipe(None))
+        fill_cache(path, random_shuffle=random_shuffle)
+        pipe = cached_pipe(path, random_shuffle=random_shuffle)
+        assert is_cache_reader(pipe)
+        for _ in range(2):
+            out = run_epoch(pipe)
+            assert out.keys() == ref.keys()
+            for src, (image, label, layout) in out.items():
+                ref_image, ref_label, ref_layout = ref[src]
+                np.testing.assert_array_equal(image, ref_image)
+                np.testing.assert_array_equal(label, ref_label)
+                assert layout == ref_layout
+
+
+def test_outputs():
+    for random_shuffle in [False, True]:
+        yield check_outputs, random_shuffle
+
+
+def test_invalidation():
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "cache.dpc")
+        fill_cache(path, size=64)
+        assert is_cache_reader(cached_pipe(path, size=64))
+        assert not is_cache_reader(cached_pipe(path, size=32))
+        assert not is_cache_reader(cached_pipe(path, size=64, key="v2"))
+
+
+def test_incomplete_epoch():
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "cache.dpc")
+        pipe = cached_pipe(path)
+        pipe.build()
+        pipe.run()
+        del pipe
+        assert not os.path.exists(path)
+        assert os.listdir(tmp_dir) == []
+
+
+def test_corrupted_file():
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "cache.dpc")
+        fill_cache(path)
+        with open(path, "r+b") as f:
+            f.seek(-40, os.SEEK_END)
+            byte = f.read(1)
+            f.seek(-40, os.SEEK_END)
+            f.write(bytes([byte[0] ^ 0xff]))
+        pipe = cached_pipe(path)
+        assert is_cache_reader(pipe)
+        with assert_raises(RuntimeError, glob="Corrupted persistent cache file"):
+            pipe.build()
+
+
+def test_duplicate_entries():
+    files = sorted(glob.glob(os.path.join(images_dir, "*", "*.jpg")))
+
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=None)
+    def pipe(path):
+        jpegs, labels = fn.readers.file(files=files + files[:1], name="Reader")
+        return persistent_cache(jpegs, labels, path=path)
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "cache.dpc")
+        p = pipe(path)
+        p.build()
+        epoch_size = p.epoch_size("Reader")
+        for _ in range(2 * ((epoch_size + batch_size - 1) // batch_size)):
+            p.run()
+        del p
+        # the duplicated sample is stored once, so the cache never reaches the epoch size
+        assert not os.path.exists(path)
@@ -13,6 +13,8 @@
 # limitations under the License.
 
 import os
+import shutil
+import tempfile
 from glob import glob
 import math
 import nvidia.dali as dali
@@ -451,3 +453,44 @@ def test_index_generation():
             test_batch_size,
             math.ceil(num_samples / num_shards / test_batch_size) * 2,
         )
+
+
+def test_save_generated_index():
+    num_samples = 3000
+    src_paths = [
+        os.path.join(get_dali_extra_path(), f"db/webdataset/MNIST/devel-{i}.tar") for i in range(3)
+    ]
+    index_files = [generate_temp_index_file(tar_file_path) for tar_file_path in src_paths]
+
+    @dali.pipeline_def(batch_size=test_batch_size, device_id=None, num_threads=4)
+    def generated_index_pipeline(paths):
+        return tuple(dali.fn.readers.webdataset(paths=paths, ext=["jpg", "cls"],
+                                                save_generated_index=True))
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        # the names differ only in the extensions, so the indices must not collide
+        tar_file_paths = [
+            shutil.copy(path, os.path.join(tmp_dir, f"devel.{i}.tar"))
+            for i, path in enumerate(src_paths)
+        ]
+        saved_index_paths = [path + ".idx" for path in tar_file_paths]
+        mtimes = None
+        for _ in range(2):
+            compare_pipelines(
+                generated_index_pipeline(tar_file_paths),
+                webdataset_raw_pipeline(
+                    tar_file_paths,
+                    [index_file.name for index_file in index_files],
+                    ["jpg", "cls"],
+                    batch_size=test_batch_size,
+                    device_id=0,
+                    num_threads=1,
+                ),
+                test_batch_size,
+                math.ceil(num_samples / test_batch_size),
+            )
+            assert all(os.path.exists(path) for path in saved_index_paths)
+            # the saved indices are reused in the subsequent runs
+            if mtimes is not None:
+                assert_equal(mtimes, [os.path.getmtime(path) for path in saved_index_paths])
+            mtimes = [os.path.getmtime(path) for path in saved_index_paths]
@@ -21,9 +21,11 @@ import nvidia.dali.tfrecord as tfrec
 import nvidia.dali.types as types
 import os
 import re
+import tempfile
 from collections.abc import Iterable
 from nose.plugins.attrib import attr
 from nose.tools import nottest
+from nvidia.dali.experimental import persistent_cache
 from nvidia.dali.pipeline import Pipeline, pipeline_def
 from nvidia.dali.pipeline.experimental import pipeline_def as experimental_pipeline_def
 from nvidia.dali.plugin.numba.fn.experimental import numba_function
@@ -258,6 +260,29 @@ def test_laplacian_cpu():
     check_single_input(fn.laplacian, window_size=5)
 
 
+def test_median_blur_cpu():
+    check_single_input(fn.experimental.median_blur, window_size=5)
+
+
+def test_remap_cpu():
+    def get_maps():
+        h, w = test_data_shape[:2]
+        mapx = [np.random.uniform(-1, w + 1, size=(h, w)).astype(np.float32)
+                for _ in range(batch_size)]
+        mapy = [np.random.uniform(-1, h + 1, size=(h, w)).astype(np.float32)
+                for _ in range(batch_size)]
+        return mapx, mapy
+
+    pipe = Pipeline(batch_size=batch_size, num_threads=3, device_id=None)
+    data = fn.external_source(source=get_data, layout="HWC")
+    mapx, mapy = fn.external_source(source=get_maps, num_outputs=2)
+    processed = fn.experimental.remap(data, mapx, mapy)
+    pipe.set_outputs(processed)
+    pipe.build()
+    for _ in range(3):
+        pipe.run()
+
+
 def test_crop_mirror_normalize_cpu():
     check_single_input(fn.crop_mirror_normalize)
 
@@ -695,6 +720,21 @@ def test_webdataset_reader_cpu():
                    ext=["jpg", "cls"], shard_id=0, num_shards=1)
 
 
+def test_persistent_cache_cpu():
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "cache.dpc")
+        for _ in range(2):  # write the cache, then read it
+            pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=None)
+            jpegs, labels = fn.readers.file(file_root=images_dir, name="Reader")
+            images = fn.decoders.image(jpegs, device="cpu")
+            pipe.set_outputs(*persistent_cache(images, labels, path=path))
+            pipe.build()
+            for _ in range(pipe.epoch_size("Reader") // batch_size + 2):
+                pipe.run()
+            del pipe
+            assert os.path.exists(path)
+
+
 def test_coco_reader_cpu():
     check_no_input(fn.readers.coco, file_root=coco_dir, annotations_file=coco_annotation,
                    shard_id=0, num_shards=1)
@@ -722,6 +762,11 @@ def test_video_reader():
                    sequence_length=10)
 
 
+def test_video_reader_resize():
+    check_no_input(fn.experimental.readers.video_resize, filenames=video_files, labels=[0, 1],
+                   sequence_length=10, resize_x=64, resize_y=48)
+
+
 def test_copy_cpu():
     check_single_input(fn.copy)
 
@@ -1249,7 +1294,10 @@ tested_methods = [
     "readers.coco",
     "readers.numpy",
     "readers.webdataset",
+    "experimental.persistent_cache_writer",
+    "experimental.readers.persistent_cache",
     "experimental.readers.video",
+    "experimental.readers.video_resize",
     "coin_flip",
     "uniform",
     "random.uniform",
@@ -1274,6 +1322,8 @@ tested_methods = [
     "experimental.tensor_resize",
     "gaussian_blur",
     "laplacian",
+    "experimental.median_blur",
+    "experimental.remap",
     "crop_mirror_normalize",
     "flip",
     "jpeg_compression_distortion",
@@ -1378,10 +1428,8 @@ excluded_methods = [
     "experimental.debayer",  # not supported for CPU
     "experimental.equalize",  # not supported for CPU
     "experimental.filter",  # not supported for CPU
-    "experimental.inflate",  # not supported for CPU
-    "experimental.remap",  # operator is GPU-only
+    "experimental.inflate",  # CPU support depends on the build options
     "experimental.readers.fits",  # lacking test files in DALI_EXTRA
-    "experimental.median_blur"  # not supported for CPU
 ]
 
 
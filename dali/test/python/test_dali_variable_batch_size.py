@@ -341,7 +341,7 @@ ops_image_custom_args = [
         'setup_fn': numba_setup_out_shape
         }),
     (fn.multi_paste, {'in_ids': np.zeros([31], dtype=np.int32), 'output_size': [300, 300, 3]}),
-    (fn.experimental.median_blur, {'devices': ['gpu']})
+    (fn.experimental.median_blur, {'devices': ['cpu', 'gpu']})
 ]
 
 
@@ -709,7 +709,7 @@ def test_remap():
         return input, mapx, mapy
 
     input_data = [get_data(random.randint(5, 31)) for _ in range(13)]
-    check_pipeline(input_data, pipeline_fn=pipe, devices=['gpu'])
+    check_pipeline(input_data, pipeline_fn=pipe, devices=['cpu', 'gpu'])
 
 
 def test_random_bbox_crop_op():
@@ -1554,8 +1554,12 @@ excluded_methods = [
     "experimental.inputs.video",     # Input batch_size of inputs.video is always 1 and output
                                      # batch_size varies and is tested in this operator's test.
     "experimental.readers.video",    # readers do not support variable batch size yet
+    "experimental.readers.video_resize",  # readers do not support variable batch size yet
     "experimental.audio_resample",   # Alias of audio_resample (already tested)
     "experimental.readers.fits",     # readers do not support variable batch size yet
+    "experimental.readers.persistent_cache",  # readers do not support variable batch size yet
+    "experimental.persistent_cache_writer",   # requires the samples of a reader, tested
+                                              # together with the cache reader
 ]
 
 
@@ -0,0 +1,59 @@
+# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+from numpy.testing import assert_array_equal
+from test_utils import get_dali_extra_path
+
+seed = 1549361629
+
+img_root = get_dali_extra_path()
+image_dir = img_root + "/db/single/jpeg"
+batch_size = 20
+
+
+@pipeline_def(batch_size=batch_size, num_threads=4, device_id=None, seed=seed)
+def host_decoder_pipe(cache_size, cache_type=None, skip_cached_images=False):
+    jpegs, labels = fn.readers.file(file_root=image_dir, name="Reader",
+                                    skip_cached_images=skip_cached_images)
+    images = fn.decoders.image(jpegs, device="cpu", output_type=types.RGB,
+                               cache_size=cache_size, cache_type=cache_type, cache_threshold=0)
+    return images, labels
+
+
+def check_host_decoder_cached(cache_type, skip_cached_images):
+    ref_pipe = host_decoder_pipe(0)
+    ref_pipe.build()
+    cached_pipe = host_decoder_pipe(100, cache_type, skip_cached_images)
+    cached_pipe.build()
+    epoch_size = ref_pipe.epoch_size("Reader")
+
+    # the "largest" policy starts caching in the second epoch - the third one reads the cache
+    for i in range(3 * ((epoch_size + batch_size - 1) // batch_size)):
+        ref_images, ref_labels = ref_pipe.run()
+        out_images, out_labels = cached_pipe.run()
+        for j in range(batch_size):
+            assert_array_equal(ref_labels.at(j), out_labels.at(j))
+            assert_array_equal(ref_images.at(j), out_images.at(j),
+                               "cached and non-cached images differ")
+    # the cache is shared by the decoders of the process - release it before the next test case
+    del cached_pipe
+
+
+def test_host_decoder_cached():
+    for cache_type in ["threshold", "largest"]:
+        for skip_cached_images in [False, True]:
+            yield check_host_decoder_cached, cache_type, skip_cached_images
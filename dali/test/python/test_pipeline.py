@@ -1510,6 +1510,130 @@ def test_executor_meta():
             assert calc_avg_max(v["reserved_memory_size"]) == v["max_reserved_memory_size"]
 
 
+def test_operator_profile():
+    batch_size = 10
+    iters = 3
+
+    def get_data():
+        return [np.full((16, 16, 3), 42, dtype=np.uint8) for _ in range(batch_size)]
+
+    pipe = Pipeline(batch_size, 2, None, exec_async=False, exec_pipelined=False,
+                    enable_operator_profiling=True)
+    with pipe:
+        data = fn.external_source(source=get_data, name="data")
+        flipped = fn.flip(data, horizontal=True, name="flipped")
+        pipe.set_outputs(flipped)
+    pipe.build()
+    for _ in range(iters):
+        pipe.run()
+    profile = pipe.operator_profile()
+    flip_profile = profile["CPU_flipped"]
+    assert flip_profile["iterations"] == iters
+    assert flip_profile["samples"] == iters * batch_size
+    assert flip_profile["bytes"] == iters * batch_size * 16 * 16 * 3
+    assert flip_profile["run_time"] > 0
+    assert flip_profile["queue_wait_time"] == 0
+    # the wait for the queues is reported once per stage, not for each operator
+    assert "CPU" in profile and "GPU" not in profile
+    assert profile["CPU"]["iterations"] == iters
+    for v in profile.values():
+        for key in ["setup_time", "run_time", "thread_pool_busy_time", "queue_wait_time"]:
+            assert v[key] >= 0
+
+    no_profiling_pipe = Pipeline(batch_size, 2, None)
+    with no_profiling_pipe:
+        no_profiling_pipe.set_outputs(fn.external_source(source=get_data))
+    no_profiling_pipe.build()
+    no_profiling_pipe.run()
+    assert no_profiling_pipe.operator_profile() == {}
+
+
+def test_parallel_cpu_ops():
+    batch_size = 8
+
+    def make_pipe(parallel):
+        rng = np.random.default_rng(1234)
+
+        def get_data():
+            return [rng.integers(0, 255, (20, 30, 3), dtype=np.uint8) for _ in range(batch_size)]
+
+        pipe = Pipeline(batch_size, 4, None, seed=42, exec_async=False, exec_pipelined=False,
+                        enable_parallel_cpu_ops=parallel)
+        with pipe:
+            # no layout - the consumers set their default layouts on the shared input
+            data = fn.external_source(source=get_data)
+            flipped = fn.flip(data, horizontal=True)
+            angle = fn.random.uniform(range=(-30, 30))
+            rotated = fn.rotate(data, angle=angle, fill_value=0)
+            bright = fn.brightness(data, brightness=fn.random.uniform(range=(0.5, 1.5)))
+            mirrored = fn.crop_mirror_normalize(bright, mirror=fn.random.coin_flip(),
+                                                dtype=types.UINT8, output_layout="HWC")
+            pipe.set_outputs(flipped, rotated, mirrored, angle)
+        return pipe
+
+    compare_pipelines(make_pipe(False), make_pipe(True), batch_size=batch_size, N_iterations=4)
+
+
+def test_sample_streaming():
+    batch_size = 8
+
+    def make_pipe(streaming):
+        rng = np.random.default_rng(1234)
+
+        def get_images():
+            return [rng.integers(0, 255, (rng.integers(10, 30), 20, 3), dtype=np.uint8)
+                    for _ in range(batch_size)]
+
+        def get_boxes():
+            return [rng.random((4, 4), dtype=np.float32) for _ in range(batch_size)]
+
+        pipe = Pipeline(batch_size, 4, None, exec_async=False, exec_pipelined=False,
+                        enable_sample_streaming=streaming, enable_operator_profiling=True)
+        with pipe:
+            images = fn.external_source(source=get_images, layout="HWC")
+            # the operators process the samples separately - they form a chain
+            flipped = fn.flip(images, horizontal=True, name="flip1")
+            flipped = fn.flip(flipped, vertical=True, horizontal=fn.random.coin_flip(seed=42),
+                              name="flip2")
+            boxes = fn.external_source(source=get_boxes)
+            pasted = fn.bbox_paste(boxes, ltrb=True, ratio=2, paste_x=0.25, paste_y=0.75,
+                                   name="paste1")
+            pasted = fn.bbox_paste(pasted, ltrb=True, ratio=1.5, paste_x=0.5, paste_y=0.5,
+                                   name="paste2")
+            pipe.set_outputs(flipped, pasted)
+        return pipe
+
+    streaming_pipe = make_pipe(True)
+    # the first iteration is never streamed - the operators are recognized when they run
+    compare_pipelines(make_pipe(False), streaming_pipe, batch_size=batch_size, N_iterations=4)
+    profile = streaming_pipe.operator_profile()
+    for name in ["flip1", "flip2", "paste1", "paste2"]:
+        assert profile["CPU_" + name]["streamed_iterations"] > 0, profile
+
+
+def test_sample_streaming_reader():
+    batch_size = 4
+
+    def make_pipe(streaming):
+        pipe = Pipeline(batch_size, 4, None, exec_async=False, exec_pipelined=False,
+                        enable_sample_streaming=streaming, enable_operator_profiling=True)
+        with pipe:
+            # the reader overrides Run and must not be streamed into the decoder
+            jpegs, labels = fn.readers.file(file_root=jpeg_folder, seed=42, name="reader")
+            images = fn.decoders.image(jpegs, device="cpu", name="decoder")
+            images = fn.resize_crop_mirror(images, resize_shorter=64, crop=(48, 48), name="rcm")
+            # flip infers its output shapes - it can't follow resize_crop_mirror in the chain
+            pipe.set_outputs(fn.flip(images, name="flip"), labels)
+        return pipe
+
+    streaming_pipe = make_pipe(True)
+    compare_pipelines(make_pipe(False), streaming_pipe, batch_size=batch_size, N_iterations=4)
+    profile = streaming_pipe.operator_profile()
+    streamed = {k: v["streamed_iterations"] for k, v in profile.items()}
+    assert streamed["CPU_reader"] == 0 and streamed["CPU_flip"] == 0, profile
+    assert streamed["CPU_decoder"] > 0 and streamed["CPU_rcm"] > 0, profile
+
+
 def test_bytes_per_sample_hint():
     import nvidia.dali.backend
     if nvidia.dali.backend.RestrictPinnedMemUsage():
@@ -172,6 +172,9 @@ if [ "$BUILD_INHOST" == "YES" ]; then
                                         BUILD_CFITSIO=${BUILD_CFITSIO}            \
                                         BUILD_CUFILE=${BUILD_CUFILE}              \
                                         BUILD_NVCOMP=${BUILD_NVCOMP}              \
+                                        BUILD_LZ4=${BUILD_LZ4}                    \
+                                        BUILD_ZSTD=${BUILD_ZSTD}                  \
+                                        BUILD_ZLIB=${BUILD_ZLIB}                  \
                                         LINK_DRIVER=${LINK_DRIVER}                \
                                         WITH_DYNAMIC_CUDA_TOOLKIT=${WITH_DYNAMIC_CUDA_TOOLKIT} \
                                         WITH_DYNAMIC_NVJPEG=${WITH_DYNAMIC_NVJPEG:-ON} \
@@ -220,6 +223,9 @@ else
                                    --build-arg "BUILD_CFITSIO=${BUILD_CFITSIO}"            \
                                    --build-arg "BUILD_CUFILE=${BUILD_CUFILE}"              \
                                    --build-arg "BUILD_NVCOMP=${BUILD_NVCOMP}"              \
+                                   --build-arg "BUILD_LZ4=${BUILD_LZ4}"                    \
+                                   --build-arg "BUILD_ZSTD=${BUILD_ZSTD}"                  \
+                                   --build-arg "BUILD_ZLIB=${BUILD_ZLIB}"                  \
                                    --build-arg "LINK_DRIVER=${LINK_DRIVER}"                \
                                    --build-arg "WITH_DYNAMIC_CUDA_TOOLKIT=${WITH_DYNAMIC_CUDA_TOOLKIT}"\
                                    --build-arg "WITH_DYNAMIC_NVJPEG"=${WITH_DYNAMIC_NVJPEG:-ON} \
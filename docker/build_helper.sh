@@ -48,6 +48,10 @@ export BUILD_CFITSIO=${BUILD_CFITSIO:-ON}
 export BUILD_CVCUDA=${BUILD_CVCUDA:-ON}
 export BUILD_CUFILE=${BUILD_CUFILE:-OFF}
 export BUILD_NVCOMP=${BUILD_NVCOMP:-OFF}
+# zstd and zlib come with the dependencies image, lz4 is used when it is found
+export BUILD_LZ4=${BUILD_LZ4}
+export BUILD_ZSTD=${BUILD_ZSTD:-ON}
+export BUILD_ZLIB=${BUILD_ZLIB:-ON}
 export LINK_LIBCUDA=${LINK_LIBCUDA:-OFF}
 export WITH_DYNAMIC_CUDA_TOOLKIT=${WITH_DYNAMIC_CUDA_TOOLKIT:-OFF}
 export WITH_DYNAMIC_NVJPEG=${WITH_DYNAMIC_NVJPEG:-ON}
@@ -98,6 +102,9 @@ cmake ../ -DCMAKE_INSTALL_PREFIX=.                 \
       -DBUILD_CFITSIO=${BUILD_CFITSIO}             \
       -DBUILD_CUFILE=${BUILD_CUFILE}               \
       -DBUILD_NVCOMP=${BUILD_NVCOMP}               \
+      -DBUILD_LZ4=${BUILD_LZ4}                     \
+      -DBUILD_ZSTD=${BUILD_ZSTD}                   \
+      -DBUILD_ZLIB=${BUILD_ZLIB}                   \
       -DBUILD_CVCUDA=${BUILD_CVCUDA}               \
       -DLINK_LIBCUDA=${LINK_LIBCUDA}               \
       -DWITH_DYNAMIC_CUDA_TOOLKIT=${WITH_DYNAMIC_CUDA_TOOLKIT} \
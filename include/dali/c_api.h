@@ -85,6 +85,21 @@ typedef struct {
   size_t *max_reserved;        // the biggest reserved memory size for the tensor in the batch
 } daliExecutorMetadata;
 
+/*
+ * Need to keep that in sync with ExecutorOpProfile from executor.h
+ */
+typedef struct {
+  char *operator_name;            // operator name, user need to free the memory
+  size_t iterations;              // number of the iterations profiled
+  int64_t setup_time_ns;          // total wall time of the operator's Setup
+  int64_t run_time_ns;            // total wall time of the operator's Run
+  int64_t thread_pool_busy_ns;    // total time of the thread pool work (CPU operators only)
+  int64_t queue_wait_ns;          // total time the stage waited for the queues (stages only)
+  size_t streamed_iterations;     // number of the iterations run in a chain of streamed operators
+  size_t samples;                 // number of samples produced
+  size_t bytes;                   // number of bytes produced
+} daliOperatorProfile;
+
 /**
  * @brief DALI initialization
  *
@@ -652,6 +667,40 @@ DLL_PUBLIC void daliGetExecutorMetadata(daliPipelineHandle *pipe_handle,
 DLL_PUBLIC void daliFreeExecutorMetadata(daliExecutorMetadata *operator_meta,
                                          size_t operator_meta_num);
 
+/**
+ * @brief Enables or disables the per-operator profiling.
+ *
+ * When enabled, the executor accumulates the timings and the output sizes of each operator,
+ * which can be obtained with `daliGetOperatorProfile`.
+ * @param enable 1 to enable the profiling, 0 to disable it
+ */
+DLL_PUBLIC void daliEnableOperatorProfiling(daliPipelineHandle *pipe_handle, int enable);
+
+/**
+ * @brief Obtains the per-operator profile, accumulated over the iterations run with
+ *        the profiling enabled
+ *  @param operator_profile Pointer to the memory allocated by the function with
+ *                          operator_profile_num entries. To free the returned profile use
+ *                          `daliFreeOperatorProfile` function
+ *  @param operator_profile_num Pointer to the variable which will tell how many entries
+ *                              (operators) have been filled
+ *
+ * The entries named after a stage ("CPU", "MIXED" or "GPU") describe the stage itself:
+ * they hold only the number of the iterations and `queue_wait_ns`, the time the stage waited
+ * for the queues, which is shared by all of its operators.
+ */
+DLL_PUBLIC void daliGetOperatorProfile(daliPipelineHandle *pipe_handle,
+                                       daliOperatorProfile **operator_profile,
+                                       size_t *operator_profile_num);
+
+/**
+ * @brief Frees the profile obtained from daliGetOperatorProfile
+ *  @param operator_profile Pointer to the memory allocated by `daliGetOperatorProfile`
+ *  @param operator_profile_num Number of entries provided by `daliGetOperatorProfile`
+ */
+DLL_PUBLIC void daliFreeOperatorProfile(daliOperatorProfile *operator_profile,
+                                        size_t operator_profile_num);
+
 /**
  * @brief Frees unused memory from memory pools.
  *
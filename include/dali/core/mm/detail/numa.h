@@ -0,0 +1,72 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_DETAIL_NUMA_H_
+#define DALI_CORE_MM_DETAIL_NUMA_H_
+
+#include <cstddef>
+#include <vector>
+#include "dali/core/api_helper.h"
+
+namespace dali {
+namespace mm {
+namespace detail {
+
+/**
+ * @brief Assignment of the CPUs to NUMA nodes
+ *
+ * The topology is read from sysfs, so that DALI doesn't need to depend on libnuma.
+ * If it's not available, all CPUs are assumed to belong to node 0.
+ */
+struct DLL_PUBLIC cpu_topology {
+  /// The number of CPUs, including the ones which are offline
+  int num_cpus = 1;
+  int num_nodes = 1;
+  /// The NUMA node of each CPU, indexed with CPU id
+  std::vector<int> cpu_node;
+
+  int node_of(int cpu) const noexcept {
+    return cpu >= 0 && cpu < static_cast<int>(cpu_node.size()) ? cpu_node[cpu] : 0;
+  }
+
+  static const cpu_topology &get();
+};
+
+/**
+ * @brief Returns the CPU on which the calling thread is running or 0, if it cannot be determined
+ *
+ * The thread may be migrated to another CPU at any time - the value is a hint.
+ */
+DLL_PUBLIC int current_cpu() noexcept;
+
+/**
+ * @brief Asks the OS to place the (not yet touched) pages of the memory range on given node.
+ *
+ * Only the pages which are completely contained in the range are affected.
+ * This is a best-effort operation - the errors are ignored.
+ */
+DLL_PUBLIC void prefer_numa_node(void *ptr, size_t bytes, int node) noexcept;
+
+/**
+ * @brief Parses a list of CPUs (or nodes) in the format used by sysfs, e.g. "0-3,8,10-11"
+ *
+ * @return The list of the values or an empty list if the text is not a valid list.
+ */
+DLL_PUBLIC std::vector<int> parse_cpu_list(const char *text);
+
+}  // namespace detail
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_DETAIL_NUMA_H_
@@ -0,0 +1,350 @@
+// Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_NUMA_CACHED_RESOURCE_H_
+#define DALI_CORE_MM_NUMA_CACHED_RESOURCE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/mm/malloc_resource.h"
+#include "dali/core/mm/pool_resource.h"
+#include "dali/core/mm/detail/numa.h"
+#include "dali/core/spinlock.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace mm {
+
+struct numa_cache_options {
+  /// Larger allocations bypass the CPU caches and go directly to the NUMA node's pool
+  size_t max_cached_size = 1 << 20;
+  /// Maximum total size of the blocks of one size class kept in one CPU's cache
+  size_t max_bin_bytes = 1 << 20;
+  /// Maximum number of blocks of one size class kept in one CPU's cache
+  int max_bin_count = 64;
+  /// Options of the per-node pools
+  pool_options pool = default_host_pool_opts();
+};
+
+/**
+ * @brief A host memory resource with per-CPU caches of small blocks in front of per-NUMA-node
+ *        memory pools.
+ *
+ * The allocations which fit in one of the size classes are served from a free list
+ * of the CPU on which the calling thread runs. Each CPU's cache has its own lock, which is
+ * normally taken only by the thread currently running on that CPU, so the threads don't contend
+ * for a single lock of a shared pool. The cache misses and the larger allocations are served by
+ * the pool of the NUMA node of the current CPU.
+ *
+ * The memory of the node pools is requested from the upstream in large blocks, which are
+ * (on multi-node systems) bound to the node with a best-effort "preferred" policy. The blocks
+ * are always returned to the pool which they come from, even when freed on another node.
+ *
+ * The size classes are spaced at 1/4 of a power of two, so the cached blocks are at most
+ * 25% larger than requested. The alignment of a cached block is the largest power of two
+ * which divides the size of the class, up to kMaxClassAlignment - an allocation with a larger
+ * alignment is served directly by the node pool.
+ */
+class numa_cached_resource : public host_memory_resource,
+                             public pool_resource_base<memory_kind::host> {
+ public:
+  static constexpr int kMinClassLog2 = 6;
+  static constexpr size_t kMinClassSize = 1 << kMinClassLog2;
+  static constexpr size_t kMaxClassAlignment = 256;
+
+  /**
+   * @param upstream  the resource which provides the memory for the node pools
+   * @param opt       the cache and pool options
+   * @param topology  the assignment of the CPUs to the nodes; by default, the one of the host
+   */
+  explicit numa_cached_resource(
+      host_memory_resource *upstream = &malloc_memory_resource::instance(),
+      const numa_cache_options &opt = {},
+      const detail::cpu_topology &topology = detail::cpu_topology::get())
+  : upstream_(upstream), options_(opt), topology_(topology) {
+    assert(upstream_);
+    num_classes_ = size_class(std::max(opt.max_cached_size, kMinClassSize)) + 1;
+    options_.max_cached_size = class_size(num_classes_ - 1);
+    bin_limit_.resize(num_classes_);
+    for (int cls = 0; cls < num_classes_; cls++) {
+      size_t limit = std::min<size_t>(opt.max_bin_count, opt.max_bin_bytes / class_size(cls));
+      bin_limit_[cls] = std::max<int>(limit, 2);
+    }
+
+    caches_.reset(new cpu_cache[topology_.num_cpus]);
+    for (int cpu = 0; cpu < topology_.num_cpus; cpu++)
+      caches_[cpu].bins.reset(new bin[num_classes_]);
+
+    pool_options pool_opt = opt.pool;
+    // page-aligned upstream blocks can be bound to a node as a whole
+    pool_opt.upstream_alignment = std::max<size_t>(pool_opt.upstream_alignment, 4096);
+    pool_opt.max_upstream_alignment = std::max<size_t>(pool_opt.max_upstream_alignment, 4096);
+    for (int node = 0; node < topology_.num_nodes; node++)
+      nodes_.push_back(std::make_unique<node_data>(this, node, pool_opt));
+  }
+
+  numa_cached_resource(const numa_cached_resource &) = delete;
+  numa_cached_resource(numa_cached_resource &&) = delete;
+
+  int num_nodes() const noexcept {
+    return topology_.num_nodes;
+  }
+
+  const numa_cache_options &options() const noexcept {
+    return options_;
+  }
+
+  /**
+   * @brief Returns the blocks kept in the CPU caches to the node pools.
+   */
+  void flush_caches() {
+    for (int cpu = 0; cpu < topology_.num_cpus; cpu++) {
+      cpu_cache &cache = caches_[cpu];
+      for (int cls = 0; cls < num_classes_; cls++) {
+        free_block *blocks;
+        {
+          std::lock_guard<spinlock> guard(cache.lock);
+          bin &b = cache.bins[cls];
+          blocks = b.head;
+          b.head = nullptr;
+          b.count = 0;
+        }
+        release_blocks(blocks, cls);
+      }
+    }
+  }
+
+  /**
+   * @brief Flushes the CPU caches and returns the completely free blocks of the node pools
+   *        to the upstream resource.
+   */
+  void release_unused() override {
+    flush_caches();
+    for (auto &node : nodes_)
+      node->pool.release_unused();
+  }
+
+  void *try_allocate_from_free(size_t bytes, size_t alignment) override {
+    return current_pool().try_allocate_from_free(bytes, alignment);
+  }
+
+  /**
+   * @brief Returns the index of the size class to which an allocation of `bytes` belongs.
+   *
+   * The size of the class is the smallest number of the form (4 + k) * 2^(n - 2), k = 1..4,
+   * that's not less than `bytes`, or kMinClassSize.
+   */
+  static constexpr int size_class(size_t bytes) noexcept {
+    if (bytes <= kMinClassSize)
+      return 0;
+    int e = 63 - __builtin_clzll(bytes - 1);  // 2^e < bytes <= 2^(e+1)
+    size_t step = size_t(1) << (e - 2);
+    int sub = (bytes - (size_t(1) << e) + step - 1) >> (e - 2);
+    return (e - kMinClassLog2) * 4 + sub;
+  }
+
+  static constexpr size_t class_size(int cls) noexcept {
+    if (cls == 0)
+      return kMinClassSize;
+    int e = kMinClassLog2 + (cls - 1) / 4;
+    int sub = (cls - 1) % 4 + 1;
+    return (size_t(1) << e) + (size_t(sub) << (e - 2));
+  }
+
+  static constexpr size_t class_alignment(int cls) noexcept {
+    size_t size = class_size(cls);
+    return std::min(size & -size, kMaxClassAlignment);
+  }
+
+ private:
+  struct free_block {
+    free_block *next;
+  };
+
+  struct bin {
+    free_block *head = nullptr;
+    int count = 0;
+  };
+
+  /// The cache of one CPU; aligned to avoid false sharing of the locks
+  struct alignas(64) cpu_cache {
+    spinlock lock;
+    std::unique_ptr<bin[]> bins;
+  };
+
+  /**
+   * @brief Allocates the blocks of a node pool and records which node they belong to.
+   */
+  class node_upstream : public host_memory_resource {
+   public:
+    node_upstream(numa_cached_resource *owner, int node) : owner_(owner), node_(node) {}
+
+   private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+      void *ptr = owner_->upstream_->allocate(bytes, alignment);
+      if (owner_->num_nodes() > 1) {
+        detail::prefer_numa_node(ptr, bytes, node_);
+        try {
+          std::lock_guard<std::shared_mutex> guard(owner_->chunks_lock_);
+          owner_->chunks_.emplace(static_cast<char *>(ptr), chunk{ bytes, node_ });
+        } catch (...) {
+          owner_->upstream_->deallocate(ptr, bytes, alignment);
+          throw;
+        }
+      }
+      return ptr;
+    }
+
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+      if (owner_->num_nodes() > 1) {
+        std::lock_guard<std::shared_mutex> guard(owner_->chunks_lock_);
+        owner_->chunks_.erase(static_cast<char *>(ptr));
+      }
+      owner_->upstream_->deallocate(ptr, bytes, alignment);
+    }
+
+    numa_cached_resource *owner_;
+    int node_;
+  };
+
+  using node_pool_t = pool_resource<mm::memory_kind::host, coalescing_free_tree, spinlock>;
+
+  struct node_data {
+    node_data(numa_cached_resource *owner, int node, const pool_options &opt)
+    : upstream(owner, node), pool(&upstream, opt) {}
+
+    node_upstream upstream;
+    node_pool_t pool;
+  };
+
+  struct chunk {
+    size_t bytes;
+    int node;
+  };
+
+  int current_cpu() const noexcept {
+    int cpu = detail::current_cpu();
+    return cpu < topology_.num_cpus ? cpu : cpu % topology_.num_cpus;
+  }
+
+  node_pool_t &current_pool() {
+    return nodes_[topology_.node_of(current_cpu())]->pool;
+  }
+
+  /**
+   * @brief Finds the node pool which owns the memory block
+   */
+  node_pool_t &owner_pool(void *ptr) {
+    if (nodes_.size() == 1)
+      return nodes_[0]->pool;
+    std::shared_lock<std::shared_mutex> guard(chunks_lock_);
+    auto it = chunks_.upper_bound(static_cast<char *>(ptr));
+    assert(it != chunks_.begin());
+    --it;
+    assert(static_cast<char *>(ptr) < it->first + it->second.bytes);
+    return nodes_[it->second.node]->pool;
+  }
+
+  bool is_cached(size_t bytes, size_t alignment) const noexcept {
+    return alignment <= kMaxClassAlignment &&
+           align_up(bytes, alignment) <= options_.max_cached_size;
+  }
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (!bytes)
+      return nullptr;
+    int cpu = current_cpu();
+    if (!is_cached(bytes, alignment))
+      return nodes_[topology_.node_of(cpu)]->pool.allocate(bytes, alignment);
+
+    // Rounding up to the alignment results in a class whose size is a multiple of the alignment
+    int cls = size_class(align_up(bytes, alignment));
+    cpu_cache &cache = caches_[cpu];
+    {
+      std::lock_guard<spinlock> guard(cache.lock);
+      bin &b = cache.bins[cls];
+      if (free_block *blk = b.head) {
+        b.head = blk->next;
+        b.count--;
+        return blk;
+      }
+    }
+    return nodes_[topology_.node_of(cpu)]->pool.allocate(class_size(cls), class_alignment(cls));
+  }
+
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    if (!ptr)
+      return;
+    if (!is_cached(bytes, alignment)) {
+      owner_pool(ptr).deallocate(ptr, bytes, alignment);
+      return;
+    }
+
+    int cls = size_class(align_up(bytes, alignment));
+    cpu_cache &cache = caches_[current_cpu()];
+    free_block *excess = nullptr;
+    {
+      std::lock_guard<spinlock> guard(cache.lock);
+      bin &b = cache.bins[cls];
+      auto *blk = static_cast<free_block *>(ptr);
+      blk->next = b.head;
+      b.head = blk;
+      if (++b.count > bin_limit_[cls]) {
+        // The bin is full - keep half of it and return the rest to the pools
+        int keep = bin_limit_[cls] / 2;
+        free_block *last = b.head;
+        for (int i = 1; i < keep; i++)
+          last = last->next;
+        excess = last->next;
+        last->next = nullptr;
+        b.count = keep;
+      }
+    }
+    release_blocks(excess, cls);
+  }
+
+  void release_blocks(free_block *blocks, int cls) {
+    size_t size = class_size(cls);
+    size_t alignment = class_alignment(cls);
+    while (blocks) {
+      free_block *next = blocks->next;
+      owner_pool(blocks).deallocate(blocks, size, alignment);
+      blocks = next;
+    }
+  }
+
+  host_memory_resource *upstream_;
+  numa_cache_options options_;
+  detail::cpu_topology topology_;
+  int num_classes_ = 0;
+  std::vector<int> bin_limit_;
+  std::unique_ptr<cpu_cache[]> caches_;
+
+  // The chunks must outlive the node pools, which unregister their blocks on destruction
+  std::shared_mutex chunks_lock_;
+  std::map<char *, chunk> chunks_;
+  std::vector<std::unique_ptr<node_data>> nodes_;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_NUMA_CACHED_RESOURCE_H_
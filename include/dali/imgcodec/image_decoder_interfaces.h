@@ -39,6 +39,13 @@ struct DecodeParams {
   DALIImageType format  = DALI_RGB;
   bool          planar  = false;
   bool          use_orientation = true;
+  /**
+   * @brief The minimum size (height, width) of the decoded image, after orientation.
+   *
+   * If not empty, JPEG images are downscaled while decoding (by a factor of 2, 4 or 8), as long
+   * as they remain at least this large. See `DecodeScale`.
+   */
+  TensorShape<> hint_size;
 };
 
 /**
@@ -0,0 +1,154 @@
+#!/usr/bin/python3
+# Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+import array
+import fnmatch
+import os
+import re
+import struct
+import sys
+import time
+
+# Must match dali/operators/reader/loader/file_index.h
+MAGIC = b"DALIFIDX"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQQ")  # magic, version, reserved, number of files, blob size
+
+# Must match kKnownExtensionsGlob in dali/operators/reader/loader/utils.h
+KNOWN_EXTENSIONS_GLOB = [
+    "*.jpg", "*.jpeg", "*.png", "*.bmp", "*.tif", "*.tiff", "*.pnm", "*.ppm", "*.pgm", "*.pbm",
+    "*.jp2", "*.webp", "*.flac", "*.ogg", "*.wav"
+]
+
+
+class IndexCreator:
+    """Creates a binary file index for the use with the `fn.readers.file`.
+
+    The (file, label) pairs are listed in the same way and in the same order as `fn.readers.file`
+    lists them when given `file_root` or `file_list`.
+
+    Example usage:
+    ----------
+    >> IndexCreator("data/index.fidx", verbose=False).from_directory("data/train")
+
+    Parameters
+    ----------
+    idx_path : str
+        Path to the index file, that will be created/overwritten.
+    """
+
+    report_step = 1000000
+
+    def __init__(self, idx_path, verbose=True):
+        self.idx_path = idx_path
+        self.verbose = verbose
+        self.start_time = time.time()
+
+    def _report(self, count, stage):
+        if self.verbose:
+            print(f"time: {time.time() - self.start_time:.2f} count: {count} stage: {stage}")
+
+    def from_directory(self, file_root, file_filters=KNOWN_EXTENSIONS_GLOB,
+                       case_sensitive_filter=False):
+        """Indexes the files in the subdirectories of `file_root`, labeled by the subdirectory."""
+        if not case_sensitive_filter:
+            file_filters = [f.lower() for f in file_filters]
+        subdirs = sorted(entry.name for entry in os.scandir(file_root) if entry.is_dir())
+        pairs = []
+        for label, subdir in enumerate(subdirs):
+            for entry in os.scandir(os.path.join(file_root, subdir)):
+                # only regular files and symlinks are listed
+                if not (entry.is_file(follow_symlinks=False) or entry.is_symlink()):
+                    continue
+                name = entry.name if case_sensitive_filter else entry.name.lower()
+                if any(fnmatch.fnmatchcase(name, f) for f in file_filters):
+                    pairs.append((os.path.join(subdir, entry.name), label))
+                    if len(pairs) % self.report_step == 0:
+                        self._report(len(pairs), "collect")
+        pairs.sort()
+        self.write(pairs)
+
+    def from_file_list(self, file_list):
+        """Indexes the ``filename label`` pairs listed in a text file."""
+        line_re = re.compile(r"^(.*\S)\s+(\d+)$")
+        pairs = []
+        with open(file_list, "r") as f:
+            for n, line in enumerate(f, 1):
+                line = line.rstrip()
+                if not line:
+                    continue
+                match = line_re.match(line)
+                if match is None:
+                    raise ValueError(f"Incorrect format of the list file \"{file_list}\":{n} "
+                                     f"expected file name followed by a label; got: {line}")
+                pairs.append((match.group(1), int(match.group(2))))
+                if len(pairs) % self.report_step == 0:
+                    self._report(len(pairs), "collect")
+        self.write(pairs)
+
+    def write(self, pairs):
+        """Writes the index of the (file, label) pairs."""
+        if not pairs:
+            raise ValueError("No files found.")
+        offsets = array.array("Q", [0])
+        labels = array.array("i")
+        names = []
+        for name, label in pairs:
+            encoded = name.encode()
+            names.append(encoded)
+            offsets.append(offsets[-1] + len(encoded))
+            labels.append(label)
+        # the labels are padded to a multiple of 8 bytes
+        if len(labels) % 2:
+            labels.append(0)
+        if sys.byteorder != "little":
+            offsets.byteswap()
+            labels.byteswap()
+        with open(self.idx_path, "wb") as f:
+            f.write(HEADER.pack(MAGIC, VERSION, 0, len(pairs), offsets[-1]))
+            f.write(offsets.tobytes())
+            f.write(labels.tobytes())
+            f.writelines(names)
+        self._report(len(pairs), "done")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+        description="Creates a binary file index for the use with the `fn.readers.file`.",
+    )
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--file_root", help="directory with one subdirectory per label.")
+    source.add_argument("--file_list", help="text file with one `filename label` pair per line.")
+    parser.add_argument("--file_filters", nargs="+", default=KNOWN_EXTENSIONS_GLOB,
+                        help="glob patterns of the files to index, used with --file_root.")
+    parser.add_argument("--case_sensitive_filter", action="store_true",
+                        help="match the --file_filters case-sensitively.")
+    parser.add_argument("index", help="path to the index file.")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    creator = IndexCreator(args.index)
+    if args.file_root is not None:
+        creator.from_directory(args.file_root, args.file_filters, args.case_sensitive_filter)
+    else:
+        creator.from_file_list(args.file_list)
+
+
+if __name__ == "__main__":
+    main()